@@ -17,6 +17,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include <stddef.h>
+#include <string.h>
 
 #include "api/stse_device_management.h"
 
@@ -24,18 +25,9 @@
 #define I2C_ADDR_MAX 0x7F
 #define IDLE_BUS_DELAY_MAX 0x1F
 
-/* Exported functions --------------------------------------------------------*/
-stse_ReturnCode_t stse_init(stse_Handler_t *pSTSE) {
+/* Private functions ---------------------------------------------------------*/
+static stse_ReturnCode_t stse_init_platform(stse_Handler_t *pSTSE) {
     stse_ReturnCode_t ret = STSE_API_INVALID_PARAMETER;
-#ifdef STSE_CONF_STSAFE_A_SUPPORT
-    PLAT_UI8 mask_id[STSAFEA_MASK_ID_SIZE];
-    PLAT_UI16 mask_number;
-#endif /* STSE_CONF_STSAFE_A_SUPPORT */
-
-    /* - Check STSAFE handler initialization */
-    if (pSTSE == NULL) {
-        return (STSE_API_HANDLER_NOT_INITIALISED);
-    }
 
     switch (pSTSE->io.BusType) {
 #if defined(STSE_CONF_STSAFE_A_SUPPORT) || \
@@ -60,6 +52,8 @@ stse_ReturnCode_t stse_init(stse_Handler_t *pSTSE) {
         pSTSE->io.BusRecvStart = stse_platform_st1wire_receive_start;
         pSTSE->io.BusRecvContinue = stse_platform_st1wire_receive_continue;
         pSTSE->io.BusRecvStop = stse_platform_st1wire_receive_stop;
+        pSTSE->io.BusRecvV = NULL;
+        pSTSE->io.BusSendV = NULL;
         break;
 #endif /* STSE_CONF_USE_ST1WIRE */
 
@@ -93,6 +87,118 @@ stse_ReturnCode_t stse_init(stse_Handler_t *pSTSE) {
         return ret;
     }
 
+    return ret;
+}
+
+#ifdef STSE_CONF_STSAFE_A_SUPPORT
+#ifndef STSE_CONF_USE_STATIC_PERSONALIZATION_INFORMATIONS
+static stse_ReturnCode_t stse_init_device_identify(stse_Handler_t *pSTSE, PLAT_UI8 *pMask_id) {
+    stse_ReturnCode_t ret;
+    PLAT_UI16 mask_number;
+
+    ret = stsafea_query_mask_id(pSTSE, pMask_id);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+
+    mask_number = (pMask_id[STSAFEA_MASK_ID_SIZE - 2] << 8) + pMask_id[STSAFEA_MASK_ID_SIZE - 1];
+    if (mask_number >= 0x6000) {
+        pSTSE->device_type = STSAFE_A120;
+    } else if (mask_number >= 0x4600) {
+        pSTSE->device_type = STSAFE_A110;
+    } else if (mask_number >= 0x4000) {
+        pSTSE->device_type = STSAFE_A100;
+    } else {
+        return (STSE_SERVICE_INCOMPATIBLE_DEVICE_TYPE);
+    }
+
+    return STSE_OK;
+}
+
+static void stse_perso_snapshot_put_ui32(PLAT_UI8 *pBuffer, PLAT_UI32 value) {
+    pBuffer[0] = UI32_B3(value);
+    pBuffer[1] = UI32_B2(value);
+    pBuffer[2] = UI32_B1(value);
+    pBuffer[3] = UI32_B0(value);
+}
+
+static PLAT_UI32 stse_perso_snapshot_get_ui32(const PLAT_UI8 *pBuffer) {
+    return UI32_B3_SET((PLAT_UI32)pBuffer[0]) + UI32_B2_SET((PLAT_UI32)pBuffer[1]) +
+           UI32_B1_SET((PLAT_UI32)pBuffer[2]) + UI32_B0_SET((PLAT_UI32)pBuffer[3]);
+}
+
+static void stse_perso_snapshot_put_ui64(PLAT_UI8 *pBuffer, PLAT_UI64 value) {
+    stse_perso_snapshot_put_ui32(pBuffer, (PLAT_UI32)(value >> 32));
+    stse_perso_snapshot_put_ui32(pBuffer + 4, (PLAT_UI32)value);
+}
+
+static PLAT_UI64 stse_perso_snapshot_get_ui64(const PLAT_UI8 *pBuffer) {
+    return ((PLAT_UI64)stse_perso_snapshot_get_ui32(pBuffer) << 32) + stse_perso_snapshot_get_ui32(pBuffer + 4);
+}
+
+static PLAT_UI8 stse_perso_snapshot_check(stse_Handler_t *pSTSE,
+                                          const PLAT_UI8 *pSnapshot,
+                                          PLAT_UI16 snapshot_length,
+                                          const PLAT_UI8 *pMask_id) {
+    PLAT_UI16 crc;
+
+    if ((pSnapshot == NULL) || (snapshot_length < STSE_PERSO_SNAPSHOT_SIZE)) {
+        return 0;
+    }
+
+    /* - Snapshot format and integrity */
+    if ((pSnapshot[STSE_PERSO_SNAPSHOT_MAGIC_OFFSET] != STSE_PERSO_SNAPSHOT_MAGIC_0) ||
+        (pSnapshot[STSE_PERSO_SNAPSHOT_MAGIC_OFFSET + 1] != STSE_PERSO_SNAPSHOT_MAGIC_1) ||
+        (pSnapshot[STSE_PERSO_SNAPSHOT_VERSION_OFFSET] != STSE_PERSO_SNAPSHOT_VERSION)) {
+        return 0;
+    }
+    if (stse_frame_crc16_accumulate((PLAT_UI8 *)pSnapshot, STSE_PERSO_SNAPSHOT_CRC_OFFSET, 1, &crc) != STSE_OK) {
+        return 0;
+    }
+    if ((pSnapshot[STSE_PERSO_SNAPSHOT_CRC_OFFSET] != UI16_B1(crc)) ||
+        (pSnapshot[STSE_PERSO_SNAPSHOT_CRC_OFFSET + 1] != UI16_B0(crc))) {
+        return 0;
+    }
+
+    /* - Snapshot taken on the same device mask */
+    if ((pSnapshot[STSE_PERSO_SNAPSHOT_DEVICE_TYPE_OFFSET] != (PLAT_UI8)pSTSE->device_type) ||
+        (memcmp(&pSnapshot[STSE_PERSO_SNAPSHOT_MASK_ID_OFFSET], pMask_id, STSAFEA_MASK_ID_SIZE) != 0)) {
+        return 0;
+    }
+
+    return 1;
+}
+
+static void stse_perso_snapshot_restore(stse_Handler_t *pSTSE, const PLAT_UI8 *pSnapshot) {
+    const PLAT_UI8 *pPerso = &pSnapshot[STSE_PERSO_SNAPSHOT_PERSO_OFFSET];
+
+    pSTSE->perso_info.cmd_encryption_status = stse_perso_snapshot_get_ui32(pPerso);
+    pSTSE->perso_info.rsp_encryption_status = stse_perso_snapshot_get_ui32(pPerso + 4);
+    pSTSE->perso_info.ext_cmd_encryption_status = stse_perso_snapshot_get_ui32(pPerso + 8);
+    pSTSE->perso_info.ext_rsp_encryption_status = stse_perso_snapshot_get_ui32(pPerso + 12);
+    pSTSE->perso_info.cmd_AC_status = stse_perso_snapshot_get_ui64(pPerso + 16);
+    pSTSE->perso_info.ext_cmd_AC_status = stse_perso_snapshot_get_ui64(pPerso + 24);
+}
+#endif /* STSE_CONF_USE_STATIC_PERSONALIZATION_INFORMATIONS */
+#endif /* STSE_CONF_STSAFE_A_SUPPORT */
+
+/* Exported functions --------------------------------------------------------*/
+stse_ReturnCode_t stse_init(stse_Handler_t *pSTSE) {
+    stse_ReturnCode_t ret;
+#if defined(STSE_CONF_STSAFE_A_SUPPORT) && !defined(STSE_CONF_USE_STATIC_PERSONALIZATION_INFORMATIONS)
+    PLAT_UI8 mask_id[STSAFEA_MASK_ID_SIZE];
+#endif /* STSE_CONF_STSAFE_A_SUPPORT && !STSE_CONF_USE_STATIC_PERSONALIZATION_INFORMATIONS */
+
+    /* - Check STSAFE handler initialization */
+    if (pSTSE == NULL) {
+        return (STSE_API_HANDLER_NOT_INITIALISED);
+    }
+
+    ret = stse_init_platform(pSTSE);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+
 #ifdef STSE_CONF_STSAFE_A_SUPPORT
 #ifdef STSE_CONF_STSAFE_L_SUPPORT
     if (pSTSE->device_type != STSAFE_L010) {
@@ -100,27 +206,12 @@ stse_ReturnCode_t stse_init(stse_Handler_t *pSTSE) {
         stse_platform_Delay_ms(stsafea_boot_time[pSTSE->device_type]);
 
 #ifndef STSE_CONF_USE_STATIC_PERSONALIZATION_INFORMATIONS
-		ret = stsafea_query_mask_id(pSTSE, mask_id);
-	    if (ret != STSE_OK) {
-	        return ret;
-	    }
-
-	    mask_number = (mask_id[STSAFEA_MASK_ID_SIZE - 2] << 8) + mask_id[STSAFEA_MASK_ID_SIZE - 1];
-	    if (mask_number >= 0x6000) {
-	    	pSTSE->device_type = STSAFE_A120;
-	    }
-	    else if (mask_number >= 0x4600) {
-	    	pSTSE->device_type = STSAFE_A110;
-	    }
-	    else if (mask_number >= 0x4000) {
-	    	pSTSE->device_type = STSAFE_A100;
-	    }
-	    else
-	    {
-	    	return (STSE_SERVICE_INCOMPATIBLE_DEVICE_TYPE);
-	    }
-
-	    ret = stsafea_perso_info_update(pSTSE);
+        ret = stse_init_device_identify(pSTSE, mask_id);
+        if (ret != STSE_OK) {
+            return ret;
+        }
+
+        ret = stsafea_perso_info_update(pSTSE);
 #endif /* STSE_CONF_USE_STATIC_PERSONALIZATION_INFORMATIONS */
 #ifdef STSE_CONF_STSAFE_L_SUPPORT
     }
@@ -130,6 +221,106 @@ stse_ReturnCode_t stse_init(stse_Handler_t *pSTSE) {
     return ret;
 }
 
+#if defined(STSE_CONF_STSAFE_A_SUPPORT) && !defined(STSE_CONF_USE_STATIC_PERSONALIZATION_INFORMATIONS)
+stse_ReturnCode_t stse_init_from_perso_snapshot(stse_Handler_t *pSTSE,
+                                                const PLAT_UI8 *pSnapshot,
+                                                PLAT_UI16 snapshot_length,
+                                                PLAT_UI8 *pSnapshot_restored) {
+    stse_ReturnCode_t ret;
+    PLAT_UI8 mask_id[STSAFEA_MASK_ID_SIZE];
+    PLAT_UI8 restored = 0;
+
+    /* - Check STSAFE handler initialization */
+    if (pSTSE == NULL) {
+        return (STSE_API_HANDLER_NOT_INITIALISED);
+    }
+
+    ret = stse_init_platform(pSTSE);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+
+#ifdef STSE_CONF_STSAFE_L_SUPPORT
+    if (pSTSE->device_type != STSAFE_L010) {
+#endif /* STSE_CONF_STSAFE_L_SUPPORT */
+        stse_platform_Delay_ms(stsafea_boot_time[pSTSE->device_type]);
+
+        /* - Mask identification query validates the snapshot against the connected device */
+        ret = stse_init_device_identify(pSTSE, mask_id);
+        if (ret != STSE_OK) {
+            return ret;
+        }
+
+        if (stse_perso_snapshot_check(pSTSE, pSnapshot, snapshot_length, mask_id) != 0) {
+            stse_perso_snapshot_restore(pSTSE, pSnapshot);
+            restored = 1;
+        } else {
+            /* - Invalid or outdated snapshot : full personalization discovery */
+            ret = stsafea_perso_info_update(pSTSE);
+        }
+#ifdef STSE_CONF_STSAFE_L_SUPPORT
+    }
+#endif /* STSE_CONF_STSAFE_L_SUPPORT */
+
+    if (pSnapshot_restored != NULL) {
+        *pSnapshot_restored = restored;
+    }
+
+    return ret;
+}
+
+stse_ReturnCode_t stse_perso_snapshot_export(stse_Handler_t *pSTSE,
+                                             PLAT_UI8 *pSnapshot,
+                                             PLAT_UI16 *pSnapshot_length) {
+    stse_ReturnCode_t ret;
+    PLAT_UI8 *pPerso;
+    PLAT_UI16 crc;
+
+    /* - Check STSAFE handler initialization */
+    if (pSTSE == NULL) {
+        return (STSE_API_HANDLER_NOT_INITIALISED);
+    }
+
+    if ((pSnapshot == NULL) || (pSnapshot_length == NULL) || (*pSnapshot_length < STSE_PERSO_SNAPSHOT_SIZE)) {
+        return (STSE_API_INVALID_PARAMETER);
+    }
+
+    if ((pSTSE->device_type < STSE_DEVICE_STSAFEA_FAMILY_INDEX) ||
+        (pSTSE->device_type >= (STSE_DEVICE_STSAFEA_FAMILY_INDEX + STSAFEA_PRODUCT_COUNT))) {
+        return (STSE_API_INCOMPATIBLE_DEVICE_TYPE);
+    }
+
+    ret = stsafea_query_mask_id(pSTSE, &pSnapshot[STSE_PERSO_SNAPSHOT_MASK_ID_OFFSET]);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+
+    pSnapshot[STSE_PERSO_SNAPSHOT_MAGIC_OFFSET] = STSE_PERSO_SNAPSHOT_MAGIC_0;
+    pSnapshot[STSE_PERSO_SNAPSHOT_MAGIC_OFFSET + 1] = STSE_PERSO_SNAPSHOT_MAGIC_1;
+    pSnapshot[STSE_PERSO_SNAPSHOT_VERSION_OFFSET] = STSE_PERSO_SNAPSHOT_VERSION;
+    pSnapshot[STSE_PERSO_SNAPSHOT_DEVICE_TYPE_OFFSET] = (PLAT_UI8)pSTSE->device_type;
+
+    pPerso = &pSnapshot[STSE_PERSO_SNAPSHOT_PERSO_OFFSET];
+    stse_perso_snapshot_put_ui32(pPerso, pSTSE->perso_info.cmd_encryption_status);
+    stse_perso_snapshot_put_ui32(pPerso + 4, pSTSE->perso_info.rsp_encryption_status);
+    stse_perso_snapshot_put_ui32(pPerso + 8, pSTSE->perso_info.ext_cmd_encryption_status);
+    stse_perso_snapshot_put_ui32(pPerso + 12, pSTSE->perso_info.ext_rsp_encryption_status);
+    stse_perso_snapshot_put_ui64(pPerso + 16, pSTSE->perso_info.cmd_AC_status);
+    stse_perso_snapshot_put_ui64(pPerso + 24, pSTSE->perso_info.ext_cmd_AC_status);
+
+    ret = stse_frame_crc16_accumulate(pSnapshot, STSE_PERSO_SNAPSHOT_CRC_OFFSET, 1, &crc);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+    pSnapshot[STSE_PERSO_SNAPSHOT_CRC_OFFSET] = UI16_B1(crc);
+    pSnapshot[STSE_PERSO_SNAPSHOT_CRC_OFFSET + 1] = UI16_B0(crc);
+
+    *pSnapshot_length = STSE_PERSO_SNAPSHOT_SIZE;
+
+    return STSE_OK;
+}
+#endif /* STSE_CONF_STSAFE_A_SUPPORT && !STSE_CONF_USE_STATIC_PERSONALIZATION_INFORMATIONS */
+
 stse_ReturnCode_t stse_device_enter_hibernate(stse_Handler_t *pSTSE,
                                               stse_hibernate_wake_up_mode_t wake_up_mode) {
     stse_ReturnCode_t ret = STSE_API_INCOMPATIBLE_DEVICE_TYPE;
@@ -64,6 +64,58 @@ typedef enum stse_low_power_mode_t {
  */
 stse_ReturnCode_t stse_init(stse_Handler_t *pSTSE);
 
+#if defined(STSE_CONF_STSAFE_A_SUPPORT) && !defined(STSE_CONF_USE_STATIC_PERSONALIZATION_INFORMATIONS)
+
+/* Personalization snapshot layout : [magic (2)][version (1)][device type (1)][mask ID (3)][perso info (32 , big endian)][CRC16 (2)] */
+#define STSE_PERSO_SNAPSHOT_MAGIC_0 0x53U /*!< Personalization snapshot magic first byte ('S') */
+#define STSE_PERSO_SNAPSHOT_MAGIC_1 0x50U /*!< Personalization snapshot magic second byte ('P') */
+#define STSE_PERSO_SNAPSHOT_VERSION 0x01U /*!< Personalization snapshot format version */
+#define STSE_PERSO_SNAPSHOT_MAGIC_OFFSET 0U
+#define STSE_PERSO_SNAPSHOT_VERSION_OFFSET 2U
+#define STSE_PERSO_SNAPSHOT_DEVICE_TYPE_OFFSET 3U
+#define STSE_PERSO_SNAPSHOT_MASK_ID_OFFSET 4U
+#define STSE_PERSO_SNAPSHOT_PERSO_OFFSET (STSE_PERSO_SNAPSHOT_MASK_ID_OFFSET + STSAFEA_MASK_ID_SIZE)
+#define STSE_PERSO_SNAPSHOT_CRC_OFFSET (STSE_PERSO_SNAPSHOT_PERSO_OFFSET + 32U)
+#define STSE_PERSO_SNAPSHOT_SIZE (STSE_PERSO_SNAPSHOT_CRC_OFFSET + 2U) /*!< Personalization snapshot size in bytes */
+
+/**
+ * \brief 		Initialize target device from a personalization snapshot
+ * \details 	This function performs the same initialization as \ref stse_init but restores the handler
+ *              personalization information (command access conditions and encryption flags) from a snapshot
+ *              exported by \ref stse_perso_snapshot_export instead of reading the command authorization table
+ *              from the device. The device mask identification is queried to validate the snapshot : when the
+ *              snapshot is corrupted , has another format version or was taken on another device mask , the
+ *              personalization information is read from the device as done by \ref stse_init
+ * \param[in] 	pSTSE 				Pointer to STSE Handler
+ * \param[in] 	pSnapshot 			Pointer to personalization snapshot (NULL : full discovery)
+ * \param[in] 	snapshot_length 	Personalization snapshot length
+ * \param[out] 	pSnapshot_restored 	Set to 1 when the snapshot has been restored , 0 otherwise (optional , NULL if not used)
+ * \return \ref STSE_OK on success ; \ref stse_ReturnCode_t error code otherwise
+ * \note        The snapshot must be exported again after any change of the device command authorization configuration
+ * \details 	\include{doc} stse_init_from_perso_snapshot.dox
+ */
+stse_ReturnCode_t stse_init_from_perso_snapshot(stse_Handler_t *pSTSE,
+                                                const PLAT_UI8 *pSnapshot,
+                                                PLAT_UI16 snapshot_length,
+                                                PLAT_UI8 *pSnapshot_restored);
+
+/**
+ * \brief 		Export handler personalization snapshot
+ * \details 	This function serializes the detected device type , the device mask identification and the handler
+ *              personalization information in a versioned and CRC16 protected snapshot of \ref STSE_PERSO_SNAPSHOT_SIZE
+ *              bytes , to be stored by the application (e.g. in host flash) and given to \ref stse_init_from_perso_snapshot
+ *              on next startups
+ * \param[in] 	pSTSE 				Pointer to initialized STSE Handler
+ * \param[out] 	pSnapshot 			Snapshot buffer
+ * \param[in,out] pSnapshot_length 	In : snapshot buffer size , out : snapshot length
+ * \return \ref STSE_OK on success ; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_perso_snapshot_export(stse_Handler_t *pSTSE,
+                                             PLAT_UI8 *pSnapshot,
+                                             PLAT_UI16 *pSnapshot_length);
+
+#endif /* STSE_CONF_STSAFE_A_SUPPORT && !STSE_CONF_USE_STATIC_PERSONALIZATION_INFORMATIONS */
+
 /**
  * \brief 		Reset target device
  * \details 	This function call reset service to reset the device
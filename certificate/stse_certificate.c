@@ -19,6 +19,7 @@
 #include "certificate/stse_certificate_crypto.h"
 #include "certificate/stse_certificate_prints.h"
 #include "certificate/stse_certificate_subparsing.h"
+#include "core/stse_platform.h"
 #include <stdint.h>
 #include <string.h>
 
@@ -394,10 +395,49 @@ stse_ReturnCode_t stse_certificate_parse_chain(
 
 void stse_certificate_set_stse_companion(stse_Handler_t *pSTSE) {
     if (pSTSE != NULL) {
+#if defined(STSE_CONF_USE_THREAD_SAFETY) && defined(STSE_CONF_USE_COMPANION)
+        if (stse_platform_companion_lock() != STSE_OK) {
+            return;
+        }
+        stsafe_x509_parser_companion_handler = pSTSE;
+        stse_platform_companion_unlock();
+#else
         stsafe_x509_parser_companion_handler = pSTSE;
+#endif /* STSE_CONF_USE_THREAD_SAFETY && STSE_CONF_USE_COMPANION */
     }
 }
 
 void stse_certificate_reset_stse_companion() {
+#if defined(STSE_CONF_USE_THREAD_SAFETY) && defined(STSE_CONF_USE_COMPANION)
+    /* - Wait for verifications using the companion */
+    if (stse_platform_companion_lock() != STSE_OK) {
+        return;
+    }
+    stsafe_x509_parser_companion_handler = NULL;
+    stse_platform_companion_unlock();
+#else
     stsafe_x509_parser_companion_handler = NULL;
+#endif /* STSE_CONF_USE_THREAD_SAFETY && STSE_CONF_USE_COMPANION */
+}
+
+#ifdef STSE_CONF_USE_COMPANION
+stse_ReturnCode_t stse_certificate_get_stse_companion(stse_Handler_t **ppCompanion) {
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+    stse_ReturnCode_t ret;
+
+    ret = stse_platform_companion_lock();
+    if (ret != STSE_OK) {
+        return ret;
+    }
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
+    *ppCompanion = stsafe_x509_parser_companion_handler;
+
+    return STSE_OK;
+}
+
+void stse_certificate_put_stse_companion(void) {
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+    stse_platform_companion_unlock();
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
 }
+#endif /* STSE_CONF_USE_COMPANION */
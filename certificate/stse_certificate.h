@@ -108,9 +108,25 @@ void stse_certificate_set_stse_companion(stse_Handler_t *pSTSE);
 
 /**
  * \brief Reset the certificate parser STSAFE-A companion
+ * \details When STSE_CONF_USE_THREAD_SAFETY is defined , returns once no certificate verification uses the companion
  */
 void stse_certificate_reset_stse_companion();
 
+#ifdef STSE_CONF_USE_COMPANION
+/**
+ * \brief Get the certificate parser STSAFE-A companion for a verification step
+ * \details Takes the companion lock (STSE_CONF_USE_THREAD_SAFETY) , released by \ref stse_certificate_put_stse_companion
+ * \param[out] ppCompanion 	Pointer to the companion handler (NULL when no companion is assigned)
+ * \return \ref STSE_OK on success ; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_certificate_get_stse_companion(stse_Handler_t **ppCompanion);
+
+/**
+ * \brief Release the certificate parser STSAFE-A companion got by \ref stse_certificate_get_stse_companion
+ */
+void stse_certificate_put_stse_companion(void);
+#endif /* STSE_CONF_USE_COMPANION */
+
 /** @}*/
 
 #endif /* STSE_CERTIFICATE_H */
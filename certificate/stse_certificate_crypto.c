@@ -21,11 +21,15 @@
 
 #include "api/stse_ecc.h"
 #include "api/stse_hash.h"
+#include "certificate/stse_certificate.h"
 #include "certificate/stse_certificate_crypto.h"
 
 stse_ReturnCode_t stse_certificate_verify_cert_signature(const stse_certificate_t *parent, const stse_certificate_t *child) {
     stse_ReturnCode_t ret;
     stse_hash_algorithm_t hash_algo;
+#ifdef STSE_CONF_USE_COMPANION
+    stse_Handler_t *pCompanion;
+#endif
 
     if ((parent == NULL) || (child == NULL)) {
         return (STSE_CERT_INVALID_PARAMETER);
@@ -44,19 +48,27 @@ stse_ReturnCode_t stse_certificate_verify_cert_signature(const stse_certificate_
     PLAT_UI8 digest[digestSize];
     PLAT_UI8 *digestPtr = digest;
 
+#ifdef STSE_CONF_USE_COMPANION
+    /* - Companion kept assigned until digest computation completion */
+    ret = stse_certificate_get_stse_companion(&pCompanion);
+    if (ret != STSE_OK) {
+        return (ret);
+    }
+#endif
+
     if (parent->SignatureAlgorithm == SIG_EDDSA_ED25519) {
         digestPtr = (PLAT_UI8 *)child->tbs;
         digestSize = child->tbsSize;
         ret = STSE_OK;
     }
 #ifdef STSE_CONF_USE_COMPANION
-    else if (stsafe_x509_parser_companion_handler != NULL &&
-             stsafe_x509_parser_companion_handler->device_type == STSAFE_A120
+    else if (pCompanion != NULL &&
+             pCompanion->device_type == STSAFE_A120
 #ifdef STSE_CONF_HASH_SHA_256
              && hash_algo >= STSE_SHA_256
 #endif
     ) { /* Only STSAFE-A120 support Hash features */
-        ret = stse_compute_hash(stsafe_x509_parser_companion_handler, hash_algo,
+        ret = stse_compute_hash(pCompanion, hash_algo,
                                 (PLAT_UI8 *)child->tbs, child->tbsSize, digestPtr,
                                 (PLAT_UI16 *)&digestSize);
     }
@@ -65,6 +77,9 @@ stse_ReturnCode_t stse_certificate_verify_cert_signature(const stse_certificate_
         ret = stse_platform_hash_compute(hash_algo, (PLAT_UI8 *)child->tbs, child->tbsSize,
                                          digestPtr, &digestSize);
     }
+#ifdef STSE_CONF_USE_COMPANION
+    stse_certificate_put_stse_companion();
+#endif
 
     if (ret != STSE_OK) {
         return (ret);
@@ -102,6 +117,13 @@ stse_ReturnCode_t stse_certificate_verify_signature(const stse_certificate_t *ce
     PLAT_UI8 signature[signature_size];
 #ifdef STSE_CONF_USE_COMPANION
     PLAT_UI8 signature_validity;
+    stse_Handler_t *pCompanion;
+
+    /* - Companion kept assigned until signature verification completion */
+    ret = stse_certificate_get_stse_companion(&pCompanion);
+    if (ret != STSE_OK) {
+        return (ret);
+    }
 #endif
 
     /* Extract and format the public key from the certificate */
@@ -113,9 +135,9 @@ stse_ReturnCode_t stse_certificate_verify_signature(const stse_certificate_t *ce
             memcpy(pub_key + (pub_key_size >> 1), cert->PubKey.pY, (pub_key_size >> 1));
         } else {
 #ifdef STSE_CONF_USE_COMPANION
-            if (stsafe_x509_parser_companion_handler != NULL) {
+            if (pCompanion != NULL) {
                 stsafea_ecc_decompress_public_key(
-                    stsafe_x509_parser_companion_handler,
+                    pCompanion,
                     key_type,
                     *cert->pPubKey_point_representation_id,
                     pub_key,
@@ -123,6 +145,9 @@ stse_ReturnCode_t stse_certificate_verify_signature(const stse_certificate_t *ce
             } else
 #endif
             {
+#ifdef STSE_CONF_USE_COMPANION
+                stse_certificate_put_stse_companion();
+#endif
                 return STSE_CERT_UNSUPPORTED_FEATURE;
             }
         }
@@ -133,10 +158,10 @@ stse_ReturnCode_t stse_certificate_verify_signature(const stse_certificate_t *ce
     memcpy(signature + (signature_size >> 1), signatureS, (signature_size >> 1));
 
 #ifdef STSE_CONF_USE_COMPANION
-    if (stsafe_x509_parser_companion_handler != NULL) {
+    if (pCompanion != NULL) {
         /* Verify the signature using STSAFE */
         ret = stse_ecc_verify_signature(
-            stsafe_x509_parser_companion_handler,
+            pCompanion,
             key_type,
             pub_key,
             signature,
@@ -145,8 +170,8 @@ stse_ReturnCode_t stse_certificate_verify_signature(const stse_certificate_t *ce
             1, /* Message is hashed */
             &signature_validity);
 
-        if ((ret == STSE_OK) && (signature_validity == 1)) {
-            return (STSE_OK);
+        if ((ret == STSE_OK) && (signature_validity != 1)) {
+            ret = STSE_CERT_INVALID_SIGNATURE;
         }
     } else
 #endif
@@ -157,10 +182,13 @@ stse_ReturnCode_t stse_certificate_verify_signature(const stse_certificate_t *ce
             (PLAT_UI8 *)digest,
             (PLAT_UI16)digestSize,
             signature);
+    }
+#ifdef STSE_CONF_USE_COMPANION
+    stse_certificate_put_stse_companion();
+#endif
 
-        if (ret == STSE_OK) {
-            return (STSE_OK);
-        }
+    if (ret == STSE_OK) {
+        return (STSE_OK);
     }
 
     return (STSE_CERT_INVALID_SIGNATURE);
@@ -0,0 +1,160 @@
+/*!
+ * ******************************************************************************
+ * \file	stse_cmd_metrics.c
+ * \brief   STSELib command metrics (sources)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include "core/stse_cmd_metrics.h"
+#include <string.h>
+
+#ifdef STSE_CMD_METRICS
+
+#define STSE_CMD_METRICS_CMD_CODE_MASK 0x1FU       /*!< Command code field of the command header */
+#define STSE_CMD_METRICS_EXTENDED_CMD_PREFIX 0x1FU /*!< Extended command prefix */
+
+static stse_cmd_metrics_t *stse_cmd_metrics_get(stse_Handler_t *pSTSE, stse_frame_t *pCmdFrame) {
+    PLAT_UI8 cmd_code;
+
+    if ((pSTSE == NULL) || (pCmdFrame == NULL) || (pCmdFrame->first_element == NULL) || (pCmdFrame->first_element->pData == NULL)) {
+        return NULL;
+    }
+
+    cmd_code = pCmdFrame->first_element->pData[0] & STSE_CMD_METRICS_CMD_CODE_MASK;
+    if ((cmd_code == STSE_CMD_METRICS_EXTENDED_CMD_PREFIX) && (pCmdFrame->first_element->length > 1)) {
+        if (pCmdFrame->first_element->pData[1] >= STSE_CMD_METRICS_TRACKED_CMD_COUNT) {
+            return NULL;
+        }
+        return &pSTSE->cmd_metrics.metrics.ext_cmd[pCmdFrame->first_element->pData[1]];
+    }
+
+    return &pSTSE->cmd_metrics.metrics.cmd[cmd_code];
+}
+
+void stse_cmd_metrics_command_start(stse_Handler_t *pSTSE) {
+    pSTSE->cmd_metrics.cmd_start = stse_platform_get_timestamp();
+    pSTSE->cmd_metrics.tx_end = pSTSE->cmd_metrics.cmd_start;
+    pSTSE->cmd_metrics.rx_start = pSTSE->cmd_metrics.cmd_start;
+    pSTSE->cmd_metrics.retry_count = 0;
+}
+
+void stse_cmd_metrics_tx_end(stse_Handler_t *pSTSE) {
+    pSTSE->cmd_metrics.tx_end = stse_platform_get_timestamp();
+    pSTSE->cmd_metrics.rx_start = pSTSE->cmd_metrics.tx_end;
+}
+
+void stse_cmd_metrics_rx_start(stse_Handler_t *pSTSE) {
+    pSTSE->cmd_metrics.rx_start = stse_platform_get_timestamp();
+}
+
+void stse_cmd_metrics_command_end(stse_Handler_t *pSTSE,
+                                  stse_frame_t *pCmdFrame,
+                                  stse_frame_t *pRspFrame,
+                                  stse_ReturnCode_t status) {
+    stse_cmd_metrics_t *pMetrics = stse_cmd_metrics_get(pSTSE, pCmdFrame);
+    PLAT_UI32 end = stse_platform_get_timestamp();
+    PLAT_UI32 latency;
+    PLAT_UI8 bin = 0;
+
+    if (pMetrics == NULL) {
+        return;
+    }
+
+    pMetrics->count++;
+    if (status != STSE_OK) {
+        pMetrics->error_count++;
+    }
+    pMetrics->retry_count += pSTSE->cmd_metrics.retry_count;
+    pMetrics->tx_bytes += pCmdFrame->length;
+    if ((pRspFrame != NULL) && (status <= 0xFF)) {
+        pMetrics->rx_bytes += pRspFrame->length;
+    }
+
+    /* - Split transfer latency in transmit , execution wait and receive times */
+    pMetrics->tx_time += pSTSE->cmd_metrics.tx_end - pSTSE->cmd_metrics.cmd_start;
+    pMetrics->exec_time += pSTSE->cmd_metrics.rx_start - pSTSE->cmd_metrics.tx_end;
+    pMetrics->rx_time += end - pSTSE->cmd_metrics.rx_start;
+
+    /* - Update latency histogram (log2 bins) */
+    latency = (end - pSTSE->cmd_metrics.cmd_start) >> STSE_CMD_METRICS_HISTOGRAM_SHIFT;
+    while ((latency != 0) && (bin < (STSE_CMD_METRICS_HISTOGRAM_SIZE - 1))) {
+        latency >>= 1;
+        bin++;
+    }
+    if (pMetrics->latency_histogram[bin] != 0xFFFF) {
+        pMetrics->latency_histogram[bin]++;
+    }
+}
+
+void stse_cmd_metrics_crypto_record(stse_Handler_t *pSTSE,
+                                    stse_frame_t *pCmdFrame,
+                                    PLAT_UI32 start_timestamp) {
+    stse_cmd_metrics_t *pMetrics = stse_cmd_metrics_get(pSTSE, pCmdFrame);
+
+    if (pMetrics != NULL) {
+        pMetrics->crypto_time += stse_platform_get_timestamp() - start_timestamp;
+    }
+}
+
+stse_ReturnCode_t stse_cmd_metrics_snapshot(stse_Handler_t *pSTSE, stse_cmd_metrics_snapshot_t *pSnapshot) {
+    stse_ReturnCode_t ret = STSE_OK;
+
+    if (pSTSE == NULL) {
+        return STSE_CORE_HANDLER_NOT_INITIALISED;
+    }
+    if (pSnapshot == NULL) {
+        return STSE_CORE_INVALID_PARAMETER;
+    }
+
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+    /* - Take device lock to get consistent metrics */
+    ret = stse_handler_lock(pSTSE);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
+
+    memcpy(pSnapshot, &pSTSE->cmd_metrics.metrics, sizeof(stse_cmd_metrics_snapshot_t));
+
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+    stse_handler_unlock(pSTSE);
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
+
+    return ret;
+}
+
+stse_ReturnCode_t stse_cmd_metrics_reset(stse_Handler_t *pSTSE) {
+    stse_ReturnCode_t ret = STSE_OK;
+
+    if (pSTSE == NULL) {
+        return STSE_CORE_HANDLER_NOT_INITIALISED;
+    }
+
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+    ret = stse_handler_lock(pSTSE);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
+
+    memset(&pSTSE->cmd_metrics.metrics, 0, sizeof(stse_cmd_metrics_snapshot_t));
+
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+    stse_handler_unlock(pSTSE);
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
+
+    return ret;
+}
+
+#endif /* STSE_CMD_METRICS */
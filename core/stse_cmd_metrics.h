@@ -0,0 +1,108 @@
+/*!
+ * ******************************************************************************
+ * \file	stse_cmd_metrics.h
+ * \brief   STSELib command metrics (header)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef STSE_CMD_METRICS_H
+#define STSE_CMD_METRICS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "core/stse_device.h"
+#include "core/stse_frame.h"
+#include "core/stse_platform.h"
+
+/*! \defgroup stse_cmd_metrics Command metrics
+ *  \ingroup stse_core
+ *  \brief      Per command latency and throughput metrics
+ *  \details    When STSE_CMD_METRICS is defined , each command transfer updates the handler metrics of its command
+ *              (or extended command) code : transfer and error counts , bus retries , bytes sent and received ,
+ *              time spent in command transmit , command execution wait , response receive and host session
+ *              cryptographic processing , and a transfer latency histogram. Metrics are read using
+ *              \ref stse_cmd_metrics_snapshot and cleared using \ref stse_cmd_metrics_reset.
+ *  @{
+ */
+
+#ifdef STSE_CMD_METRICS
+
+/**
+ * \brief       Start metrics accounting of a command transfer
+ * \param[in]   pSTSE : Pointer to STSE handler
+ */
+void stse_cmd_metrics_command_start(stse_Handler_t *pSTSE);
+
+/**
+ * \brief       Mark the end of the command frame transmission
+ * \param[in]   pSTSE : Pointer to STSE handler
+ */
+void stse_cmd_metrics_tx_end(stse_Handler_t *pSTSE);
+
+/**
+ * \brief       Mark the start of a response reception attempt
+ * \param[in]   pSTSE : Pointer to STSE handler
+ */
+void stse_cmd_metrics_rx_start(stse_Handler_t *pSTSE);
+
+/**
+ * \brief       End metrics accounting of a command transfer
+ * \param[in]   pSTSE : Pointer to STSE handler
+ * \param[in]   pCmdFrame : Pointer to the command frame
+ * \param[in]   pRspFrame : Pointer to the response frame
+ * \param[in]   status : Command transfer status
+ */
+void stse_cmd_metrics_command_end(stse_Handler_t *pSTSE,
+                                  stse_frame_t *pCmdFrame,
+                                  stse_frame_t *pRspFrame,
+                                  stse_ReturnCode_t status);
+
+/**
+ * \brief       Account host session cryptographic processing time of a command
+ * \param[in]   pSTSE : Pointer to STSE handler
+ * \param[in]   pCmdFrame : Pointer to the command frame
+ * \param[in]   start_timestamp : Platform timestamp taken before the cryptographic processing
+ */
+void stse_cmd_metrics_crypto_record(stse_Handler_t *pSTSE,
+                                    stse_frame_t *pCmdFrame,
+                                    PLAT_UI32 start_timestamp);
+
+/**
+ * \brief       Get a snapshot of the handler command metrics
+ * \details     When STSE_CONF_USE_THREAD_SAFETY is defined , the device lock is taken during the copy (not to be
+ *              called by the thread owning a pending asynchronous transfer of the same handler)
+ * \param[in]   pSTSE : Pointer to STSE handler
+ * \param[out]  pSnapshot : Pointer to the metrics snapshot
+ * \return \ref STSE_OK on success ; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_cmd_metrics_snapshot(stse_Handler_t *pSTSE, stse_cmd_metrics_snapshot_t *pSnapshot);
+
+/**
+ * \brief       Clear the handler command metrics
+ * \param[in]   pSTSE : Pointer to STSE handler
+ * \return \ref STSE_OK on success ; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_cmd_metrics_reset(stse_Handler_t *pSTSE);
+
+#endif /* STSE_CMD_METRICS */
+
+/** @}*/
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* STSE_CMD_METRICS_H */
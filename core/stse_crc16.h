@@ -0,0 +1,85 @@
+/*!
+ * ******************************************************************************
+ * \file	stse_crc16.h
+ * \brief   STSELib built-in CRC16 reference implementation (header)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef STSE_CRC16_H
+#define STSE_CRC16_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "core/stse_util.h"
+#include "stse_conf.h"
+
+/*! \defgroup stse_crc16 Built-in CRC16
+ *  \ingroup stse_core
+ *  \brief      Built-in table-driven CRC16 reference implementation
+ *  \details    Frame CRC used by STSE devices is the CRC-16/X-25 (reflected polynomial 0x1021 , initial value 0xFFFF ,
+ *              final XOR 0xFFFF). The CRC value returned to the frame layer is byte swapped so that it is transmitted
+ *              least significant byte first. When STSE_CONF_USE_BUILTIN_CRC16 is defined , the frame layer computes
+ *              the CRC with these functions on a caller owned value (no shared state , frames can be processed
+ *              concurrently) and this implementation backs the stse_platform_crc16_init and
+ *              stse_platform_Crc16_Calculate platform functions (weak definitions , overridden by any platform
+ *              implementation).
+ *  @{
+ */
+
+#ifdef STSE_CONF_USE_BUILTIN_CRC16
+
+#define STSE_CRC16_INIT_VALUE 0xFFFFU /*!< CRC16 register initial value */
+
+/**
+ * \brief 			Update a CRC16 register with a data buffer
+ * \details 		This core function fold a data buffer in a CRC16 register (table-driven , slice-by-8
+ *                  when STSE_CONF_BUILTIN_CRC16_SLICE_BY_8 is defined , carry-less multiply folding of buffers of
+ *                  64 bytes or more when STSE_CONF_BUILTIN_CRC16_CLMUL is defined on x86 targets built with
+ *                  PCLMULQDQ support)
+ * \param[in] 		crc 			Current CRC16 register value (\ref STSE_CRC16_INIT_VALUE for a new computation)
+ * \param[in] 		pData 			Pointer to data buffer
+ * \param[in] 		length 			Data buffer length
+ * \return 			Updated CRC16 register value
+ */
+PLAT_UI16 stse_crc16_update(PLAT_UI16 crc, PLAT_UI8 *pData, PLAT_UI16 length);
+
+/**
+ * \brief 			Get the frame CRC16 value from a CRC16 register
+ * \details 		This core function apply the final XOR and byte swap to a CRC16 register value
+ * \param[in] 		crc 			CRC16 register value
+ * \return 			Frame CRC16 value (as expected from stse_platform_Crc16_Calculate)
+ */
+PLAT_UI16 stse_crc16_finalize(PLAT_UI16 crc);
+
+/**
+ * \brief 			Accumulate a data buffer in a frame CRC16 value
+ * \details 		This core function continue a CRC16 computation from the frame CRC16 value of the previous data
+ * \param[in] 		frame_crc 		Frame CRC16 value of the previous data (\ref stse_crc16_finalize output)
+ * \param[in] 		pData 			Pointer to data buffer
+ * \param[in] 		length 			Data buffer length
+ * \return 			Frame CRC16 value of the previous data followed by the data buffer
+ */
+PLAT_UI16 stse_crc16_accumulate(PLAT_UI16 frame_crc, PLAT_UI8 *pData, PLAT_UI16 length);
+
+#endif /* STSE_CONF_USE_BUILTIN_CRC16 */
+
+/*! @}*/
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* STSE_CRC16_H */
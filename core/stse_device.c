@@ -39,10 +39,25 @@ stse_ReturnCode_t stse_set_default_handler_value(stse_Handler_t *pStseHandler) {
     pStseHandler->io.BusSendStop = stse_platform_i2c_send_stop;
     pStseHandler->io.BusWake = stse_platform_i2c_wake;
 #endif /* STSE_CONF_STSAFE_A_SUPPORT || (STSE_CONF_STSAFE_L_SUPPORT && defined(STSE_CONF_USE_I2C) */
+    pStseHandler->io.BusRecvV = NULL;
+    pStseHandler->io.BusSendV = NULL;
+#ifdef STSE_USE_ZERO_COPY_RSP
+    pStseHandler->io.BusRecvFrame = NULL;
+#endif /* STSE_USE_ZERO_COPY_RSP */
     pStseHandler->io.IOLineGet = NULL;
+#ifdef STSE_USE_IO_LINE_RSP_WAIT
+    pStseHandler->io.IOLineReady = NULL;
+    pStseHandler->io.IOLineWait = NULL;
+#endif /* STSE_USE_IO_LINE_RSP_WAIT */
     pStseHandler->io.BusRecovery = NULL;
     pStseHandler->io.PowerLineOff = stse_platform_power_off;
     pStseHandler->io.PowerLineOn = stse_platform_power_on;
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+    pStseHandler->io.BusLock = NULL;
+    pStseHandler->io.BusUnlock = NULL;
+    pStseHandler->io.DeviceLock = NULL;
+    pStseHandler->io.DeviceUnlock = NULL;
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
     pStseHandler->io.busID = 0;
     pStseHandler->io.Devaddr = 0x20;
     pStseHandler->io.BusSpeed = 100;
@@ -50,5 +65,61 @@ stse_ReturnCode_t stse_set_default_handler_value(stse_Handler_t *pStseHandler) {
     (defined(STSE_CONF_STSAFE_L_SUPPORT) && defined(STSE_CONF_USE_I2C))
     pStseHandler->io.BusType = STSE_BUS_TYPE_I2C;
 #endif /* STSE_CONF_STSAFE_A_SUPPORT || (STSE_CONF_STSAFE_L_SUPPORT && defined(STSE_CONF_USE_I2C) */
+#ifdef STSE_USE_ADAPTIVE_RSP_POLLING
+    memset(&pStseHandler->exec_time, 0, sizeof(pStseHandler->exec_time));
+#endif /* STSE_USE_ADAPTIVE_RSP_POLLING */
+#ifdef STSE_USE_RETRY_POLICY
+    pStseHandler->retry_policy.initial_delay = STSE_POLLING_RETRY_INTERVAL;
+    pStseHandler->retry_policy.max_delay = STSE_POLLING_RETRY_INTERVAL;
+    pStseHandler->retry_policy.deadline = 0;
+    pStseHandler->retry_policy.backoff_factor = 1;
+    pStseHandler->retry_policy.jitter = 0;
+    memset(&pStseHandler->retry_stats, 0, sizeof(pStseHandler->retry_stats));
+#endif /* STSE_USE_RETRY_POLICY */
+#ifdef STSE_FRAME_TRACE
+    pStseHandler->frame_trace.sequence = 0;
+    pStseHandler->frame_trace.retry_count = 0;
+#endif /* STSE_FRAME_TRACE */
+#ifdef STSE_CMD_METRICS
+    memset(&pStseHandler->cmd_metrics, 0, sizeof(pStseHandler->cmd_metrics));
+#endif /* STSE_CMD_METRICS */
     return STSE_OK;
 }
+
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+
+stse_ReturnCode_t stse_handler_lock(stse_Handler_t *pSTSE) {
+    if (pSTSE == NULL) {
+        return STSE_CORE_HANDLER_NOT_INITIALISED;
+    }
+    if (pSTSE->io.DeviceLock == NULL) {
+        return STSE_OK;
+    }
+
+    return pSTSE->io.DeviceLock(pSTSE->io.busID, pSTSE->io.Devaddr);
+}
+
+void stse_handler_unlock(stse_Handler_t *pSTSE) {
+    if ((pSTSE != NULL) && (pSTSE->io.DeviceUnlock != NULL)) {
+        pSTSE->io.DeviceUnlock(pSTSE->io.busID, pSTSE->io.Devaddr);
+    }
+}
+
+stse_ReturnCode_t stse_bus_lock(stse_Handler_t *pSTSE) {
+    if (pSTSE == NULL) {
+        return STSE_CORE_HANDLER_NOT_INITIALISED;
+    }
+    if (pSTSE->io.BusLock == NULL) {
+        return STSE_OK;
+    }
+
+    return pSTSE->io.BusLock(pSTSE->io.busID);
+}
+
+void stse_bus_unlock(stse_Handler_t *pSTSE) {
+    if ((pSTSE != NULL) && (pSTSE->io.BusUnlock != NULL)) {
+        pSTSE->io.BusUnlock(pSTSE->io.busID);
+    }
+}
+
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
@@ -66,6 +66,19 @@ typedef enum stse_device_t {
 #define STSE_DEVICE_STSAFEL_FAMILY_INDEX STSAFE_L010
 #endif /* STSE_CONF_STSAFE_L_SUPPORT */
 
+/*
+ * \brief Handler structures packing (stse_perso_info_t , stse_io_t , stse_session_t , stse_Handler_t and the
+ *        tracker structures embedded in the handler)
+ * \details Packed by default , with the historical field order. STSE_CONF_USE_ALIGNED_HANDLER selects the natural
+ *          alignment of handler fields so that callback pointers , MAC counter and access condition bitmaps are
+ *          read with aligned loads , and places the fields used on each frame transfer at the handler beginning
+ */
+#ifdef STSE_CONF_USE_ALIGNED_HANDLER
+#define STSE_HANDLER_PACKED_STRUCT
+#else
+#define STSE_HANDLER_PACKED_STRUCT PLAT_PACKED_STRUCT
+#endif /* STSE_CONF_USE_ALIGNED_HANDLER */
+
 typedef struct stse_perso_info_t {
     PLAT_UI32 cmd_encryption_status;
     PLAT_UI32 rsp_encryption_status;
@@ -73,7 +86,149 @@ typedef struct stse_perso_info_t {
     PLAT_UI32 ext_rsp_encryption_status;
     PLAT_UI64 cmd_AC_status;
     PLAT_UI64 ext_cmd_AC_status;
-} PLAT_PACKED_STRUCT stse_perso_info_t;
+} STSE_HANDLER_PACKED_STRUCT stse_perso_info_t;
+
+#ifdef STSE_USE_ADAPTIVE_RSP_POLLING
+
+#define STSE_EXEC_TIME_TRACKED_CMD_COUNT 32U /*!< Number of tracked command codes (5-bit command code space) */
+
+/*
+ * \brief STSE command execution time statistics
+ * \details Execution time values are stored in 1/8 ms units
+ */
+typedef struct stse_exec_time_stat_t {
+    PLAT_UI16 average;     /*!< Smoothed execution time */
+    PLAT_UI16 deviation;   /*!< Smoothed execution time mean deviation */
+    PLAT_UI8 sample_count; /*!< Number of recorded samples (saturated to 0xFF) */
+} STSE_HANDLER_PACKED_STRUCT stse_exec_time_stat_t;
+
+/*
+ * \brief STSE command execution time tracker (adaptive response polling)
+ */
+typedef struct stse_exec_time_tracker_t {
+    stse_exec_time_stat_t cmd[STSE_EXEC_TIME_TRACKED_CMD_COUNT];     /*!< Command execution time statistics */
+    stse_exec_time_stat_t ext_cmd[STSE_EXEC_TIME_TRACKED_CMD_COUNT]; /*!< Extended command execution time statistics */
+    PLAT_UI16 rsp_poll_count;                                        /*!< Number of NACKed polls on last response */
+} STSE_HANDLER_PACKED_STRUCT stse_exec_time_tracker_t;
+
+#endif /* STSE_USE_ADAPTIVE_RSP_POLLING */
+
+#ifdef STSE_USE_RETRY_POLICY
+
+/*
+ * \brief STSE bus retry policy
+ * \details Delay before retry n (n >= 1) is min(initial_delay * backoff_factor^(n-1), max_delay) plus a random
+ *          jitter in [0 ; jitter] ms. Retries stop after STSE_MAX_POLLING_RETRY attempts or when the cumulated
+ *          retry delay of the bus operation would exceed the deadline
+ */
+typedef struct stse_retry_policy_t {
+    PLAT_UI16 initial_delay; /*!< First retry delay (ms , at least 1) */
+    PLAT_UI16 max_delay;     /*!< Retry delay cap (ms) */
+    PLAT_UI16 deadline;      /*!< Cumulated retry delay limit of a bus operation (ms , 0 : no deadline) */
+    PLAT_UI8 backoff_factor; /*!< Retry delay multiplication factor (1 : constant retry delay) */
+    PLAT_UI8 jitter;         /*!< Maximum random delay added to each retry delay (ms , 0 : no jitter) */
+} STSE_HANDLER_PACKED_STRUCT stse_retry_policy_t;
+
+/*
+ * \brief STSE bus retry statistics
+ */
+typedef struct stse_retry_stats_t {
+    PLAT_UI16 cmd_retry_count;     /*!< Number of retries needed by the last command */
+    PLAT_UI16 max_cmd_retry_count; /*!< Maximum number of retries needed by a command */
+    PLAT_UI32 total_retry_count;   /*!< Total number of retries */
+    PLAT_UI32 cmd_count;           /*!< Number of commands */
+} STSE_HANDLER_PACKED_STRUCT stse_retry_stats_t;
+
+#endif /* STSE_USE_RETRY_POLICY */
+
+#ifdef STSE_FRAME_TRACE
+
+#ifndef STSE_FRAME_TRACE_DEPTH
+#define STSE_FRAME_TRACE_DEPTH 32U /*!< Number of frame trace records (power of 2) */
+#endif /* STSE_FRAME_TRACE_DEPTH */
+
+#ifndef STSE_FRAME_TRACE_PAYLOAD_SIZE
+#define STSE_FRAME_TRACE_PAYLOAD_SIZE 0U /*!< Number of frame bytes captured per trace record (0 : no payload capture) */
+#endif /* STSE_FRAME_TRACE_PAYLOAD_SIZE */
+
+/*
+ * \brief STSE frame trace record
+ */
+typedef struct stse_frame_trace_record_t {
+    PLAT_UI32 timestamp;     /*!< Platform timestamp of the frame transfer end */
+    PLAT_UI16 length;        /*!< Frame length (CRC excluded) */
+    PLAT_UI16 status;        /*!< Transfer status (\ref stse_ReturnCode_t) */
+    PLAT_UI8 direction;      /*!< Frame direction (\ref stse_frame_trace_direction_t) */
+    PLAT_UI8 header;         /*!< Command code (command frame) or response header (response frame) */
+    PLAT_UI8 retry_count;    /*!< Number of bus retries since previous record (saturated to 0xFF) */
+    PLAT_UI8 payload_length; /*!< Number of captured frame bytes */
+#if STSE_FRAME_TRACE_PAYLOAD_SIZE > 0
+    PLAT_UI8 payload[STSE_FRAME_TRACE_PAYLOAD_SIZE]; /*!< Captured frame bytes */
+#endif                                               /* STSE_FRAME_TRACE_PAYLOAD_SIZE */
+} STSE_HANDLER_PACKED_STRUCT stse_frame_trace_record_t;
+
+/*
+ * \brief STSE frame trace ring buffer
+ */
+typedef struct stse_frame_trace_t {
+    PLAT_UI32 sequence;                                        /*!< Number of records written since last clear */
+    PLAT_UI16 retry_count;                                     /*!< Number of bus retries since previous record */
+    stse_frame_trace_record_t record[STSE_FRAME_TRACE_DEPTH]; /*!< Trace records */
+} STSE_HANDLER_PACKED_STRUCT stse_frame_trace_t;
+
+#endif /* STSE_FRAME_TRACE */
+
+#ifdef STSE_CMD_METRICS
+
+#define STSE_CMD_METRICS_TRACKED_CMD_COUNT 32U /*!< Number of tracked command codes (5-bit command code space) */
+
+#ifndef STSE_CMD_METRICS_HISTOGRAM_SIZE
+#define STSE_CMD_METRICS_HISTOGRAM_SIZE 12U /*!< Number of command latency histogram bins */
+#endif                                      /* STSE_CMD_METRICS_HISTOGRAM_SIZE */
+
+#ifndef STSE_CMD_METRICS_HISTOGRAM_SHIFT
+#define STSE_CMD_METRICS_HISTOGRAM_SHIFT 0U /*!< Latency histogram first bin width (2^shift timestamp units) */
+#endif                                      /* STSE_CMD_METRICS_HISTOGRAM_SHIFT */
+
+/*
+ * \brief STSE command metrics
+ * \details Times are cumulated in platform timestamp units. Latency histogram bin 0 counts commands with a
+ *          transfer latency lower than 2^STSE_CMD_METRICS_HISTOGRAM_SHIFT , bin n counts latencies in
+ *          [2^(STSE_CMD_METRICS_HISTOGRAM_SHIFT+n-1) ; 2^(STSE_CMD_METRICS_HISTOGRAM_SHIFT+n)[ (last bin : all greater latencies)
+ */
+typedef struct stse_cmd_metrics_t {
+    PLAT_UI32 count;       /*!< Number of command transfers */
+    PLAT_UI32 error_count; /*!< Number of command transfers not ending with STSE_OK */
+    PLAT_UI32 retry_count; /*!< Number of bus retries (command send and response polling) */
+    PLAT_UI32 tx_bytes;    /*!< Number of command frame bytes sent (CRC excluded) */
+    PLAT_UI32 rx_bytes;    /*!< Number of response frame bytes received (CRC excluded) */
+    PLAT_UI32 tx_time;     /*!< Cumulated command frame transmit time */
+    PLAT_UI32 exec_time;   /*!< Cumulated command execution wait time (processing delay and NACKed polls) */
+    PLAT_UI32 rx_time;     /*!< Cumulated response frame receive time */
+    PLAT_UI32 crypto_time; /*!< Cumulated host session cryptographic processing time */
+    PLAT_UI16 latency_histogram[STSE_CMD_METRICS_HISTOGRAM_SIZE]; /*!< Command transfer latency histogram (saturated bins) */
+} STSE_HANDLER_PACKED_STRUCT stse_cmd_metrics_t;
+
+/*
+ * \brief STSE command metrics snapshot
+ */
+typedef struct stse_cmd_metrics_snapshot_t {
+    stse_cmd_metrics_t cmd[STSE_CMD_METRICS_TRACKED_CMD_COUNT];     /*!< Command metrics (indexed by command code) */
+    stse_cmd_metrics_t ext_cmd[STSE_CMD_METRICS_TRACKED_CMD_COUNT]; /*!< Extended command metrics (indexed by extended command code) */
+} STSE_HANDLER_PACKED_STRUCT stse_cmd_metrics_snapshot_t;
+
+/*
+ * \brief STSE command metrics tracker
+ */
+typedef struct stse_cmd_metrics_tracker_t {
+    stse_cmd_metrics_snapshot_t metrics; /*!< Command metrics */
+    PLAT_UI32 cmd_start;                 /*!< Current command transfer start timestamp */
+    PLAT_UI32 tx_end;                    /*!< Current command frame transmit end timestamp */
+    PLAT_UI32 rx_start;                  /*!< Current command last response reception attempt timestamp */
+    PLAT_UI16 retry_count;               /*!< Current command bus retries */
+} STSE_HANDLER_PACKED_STRUCT stse_cmd_metrics_tracker_t;
+
+#endif /* STSE_CMD_METRICS */
 
 /*
  * \details STSE Bus type
@@ -88,12 +243,27 @@ typedef enum stse_bus {
 #endif                    /* STSE_CONF_USE_ST1WIRE */
 } stse_bus_t;
 
+/*
+ * \struct stse_io_vector_t
+ * \brief STSE Input/Output vector type (scatter-gather bus transfer entry)
+ */
+typedef struct stse_io_vector_t {
+    PLAT_UI8 *pData;  /*!< Pointer to entry data (NULL : zero-padding on send / discard on receive) */
+    PLAT_UI16 length; /*!< Entry length in bytes */
+} stse_io_vector_t;
+
 /*
  * \struct stse_io_t
  * \brief STSE Input/Output type
  */
 typedef struct
 {
+#ifdef STSE_CONF_USE_ALIGNED_HANDLER
+    PLAT_UI8 busID;     /*<\var stse_io_t::busID Bus ID */
+    PLAT_UI8 Devaddr;   /*<\var stse_io_t::Devaddr Device address */
+    PLAT_UI16 BusSpeed; /*<\var stse_io_t::BusSpeed Bus speed */
+    stse_bus_t BusType; /*<\var stse_io_t::BusType Bus type */
+#endif /* STSE_CONF_USE_ALIGNED_HANDLER */
     stse_ReturnCode_t (*BusRecvStart)(
         PLAT_UI8,  /* busID */
         PLAT_UI8,  /* devAddr */
@@ -134,8 +304,43 @@ typedef struct
         PLAT_UI8 *, /*pElement*/
         PLAT_UI16   /*element_size*/
     );              /*<\var stse_io_t::BusSendStop Bus Send stop function callback */
+    stse_ReturnCode_t (*BusRecvV)(
+        PLAT_UI8,           /*busID*/
+        PLAT_UI8,           /*devAddr*/
+        PLAT_UI16,          /*speed*/
+        stse_io_vector_t *, /*pVector*/
+        PLAT_UI8            /*vector_count*/
+    );                      /*<\var stse_io_t::BusRecvV Bus vectored Receive function callback (optional, NULL if not supported) */
+    stse_ReturnCode_t (*BusSendV)(
+        PLAT_UI8,           /*busID*/
+        PLAT_UI8,           /*devAddr*/
+        PLAT_UI16,          /*speed*/
+        stse_io_vector_t *, /*pVector*/
+        PLAT_UI8            /*vector_count*/
+    );                      /*<\var stse_io_t::BusSendV Bus vectored Send function callback (optional, NULL if not supported) */
+#ifdef STSE_USE_ZERO_COPY_RSP
+    stse_ReturnCode_t (*BusRecvFrame)(
+        PLAT_UI8,   /*busID*/
+        PLAT_UI8,   /*devAddr*/
+        PLAT_UI16,  /*speed*/
+        PLAT_UI16,  /*length*/
+        PLAT_UI8 ** /*ppFrame*/
+    );              /*<\var stse_io_t::BusRecvFrame Bus zero-copy Receive function callback : receives length bytes in a driver owned buffer valid until the next bus transaction (optional, NULL if not supported) */
+#endif              /* STSE_USE_ZERO_COPY_RSP */
     stse_ReturnCode_t (*IOLineGet)(
         PLAT_UI8); /*<\var stse_io_t::IOLineGet Get Bus I/O Line state function callback */
+#ifdef STSE_USE_IO_LINE_RSP_WAIT
+    stse_ReturnCode_t (*IOLineReady)(
+        PLAT_UI8, /*busID*/
+        PLAT_UI8  /*devAddr*/
+    );            /*<\var stse_io_t::IOLineReady Get device ready line state function callback (non blocking) : returns STSE_OK when the ready line of the addressed device is asserted (optional, NULL if not supported) */
+    stse_ReturnCode_t (*IOLineWait)(
+        PLAT_UI8,   /*busID*/
+        PLAT_UI8,   /*devAddr*/
+        PLAT_UI16,  /*timeout_ms*/
+        PLAT_UI16 * /*pWaited_ms*/
+    );              /*<\var stse_io_t::IOLineWait Blocking wait of the device ready line assertion (GPIO edge) : returns STSE_OK when asserted before timeout and the waited time in ms (optional, NULL if not supported) */
+#endif              /* STSE_USE_IO_LINE_RSP_WAIT */
     stse_ReturnCode_t (*BusWake)(
         PLAT_UI8,
         PLAT_UI8,
@@ -149,11 +354,25 @@ typedef struct
     stse_ReturnCode_t (*PowerLineOn)(
         PLAT_UI8,
         PLAT_UI8);      /*<\var stse_io_t::PowerLineOn Bus power line on function callback */
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+    stse_ReturnCode_t (*BusLock)(
+        PLAT_UI8); /*<\var stse_io_t::BusLock Bus lock function callback (optional, NULL if bus not shared between threads) */
+    stse_ReturnCode_t (*BusUnlock)(
+        PLAT_UI8); /*<\var stse_io_t::BusUnlock Bus unlock function callback (optional) */
+    stse_ReturnCode_t (*DeviceLock)(
+        PLAT_UI8,
+        PLAT_UI8); /*<\var stse_io_t::DeviceLock Device lock function callback (optional, NULL if device not shared between threads) */
+    stse_ReturnCode_t (*DeviceUnlock)(
+        PLAT_UI8,
+        PLAT_UI8); /*<\var stse_io_t::DeviceUnlock Device unlock function callback (optional) */
+#endif             /* STSE_CONF_USE_THREAD_SAFETY */
+#ifndef STSE_CONF_USE_ALIGNED_HANDLER
     PLAT_UI8 busID;     /*<\var stse_io_t::busID Bus ID */
     PLAT_UI8 Devaddr;   /*<\var stse_io_t::Devaddr Device address */
     PLAT_UI16 BusSpeed; /*<\var stse_io_t::BusSpeed Bus speed */
     stse_bus_t BusType; /*<\var stse_io_t::BusType Bus type */
-} PLAT_PACKED_STRUCT stse_io_t;
+#endif /* STSE_CONF_USE_ALIGNED_HANDLER */
+} STSE_HANDLER_PACKED_STRUCT stse_io_t;
 
 typedef struct stse_session_t stse_session_t;
 
@@ -169,6 +388,10 @@ struct stse_session_t {
             PLAT_UI8 *pHost_cypher_key;
             stse_aes_key_type_t key_type;
             PLAT_UI32 MAC_counter;
+#ifdef STSE_CONF_USE_HOST_SESSION_KEY_HANDLES
+            void *pHost_MAC_key_handle;    /* Platform pre-expanded MAC key handle (see stse_platform_aes_key_handle_create) */
+            void *pHost_cypher_key_handle; /* Platform pre-expanded cypher key handle */
+#endif /* STSE_CONF_USE_HOST_SESSION_KEY_HANDLES */
         } host;
 
         struct {
@@ -176,7 +399,7 @@ struct stse_session_t {
             PLAT_UI8 working_kek_counter;
         } kek;
     } context;
-} PLAT_PACKED_STRUCT;
+} STSE_HANDLER_PACKED_STRUCT;
 
 /*!
  * \typedef stse_Handler_t
@@ -186,12 +409,35 @@ struct stse_session_t {
  *        A specific STSE target Handler must be initialized using the "stsafe_init" API function
  */
 struct stse_Handler_t {
+#ifdef STSE_CONF_USE_ALIGNED_HANDLER
+    /* - Data accessed on each frame transfer */
+    stse_io_t io;
+    stse_session_t *pActive_host_session;
+    stse_device_t device_type;
+    stse_perso_info_t perso_info;
+    /* - Data accessed on session setup or by optional services */
+    stse_session_t *pActive_other_session;
+#else
     stse_device_t device_type;
     stse_perso_info_t perso_info;
     stse_session_t *pActive_host_session;
     stse_session_t *pActive_other_session;
     stse_io_t io;
-} PLAT_PACKED_STRUCT;
+#endif /* STSE_CONF_USE_ALIGNED_HANDLER */
+#ifdef STSE_USE_ADAPTIVE_RSP_POLLING
+    stse_exec_time_tracker_t exec_time;
+#endif /* STSE_USE_ADAPTIVE_RSP_POLLING */
+#ifdef STSE_USE_RETRY_POLICY
+    stse_retry_policy_t retry_policy;
+    stse_retry_stats_t retry_stats;
+#endif /* STSE_USE_RETRY_POLICY */
+#ifdef STSE_FRAME_TRACE
+    stse_frame_trace_t frame_trace;
+#endif /* STSE_FRAME_TRACE */
+#ifdef STSE_CMD_METRICS
+    stse_cmd_metrics_tracker_t cmd_metrics;
+#endif /* STSE_CMD_METRICS */
+} STSE_HANDLER_PACKED_STRUCT;
 
 /* Exported variables --------------------------------------------------------*/
 
@@ -203,6 +449,40 @@ struct stse_Handler_t {
  */
 stse_ReturnCode_t stse_set_default_handler_value(stse_Handler_t *pStseHandler);
 
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+
+/**
+ * \brief       Lock the STSE handler (target device)
+ * \details     This core function takes the device lock of the handler (io.DeviceLock callback) to get exclusive
+ *              access to the target device and to its handler for the duration of a command transaction
+ * \param[in]   pSTSE : Pointer to STSE handler
+ * \return \ref stse_ReturnCode_t : STSE_OK on success ; error code otherwise
+ */
+stse_ReturnCode_t stse_handler_lock(stse_Handler_t *pSTSE);
+
+/**
+ * \brief       Unlock the STSE handler (target device)
+ * \param[in]   pSTSE : Pointer to STSE handler
+ */
+void stse_handler_unlock(stse_Handler_t *pSTSE);
+
+/**
+ * \brief       Lock the bus of the STSE target device
+ * \details     This core function takes the bus lock of the handler (io.BusLock callback) to get exclusive
+ *              access to the bus for the duration of a bus transaction
+ * \param[in]   pSTSE : Pointer to STSE handler
+ * \return \ref stse_ReturnCode_t : STSE_OK on success ; error code otherwise
+ */
+stse_ReturnCode_t stse_bus_lock(stse_Handler_t *pSTSE);
+
+/**
+ * \brief       Unlock the bus of the STSE target device
+ * \param[in]   pSTSE : Pointer to STSE handler
+ */
+void stse_bus_unlock(stse_Handler_t *pSTSE);
+
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
+
 /*! @}*/
 
 #ifdef __cplusplus
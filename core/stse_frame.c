@@ -21,8 +21,10 @@
 #include <stdio.h>
 
 #include "core/stse_frame.h"
+#include "core/stse_crc16.h"
 
 stse_ReturnCode_t stse_frame_crc16_compute(stse_frame_t *pFrame, PLAT_UI16 *pCrc) {
+    stse_ReturnCode_t ret;
     stse_frame_element_t *pCurrent_element;
 
     if (pFrame == NULL || pCrc == NULL) {
@@ -30,14 +32,13 @@ stse_ReturnCode_t stse_frame_crc16_compute(stse_frame_t *pFrame, PLAT_UI16 *pCrc
     }
 
     pCurrent_element = pFrame->first_element;
-    *pCrc = stse_platform_Crc16_Calculate(pCurrent_element->pData, pCurrent_element->length);
-    pCurrent_element = pCurrent_element->next;
     while (pCurrent_element != NULL) {
-        if (pCurrent_element->length != 0) {
-            if (pCurrent_element->pData == NULL) {
-                return STSE_CORE_INCONSISTENT_FRAME;
-            }
-            *pCrc = stse_platform_Crc16_Accumulate(pCurrent_element->pData, pCurrent_element->length);
+        ret = stse_frame_crc16_accumulate(pCurrent_element->pData,
+                                          pCurrent_element->length,
+                                          (pCurrent_element == pFrame->first_element),
+                                          pCrc);
+        if (ret != STSE_OK) {
+            return ret;
         }
         pCurrent_element = pCurrent_element->next;
     }
@@ -45,6 +46,31 @@ stse_ReturnCode_t stse_frame_crc16_compute(stse_frame_t *pFrame, PLAT_UI16 *pCrc
     return STSE_OK;
 }
 
+stse_ReturnCode_t stse_frame_crc16_accumulate(PLAT_UI8 *pData, PLAT_UI16 length, PLAT_UI8 first_chunk, PLAT_UI16 *pCrc) {
+#ifdef STSE_CONF_USE_BUILTIN_CRC16
+    /* - CRC carried by the caller owned value (no platform CRC state shared between frames) */
+    if (first_chunk != 0) {
+        *pCrc = stse_crc16_finalize(stse_crc16_update(STSE_CRC16_INIT_VALUE, pData, length));
+    } else if (length != 0) {
+        if (pData == NULL) {
+            return STSE_CORE_INCONSISTENT_FRAME;
+        }
+        *pCrc = stse_crc16_accumulate(*pCrc, pData, length);
+    }
+#else
+    if (first_chunk != 0) {
+        *pCrc = stse_platform_Crc16_Calculate(pData, length);
+    } else if (length != 0) {
+        if (pData == NULL) {
+            return STSE_CORE_INCONSISTENT_FRAME;
+        }
+        *pCrc = stse_platform_Crc16_Accumulate(pData, length);
+    }
+#endif /* STSE_CONF_USE_BUILTIN_CRC16 */
+
+    return STSE_OK;
+}
+
 void stse_frame_element_swap_byte_order(stse_frame_element_t *pElement) {
     PLAT_UI8 tmp;
 
@@ -61,6 +87,11 @@ void stse_append_frame(stse_frame_t *pFrame1, stse_frame_t *pFrame2) {
         pFrame1->first_element = pFrame2->first_element;
     } else {
         pFrame1->last_element->next = pFrame2->first_element;
+#ifdef STSE_CONF_USE_FRAME_ELEMENT_BACK_LINK
+        if (pFrame2->first_element != NULL) {
+            pFrame2->first_element->prev = pFrame1->last_element;
+        }
+#endif /* STSE_CONF_USE_FRAME_ELEMENT_BACK_LINK */
     }
 
     /* - Position element as last one in the frame*/
@@ -87,6 +118,9 @@ void stse_frame_unstrap(stse_frame_t *pFrame) {
     pFrame->length = 0;
     pFrame->element_count = 0;
     while (pElement != NULL) {
+#ifdef STSE_CONF_USE_FRAME_ELEMENT_BACK_LINK
+        pElement->prev = (pFrame->element_count == 0) ? NULL : pFrame->last_element;
+#endif /* STSE_CONF_USE_FRAME_ELEMENT_BACK_LINK */
         pFrame->length += pElement->length;
         pFrame->element_count++;
         pFrame->last_element = pElement;
@@ -108,6 +142,9 @@ void stse_frame_update(stse_frame_t *pFrame) {
         return;
     } else {
         do {
+#ifdef STSE_CONF_USE_FRAME_ELEMENT_BACK_LINK
+            pCurrent_element->prev = (pFrame->element_count == 0) ? NULL : pFrame->last_element;
+#endif /* STSE_CONF_USE_FRAME_ELEMENT_BACK_LINK */
             pFrame->length += pCurrent_element->length;
             pFrame->element_count++;
             pFrame->last_element = pCurrent_element;
@@ -124,9 +161,15 @@ void stse_frame_push_element(stse_frame_t *pFrame,
     if (pFrame->first_element == NULL) {
         /* - Set Element as first one if Frame is empty */
         pFrame->first_element = pElement;
+#ifdef STSE_CONF_USE_FRAME_ELEMENT_BACK_LINK
+        pElement->prev = NULL;
+#endif /* STSE_CONF_USE_FRAME_ELEMENT_BACK_LINK */
     } else {
         /* - Position element as last one in the frame*/
         pFrame->last_element->next = pElement;
+#ifdef STSE_CONF_USE_FRAME_ELEMENT_BACK_LINK
+        pElement->prev = pFrame->last_element;
+#endif /* STSE_CONF_USE_FRAME_ELEMENT_BACK_LINK */
     }
     pFrame->last_element = pElement;
     pElement->next = NULL;
@@ -140,11 +183,18 @@ void stse_frame_pop_element(stse_frame_t *pFrame) {
     stse_frame_element_t *pCurrent_element;
 
     if (pFrame->element_count > 1) {
-        /* Select first Frame Element*/
-        pCurrent_element = pFrame->first_element;
-        /* Parse Frame until previous to last element */
-        while (pCurrent_element->next != pFrame->last_element) {
-            pCurrent_element = pCurrent_element->next;
+#ifdef STSE_CONF_USE_FRAME_ELEMENT_BACK_LINK
+        /* Select previous to last element from its back link (frame parsed if the back link is not consistent) */
+        pCurrent_element = pFrame->last_element->prev;
+        if ((pCurrent_element == NULL) || (pCurrent_element->next != pFrame->last_element))
+#endif /* STSE_CONF_USE_FRAME_ELEMENT_BACK_LINK */
+        {
+            /* Select first Frame Element*/
+            pCurrent_element = pFrame->first_element;
+            /* Parse Frame until previous to last element */
+            while (pCurrent_element->next != pFrame->last_element) {
+                pCurrent_element = pCurrent_element->next;
+            }
         }
         /* Remove references/link to the last element */
         pFrame->length -= pCurrent_element->next->length;
@@ -159,6 +209,25 @@ void stse_frame_pop_element(stse_frame_t *pFrame) {
     }
 }
 
+PLAT_UI8 stse_frame_io_vector_fill(stse_frame_t *pFrame,
+                                   stse_frame_element_t *pFirst_element,
+                                   stse_io_vector_t *pVector) {
+    stse_frame_element_t *pCurrent_element = pFirst_element;
+    PLAT_UI8 vector_count = 0;
+
+    while (pCurrent_element != NULL) {
+        pVector[vector_count].pData = pCurrent_element->pData;
+        pVector[vector_count].length = pCurrent_element->length;
+        vector_count++;
+        if (pCurrent_element == pFrame->last_element) {
+            break;
+        }
+        pCurrent_element = pCurrent_element->next;
+    }
+
+    return vector_count;
+}
+
 void stse_frame_debug_print(stse_frame_t *pFrame) {
     stse_frame_element_t *pCurrent_element;
     PLAT_UI16 data_index;
@@ -35,6 +35,10 @@
 #define STSE_STSAFEA_RSP_STATUS_MASK 0x1F
 #define STSE_STSAFEL_RSP_STATUS_MASK 0x0F
 
+#ifndef STSE_CONF_FRAME_MAX_ELEMENT_COUNT
+#define STSE_CONF_FRAME_MAX_ELEMENT_COUNT 24U /*!< Maximum number of bus I/O vector entries in a vectored frame transfer */
+#endif /* STSE_CONF_FRAME_MAX_ELEMENT_COUNT */
+
 typedef struct stse_frame_t stse_frame_t;
 typedef struct stse_frame_element_t stse_frame_element_t;
 
@@ -49,6 +53,9 @@ struct stse_frame_element_t {
     PLAT_UI16 length;
     PLAT_UI8 *pData;
     stse_frame_element_t *next;
+#ifdef STSE_CONF_USE_FRAME_ELEMENT_BACK_LINK
+    stse_frame_element_t *prev; /*!< Previous frame element (set on push , frame update and unstrap) */
+#endif /* STSE_CONF_USE_FRAME_ELEMENT_BACK_LINK */
 };
 
 typedef enum {
@@ -106,6 +113,18 @@ void stse_frame_update(stse_frame_t *pFrame);
  */
 stse_ReturnCode_t stse_frame_crc16_compute(stse_frame_t *pFrame, PLAT_UI16 *pCrc);
 
+/**
+ * \brief 			Accumulate a data chunk in a running frame CRC
+ * \details 		This core function fold a frame data chunk in the frame CRC (incremental CRC computation)
+ *                  The first chunk of a frame restarts the CRC computation
+ * \param[in] 		pData 			Pointer to chunk data
+ * \param[in] 		length 			Chunk length
+ * \param[in] 		first_chunk 	Set to 1 for the first chunk of the frame ; 0 otherwise
+ * \param[in,out] 	pCrc 			Pointer to the running crc (2-byte CRC value)
+ * \return 			\ref STSE_OK on success ; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_frame_crc16_accumulate(PLAT_UI8 *pData, PLAT_UI16 length, PLAT_UI8 first_chunk, PLAT_UI16 *pCrc);
+
 /**
  * \brief 			swap the Data byte order pointed by pData frame element
  * \details 		This core function swap the Data byte order pointed/defined by pData and length value from frame
@@ -125,10 +144,24 @@ void stse_frame_push_element(stse_frame_t *pFrame,
 /**
  * \brief 			Pop last element from frame
  * \details 		This core function remove the last element from frame
+ *                  (constant time when STSE_CONF_USE_FRAME_ELEMENT_BACK_LINK is defined)
  * \param[in,out] 	pFrame 				Pointer to frame
  */
 void stse_frame_pop_element(stse_frame_t *pFrame);
 
+/**
+ * \brief 			Fill bus I/O vector from frame elements
+ * \details 		This core function describe each frame element from pFirst_element up to the frame last element
+ *                  as an entry of a bus I/O vector (used for vectored bus send/receive)
+ * \param[in] 		pFrame 				Pointer to frame
+ * \param[in] 		pFirst_element 		Pointer to the first frame element to be described
+ * \param[out] 	pVector 			Pointer to the I/O vector (must provide one entry per described element)
+ * \return 			Number of I/O vector entries filled
+ */
+PLAT_UI8 stse_frame_io_vector_fill(stse_frame_t *pFrame,
+                                   stse_frame_element_t *pFirst_element,
+                                   stse_io_vector_t *pVector);
+
 /**
  * \brief 			Frame debug print
  * \details 		This core function print the content of a frame
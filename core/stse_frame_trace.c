@@ -0,0 +1,144 @@
+/*!
+ * ******************************************************************************
+ * \file	stse_frame_trace.c
+ * \brief   STSELib frame trace (sources)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include "core/stse_frame_trace.h"
+
+#ifdef STSE_FRAME_TRACE
+
+#if (STSE_FRAME_TRACE_DEPTH == 0) || ((STSE_FRAME_TRACE_DEPTH & (STSE_FRAME_TRACE_DEPTH - 1)) != 0)
+#error "STSE_FRAME_TRACE_DEPTH must be a power of 2"
+#endif
+
+#if STSE_FRAME_TRACE_PAYLOAD_SIZE > 255
+#error "STSE_FRAME_TRACE_PAYLOAD_SIZE must not exceed 255"
+#endif
+
+void stse_frame_trace_record(stse_Handler_t *pSTSE,
+                             stse_frame_trace_direction_t direction,
+                             stse_frame_t *pFrame,
+                             stse_ReturnCode_t status) {
+    stse_frame_trace_record_t *pRecord;
+#if STSE_FRAME_TRACE_PAYLOAD_SIZE > 0
+    stse_frame_element_t *pElement;
+    PLAT_UI16 index;
+#endif /* STSE_FRAME_TRACE_PAYLOAD_SIZE */
+
+    pRecord = &pSTSE->frame_trace.record[pSTSE->frame_trace.sequence & (STSE_FRAME_TRACE_DEPTH - 1)];
+    pSTSE->frame_trace.sequence++;
+
+    pRecord->timestamp = stse_platform_get_timestamp();
+    pRecord->length = pFrame->length;
+    pRecord->status = (PLAT_UI16)status;
+    pRecord->direction = (PLAT_UI8)direction;
+    pRecord->header = 0;
+    if ((pFrame->first_element != NULL) && (pFrame->first_element->pData != NULL) && (pFrame->first_element->length != 0)) {
+        pRecord->header = pFrame->first_element->pData[0];
+    }
+    pRecord->retry_count = (pSTSE->frame_trace.retry_count > 0xFF) ? 0xFF : (PLAT_UI8)pSTSE->frame_trace.retry_count;
+    pSTSE->frame_trace.retry_count = 0;
+    pRecord->payload_length = 0;
+
+#if STSE_FRAME_TRACE_PAYLOAD_SIZE > 0
+    /* - Capture first frame bytes (strap elements captured as zeros) */
+    pElement = pFrame->first_element;
+    while ((pElement != NULL) && (pRecord->payload_length < STSE_FRAME_TRACE_PAYLOAD_SIZE)) {
+        for (index = 0; (index < pElement->length) && (pRecord->payload_length < STSE_FRAME_TRACE_PAYLOAD_SIZE); index++) {
+            pRecord->payload[pRecord->payload_length++] = (pElement->pData != NULL) ? pElement->pData[index] : 0x00;
+        }
+        pElement = pElement->next;
+    }
+#endif /* STSE_FRAME_TRACE_PAYLOAD_SIZE */
+}
+
+stse_ReturnCode_t stse_frame_trace_export(stse_Handler_t *pSTSE,
+                                          PLAT_UI8 *pBuffer,
+                                          PLAT_UI16 buffer_size,
+                                          PLAT_UI16 *pLength) {
+    stse_frame_trace_record_t *pRecord;
+    PLAT_UI32 sequence;
+    PLAT_UI32 record_count;
+    PLAT_UI16 offset;
+#if STSE_FRAME_TRACE_PAYLOAD_SIZE > 0
+    PLAT_UI16 index;
+#endif /* STSE_FRAME_TRACE_PAYLOAD_SIZE */
+
+    if (pSTSE == NULL) {
+        return STSE_CORE_HANDLER_NOT_INITIALISED;
+    }
+    if ((pBuffer == NULL) || (pLength == NULL) || (buffer_size < STSE_FRAME_TRACE_EXPORT_HEADER_SIZE)) {
+        return STSE_CORE_INVALID_PARAMETER;
+    }
+
+    /* - Select newest records fitting in the export buffer */
+    record_count = (pSTSE->frame_trace.sequence < STSE_FRAME_TRACE_DEPTH) ? pSTSE->frame_trace.sequence : STSE_FRAME_TRACE_DEPTH;
+    if (record_count > ((buffer_size - STSE_FRAME_TRACE_EXPORT_HEADER_SIZE) / STSE_FRAME_TRACE_EXPORT_RECORD_SIZE)) {
+        record_count = (buffer_size - STSE_FRAME_TRACE_EXPORT_HEADER_SIZE) / STSE_FRAME_TRACE_EXPORT_RECORD_SIZE;
+    }
+    sequence = pSTSE->frame_trace.sequence - record_count;
+
+    /* - Export header */
+    pBuffer[0] = 'S';
+    pBuffer[1] = 'T';
+    pBuffer[2] = 'F';
+    pBuffer[3] = 'T';
+    pBuffer[4] = STSE_FRAME_TRACE_EXPORT_VERSION;
+    pBuffer[5] = STSE_FRAME_TRACE_PAYLOAD_SIZE;
+    pBuffer[6] = (PLAT_UI8)(record_count & 0xFF);
+    pBuffer[7] = (PLAT_UI8)(record_count >> 8);
+    pBuffer[8] = (PLAT_UI8)(sequence & 0xFF);
+    pBuffer[9] = (PLAT_UI8)(sequence >> 8);
+    pBuffer[10] = (PLAT_UI8)(sequence >> 16);
+    pBuffer[11] = (PLAT_UI8)(sequence >> 24);
+    offset = STSE_FRAME_TRACE_EXPORT_HEADER_SIZE;
+
+    /* - Export records from the oldest to the newest one */
+    while (sequence != pSTSE->frame_trace.sequence) {
+        pRecord = &pSTSE->frame_trace.record[sequence & (STSE_FRAME_TRACE_DEPTH - 1)];
+        pBuffer[offset++] = (PLAT_UI8)(pRecord->timestamp & 0xFF);
+        pBuffer[offset++] = (PLAT_UI8)(pRecord->timestamp >> 8);
+        pBuffer[offset++] = (PLAT_UI8)(pRecord->timestamp >> 16);
+        pBuffer[offset++] = (PLAT_UI8)(pRecord->timestamp >> 24);
+        pBuffer[offset++] = (PLAT_UI8)(pRecord->length & 0xFF);
+        pBuffer[offset++] = (PLAT_UI8)(pRecord->length >> 8);
+        pBuffer[offset++] = (PLAT_UI8)(pRecord->status & 0xFF);
+        pBuffer[offset++] = (PLAT_UI8)(pRecord->status >> 8);
+        pBuffer[offset++] = pRecord->direction;
+        pBuffer[offset++] = pRecord->header;
+        pBuffer[offset++] = pRecord->retry_count;
+        pBuffer[offset++] = pRecord->payload_length;
+#if STSE_FRAME_TRACE_PAYLOAD_SIZE > 0
+        for (index = 0; index < STSE_FRAME_TRACE_PAYLOAD_SIZE; index++) {
+            pBuffer[offset++] = (index < pRecord->payload_length) ? pRecord->payload[index] : 0x00;
+        }
+#endif /* STSE_FRAME_TRACE_PAYLOAD_SIZE */
+        sequence++;
+    }
+
+    *pLength = offset;
+
+    return STSE_OK;
+}
+
+void stse_frame_trace_clear(stse_Handler_t *pSTSE) {
+    if (pSTSE != NULL) {
+        pSTSE->frame_trace.sequence = 0;
+        pSTSE->frame_trace.retry_count = 0;
+    }
+}
+
+#endif /* STSE_FRAME_TRACE */
@@ -0,0 +1,102 @@
+/*!
+ * ******************************************************************************
+ * \file	stse_frame_trace.h
+ * \brief   STSELib frame trace (header)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef STSE_FRAME_TRACE_H
+#define STSE_FRAME_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "core/stse_device.h"
+#include "core/stse_frame.h"
+#include "core/stse_platform.h"
+
+/*! \defgroup stse_frame_trace Frame trace
+ *  \ingroup stse_core
+ *  \brief      Binary HOST<->STSE frame trace
+ *  \details    When STSE_FRAME_TRACE is defined , each frame sent to or received from the target device is recorded
+ *              in the handler frame trace ring buffer (last STSE_FRAME_TRACE_DEPTH frames). A record holds the frame
+ *              direction , command code or response header , length , transfer status , bus retry count , platform
+ *              timestamp and optionally the first STSE_FRAME_TRACE_PAYLOAD_SIZE frame bytes. The trace is exported
+ *              as a binary blob using \ref stse_frame_trace_export and decoded on host side using the
+ *              tools/stse_frame_trace_decode.c utility.
+ *  @{
+ */
+
+#ifdef STSE_FRAME_TRACE
+
+#define STSE_FRAME_TRACE_EXPORT_VERSION 0x01U   /*!< Frame trace export format version */
+#define STSE_FRAME_TRACE_EXPORT_HEADER_SIZE 12U /*!< Frame trace export header size */
+#define STSE_FRAME_TRACE_EXPORT_RECORD_SIZE (12U + STSE_FRAME_TRACE_PAYLOAD_SIZE) /*!< Frame trace export record size */
+
+/*!
+ * \enum stse_frame_trace_direction_t
+ * \brief STSE frame trace direction
+ */
+typedef enum stse_frame_trace_direction_t {
+    STSE_FRAME_TRACE_CMD = 0, /*!< HOST to STSE command frame */
+    STSE_FRAME_TRACE_RSP      /*!< STSE to HOST response frame */
+} stse_frame_trace_direction_t;
+
+/**
+ * \brief       Record a frame in the handler frame trace
+ * \param[in]   pSTSE : Pointer to STSE handler
+ * \param[in]   direction : Frame direction
+ * \param[in]   pFrame : Pointer to the sent or received frame
+ * \param[in]   status : Frame transfer status
+ */
+void stse_frame_trace_record(stse_Handler_t *pSTSE,
+                             stse_frame_trace_direction_t direction,
+                             stse_frame_t *pFrame,
+                             stse_ReturnCode_t status);
+
+/**
+ * \brief       Export the handler frame trace
+ * \details     Records are exported from the oldest to the newest one (newest records are kept when the buffer
+ *              is too small to export all records). Export format (little endian) : \n
+ *              - header : "STFT" magic , format version (1 byte) , payload capture size (1 byte) ,
+ *                record count (2 bytes) , sequence number of the first exported record (4 bytes) \n
+ *              - records : timestamp (4 bytes) , length (2 bytes) , status (2 bytes) , direction (1 byte) ,
+ *                header (1 byte) , retry count (1 byte) , captured length (1 byte) , captured bytes (payload capture size)
+ * \param[in]   pSTSE : Pointer to STSE handler
+ * \param[out]  pBuffer : Export buffer
+ * \param[in]   buffer_size : Export buffer size
+ * \param[out]  pLength : Exported length
+ * \return \ref STSE_OK on success ; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_frame_trace_export(stse_Handler_t *pSTSE,
+                                          PLAT_UI8 *pBuffer,
+                                          PLAT_UI16 buffer_size,
+                                          PLAT_UI16 *pLength);
+
+/**
+ * \brief       Clear the handler frame trace
+ * \param[in]   pSTSE : Pointer to STSE handler
+ */
+void stse_frame_trace_clear(stse_Handler_t *pSTSE);
+
+#endif /* STSE_FRAME_TRACE */
+
+/** @}*/
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* STSE_FRAME_TRACE_H */
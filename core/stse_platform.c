@@ -25,6 +25,12 @@
  *                STSAFE CRYPTO Global variables
  **************************************************************/
 
+#if (defined(STSE_CONF_USE_HOST_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_HOST_SESSION)) && \
+    defined(STSE_CONF_USE_PLATFORM_AES_CMAC_CTX)
+/* Context backing the legacy AES CMAC sequence API */
+static stse_platform_aes_cmac_ctx_t stse_platform_aes_cmac_legacy_ctx;
+#endif
+
 /************************************************************
  *                STSAFE CRYPTO HAL
  **************************************************************/
@@ -62,3 +68,72 @@ __WEAK stse_ReturnCode_t stse_platform_hmac_sha256_compute(PLAT_UI8 *pSalt, PLAT
 
     return retval;
 }
+
+#if defined(STSE_CONF_USE_HOST_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_HOST_SESSION)
+
+#ifdef STSE_CONF_USE_PLATFORM_AES_CMAC_CTX
+
+/* - Legacy AES CMAC sequence API on top of the platform context API */
+
+__WEAK stse_ReturnCode_t stse_platform_aes_cmac_init(const PLAT_UI8 *pKey,
+                                                     PLAT_UI16 key_length,
+                                                     PLAT_UI16 exp_tag_size) {
+    return stse_platform_aes_cmac_ctx_init(&stse_platform_aes_cmac_legacy_ctx, pKey, key_length, exp_tag_size);
+}
+
+__WEAK stse_ReturnCode_t stse_platform_aes_cmac_append(PLAT_UI8 *pInput, PLAT_UI16 length) {
+    return stse_platform_aes_cmac_ctx_append(&stse_platform_aes_cmac_legacy_ctx, pInput, length);
+}
+
+__WEAK stse_ReturnCode_t stse_platform_aes_cmac_compute_finish(PLAT_UI8 *pTag, PLAT_UI8 *pTagLen) {
+    return stse_platform_aes_cmac_ctx_compute_finish(&stse_platform_aes_cmac_legacy_ctx, pTag, pTagLen);
+}
+
+__WEAK stse_ReturnCode_t stse_platform_aes_cmac_verify_finish(PLAT_UI8 *pTag) {
+    return stse_platform_aes_cmac_ctx_verify_finish(&stse_platform_aes_cmac_legacy_ctx, pTag);
+}
+
+#else
+
+/* - AES CMAC context API on top of the platform legacy sequence API (single computation at a time , context unused) */
+
+__WEAK stse_ReturnCode_t stse_platform_aes_cmac_ctx_init(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                         const PLAT_UI8 *pKey,
+                                                         PLAT_UI16 key_length,
+                                                         PLAT_UI16 exp_tag_size) {
+    (void)pCtx;
+    return stse_platform_aes_cmac_init(pKey, key_length, exp_tag_size);
+}
+
+__WEAK stse_ReturnCode_t stse_platform_aes_cmac_ctx_append(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                           PLAT_UI8 *pInput,
+                                                           PLAT_UI16 length) {
+    (void)pCtx;
+    return stse_platform_aes_cmac_append(pInput, length);
+}
+
+__WEAK stse_ReturnCode_t stse_platform_aes_cmac_ctx_compute_finish(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                                   PLAT_UI8 *pTag,
+                                                                   PLAT_UI8 *pTagLen) {
+    (void)pCtx;
+    return stse_platform_aes_cmac_compute_finish(pTag, pTagLen);
+}
+
+__WEAK stse_ReturnCode_t stse_platform_aes_cmac_ctx_verify_finish(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                                  PLAT_UI8 *pTag) {
+    (void)pCtx;
+    return stse_platform_aes_cmac_verify_finish(pTag);
+}
+
+#endif /* STSE_CONF_USE_PLATFORM_AES_CMAC_CTX */
+
+__WEAK void stse_platform_aes_cmac_ctx_abort(stse_platform_aes_cmac_ctx_t *pCtx) {
+    PLAT_UI8 tag[16]; /* AES block size */
+    PLAT_UI8 tag_length;
+
+    /* - Finish the computation to release the context resources (result discarded) */
+    (void)stse_platform_aes_cmac_ctx_compute_finish(pCtx, tag, &tag_length);
+    memset(tag, 0, sizeof(tag));
+}
+
+#endif
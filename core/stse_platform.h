@@ -59,6 +59,31 @@ stse_ReturnCode_t stse_platform_crc16_init(void);
  */
 stse_ReturnCode_t stse_platform_crypto_init(void);
 
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+#ifndef STSE_CONF_USE_BUILTIN_CRC16
+#error "STSE_CONF_USE_THREAD_SAFETY requires STSE_CONF_USE_BUILTIN_CRC16 (platform CRC16 accumulation state shared by all transfers)"
+#endif /* STSE_CONF_USE_BUILTIN_CRC16 */
+#if defined(STSE_CONF_USE_HOST_SESSION) && !defined(STSE_CONF_USE_PLATFORM_AES_CMAC_CTX)
+#error "STSE_CONF_USE_THREAD_SAFETY requires STSE_CONF_USE_PLATFORM_AES_CMAC_CTX (platform AES CMAC sequence shared by all host sessions)"
+#endif /* STSE_CONF_USE_HOST_SESSION && !STSE_CONF_USE_PLATFORM_AES_CMAC_CTX */
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
+
+#if defined(STSE_CONF_USE_THREAD_SAFETY) && defined(STSE_CONF_USE_COMPANION)
+/*!
+ * \brief      Lock the certificate parser companion handler
+ * \details    Held by certificate verification while it uses the companion STSE and by companion set / reset ,
+ *             so that a companion is never reset while in use. Shall not be recursive-dependent : the device lock
+ *             of the companion handler is taken while it is held
+ * \return     \ref STSE_OK on success; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_platform_companion_lock(void);
+
+/*!
+ * \brief      Unlock the certificate parser companion handler
+ */
+void stse_platform_companion_unlock(void);
+#endif /* STSE_CONF_USE_THREAD_SAFETY && STSE_CONF_USE_COMPANION */
+
 /*!
  * \brief      Platform random number generation initialization callback function
  * \return     \ref STSE_OK on success; \ref stse_ReturnCode_t error code otherwise
@@ -94,6 +119,15 @@ PLAT_UI16 stse_platform_Crc16_Accumulate(PLAT_UI8 *pbuffer, PLAT_UI16 length);
  */
 void stse_platform_Delay_ms(PLAT_UI16 delay_val);
 
+#if defined(STSE_FRAME_TRACE) || defined(STSE_CMD_METRICS)
+/*!
+ * \brief      Get a monotonic platform timestamp (used by frame trace and command metrics)
+ * \details    Timestamp unit is platform specific (e.g. ms tick , us timer or CPU cycle counter)
+ * \return     Current timestamp value (wrapping 32-bit counter)
+ */
+PLAT_UI32 stse_platform_get_timestamp(void);
+#endif /* STSE_FRAME_TRACE || STSE_CMD_METRICS */
+
 /*!
  * \brief      Verify ECC signature
  * \param[in]  key_type Type of ECC key
@@ -209,8 +243,80 @@ stse_ReturnCode_t stse_platform_nist_kw_encrypt(PLAT_UI8 *pPayload, PLAT_UI32 pa
 
 #if defined(STSE_CONF_USE_HOST_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_HOST_SESSION)
 
+#ifndef STSE_PLATFORM_AES_CMAC_CTX_SIZE
+#define STSE_PLATFORM_AES_CMAC_CTX_SIZE 512U /*!< Platform AES CMAC context storage size in bytes (may be overridden in stse_platform_generic.h) */
+#endif /* STSE_PLATFORM_AES_CMAC_CTX_SIZE */
+
+/*!
+ * \brief      Platform AES CMAC computation context
+ * \details    Opaque storage owned by the caller and used by the platform to hold one AES CMAC computation state
+ *             (e.g. crypto library CMAC handle). When STSE_CONF_USE_PLATFORM_AES_CMAC_CTX is defined , the platform
+ *             implements the stse_platform_aes_cmac_ctx_* functions and each context being independent , several CMAC
+ *             computations can be carried concurrently (different sessions , devices or threads). Otherwise the weak
+ *             library definitions forward to the platform legacy sequence API (\ref stse_platform_aes_cmac_init) and
+ *             the context storage is unused
+ */
+typedef struct {
+    PLAT_UI64 storage[(STSE_PLATFORM_AES_CMAC_CTX_SIZE + 7U) / 8U]; /*!< Platform specific context storage */
+} stse_platform_aes_cmac_ctx_t;
+
+/*!
+ * \brief      Initialize AES CMAC computation on a context
+ * \param[in,out] pCtx Pointer to the AES CMAC context
+ * \param[in]  pKey Pointer to the key
+ * \param[in]  key_length Length of the key
+ * \param[in]  exp_tag_size Expected tag size
+ * \return     \ref STSE_OK on success; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_platform_aes_cmac_ctx_init(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                  const PLAT_UI8 *pKey,
+                                                  PLAT_UI16 key_length,
+                                                  PLAT_UI16 exp_tag_size);
+
+/*!
+ * \brief      Append data to AES CMAC computation on a context
+ * \param[in,out] pCtx Pointer to the AES CMAC context
+ * \param[in]  pInput Pointer to the input data
+ * \param[in]  length Length of the input data
+ * \return     \ref STSE_OK on success; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_platform_aes_cmac_ctx_append(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                    PLAT_UI8 *pInput,
+                                                    PLAT_UI16 length);
+
+/*!
+ * \brief      Finish AES CMAC computation on a context and get the tag
+ * \param[in,out] pCtx Pointer to the AES CMAC context
+ * \param[out] pTag Pointer to the tag buffer
+ * \param[out] pTagLen Pointer to the tag length
+ * \return     \ref STSE_OK on success; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_platform_aes_cmac_ctx_compute_finish(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                            PLAT_UI8 *pTag,
+                                                            PLAT_UI8 *pTagLen);
+
+/*!
+ * \brief      Finish AES CMAC verification on a context
+ * \param[in,out] pCtx Pointer to the AES CMAC context
+ * \param[in]  pTag Pointer to the tag
+ * \return     \ref STSE_OK on success; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_platform_aes_cmac_ctx_verify_finish(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                           PLAT_UI8 *pTag);
+
+/*!
+ * \brief      Abort AES CMAC computation on a context
+ * \details    Releases the context resources of a computation that will not be finished (error paths). The weak
+ *             library definition finishes the computation and discards the tag
+ * \param[in,out] pCtx Pointer to the AES CMAC context
+ */
+void stse_platform_aes_cmac_ctx_abort(stse_platform_aes_cmac_ctx_t *pCtx);
+
 /*!
  * \brief      Initialize AES CMAC computation
+ * \details    Legacy sequence API operating on a single context. Implemented by the platform when
+ *             STSE_CONF_USE_PLATFORM_AES_CMAC_CTX is not defined , weak library definition forwarding to
+ *             \ref stse_platform_aes_cmac_ctx_init otherwise
  * \param[in]  pKey Pointer to the key
  * \param[in]  key_length Length of the key
  * \param[in]  exp_tag_size Expected tag size
@@ -222,6 +328,7 @@ stse_ReturnCode_t stse_platform_aes_cmac_init(const PLAT_UI8 *pKey,
 
 /*!
  * \brief      Append data to AES CMAC computation
+ * \details    Legacy sequence API (see \ref stse_platform_aes_cmac_init)
  * \param[in]  pInput Pointer to the input data
  * \param[in]  length Length of the input data
  * \return     \ref STSE_OK on success; \ref stse_ReturnCode_t error code otherwise
@@ -230,6 +337,7 @@ stse_ReturnCode_t stse_platform_aes_cmac_append(PLAT_UI8 *pInput, PLAT_UI16 leng
 
 /*!
  * \brief      Finish AES CMAC computation and get the tag
+ * \details    Legacy sequence API (see \ref stse_platform_aes_cmac_init)
  * \param[out] pTag Pointer to the tag buffer
  * \param[out] pTagLen Pointer to the tag length
  * \return     \ref STSE_OK on success; \ref stse_ReturnCode_t error code otherwise
@@ -238,6 +346,7 @@ stse_ReturnCode_t stse_platform_aes_cmac_compute_finish(PLAT_UI8 *pTag, PLAT_UI8
 
 /*!
  * \brief      Finish AES CMAC verification
+ * \details    Legacy sequence API (see \ref stse_platform_aes_cmac_init)
  * \param[in]  pTag Pointer to the tag
  * \return     \ref STSE_OK on success; \ref stse_ReturnCode_t error code otherwise
  */
@@ -319,6 +428,93 @@ stse_ReturnCode_t stse_platform_aes_ecb_enc(const PLAT_UI8 *pPlaintext, PLAT_UI1
                                             const PLAT_UI8 *pKey, PLAT_UI16 key_length,
                                             PLAT_UI8 *pEncryptedtext, PLAT_UI16 *pEncryptedtext_length);
 
+#if defined(STSE_CONF_USE_HOST_SESSION) && defined(STSE_CONF_USE_HOST_SESSION_KEY_HANDLES)
+
+#ifndef STSE_CONF_USE_PLATFORM_AES_CMAC_CTX
+#error "STSE_CONF_USE_HOST_SESSION_KEY_HANDLES requires STSE_CONF_USE_PLATFORM_AES_CMAC_CTX"
+#endif /* STSE_CONF_USE_PLATFORM_AES_CMAC_CTX */
+
+/*!
+ * \brief      Opaque platform AES key handle
+ * \details    Platform owned object holding a pre-expanded AES key (encryption / decryption key schedules and
+ *             AES CMAC subkeys) so that host session operations only perform the AES block operations
+ */
+typedef void *stse_platform_aes_key_handle_t;
+
+/*!
+ * \brief      Create a pre-expanded AES key handle
+ * \details    Called once per host session key by \ref stsafea_open_host_session
+ * \param[in]  pKey Pointer to the key
+ * \param[in]  key_length Length of the key
+ * \param[out] pKey_handle Pointer to the created key handle
+ * \return     \ref STSE_OK on success; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_platform_aes_key_handle_create(const PLAT_UI8 *pKey, PLAT_UI16 key_length,
+                                                      stse_platform_aes_key_handle_t *pKey_handle);
+
+/*!
+ * \brief      Destroy a pre-expanded AES key handle
+ * \details    Called by \ref stsafea_close_host_session , the key schedules shall be erased
+ * \param[in]  key_handle Key handle to destroy
+ */
+void stse_platform_aes_key_handle_destroy(stse_platform_aes_key_handle_t key_handle);
+
+/*!
+ * \brief      Perform an AES ECB encryption with a pre-expanded key
+ * \param[in]  key_handle Key handle
+ * \param[in]  pPlaintext Pointer to the plaintext data
+ * \param[in]  plaintext_length Length of the plaintext data
+ * \param[out] pEncryptedtext Pointer to the encrypted payload
+ * \param[out] pEncryptedtext_length Length of encrypted payload
+ * \return     \ref STSE_OK on success; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_platform_aes_key_handle_ecb_enc(stse_platform_aes_key_handle_t key_handle,
+                                                       const PLAT_UI8 *pPlaintext, PLAT_UI16 plaintext_length,
+                                                       PLAT_UI8 *pEncryptedtext, PLAT_UI16 *pEncryptedtext_length);
+
+/*!
+ * \brief      Perform an AES CBC encryption with a pre-expanded key
+ * \param[in]  key_handle Key handle
+ * \param[in]  pPlaintext Pointer to the plaintext data
+ * \param[in]  plaintext_length Length of the plaintext data
+ * \param[in]  pInitial_value Pointer to encryption IV
+ * \param[out] pEncryptedtext Pointer to the encrypted payload
+ * \param[out] pEncryptedtext_length Length of encrypted payload
+ * \return     \ref STSE_OK on success; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_platform_aes_key_handle_cbc_enc(stse_platform_aes_key_handle_t key_handle,
+                                                       const PLAT_UI8 *pPlaintext, PLAT_UI16 plaintext_length,
+                                                       PLAT_UI8 *pInitial_value,
+                                                       PLAT_UI8 *pEncryptedtext, PLAT_UI16 *pEncryptedtext_length);
+
+/*!
+ * \brief      Perform an AES CBC decryption with a pre-expanded key
+ * \param[in]  key_handle Key handle
+ * \param[in]  pEncryptedtext Pointer to the encrypted payload
+ * \param[in]  encryptedtext_length Length of encrypted payload
+ * \param[in]  pInitial_value Pointer to decryption IV
+ * \param[out] pPlaintext Pointer to PlainText payload
+ * \param[out] pPlaintext_length Length of the PlainText payload
+ * \return     \ref STSE_OK on success; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_platform_aes_key_handle_cbc_dec(stse_platform_aes_key_handle_t key_handle,
+                                                       const PLAT_UI8 *pEncryptedtext, PLAT_UI16 encryptedtext_length,
+                                                       PLAT_UI8 *pInitial_value,
+                                                       PLAT_UI8 *pPlaintext, PLAT_UI16 *pPlaintext_length);
+
+/*!
+ * \brief      Initialize AES CMAC computation on a context with a pre-expanded key
+ * \param[in,out] pCtx Pointer to the AES CMAC context
+ * \param[in]  key_handle Key handle
+ * \param[in]  exp_tag_size Expected tag size
+ * \return     \ref STSE_OK on success; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_platform_aes_key_handle_cmac_init(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                         stse_platform_aes_key_handle_t key_handle,
+                                                         PLAT_UI16 exp_tag_size);
+
+#endif /* STSE_CONF_USE_HOST_SESSION && STSE_CONF_USE_HOST_SESSION_KEY_HANDLES */
+
 #endif /* defined(STSE_CONF_USE_HOST_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_HOST_SESSION) */
 
 /*!
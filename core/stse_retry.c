@@ -0,0 +1,137 @@
+/*!
+ * ******************************************************************************
+ * \file	stse_retry.c
+ * \brief   STSELib bus retry management (sources)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include "core/stse_retry.h"
+#include <string.h>
+
+void stse_retry_init(stse_Handler_t *pSTSE, stse_retry_t *pRetry, PLAT_UI16 max_attempt) {
+    pRetry->max_attempt = max_attempt;
+    pRetry->failed_attempt = 0;
+#ifdef STSE_USE_RETRY_POLICY
+    pRetry->delay = pSTSE->retry_policy.initial_delay;
+    pRetry->elapsed = 0;
+#else
+    (void)pSTSE;
+#endif /* STSE_USE_RETRY_POLICY */
+}
+
+PLAT_UI8 stse_retry_next(stse_Handler_t *pSTSE, stse_retry_t *pRetry, PLAT_UI16 *pDelay) {
+#ifdef STSE_USE_RETRY_POLICY
+    stse_retry_policy_t *pPolicy = &pSTSE->retry_policy;
+    PLAT_UI32 delay;
+
+    pRetry->failed_attempt++;
+
+    if (pRetry->failed_attempt >= pRetry->max_attempt) {
+        return 0;
+    }
+
+    /* - Apply random jitter to the base delay */
+    delay = pRetry->delay;
+    if (pPolicy->jitter != 0) {
+        delay += stse_platform_generate_random() % ((PLAT_UI32)pPolicy->jitter + 1U);
+    }
+    /* - Clamp delay to the platform delay range */
+    if (delay > 0xFFFFU) {
+        delay = 0xFFFFU;
+    }
+
+    /* - Verify cumulated retry delay against deadline */
+    if ((pPolicy->deadline != 0) && ((pRetry->elapsed + delay) > pPolicy->deadline)) {
+        return 0;
+    }
+    pRetry->elapsed += delay;
+
+    /* - Compute next base delay (exponential backoff up to delay cap) */
+    if (((PLAT_UI32)pRetry->delay * pPolicy->backoff_factor) > pPolicy->max_delay) {
+        pRetry->delay = pPolicy->max_delay;
+    } else {
+        pRetry->delay *= pPolicy->backoff_factor;
+    }
+
+    pSTSE->retry_stats.cmd_retry_count++;
+    pSTSE->retry_stats.total_retry_count++;
+
+    *pDelay = (PLAT_UI16)delay;
+#else
+    (void)pSTSE;
+
+    pRetry->failed_attempt++;
+
+    if (pRetry->failed_attempt >= pRetry->max_attempt) {
+        return 0;
+    }
+
+    *pDelay = STSE_POLLING_RETRY_INTERVAL;
+#endif /* STSE_USE_RETRY_POLICY */
+
+#ifdef STSE_FRAME_TRACE
+    pSTSE->frame_trace.retry_count++;
+#endif /* STSE_FRAME_TRACE */
+#ifdef STSE_CMD_METRICS
+    pSTSE->cmd_metrics.retry_count++;
+#endif /* STSE_CMD_METRICS */
+
+    return 1;
+}
+
+PLAT_UI8 stse_retry_wait(stse_Handler_t *pSTSE, stse_retry_t *pRetry) {
+    PLAT_UI16 delay;
+
+    if (stse_retry_next(pSTSE, pRetry, &delay) == 0) {
+        return 0;
+    }
+    stse_platform_Delay_ms(delay);
+
+    return 1;
+}
+
+#ifdef STSE_USE_RETRY_POLICY
+
+stse_ReturnCode_t stse_retry_set_policy(stse_Handler_t *pSTSE, const stse_retry_policy_t *pPolicy) {
+    if (pSTSE == NULL) {
+        return STSE_CORE_HANDLER_NOT_INITIALISED;
+    }
+    if ((pPolicy == NULL) || (pPolicy->initial_delay == 0) || (pPolicy->backoff_factor == 0) ||
+        (pPolicy->max_delay < pPolicy->initial_delay)) {
+        return STSE_CORE_INVALID_PARAMETER;
+    }
+
+    pSTSE->retry_policy = *pPolicy;
+
+    return STSE_OK;
+}
+
+void stse_retry_command_start(stse_Handler_t *pSTSE) {
+    pSTSE->retry_stats.cmd_retry_count = 0;
+}
+
+void stse_retry_command_end(stse_Handler_t *pSTSE) {
+    pSTSE->retry_stats.cmd_count++;
+    if (pSTSE->retry_stats.cmd_retry_count > pSTSE->retry_stats.max_cmd_retry_count) {
+        pSTSE->retry_stats.max_cmd_retry_count = pSTSE->retry_stats.cmd_retry_count;
+    }
+}
+
+void stse_retry_reset_statistics(stse_Handler_t *pSTSE) {
+    if (pSTSE != NULL) {
+        memset(&pSTSE->retry_stats, 0, sizeof(pSTSE->retry_stats));
+    }
+}
+
+#endif /* STSE_USE_RETRY_POLICY */
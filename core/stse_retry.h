@@ -0,0 +1,114 @@
+/*!
+ * ******************************************************************************
+ * \file	stse_retry.h
+ * \brief   STSELib bus retry management (header)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef STSE_RETRY_H
+#define STSE_RETRY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "core/stse_device.h"
+#include "core/stse_platform.h"
+
+/*! \defgroup stse_retry Bus retry management
+ *  \ingroup stse_core
+ *  \brief      Retry of bus operations NACKed by the target device
+ *  \details    By default a NACKed bus operation is retried up to STSE_MAX_POLLING_RETRY times every
+ *              STSE_POLLING_RETRY_INTERVAL ms. When STSE_USE_RETRY_POLICY is defined , the retry delays follow
+ *              the retry policy of the handler (initial delay , backoff factor , delay cap , deadline and jitter)
+ *              and the retries needed by each command are recorded in the handler retry statistics.
+ *  @{
+ */
+
+/*!
+ * \brief STSE bus operation retry state
+ */
+typedef struct stse_retry_t {
+    PLAT_UI16 max_attempt;    /*!< Maximum number of attempts */
+    PLAT_UI16 failed_attempt; /*!< Number of failed (NACKed) attempts */
+#ifdef STSE_USE_RETRY_POLICY
+    PLAT_UI16 delay;   /*!< Base delay before next attempt (ms) */
+    PLAT_UI32 elapsed; /*!< Cumulated retry delay (ms) */
+#endif                 /* STSE_USE_RETRY_POLICY */
+} stse_retry_t;
+
+/**
+ * \brief       Initialize a bus operation retry state
+ * \param[in]   pSTSE : Pointer to STSE handler
+ * \param[out]  pRetry : Pointer to retry state
+ * \param[in]   max_attempt : Maximum number of attempts
+ */
+void stse_retry_init(stse_Handler_t *pSTSE, stse_retry_t *pRetry, PLAT_UI16 max_attempt);
+
+/**
+ * \brief       Account a failed attempt and get the delay before the next one
+ * \param[in]   pSTSE : Pointer to STSE handler
+ * \param[in,out] pRetry : Pointer to retry state
+ * \param[out]  pDelay : Delay to wait before next attempt (ms)
+ * \return      1 if a new attempt is allowed ; 0 when attempts or deadline are exhausted
+ */
+PLAT_UI8 stse_retry_next(stse_Handler_t *pSTSE, stse_retry_t *pRetry, PLAT_UI16 *pDelay);
+
+/**
+ * \brief       Account a failed attempt and wait before the next one
+ * \param[in]   pSTSE : Pointer to STSE handler
+ * \param[in,out] pRetry : Pointer to retry state
+ * \return      1 if a new attempt is allowed ; 0 when attempts or deadline are exhausted (no wait)
+ */
+PLAT_UI8 stse_retry_wait(stse_Handler_t *pSTSE, stse_retry_t *pRetry);
+
+#ifdef STSE_USE_RETRY_POLICY
+
+/**
+ * \brief       Set the retry policy of a handler
+ * \details     The policy is refused (\ref STSE_CORE_INVALID_PARAMETER) when its initial delay or backoff factor is 0
+ *              or when its delay cap is lower than its initial delay
+ * \param[in]   pSTSE : Pointer to STSE handler
+ * \param[in]   pPolicy : Pointer to retry policy
+ * \return \ref STSE_OK on success ; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_retry_set_policy(stse_Handler_t *pSTSE, const stse_retry_policy_t *pPolicy);
+
+/**
+ * \brief       Start retry accounting of a command
+ * \param[in]   pSTSE : Pointer to STSE handler
+ */
+void stse_retry_command_start(stse_Handler_t *pSTSE);
+
+/**
+ * \brief       End retry accounting of a command
+ * \param[in]   pSTSE : Pointer to STSE handler
+ */
+void stse_retry_command_end(stse_Handler_t *pSTSE);
+
+/**
+ * \brief       Clear the retry statistics of a handler
+ * \param[in]   pSTSE : Pointer to STSE handler
+ */
+void stse_retry_reset_statistics(stse_Handler_t *pSTSE);
+
+#endif /* STSE_USE_RETRY_POLICY */
+
+/** @}*/
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* STSE_RETRY_H */
@@ -104,6 +104,7 @@ enum stse_ReturnCode_t {
     STSE_SERVICE_FRAME_SIZE_ERROR,
     STSE_SERVICE_INVALID_FRAME,
     STSE_SERVICE_INCOMPATIBLE_DEVICE_TYPE,
+    STSE_SERVICE_TRANSFER_PENDING,           /*!< STSE transfer submitted, target response not yet available */
 
     /* - STSE API layer response code (MSB Mask 0x04xx)*/
     STSE_API_INVALID_PARAMETER = 0x0401,
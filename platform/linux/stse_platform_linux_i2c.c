@@ -0,0 +1,669 @@
+/*!
+ * ******************************************************************************
+ * \file	stse_platform_linux_i2c.c
+ * \brief   STSecureElement I2C and delay platform file for Linux i2c-dev (sources)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#define _GNU_SOURCE
+#include "platform/linux/stse_platform_linux_i2c.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#ifdef STSE_USE_IO_LINE_RSP_WAIT
+#include <poll.h>
+#include <linux/gpio.h>
+#endif /* STSE_USE_IO_LINE_RSP_WAIT */
+
+#ifndef STSE_LINUX_I2C_BUS_COUNT
+#define STSE_LINUX_I2C_BUS_COUNT 8U
+#endif
+
+#ifndef STSE_LINUX_I2C_BUFFER_SIZE
+#define STSE_LINUX_I2C_BUFFER_SIZE 755U
+#endif
+
+#ifndef STSE_LINUX_I2C_DEVICE_PATH
+#define STSE_LINUX_I2C_DEVICE_PATH "/dev/i2c-%u"
+#endif
+
+typedef struct {
+    int fd;                                        /*!< i2c-dev file descriptor */
+    PLAT_UI8 opened;                               /*!< Bus opened flag */
+    unsigned long funcs;                           /*!< Adapter functionalities (I2C_FUNCS) */
+    PLAT_UI16 frame_size;                          /*!< Current frame size */
+    PLAT_UI16 frame_offset;                        /*!< Current frame offset */
+    PLAT_UI8 buffer[STSE_LINUX_I2C_BUFFER_SIZE];   /*!< Frame buffer */
+} linux_i2c_bus_t;
+
+static linux_i2c_bus_t linux_i2c_bus[STSE_LINUX_I2C_BUS_COUNT];
+static PLAT_UI8 linux_i2c_zero[STSE_LINUX_I2C_BUFFER_SIZE];
+#ifdef STSE_USE_IO_LINE_RSP_WAIT
+static int linux_ready_line_fd = -1;
+#endif /* STSE_USE_IO_LINE_RSP_WAIT */
+
+static linux_i2c_bus_t *linux_i2c_get_bus(PLAT_UI8 busID)
+{
+    if ((busID >= STSE_LINUX_I2C_BUS_COUNT) || (linux_i2c_bus[busID].opened == 0U)) {
+        return NULL;
+    }
+    return &linux_i2c_bus[busID];
+}
+
+static stse_ReturnCode_t linux_i2c_transfer(linux_i2c_bus_t *pBus,
+        struct i2c_msg *pMsgs,
+        PLAT_UI32 msg_count)
+{
+    struct i2c_rdwr_ioctl_data xfer;
+    int ret;
+
+    xfer.msgs = pMsgs;
+    xfer.nmsgs = msg_count;
+
+    do {
+        ret = ioctl(pBus->fd, I2C_RDWR, &xfer);
+    } while ((ret < 0) && (errno == EINTR));
+
+    if (ret < 0) {
+        switch (errno) {
+        case ENXIO:
+        case EREMOTEIO:
+        case EIO:
+        case ETIMEDOUT:
+        case EAGAIN:
+            return STSE_PLATFORM_BUS_ACK_ERROR;
+        default:
+            return STSE_PLATFORM_BUS_ERR;
+        }
+    }
+
+    return STSE_OK;
+}
+
+static stse_ReturnCode_t linux_i2c_frame_transfer(linux_i2c_bus_t *pBus,
+        PLAT_UI8 devAddr,
+        PLAT_UI16 flags,
+        PLAT_UI8 *pData,
+        PLAT_UI16 length)
+{
+    struct i2c_msg msg;
+
+    msg.addr = devAddr;
+    msg.flags = flags;
+    msg.len = length;
+    msg.buf = pData;
+
+    return linux_i2c_transfer(pBus, &msg, 1U);
+}
+
+/**
+ * \brief   Initializes the delay platform.
+ * \return  STSE_OK on success.
+ */
+stse_ReturnCode_t stse_platform_delay_init(void)
+{
+    return STSE_OK;
+}
+
+/**
+ * \brief   Delays execution for a specified number of milliseconds.
+ * \param   delay_val Number of milliseconds to delay.
+ */
+void stse_platform_Delay_ms(PLAT_UI16 delay_val)
+{
+    struct timespec deadline;
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += delay_val / 1000U;
+    deadline.tv_nsec += (long)(delay_val % 1000U) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    /* - Absolute deadline : resume the sleep with unchanged target when interrupted by a signal */
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR) {
+    }
+}
+
+#if defined(STSE_FRAME_TRACE) || defined(STSE_CMD_METRICS)
+/**
+ * \brief   Returns a monotonic microsecond timestamp (wrapping 32-bit counter).
+ * \return  Current timestamp value.
+ */
+PLAT_UI32 stse_platform_get_timestamp(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (PLAT_UI32)(((PLAT_UI64)now.tv_sec * 1000000U) + ((PLAT_UI64)now.tv_nsec / 1000U));
+}
+#endif /* STSE_FRAME_TRACE || STSE_CMD_METRICS */
+
+/**
+ * \brief   Initializes the I2C bus.
+ * \param   busID Identifier for the I2C bus (/dev/i2c-busID).
+ * \return  STSE_OK on success.
+ */
+stse_ReturnCode_t stse_platform_i2c_init(PLAT_UI8 busID)
+{
+    linux_i2c_bus_t *pBus;
+    char path[32];
+
+    if (busID >= STSE_LINUX_I2C_BUS_COUNT) {
+        return STSE_PLATFORM_INVALID_PARAMETER;
+    }
+    pBus = &linux_i2c_bus[busID];
+    if (pBus->opened != 0U) {
+        return STSE_OK;
+    }
+
+    snprintf(path, sizeof(path), STSE_LINUX_I2C_DEVICE_PATH, busID);
+    pBus->fd = open(path, O_RDWR | O_CLOEXEC);
+    if (pBus->fd < 0) {
+        return STSE_PLATFORM_SERVICES_INIT_ERROR;
+    }
+
+    /* - Combined transactions are mandatory , NOSTART is optional (zero-copy vectored send) */
+    if ((ioctl(pBus->fd, I2C_FUNCS, &pBus->funcs) < 0) || ((pBus->funcs & I2C_FUNC_I2C) == 0U)) {
+        close(pBus->fd);
+        return STSE_PLATFORM_SERVICES_INIT_ERROR;
+    }
+
+    pBus->frame_size = 0;
+    pBus->frame_offset = 0;
+    pBus->opened = 1U;
+
+    return STSE_OK;
+}
+
+/**
+ * \brief   Releases the I2C bus file descriptor.
+ * \param   busID Identifier for the I2C bus (/dev/i2c-busID).
+ */
+void stse_platform_i2c_deinit(PLAT_UI8 busID)
+{
+    linux_i2c_bus_t *pBus = linux_i2c_get_bus(busID);
+
+    if (pBus != NULL) {
+        close(pBus->fd);
+        pBus->fd = -1;
+        pBus->opened = 0U;
+    }
+}
+
+/**
+ * \brief   Wakes up the I2C device.
+ * \param   busID Identifier for the I2C bus.
+ * \param   devAddr I2C device address.
+ * \param   speed I2C bus speed.
+ * \return  STSE_OK on success.
+ */
+stse_ReturnCode_t stse_platform_i2c_wake(PLAT_UI8 busID,
+        PLAT_UI8 devAddr,
+        PLAT_UI16 speed)
+{
+    linux_i2c_bus_t *pBus = linux_i2c_get_bus(busID);
+
+    (void)speed;
+
+    if (pBus == NULL) {
+        return STSE_PLATFORM_BUS_ERR;
+    }
+
+    /* - Address only write , the device does not acknowledge while waking up */
+    (void)linux_i2c_frame_transfer(pBus, devAddr, 0U, pBus->buffer, 0U);
+
+    return STSE_OK;
+}
+
+/**
+ * \brief   Starts an I2C send operation.
+ * \param   busID Identifier for the I2C bus.
+ * \param   devAddr I2C device address.
+ * \param   speed I2C bus speed.
+ * \param   FrameLength Length of the I2C frame.
+ * \return  STSE_OK on success, STSE_PLATFORM_BUFFER_ERR on buffer overflow.
+ */
+stse_ReturnCode_t stse_platform_i2c_send_start(PLAT_UI8 busID,
+        PLAT_UI8 devAddr,
+        PLAT_UI16 speed,
+        PLAT_UI16 FrameLength)
+{
+    linux_i2c_bus_t *pBus = linux_i2c_get_bus(busID);
+
+    (void)devAddr;
+    (void)speed;
+
+    if (pBus == NULL) {
+        return STSE_PLATFORM_BUS_ERR;
+    }
+    if (FrameLength > sizeof(pBus->buffer)) {
+        return STSE_PLATFORM_BUFFER_ERR;
+    }
+
+    pBus->frame_size = FrameLength;
+    pBus->frame_offset = 0;
+
+    return STSE_OK;
+}
+
+/**
+ * \brief   Continues an I2C send operation.
+ * \param   busID Identifier for the I2C bus.
+ * \param   devAddr I2C device address.
+ * \param   speed I2C bus speed.
+ * \param   pData Pointer to the data to send (NULL to send zeros).
+ * \param   data_size Size of the data to send.
+ * \return  STSE_OK on success, STSE_PLATFORM_BUFFER_ERR on buffer overflow.
+ */
+stse_ReturnCode_t stse_platform_i2c_send_continue(PLAT_UI8 busID,
+        PLAT_UI8 devAddr,
+        PLAT_UI16 speed,
+        PLAT_UI8 *pData,
+        PLAT_UI16 data_size)
+{
+    linux_i2c_bus_t *pBus = linux_i2c_get_bus(busID);
+
+    (void)devAddr;
+    (void)speed;
+
+    if (pBus == NULL) {
+        return STSE_PLATFORM_BUS_ERR;
+    }
+    if (data_size > (pBus->frame_size - pBus->frame_offset)) {
+        return STSE_PLATFORM_BUFFER_ERR;
+    }
+
+    if (data_size != 0U) {
+        if (pData == NULL) {
+            memset(pBus->buffer + pBus->frame_offset, 0x00, data_size);
+        } else {
+            memcpy(pBus->buffer + pBus->frame_offset, pData, data_size);
+        }
+        pBus->frame_offset += data_size;
+    }
+
+    return STSE_OK;
+}
+
+/**
+ * \brief   Stops an I2C send operation and sends the frame in a single I2C_RDWR transaction.
+ * \param   busID Identifier for the I2C bus.
+ * \param   devAddr I2C device address.
+ * \param   speed I2C bus speed.
+ * \param   pData Pointer to the data to send (NULL to send zeros).
+ * \param   data_size Size of the data to send.
+ * \return  STSE_OK on success, STSE_PLATFORM_BUS_ACK_ERROR on failure.
+ */
+stse_ReturnCode_t stse_platform_i2c_send_stop(PLAT_UI8 busID,
+        PLAT_UI8 devAddr,
+        PLAT_UI16 speed,
+        PLAT_UI8 *pData,
+        PLAT_UI16 data_size)
+{
+    stse_ReturnCode_t ret;
+    linux_i2c_bus_t *pBus;
+
+    ret = stse_platform_i2c_send_continue(busID, devAddr, speed, pData, data_size);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+
+    pBus = linux_i2c_get_bus(busID);
+    ret = linux_i2c_frame_transfer(pBus, devAddr, 0U, pBus->buffer, pBus->frame_offset);
+    pBus->frame_offset = 0;
+
+    return ret;
+}
+
+/**
+ * \brief   Starts an I2C receive operation and reads the frame in a single I2C_RDWR transaction.
+ * \param   busID Identifier for the I2C bus.
+ * \param   devAddr I2C device address.
+ * \param   speed I2C bus speed.
+ * \param   frameLength Length of the I2C frame.
+ * \return  STSE_OK on success, STSE_PLATFORM_BUS_ACK_ERROR on failure.
+ */
+stse_ReturnCode_t stse_platform_i2c_receive_start(PLAT_UI8 busID,
+        PLAT_UI8 devAddr,
+        PLAT_UI16 speed,
+        PLAT_UI16 frameLength)
+{
+    stse_ReturnCode_t ret;
+    linux_i2c_bus_t *pBus = linux_i2c_get_bus(busID);
+
+    (void)speed;
+
+    if (pBus == NULL) {
+        return STSE_PLATFORM_BUS_ERR;
+    }
+    if (frameLength > sizeof(pBus->buffer)) {
+        return STSE_PLATFORM_BUFFER_ERR;
+    }
+
+    ret = linux_i2c_frame_transfer(pBus, devAddr, I2C_M_RD, pBus->buffer, frameLength);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+
+    pBus->frame_size = frameLength;
+    pBus->frame_offset = 0;
+
+    return STSE_OK;
+}
+
+/**
+ * \brief   Continues an I2C receive operation.
+ * \param   busID Identifier for the I2C bus.
+ * \param   devAddr I2C device address.
+ * \param   speed I2C bus speed.
+ * \param   pData Pointer to the data buffer (NULL to discard).
+ * \param   data_size Size of the data to receive.
+ * \return  STSE_OK on success, STSE_PLATFORM_BUFFER_ERR on buffer overflow.
+ */
+stse_ReturnCode_t stse_platform_i2c_receive_continue(PLAT_UI8 busID,
+        PLAT_UI8 devAddr,
+        PLAT_UI16 speed,
+        PLAT_UI8 *pData,
+        PLAT_UI16 data_size)
+{
+    linux_i2c_bus_t *pBus = linux_i2c_get_bus(busID);
+
+    (void)devAddr;
+    (void)speed;
+
+    if (pBus == NULL) {
+        return STSE_PLATFORM_BUS_ERR;
+    }
+    if (data_size > (pBus->frame_size - pBus->frame_offset)) {
+        return STSE_PLATFORM_BUFFER_ERR;
+    }
+
+    if (pData != NULL) {
+        memcpy(pData, pBus->buffer + pBus->frame_offset, data_size);
+    }
+    pBus->frame_offset += data_size;
+
+    return STSE_OK;
+}
+
+/**
+ * \brief   Stops an I2C receive operation.
+ * \param   busID Identifier for the I2C bus.
+ * \param   devAddr I2C device address.
+ * \param   speed I2C bus speed.
+ * \param   pData Pointer to the data buffer (NULL to discard).
+ * \param   data_size Size of the data to receive.
+ * \return  STSE_OK on success, STSE_PLATFORM_BUFFER_ERR on buffer overflow.
+ */
+stse_ReturnCode_t stse_platform_i2c_receive_stop(PLAT_UI8 busID,
+        PLAT_UI8 devAddr,
+        PLAT_UI16 speed,
+        PLAT_UI8 *pData,
+        PLAT_UI16 data_size)
+{
+    stse_ReturnCode_t ret;
+
+    ret = stse_platform_i2c_receive_continue(busID, devAddr, speed, pData, data_size);
+
+    if (busID < STSE_LINUX_I2C_BUS_COUNT) {
+        linux_i2c_bus[busID].frame_offset = 0;
+    }
+
+    return ret;
+}
+
+/**
+ * \brief   Sends a complete I2C frame described by an I/O vector in a single I2C_RDWR transaction.
+ * \param   busID Identifier for the I2C bus.
+ * \param   devAddr I2C device address.
+ * \param   speed I2C bus speed.
+ * \param   pVector Pointer to the I/O vector entries.
+ * \param   vector_count Number of I/O vector entries.
+ * \return  STSE_OK on success, STSE_PLATFORM_BUS_ACK_ERROR on failure.
+ */
+stse_ReturnCode_t stse_platform_i2c_send_vectored(PLAT_UI8 busID,
+        PLAT_UI8 devAddr,
+        PLAT_UI16 speed,
+        stse_io_vector_t *pVector,
+        PLAT_UI8 vector_count)
+{
+    struct i2c_msg msgs[I2C_RDWR_IOCTL_MAX_MSGS];
+    PLAT_UI32 msg_count = 0;
+    PLAT_UI16 frame_length = 0;
+    PLAT_UI8 i;
+    linux_i2c_bus_t *pBus = linux_i2c_get_bus(busID);
+
+    (void)speed;
+
+    if (pBus == NULL) {
+        return STSE_PLATFORM_BUS_ERR;
+    }
+
+    for (i = 0; i < vector_count; i++) {
+        if (pVector[i].length > (sizeof(pBus->buffer) - frame_length)) {
+            return STSE_PLATFORM_BUFFER_ERR;
+        }
+        frame_length += pVector[i].length;
+    }
+
+    if ((pBus->funcs & I2C_FUNC_NOSTART) != 0U) {
+        /* - One message per entry , concatenated by the adapter in a single write transaction */
+        for (i = 0; (i < vector_count) && (msg_count < I2C_RDWR_IOCTL_MAX_MSGS); i++) {
+            if (pVector[i].length == 0U) {
+                continue;
+            }
+            msgs[msg_count].addr = devAddr;
+            msgs[msg_count].flags = (msg_count == 0U) ? 0U : I2C_M_NOSTART;
+            msgs[msg_count].len = pVector[i].length;
+            msgs[msg_count].buf = (pVector[i].pData == NULL) ? linux_i2c_zero : pVector[i].pData;
+            msg_count++;
+        }
+        if ((i == vector_count) && (msg_count != 0U)) {
+            return linux_i2c_transfer(pBus, msgs, msg_count);
+        }
+    }
+
+    /* - Gather entries in the bus buffer and send them as one message */
+    frame_length = 0;
+    for (i = 0; i < vector_count; i++) {
+        if (pVector[i].length != 0U) {
+            if (pVector[i].pData == NULL) {
+                memset(pBus->buffer + frame_length, 0x00, pVector[i].length);
+            } else {
+                memcpy(pBus->buffer + frame_length, pVector[i].pData, pVector[i].length);
+            }
+            frame_length += pVector[i].length;
+        }
+    }
+
+    return linux_i2c_frame_transfer(pBus, devAddr, 0U, pBus->buffer, frame_length);
+}
+
+/**
+ * \brief   Receives a complete I2C frame into the buffers described by an I/O vector in a single I2C_RDWR transaction.
+ * \param   busID Identifier for the I2C bus.
+ * \param   devAddr I2C device address.
+ * \param   speed I2C bus speed.
+ * \param   pVector Pointer to the I/O vector entries.
+ * \param   vector_count Number of I/O vector entries.
+ * \return  STSE_OK on success, STSE_PLATFORM_BUS_ACK_ERROR on failure.
+ */
+stse_ReturnCode_t stse_platform_i2c_receive_vectored(PLAT_UI8 busID,
+        PLAT_UI8 devAddr,
+        PLAT_UI16 speed,
+        stse_io_vector_t *pVector,
+        PLAT_UI8 vector_count)
+{
+    stse_ReturnCode_t ret;
+    PLAT_UI8 *pArea = NULL;
+    PLAT_UI16 frame_length = 0;
+    PLAT_UI8 contiguous = 1U;
+    PLAT_UI8 i;
+    linux_i2c_bus_t *pBus = linux_i2c_get_bus(busID);
+
+    (void)speed;
+
+    if (pBus == NULL) {
+        return STSE_PLATFORM_BUS_ERR;
+    }
+
+    for (i = 0; i < vector_count; i++) {
+        if (pVector[i].length == 0U) {
+            continue;
+        }
+        if (pVector[i].length > (sizeof(pBus->buffer) - frame_length)) {
+            return STSE_PLATFORM_BUFFER_ERR;
+        }
+        /* - Check that all entries follow each other in the caller memory */
+        if (pVector[i].pData == NULL) {
+            contiguous = 0U;
+        } else if (pArea == NULL) {
+            pArea = pVector[i].pData;
+        } else if (pVector[i].pData != (pArea + frame_length)) {
+            contiguous = 0U;
+        }
+        frame_length += pVector[i].length;
+    }
+
+    if ((contiguous != 0U) && (pArea != NULL)) {
+        /* - Zero-copy : read the frame directly in the caller memory */
+        return linux_i2c_frame_transfer(pBus, devAddr, I2C_M_RD, pArea, frame_length);
+    }
+
+    /* - Read the frame in the bus buffer and scatter it in the vector entries */
+    ret = linux_i2c_frame_transfer(pBus, devAddr, I2C_M_RD, pBus->buffer, frame_length);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+
+    frame_length = 0;
+    for (i = 0; i < vector_count; i++) {
+        if ((pVector[i].pData != NULL) && (pVector[i].length != 0U)) {
+            memcpy(pVector[i].pData, pBus->buffer + frame_length, pVector[i].length);
+        }
+        frame_length += pVector[i].length;
+    }
+
+    return STSE_OK;
+}
+
+#ifdef STSE_USE_IO_LINE_RSP_WAIT
+/**
+ * \brief   Requests the device ready line from a GPIO character device (rising edge events).
+ * \param   pChip_path GPIO chip character device path (e.g. "/dev/gpiochip0").
+ * \param   line_offset Ready line offset on the GPIO chip.
+ * \return  STSE_OK on success, STSE_PLATFORM_BUS_ERR on failure.
+ */
+stse_ReturnCode_t stse_platform_ready_line_init(const char *pChip_path, PLAT_UI32 line_offset)
+{
+    struct gpio_v2_line_request request;
+    int chip_fd;
+    int ret;
+
+    chip_fd = open(pChip_path, O_RDONLY | O_CLOEXEC);
+    if (chip_fd < 0) {
+        return STSE_PLATFORM_BUS_ERR;
+    }
+
+    memset(&request, 0, sizeof(request));
+    request.offsets[0] = line_offset;
+    request.num_lines = 1;
+    request.config.flags = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EDGE_RISING;
+    strncpy(request.consumer, "stse-ready", sizeof(request.consumer) - 1U);
+
+    ret = ioctl(chip_fd, GPIO_V2_GET_LINE_IOCTL, &request);
+    close(chip_fd);
+    if (ret < 0) {
+        return STSE_PLATFORM_BUS_ERR;
+    }
+    linux_ready_line_fd = request.fd;
+
+    return STSE_OK;
+}
+
+/**
+ * \brief   Gets the device ready line state.
+ * \param   busID Identifier for the I2C bus.
+ * \param   devAddr I2C device address.
+ * \return  STSE_OK when the ready line is asserted, STSE_PLATFORM_BUS_ACK_ERROR otherwise.
+ */
+stse_ReturnCode_t stse_platform_ready_line_get(PLAT_UI8 busID, PLAT_UI8 devAddr)
+{
+    struct gpio_v2_line_values values = {.bits = 0, .mask = 1};
+
+    (void)busID;
+    (void)devAddr;
+
+    if (ioctl(linux_ready_line_fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &values) < 0) {
+        return STSE_PLATFORM_BUS_ERR;
+    }
+
+    return ((values.bits & 1U) != 0U) ? STSE_OK : STSE_PLATFORM_BUS_ACK_ERROR;
+}
+
+/**
+ * \brief   Waits for the device ready line assertion.
+ * \param   busID Identifier for the I2C bus.
+ * \param   devAddr I2C device address.
+ * \param   timeout_ms Maximum waiting time in ms.
+ * \param   pWaited_ms Waited time in ms.
+ * \return  STSE_OK when asserted before timeout, STSE_PLATFORM_BUS_RECEIVE_TIMEOUT otherwise.
+ */
+stse_ReturnCode_t stse_platform_ready_line_wait(PLAT_UI8 busID,
+        PLAT_UI8 devAddr,
+        PLAT_UI16 timeout_ms,
+        PLAT_UI16 *pWaited_ms)
+{
+    struct gpio_v2_line_event event;
+    struct pollfd pfd = {.fd = linux_ready_line_fd, .events = POLLIN};
+    struct timespec start, now;
+    int ret;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    /* - Discard edges of previous commands */
+    while (poll(&pfd, 1, 0) > 0) {
+        if (read(linux_ready_line_fd, &event, sizeof(event)) <= 0) {
+            break;
+        }
+    }
+
+    if (stse_platform_ready_line_get(busID, devAddr) == STSE_OK) {
+        *pWaited_ms = 0;
+        return STSE_OK;
+    }
+
+    ret = poll(&pfd, 1, timeout_ms);
+    if (ret > 0) {
+        if (read(linux_ready_line_fd, &event, sizeof(event)) < 0) {
+            ret = 0;
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    *pWaited_ms = (PLAT_UI16)(((now.tv_sec - start.tv_sec) * 1000) + ((now.tv_nsec - start.tv_nsec) / 1000000));
+
+    return (ret > 0) ? STSE_OK : STSE_PLATFORM_BUS_RECEIVE_TIMEOUT;
+}
+#endif /* STSE_USE_IO_LINE_RSP_WAIT */
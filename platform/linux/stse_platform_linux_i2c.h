@@ -0,0 +1,104 @@
+/*!
+ * ******************************************************************************
+ * \file	stse_platform_linux_i2c.h
+ * \brief   STSecureElement I2C and delay platform file for Linux i2c-dev (header)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef STSE_PLATFORM_LINUX_I2C_H
+#define STSE_PLATFORM_LINUX_I2C_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "core/stse_platform.h"
+
+/* Exported functions --------------------------------------------------------*/
+
+/*!
+ * \brief      Send a complete I2C frame described by an I/O vector in a single I2C_RDWR transaction
+ * \details    Application level function to be assigned to the \ref stse_io_t BusSendV callback
+ * \param[in]  busID Identifier for the I2C bus (/dev/i2c-busID)
+ * \param[in]  devAddr I2C device address
+ * \param[in]  speed I2C bus speed
+ * \param[in]  pVector Pointer to the I/O vector entries
+ * \param[in]  vector_count Number of I/O vector entries
+ * \return     \ref STSE_OK on success; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_platform_i2c_send_vectored(PLAT_UI8 busID,
+                                                  PLAT_UI8 devAddr,
+                                                  PLAT_UI16 speed,
+                                                  stse_io_vector_t *pVector,
+                                                  PLAT_UI8 vector_count);
+
+/*!
+ * \brief      Receive a complete I2C frame into the buffers described by an I/O vector in a single I2C_RDWR transaction
+ * \details    Application level function to be assigned to the \ref stse_io_t BusRecvV callback
+ * \param[in]  busID Identifier for the I2C bus (/dev/i2c-busID)
+ * \param[in]  devAddr I2C device address
+ * \param[in]  speed I2C bus speed
+ * \param[in]  pVector Pointer to the I/O vector entries
+ * \param[in]  vector_count Number of I/O vector entries
+ * \return     \ref STSE_OK on success; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_platform_i2c_receive_vectored(PLAT_UI8 busID,
+                                                     PLAT_UI8 devAddr,
+                                                     PLAT_UI16 speed,
+                                                     stse_io_vector_t *pVector,
+                                                     PLAT_UI8 vector_count);
+
+/*!
+ * \brief      Release the I2C bus file descriptor
+ * \param[in]  busID Identifier for the I2C bus (/dev/i2c-busID)
+ */
+void stse_platform_i2c_deinit(PLAT_UI8 busID);
+
+#ifdef STSE_USE_IO_LINE_RSP_WAIT
+/*!
+ * \brief      Request the device ready line from a GPIO character device
+ * \param[in]  pChip_path GPIO chip character device path (e.g. "/dev/gpiochip0")
+ * \param[in]  line_offset Ready line offset on the GPIO chip
+ * \return     \ref STSE_OK on success; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_platform_ready_line_init(const char *pChip_path, PLAT_UI32 line_offset);
+
+/*!
+ * \brief      Get the device ready line state (\ref stse_io_t IOLineReady callback)
+ * \param[in]  busID Identifier for the I2C bus
+ * \param[in]  devAddr I2C device address
+ * \return     \ref STSE_OK when the ready line is asserted; \ref STSE_PLATFORM_BUS_ACK_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_ready_line_get(PLAT_UI8 busID, PLAT_UI8 devAddr);
+
+/*!
+ * \brief      Wait for the device ready line assertion (\ref stse_io_t IOLineWait callback)
+ * \param[in]  busID Identifier for the I2C bus
+ * \param[in]  devAddr I2C device address
+ * \param[in]  timeout_ms Maximum waiting time in ms
+ * \param[out] pWaited_ms Waited time in ms
+ * \return     \ref STSE_OK when asserted before timeout; \ref STSE_PLATFORM_BUS_RECEIVE_TIMEOUT otherwise
+ */
+stse_ReturnCode_t stse_platform_ready_line_wait(PLAT_UI8 busID,
+                                                PLAT_UI8 devAddr,
+                                                PLAT_UI16 timeout_ms,
+                                                PLAT_UI16 *pWaited_ms);
+#endif /* STSE_USE_IO_LINE_RSP_WAIT */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STSE_PLATFORM_LINUX_I2C_H */
@@ -35,7 +35,6 @@
  *  @{
  */
 
-#define STSAFEA_MAC_SIZE 4U
 #define STSAFEA_NONCE_SIZE 13U
 
 /**
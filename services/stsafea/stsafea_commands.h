@@ -47,6 +47,7 @@
 #define STSAFEA_COUNTER_VALUE_SIZE 4U
 #define STSAFEA_GENERIC_LENGTH_SIZE 2U
 #define STSAFEA_UID_SIZE 8U
+#define STSAFEA_MAC_SIZE 4U
 #define STSAFEA_MAX_FRAME_LENGTH_A100 507U
 #define STSAFEA_MAX_FRAME_LENGTH_A110 507U
 #define STSAFEA_MAX_FRAME_LENGTH_A120 752U
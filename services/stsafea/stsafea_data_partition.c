@@ -341,6 +341,86 @@ stse_ReturnCode_t stsafea_read_data_zone(stse_Handler_t *pSTSE,
     return ret;
 }
 
+#ifdef STSE_USE_ZERO_COPY_RSP
+stse_ReturnCode_t stsafea_read_data_zone_view(stse_Handler_t *pSTSE,
+                                              PLAT_UI32 zone_index,
+                                              stsafea_read_option_t option,
+                                              PLAT_UI16 offset,
+                                              PLAT_UI8 **ppRead_data,
+                                              PLAT_UI16 read_length,
+                                              stse_cmd_protection_t protection) {
+    stse_ReturnCode_t ret;
+    PLAT_UI8 cmd_header = STSAFEA_CMD_READ;
+    PLAT_UI8 rsp_header;
+
+    if (pSTSE == NULL) {
+        return STSE_SERVICE_HANDLER_NOT_INITIALISED;
+    }
+
+    if ((ppRead_data == NULL) || (read_length == 0)) {
+        return STSE_SERVICE_INVALID_PARAMETER;
+    }
+
+    if (read_length >= stsafea_maximum_frame_length[pSTSE->device_type]) {
+        return STSE_SERVICE_FRAME_SIZE_ERROR;
+    }
+
+    ret = stsafea_frame_rsp_view_check(pSTSE, cmd_header);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+
+#ifdef STSE_CONF_USE_HOST_SESSION
+    stse_perso_info_t perso_info_backup = pSTSE->perso_info;
+    ret = stsafea_switch_data_partition_access_protection(pSTSE, cmd_header, protection);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+#else
+    (void)protection;
+#endif
+
+    /*- Create CMD frame and populate elements */
+    stse_frame_allocate(CmdFrame);
+    stse_frame_element_allocate_push(&CmdFrame, eCmdHeader, STSAFEA_HEADER_SIZE, &cmd_header);
+    stse_frame_element_allocate_push(&CmdFrame, eOption, STSAFEA_ZONE_ACCESS_OPTION_SIZE, (PLAT_UI8 *)&option);
+    stse_frame_element_allocate_push(&CmdFrame, eZoneIndex, STSAFEA_ZONE_INDEX_SIZE, (PLAT_UI8 *)&zone_index);
+    stse_frame_element_allocate_push(&CmdFrame, eOffset, STSAFEA_ZONE_OFFSET_SIZE, (PLAT_UI8 *)&offset);
+    stse_frame_element_allocate_push(&CmdFrame, eLength, STSAFEA_ZONE_ACCESS_LENGTH_SIZE, (PLAT_UI8 *)&read_length);
+
+    /*- Create Rsp frame and populate elements (data element mapped on the received frame) */
+    stse_frame_allocate(RspFrame);
+    stse_frame_element_allocate_push(&RspFrame, eRsp_header, STSAFEA_HEADER_SIZE, &rsp_header);
+    stse_frame_element_allocate_push(&RspFrame, eData, read_length, NULL);
+
+    /*- Swap Elements byte order before sending*/
+    stse_frame_element_swap_byte_order(&eOffset);
+    stse_frame_element_swap_byte_order(&eLength);
+
+    /*- Perform Transfer*/
+    ret = stsafea_frame_transfer(pSTSE,
+                                 &CmdFrame,
+                                 &RspFrame);
+
+    /*- UnSwap Elements bytes from Command frame*/
+    stse_frame_element_swap_byte_order(&eOffset);
+    stse_frame_element_swap_byte_order(&eLength);
+
+#ifdef STSE_CONF_USE_HOST_SESSION
+    pSTSE->perso_info = perso_info_backup;
+#endif
+
+    if ((ret == STSE_OK) && (eData.pData == NULL)) {
+        ret = STSE_SERVICE_FRAME_SIZE_ERROR;
+    }
+    if (ret == STSE_OK) {
+        *ppRead_data = eData.pData;
+    }
+
+    return ret;
+}
+#endif /* STSE_USE_ZERO_COPY_RSP */
+
 stse_ReturnCode_t stsafea_update_data_zone(stse_Handler_t *pSTSE,
                                            PLAT_UI32 zone_index,
                                            stsafea_update_option_t option,
@@ -191,6 +191,30 @@ stse_ReturnCode_t stsafea_read_data_zone(stse_Handler_t *pSTSE,
                                          PLAT_UI16 read_length,
                                          stse_cmd_protection_t protection);
 
+#ifdef STSE_USE_ZERO_COPY_RSP
+/**
+ * \brief 		Read data zone without copy
+ * \details 	This service formats and sends the read data zone command and returns the read data as a view on the
+ *              received frame (platform zero-copy receive buffer, valid until the next bus transaction)
+ * \param[in] 	pSTSE 			Pointer to STSE Handler
+ * \param[in] 	zone_index		Zone index to read
+ * \param[in] 	option			Read option
+ * \param[in] 	offset			Read offset
+ * \param[out] 	ppRead_data		Pointer to read data view
+ * \param[in] 	read_length		Read length
+ * \param[in] 	protection		Command protection type
+ * \return 		\ref STSE_OK on success ; \ref STSE_SERVICE_INVALID_PARAMETER if the platform does not provide
+ *              zero-copy receive or the response is encrypted ; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stsafea_read_data_zone_view(stse_Handler_t *pSTSE,
+                                              PLAT_UI32 zone_index,
+                                              stsafea_read_option_t option,
+                                              PLAT_UI16 offset,
+                                              PLAT_UI8 **ppRead_data,
+                                              PLAT_UI16 read_length,
+                                              stse_cmd_protection_t protection);
+#endif /* STSE_USE_ZERO_COPY_RSP */
+
 /**
  * \brief 		Update data zone
  * \details 	This service formats and sends the update data zone command
@@ -387,6 +387,65 @@ stse_ReturnCode_t stsafea_ecc_generate_signature(
                                   &RspFrame);
 }
 
+#ifdef STSE_USE_ZERO_COPY_RSP
+stse_ReturnCode_t stsafea_ecc_generate_signature_view(
+    stse_Handler_t *pSTSE,
+    PLAT_UI8 slot_number,
+    stse_ecc_key_type_t key_type,
+    const PLAT_UI8 *pMessage,
+    PLAT_UI16 message_length,
+    PLAT_UI8 **ppSignature_R,
+    PLAT_UI8 **ppSignature_S) {
+    stse_ReturnCode_t ret;
+    PLAT_UI8 cmd_header = STSAFEA_CMD_GENERATE_SIGNATURE;
+    PLAT_UI8 rsp_header;
+
+    /* - Check stsafe handler initialization */
+    if (pSTSE == NULL) {
+        return (STSE_SERVICE_HANDLER_NOT_INITIALISED);
+    }
+
+    if (pMessage == NULL || ppSignature_R == NULL || ppSignature_S == NULL || key_type >= STSE_ECC_KT_INVALID) {
+        return (STSE_SERVICE_INVALID_PARAMETER);
+    }
+
+    ret = stsafea_frame_rsp_view_check(pSTSE, cmd_header);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+
+    stse_frame_allocate(CmdFrame);
+    stse_frame_element_allocate_push(&CmdFrame, eCmd_header, STSAFEA_HEADER_SIZE, &cmd_header);
+    stse_frame_element_allocate_push(&CmdFrame, eSlot_number, STSAFEA_SLOT_NUMBER_ID_SIZE, &slot_number);
+    stse_frame_element_allocate_push(&CmdFrame, eMessage_length, STSAFEA_GENERIC_LENGTH_SIZE, (PLAT_UI8 *)&message_length);
+    stse_frame_element_allocate_push(&CmdFrame, eMessage, message_length, (PLAT_UI8 *)pMessage);
+    stse_frame_element_swap_byte_order(&eMessage_length);
+
+    /* - Signature elements are mapped on the received frame */
+    stse_frame_allocate(RspFrame);
+    stse_frame_element_allocate_push(&RspFrame, eRsp_header, STSAFEA_HEADER_SIZE, &rsp_header);
+    stse_frame_element_allocate_push(&RspFrame, eSignature_R_length, STSE_ECC_GENERIC_LENGTH_SIZE, NULL);
+    stse_frame_element_allocate_push(&RspFrame, eSignature_R, (stse_ecc_info_table[key_type].signature_size >> 1), NULL);
+    stse_frame_element_allocate_push(&RspFrame, eSignature_S_length, STSE_ECC_GENERIC_LENGTH_SIZE, NULL);
+    stse_frame_element_allocate_push(&RspFrame, eSignature_S, (stse_ecc_info_table[key_type].signature_size >> 1), NULL);
+
+    /* - Perform Transfer*/
+    ret = stsafea_frame_transfer(pSTSE,
+                                 &CmdFrame,
+                                 &RspFrame);
+
+    if ((ret == STSE_OK) && ((eSignature_R.pData == NULL) || (eSignature_S.pData == NULL))) {
+        ret = STSE_SERVICE_FRAME_SIZE_ERROR;
+    }
+    if (ret == STSE_OK) {
+        *ppSignature_R = eSignature_R.pData;
+        *ppSignature_S = eSignature_S.pData;
+    }
+
+    return ret;
+}
+#endif /* STSE_USE_ZERO_COPY_RSP */
+
 stse_ReturnCode_t stsafea_ecc_establish_shared_secret(
     stse_Handler_t *pSTSE,
     PLAT_UI8 private_key_slot_number,
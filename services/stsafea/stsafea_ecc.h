@@ -128,6 +128,31 @@ stse_ReturnCode_t stsafea_ecc_generate_signature(
     PLAT_UI16 message_length,
     PLAT_UI8 *pSignature);
 
+#ifdef STSE_USE_ZERO_COPY_RSP
+/**
+ * \brief 		Generate a signature without copy
+ * \details 	This service formats and send/receive STSAFE-Axxx generate signature command/response and returns
+ *              the R and S components as views on the received frame (valid until the next bus transaction)
+ * \param[in] 	pSTSE 					Pointer to STSE Handler
+ * \param[in] 	slot_number				Slot to identify used private key
+ * \param[in] 	key_type 				Private key type
+ * \param[in] 	pMessage 				Message used in signature
+ * \param[in] 	message_length 			Message length
+ * \param[out] 	ppSignature_R 			Pointer to signature R component view
+ * \param[out] 	ppSignature_S 			Pointer to signature S component view
+ * \return \ref STSE_OK on success ; \ref STSE_SERVICE_INVALID_PARAMETER if the platform does not provide zero-copy
+ *         receive or the response is encrypted ; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stsafea_ecc_generate_signature_view(
+    stse_Handler_t *pSTSE,
+    PLAT_UI8 slot_number,
+    stse_ecc_key_type_t key_type,
+    const PLAT_UI8 *pMessage,
+    PLAT_UI16 message_length,
+    PLAT_UI8 **ppSignature_R,
+    PLAT_UI8 **ppSignature_S);
+#endif /* STSE_USE_ZERO_COPY_RSP */
+
 /**
  * \brief 		Establish shared secret using ECDH
  * \details 	This service performs ECDH key agreement to establish a shared secret
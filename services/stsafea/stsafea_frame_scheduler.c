@@ -0,0 +1,128 @@
+/*!
+ ******************************************************************************
+ * \file	stsafea_frame_scheduler.c
+ * \brief   STSAFE-A services for multi-device frame scheduling (source)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <stddef.h>
+
+#include "services/stsafea/stsafea_frame_scheduler.h"
+
+#if defined(STSE_CONF_STSAFE_A_SUPPORT) && defined(STSE_CONF_USE_ASYNC_TRANSFER)
+
+static PLAT_UI8 stsafea_frame_scheduler_device_ready(stsafea_scheduled_transfer_t *pTransfers,
+                                                     PLAT_UI8 index) {
+    PLAT_UI8 i;
+
+    /* - Device is ready when all previous transfers to the same handler are completed */
+    for (i = 0; i < index; i++) {
+        if ((pTransfers[i].pSTSE == pTransfers[index].pSTSE) &&
+            (pTransfers[i].status == STSE_SERVICE_TRANSFER_PENDING)) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+stse_ReturnCode_t stsafea_frame_scheduler_run(stsafea_scheduled_transfer_t *pTransfers,
+                                              PLAT_UI8 transfer_count) {
+    stse_ReturnCode_t ret = STSE_OK;
+    PLAT_UI8 remaining_count = transfer_count;
+    PLAT_UI8 in_flight;
+    PLAT_UI16 delay;
+    PLAT_UI8 i;
+
+    /*- Verify Parameters */
+    if ((pTransfers == NULL) || (transfer_count == 0)) {
+        return STSE_SERVICE_INVALID_PARAMETER;
+    }
+
+    for (i = 0; i < transfer_count; i++) {
+        pTransfers[i].status = STSE_SERVICE_TRANSFER_PENDING;
+        pTransfers[i].transfer.state = STSAFEA_TRANSFER_IDLE;
+    }
+
+    while (remaining_count != 0) {
+        /* - Send next command to each idle device */
+        for (i = 0; i < transfer_count; i++) {
+            if ((pTransfers[i].status == STSE_SERVICE_TRANSFER_PENDING) &&
+                (pTransfers[i].transfer.state == STSAFEA_TRANSFER_IDLE) &&
+                stsafea_frame_scheduler_device_ready(pTransfers, i)) {
+                ret = stsafea_frame_transfer_submit(pTransfers[i].pSTSE,
+                                                    &pTransfers[i].transfer,
+                                                    pTransfers[i].pCmdFrame,
+                                                    pTransfers[i].pRspFrame,
+                                                    NULL,
+                                                    NULL);
+                if (ret != STSE_OK) {
+                    pTransfers[i].status = ret;
+                    remaining_count--;
+                } else {
+                    pTransfers[i].wait_time = pTransfers[i].transfer.processing_time;
+                }
+            }
+        }
+
+        /* - Wait for the nearest expected response */
+        in_flight = 0;
+        delay = 0xFFFF;
+        for (i = 0; i < transfer_count; i++) {
+            if (pTransfers[i].transfer.state == STSAFEA_TRANSFER_PENDING) {
+                in_flight = 1;
+                if (pTransfers[i].wait_time < delay) {
+                    delay = pTransfers[i].wait_time;
+                }
+            }
+        }
+        if (in_flight == 0) {
+            continue;
+        }
+        if (delay != 0) {
+            stse_platform_Delay_ms(delay);
+        }
+
+        /* - Collect available responses */
+        for (i = 0; i < transfer_count; i++) {
+            if (pTransfers[i].transfer.state != STSAFEA_TRANSFER_PENDING) {
+                continue;
+            }
+            pTransfers[i].wait_time -= delay;
+            if (pTransfers[i].wait_time != 0) {
+                continue;
+            }
+            ret = stsafea_frame_transfer_poll(&pTransfers[i].transfer);
+            if (ret == STSE_SERVICE_TRANSFER_PENDING) {
+                pTransfers[i].wait_time = pTransfers[i].transfer.poll_interval;
+            } else {
+                pTransfers[i].status = ret;
+                remaining_count--;
+            }
+        }
+    }
+
+    /* - Report first failing transfer status */
+    ret = STSE_OK;
+    for (i = 0; i < transfer_count; i++) {
+        if (pTransfers[i].status != STSE_OK) {
+            ret = pTransfers[i].status;
+            break;
+        }
+    }
+
+    return ret;
+}
+
+#endif /* STSE_CONF_STSAFE_A_SUPPORT && STSE_CONF_USE_ASYNC_TRANSFER */
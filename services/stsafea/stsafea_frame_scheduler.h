@@ -0,0 +1,68 @@
+/*!
+ ******************************************************************************
+ * \file	stsafea_frame_scheduler.h
+ * \brief   STSAFE-A services for multi-device frame scheduling (header)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef STSAFEA_FRAME_SCHEDULER_H
+#define STSAFEA_FRAME_SCHEDULER_H
+
+#include "core/stse_device.h"
+#include "core/stse_frame.h"
+#include "core/stse_platform.h"
+#include "core/stse_return_codes.h"
+#include "core/stse_util.h"
+#include "services/stsafea/stsafea_frame_transfer.h"
+
+/*! \defgroup stsafea_frame_scheduler STSAFE-A Frame scheduler
+ *  \ingroup stsafea_services
+ *  @{
+ */
+
+#ifdef STSE_CONF_USE_ASYNC_TRANSFER
+
+/*!
+ * \brief STSAFE-A scheduled transfer
+ * \details Entry of the transfer list processed by \ref stsafea_frame_scheduler_run
+ */
+typedef struct stsafea_scheduled_transfer_t {
+    stse_Handler_t *pSTSE;       /*!< Target STSE handler */
+    stse_frame_t *pCmdFrame;     /*!< Command frame */
+    stse_frame_t *pRspFrame;     /*!< Response frame */
+    stse_ReturnCode_t status;    /*!< Transfer status (output) */
+    PLAT_UI16 wait_time;         /*!< Remaining delay before next response poll in ms (internal) */
+    stsafea_transfer_t transfer; /*!< Asynchronous transfer context (internal) */
+} stsafea_scheduled_transfer_t;
+
+/**
+ * \brief 		Run a list of frame transfers on one or several target STSAFE-Axxx
+ * \details 	This service interleaves the transmit and receive phases of transfers addressed to different
+ *              target devices (i.e. different handlers, possibly sharing the same bus) : a command is sent to
+ *              each idle device and the bus is then only used to collect responses once each command expected
+ *              processing time has elapsed. Transfers addressed to the same handler are performed sequentially
+ *              in list order.
+ * \param[in,out] pTransfers 		Pointer to the scheduled transfer list
+ * \param[in] 	transfer_count 		Number of entries in the transfer list
+ * \return 		\ref STSE_OK if all transfers succeed ; status of the first failing entry otherwise
+ *              (status of each transfer is reported in its entry)
+ */
+stse_ReturnCode_t stsafea_frame_scheduler_run(stsafea_scheduled_transfer_t *pTransfers,
+                                              PLAT_UI8 transfer_count);
+
+#endif /* STSE_CONF_USE_ASYNC_TRANSFER */
+
+/** \}*/
+
+#endif /* STSAFEA_FRAME_SCHEDULER_H */
@@ -19,7 +19,11 @@
 /* Includes ------------------------------------------------------------------*/
 #include <stddef.h>
 #include <stdio.h>
+#include <string.h>
 
+#include "core/stse_cmd_metrics.h"
+#include "core/stse_frame_trace.h"
+#include "core/stse_retry.h"
 #include "services/stsafea/stsafea_commands.h"
 #include "services/stsafea/stsafea_frame_transfer.h"
 #include "services/stsafea/stsafea_sessions.h"
@@ -27,17 +31,29 @@
 
 #ifdef STSE_CONF_STSAFE_A_SUPPORT
 
+/* - Command transfer parameters resolved from command header */
+typedef struct stsafea_frame_cmd_info_t {
+    PLAT_UI16 inter_frame_delay; /*!< Command processing time (ms) */
+#ifdef STSE_CONF_USE_HOST_SESSION
+    stse_cmd_access_conditions_t cmd_ac_info; /*!< Command access conditions */
+    PLAT_UI8 cmd_encryption_flag;             /*!< Command encryption flag */
+    PLAT_UI8 rsp_encryption_flag;             /*!< Response encryption flag */
+#endif                                        /* STSE_CONF_USE_HOST_SESSION */
+} stsafea_frame_cmd_info_t;
+
 const PLAT_UI16 stsafea_maximum_frame_length[STSAFEA_PRODUCT_COUNT] = {
     STSAFEA_MAX_FRAME_LENGTH_A100,
     STSAFEA_MAX_FRAME_LENGTH_A110,
     STSAFEA_MAX_FRAME_LENGTH_A120};
 
-stse_ReturnCode_t stsafea_frame_transmit(stse_Handler_t *pSTSE, stse_frame_t *pFrame) {
+static stse_ReturnCode_t stsafea_frame_send(stse_Handler_t *pSTSE, stse_frame_t *pFrame) {
     stse_ReturnCode_t ret = STSE_PLATFORM_BUS_ACK_ERROR;
-    PLAT_UI16 retry_count = STSE_MAX_POLLING_RETRY;
+    stse_retry_t retry;
     stse_frame_element_t *pCurrent_element;
     PLAT_UI16 crc_ret;
     PLAT_UI8 crc[STSE_FRAME_CRC_SIZE] = {0};
+    PLAT_UI8 crc_on_the_fly = 0;
+    PLAT_UI8 vectored_send;
 
     /*- Verify Parameters */
     if ((pSTSE == NULL) || (pFrame == NULL)) {
@@ -59,13 +75,21 @@ stse_ReturnCode_t stsafea_frame_transmit(stse_Handler_t *pSTSE, stse_frame_t *pF
     if (pFrame->length > stsafea_maximum_frame_length[pSTSE->device_type - STSE_DEVICE_STSAFEA_FAMILY_INDEX]) {
         return STSE_SERVICE_FRAME_SIZE_ERROR;
     }
-    /*- Compute frame crc */
-    ret = stse_frame_crc16_compute(pFrame, &crc_ret);
-    if (ret != STSE_OK) {
-        return ret;
+    /*- Send frame elements and CRC in a single bus transaction when supported (bounded I/O vector) */
+    vectored_send = ((pSTSE->io.BusSendV != NULL) && ((pFrame->element_count + 1U) <= STSE_CONF_FRAME_MAX_ELEMENT_COUNT));
+#if defined(STSE_USE_INCREMENTAL_CRC) && !defined(STSE_FRAME_DEBUG_LOG)
+    /*- Compute frame crc while sending frame elements (not applicable to vectored send) */
+    crc_on_the_fly = (vectored_send == 0);
+#endif /* STSE_USE_INCREMENTAL_CRC && !STSE_FRAME_DEBUG_LOG */
+    if (crc_on_the_fly == 0) {
+        /*- Compute frame crc */
+        ret = stse_frame_crc16_compute(pFrame, &crc_ret);
+        if (ret != STSE_OK) {
+            return ret;
+        }
+        crc[0] = (crc_ret >> 8) & 0xFF;
+        crc[1] = crc_ret & 0xFF;
     }
-    crc[0] = (crc_ret >> 8) & 0xFF;
-    crc[1] = crc_ret & 0xFF;
 
     /* - Append CRC element to the RSP Frame (valid only on Receive Scope) */
     stse_frame_element_allocate(crc_element, STSE_FRAME_CRC_SIZE, crc);
@@ -77,17 +101,38 @@ stse_ReturnCode_t stsafea_frame_transmit(stse_Handler_t *pSTSE, stse_frame_t *pF
     printf("\n\r");
 #endif /* STSE_FRAME_DEBUG_LOG */
 
-    ret = STSE_PLATFORM_BUS_ACK_ERROR;
-    while ((retry_count != 0) && (ret == STSE_PLATFORM_BUS_ACK_ERROR)) {
-        ret = pSTSE->io.BusSendStart(
-            pSTSE->io.busID,
-            pSTSE->io.Devaddr,
-            pSTSE->io.BusSpeed,
-            pFrame->length);
+    stse_retry_init(pSTSE, &retry, STSE_MAX_POLLING_RETRY);
+    do {
+        if (vectored_send != 0) {
+            /* - Describe frame elements as bus I/O vector and send the whole frame in a single bus transaction */
+            stse_io_vector_t io_vector[STSE_CONF_FRAME_MAX_ELEMENT_COUNT];
+            ret = pSTSE->io.BusSendV(
+                pSTSE->io.busID,
+                pSTSE->io.Devaddr,
+                pSTSE->io.BusSpeed,
+                io_vector,
+                stse_frame_io_vector_fill(pFrame, pFrame->first_element, io_vector));
+        } else {
+            ret = pSTSE->io.BusSendStart(
+                pSTSE->io.busID,
+                pSTSE->io.Devaddr,
+                pSTSE->io.BusSpeed,
+                pFrame->length);
+        }
 
-        if (ret == STSE_OK) {
+        if ((ret == STSE_OK) && (vectored_send == 0)) {
             pCurrent_element = pFrame->first_element;
             while (pCurrent_element != pFrame->last_element) {
+                if (crc_on_the_fly != 0) {
+                    /*- Fold element in frame crc */
+                    ret = stse_frame_crc16_accumulate(pCurrent_element->pData,
+                                                      pCurrent_element->length,
+                                                      (pCurrent_element == pFrame->first_element),
+                                                      &crc_ret);
+                    if (ret != STSE_OK) {
+                        break;
+                    }
+                }
                 ret = pSTSE->io.BusSendContinue(
                     pSTSE->io.busID,
                     pSTSE->io.Devaddr,
@@ -99,6 +144,10 @@ stse_ReturnCode_t stsafea_frame_transmit(stse_Handler_t *pSTSE, stse_frame_t *pF
                 }
                 pCurrent_element = pCurrent_element->next;
             }
+            if ((ret == STSE_OK) && (crc_on_the_fly != 0)) {
+                crc[0] = (crc_ret >> 8) & 0xFF;
+                crc[1] = crc_ret & 0xFF;
+            }
             if (ret == STSE_OK) {
                 ret = pSTSE->io.BusSendStop(
                     pSTSE->io.busID,
@@ -108,99 +157,404 @@ stse_ReturnCode_t stsafea_frame_transmit(stse_Handler_t *pSTSE, stse_frame_t *pF
                     pCurrent_element->length);
             }
         }
-
-        if (ret != STSE_OK) {
-            retry_count--;
-            stse_platform_Delay_ms(STSE_POLLING_RETRY_INTERVAL);
-        }
-    }
+    } while ((ret == STSE_PLATFORM_BUS_ACK_ERROR) && (stse_retry_wait(pSTSE, &retry) != 0));
 
     /* - Pop CRC element from Frame*/
     stse_frame_pop_element(pFrame);
+
+#ifdef STSE_FRAME_TRACE
+    stse_frame_trace_record(pSTSE, STSE_FRAME_TRACE_CMD, pFrame, ret);
+#endif /* STSE_FRAME_TRACE */
+
     return ret;
 }
 
-stse_ReturnCode_t stsafea_frame_receive(stse_Handler_t *pSTSE, stse_frame_t *pFrame) {
-    stse_ReturnCode_t ret = STSE_PLATFORM_BUS_ACK_ERROR;
-    stse_frame_element_t *pCurrent_element;
-    PLAT_UI8 received_header;
-    PLAT_UI16 received_length;
-    PLAT_UI8 received_crc[STSE_FRAME_CRC_SIZE];
-    PLAT_UI16 computed_crc;
-    PLAT_UI16 filler_size = 0;
-    PLAT_UI16 retry_count = STSE_MAX_POLLING_RETRY;
-    PLAT_UI8 length_value[STSE_FRAME_LENGTH_SIZE];
+stse_ReturnCode_t stsafea_frame_transmit(stse_Handler_t *pSTSE, stse_frame_t *pFrame) {
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+    stse_ReturnCode_t ret;
 
-    /*- Verify Parameters */
-    if ((pSTSE == NULL) || (pFrame == NULL)) {
-        return STSE_SERVICE_INVALID_PARAMETER;
-    }
-    /* - Verify Frame length */
-    if (pFrame->element_count == 0) {
-        return (STSE_SERVICE_INVALID_PARAMETER);
-    }
-    /* - Verify First Frame Element */
-    if ((pFrame->first_element == NULL) || (pFrame->first_element->pData == NULL) || (pFrame->first_element->length != STSE_RSP_FRAME_HEADER_SIZE)) {
-        return (STSE_SERVICE_INVALID_PARAMETER);
+    ret = stse_bus_lock(pSTSE);
+    if (ret != STSE_OK) {
+        return ret;
     }
-    /* - Verify Device type */
-    if (pSTSE->device_type >= (STSE_DEVICE_STSAFEA_FAMILY_INDEX + STSAFEA_PRODUCT_COUNT)) {
-        return STSE_SERVICE_INVALID_PARAMETER;
+
+    ret = stsafea_frame_send(pSTSE, pFrame);
+
+    stse_bus_unlock(pSTSE);
+
+    return ret;
+#else
+    return stsafea_frame_send(pSTSE, pFrame);
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
+}
+
+static void stsafea_frame_fit_to_length(stse_frame_t *pFrame, PLAT_UI16 payload_length) {
+    stse_frame_element_t *pCurrent_element = pFrame->first_element->next;
+
+    /* - Truncate payload elements (last element excluded) to the payload length */
+    while (pCurrent_element != pFrame->last_element) {
+        if (payload_length < pCurrent_element->length) {
+            pCurrent_element->length = payload_length;
+        }
+        payload_length -= pCurrent_element->length;
+        pCurrent_element = pCurrent_element->next;
     }
+}
 
-    /* ================================================================================= */
-    /* ============== Get the total frame length + 2 bytes (potential CRC) ============= */
-    while ((retry_count != 0) && (ret == STSE_PLATFORM_BUS_ACK_ERROR)) {
-        /* - Receive frame length from target STSAFE */
-        ret = pSTSE->io.BusRecvStart(
+#ifdef STSE_USE_SPECULATIVE_RSP_READ
+static stse_ReturnCode_t stsafea_frame_speculative_read(stse_Handler_t *pSTSE,
+                                                        stse_frame_t *pFrame,
+                                                        PLAT_UI8 *pLength_value) {
+    stse_ReturnCode_t ret;
+    stse_frame_element_t *pCurrent_element;
+    PLAT_UI8 vector_count;
+
+    if ((pSTSE->io.BusRecvV != NULL) && ((pFrame->element_count + 1U) <= STSE_CONF_FRAME_MAX_ELEMENT_COUNT)) {
+        stse_io_vector_t io_vector[STSE_CONF_FRAME_MAX_ELEMENT_COUNT];
+
+        /* - Describe response header, length and expected frame elements as bus I/O vector */
+        io_vector[0].pData = pFrame->first_element->pData;
+        io_vector[0].length = STSE_RSP_FRAME_HEADER_SIZE;
+        io_vector[1].pData = pLength_value;
+        io_vector[1].length = STSE_FRAME_LENGTH_SIZE;
+        vector_count = 2 + stse_frame_io_vector_fill(pFrame, pFrame->first_element->next, &io_vector[2]);
+
+        return pSTSE->io.BusRecvV(
             pSTSE->io.busID,
             pSTSE->io.Devaddr,
             pSTSE->io.BusSpeed,
-            STSE_FRAME_LENGTH_SIZE + STSE_RSP_FRAME_HEADER_SIZE + STSE_FRAME_CRC_SIZE);
-
-        if (ret != STSE_OK) {
-            retry_count--;
-            stse_platform_Delay_ms(STSE_POLLING_RETRY_INTERVAL);
-        }
+            io_vector,
+            vector_count);
     }
 
-    /* - Verify correct reception*/
+    ret = pSTSE->io.BusRecvStart(
+        pSTSE->io.busID,
+        pSTSE->io.Devaddr,
+        pSTSE->io.BusSpeed,
+        STSE_FRAME_LENGTH_SIZE + pFrame->length);
     if (ret != STSE_OK) {
         return ret;
     }
 
-    /* Discard response header */
+    /* - Receive response header */
     ret = pSTSE->io.BusRecvContinue(
         pSTSE->io.busID,
         pSTSE->io.Devaddr,
         pSTSE->io.BusSpeed,
-        &received_header,
+        pFrame->first_element->pData,
         STSE_RSP_FRAME_HEADER_SIZE);
     if (ret != STSE_OK) {
         return ret;
     }
 
-    /* - Get STSAFE Response Length */
+    /* - Receive response length */
     ret = pSTSE->io.BusRecvContinue(
         pSTSE->io.busID,
         pSTSE->io.Devaddr,
         pSTSE->io.BusSpeed,
-        length_value,
+        pLength_value,
         STSE_FRAME_LENGTH_SIZE);
     if (ret != STSE_OK) {
         return ret;
     }
 
-    /* - Get STSAFE Response Potential CRC */
-    ret = pSTSE->io.BusRecvStop(
+    /* - Receive expected frame elements */
+    pCurrent_element = pFrame->first_element->next;
+    while (pCurrent_element != pFrame->last_element) {
+        ret = pSTSE->io.BusRecvContinue(
+            pSTSE->io.busID,
+            pSTSE->io.Devaddr,
+            pSTSE->io.BusSpeed,
+            pCurrent_element->pData,
+            pCurrent_element->length);
+        if (ret != STSE_OK) {
+            return ret;
+        }
+        pCurrent_element = pCurrent_element->next;
+    }
+
+    return pSTSE->io.BusRecvStop(
         pSTSE->io.busID,
         pSTSE->io.Devaddr,
         pSTSE->io.BusSpeed,
-        received_crc,
-        STSE_FRAME_CRC_SIZE);
+        pCurrent_element->pData,
+        pCurrent_element->length);
+}
+
+static PLAT_UI8 stsafea_frame_speculative_crc_get(stse_frame_t *pFrame,
+                                                  PLAT_UI16 crc_offset,
+                                                  PLAT_UI8 *pCrc) {
+    stse_frame_element_t *pCurrent_element = pFrame->first_element->next;
+    PLAT_UI8 crc[STSE_FRAME_CRC_SIZE];
+    PLAT_UI8 crc_index = 0;
+
+    /* - Locate CRC bytes in the payload elements received after the response header */
+    while (crc_index < STSE_FRAME_CRC_SIZE) {
+        if (crc_offset < pCurrent_element->length) {
+            if (pCurrent_element->pData == NULL) {
+                return 0;
+            }
+            crc[crc_index++] = pCurrent_element->pData[crc_offset++];
+        } else {
+            if (pCurrent_element == pFrame->last_element) {
+                /* Response is longer than expected */
+                return 0;
+            }
+            crc_offset -= pCurrent_element->length;
+            pCurrent_element = pCurrent_element->next;
+        }
+    }
+
+    pCrc[0] = crc[0];
+    pCrc[1] = crc[1];
+
+    return 1;
+}
+
+static PLAT_UI8 stsafea_frame_speculative_allowed(stse_frame_t *pFrame) {
+    stse_frame_element_t *pCurrent_element = pFrame->first_element->next;
+    stse_frame_element_t *pOther_element;
+
+    /* - Reject frames whose payload elements share a buffer (filler bytes read past
+     *   the end of a shorter response would overwrite the bytes already received) */
+    while (pCurrent_element != NULL) {
+        pOther_element = pCurrent_element->next;
+        while ((pCurrent_element->pData != NULL) && (pOther_element != NULL)) {
+            if (pOther_element->pData == pCurrent_element->pData) {
+                return 0;
+            }
+            pOther_element = pOther_element->next;
+        }
+        pCurrent_element = pCurrent_element->next;
+    }
+
+    return 1;
+}
+#endif /* STSE_USE_SPECULATIVE_RSP_READ */
+
+#ifdef STSE_USE_ZERO_COPY_RSP
+static stse_ReturnCode_t stsafea_frame_zero_copy_receive(stse_Handler_t *pSTSE,
+                                                         stse_frame_t *pFrame,
+                                                         PLAT_UI16 received_length,
+                                                         PLAT_UI16 *pComputed_crc) {
+    stse_ReturnCode_t ret = STSE_PLATFORM_BUS_ACK_ERROR;
+    stse_frame_element_t *pCurrent_element;
+    stse_retry_t retry;
+    PLAT_UI8 *pReceived_frame = NULL;
+    PLAT_UI16 offset = STSE_RSP_FRAME_HEADER_SIZE + STSE_FRAME_LENGTH_SIZE;
+
+    /* - Fit frame elements (CRC excluded) to the received response length */
+    stsafea_frame_fit_to_length(pFrame, received_length - STSE_RSP_FRAME_HEADER_SIZE);
+
+    /* - Receive the whole frame in the driver buffer */
+    stse_retry_init(pSTSE, &retry, STSE_MAX_POLLING_RETRY);
+    do {
+        ret = pSTSE->io.BusRecvFrame(
+            pSTSE->io.busID,
+            pSTSE->io.Devaddr,
+            pSTSE->io.BusSpeed,
+            STSE_FRAME_LENGTH_SIZE + received_length + STSE_FRAME_CRC_SIZE,
+            &pReceived_frame);
+    } while ((ret == STSE_PLATFORM_BUS_ACK_ERROR) && (stse_retry_wait(pSTSE, &retry) != 0));
+    if (ret != STSE_OK) {
+        return ret;
+    }
+    if (pReceived_frame == NULL) {
+        return STSE_PLATFORM_BUS_ERR;
+    }
+
+    /* - Copy response header , map payload elements without buffer on the received frame (views) and copy others */
+    pFrame->first_element->pData[0] = pReceived_frame[0];
+    pCurrent_element = pFrame->first_element->next;
+    while (pCurrent_element != pFrame->last_element) {
+        if (pCurrent_element->pData == NULL) {
+            pCurrent_element->pData = &pReceived_frame[offset];
+        } else if (pCurrent_element->length != 0) {
+            memcpy(pCurrent_element->pData, &pReceived_frame[offset], pCurrent_element->length);
+        }
+        offset += pCurrent_element->length;
+        pCurrent_element = pCurrent_element->next;
+    }
+    memcpy(pCurrent_element->pData, &pReceived_frame[STSE_FRAME_LENGTH_SIZE + received_length], STSE_FRAME_CRC_SIZE);
+
+    /* - Compute CRC over the contiguous response header and payload */
+    ret = stse_frame_crc16_accumulate(pReceived_frame, STSE_RSP_FRAME_HEADER_SIZE, 1, pComputed_crc);
+    if (ret == STSE_OK) {
+        ret = stse_frame_crc16_accumulate(&pReceived_frame[STSE_RSP_FRAME_HEADER_SIZE + STSE_FRAME_LENGTH_SIZE],
+                                          received_length - STSE_RSP_FRAME_HEADER_SIZE,
+                                          0,
+                                          pComputed_crc);
+    }
+
+    return ret;
+}
+
+stse_ReturnCode_t stsafea_frame_rsp_view_check(stse_Handler_t *pSTSE, PLAT_UI8 cmd_header) {
+    PLAT_UI8 rsp_encryption_flag = 0;
+
+    if ((pSTSE == NULL) || (pSTSE->io.BusRecvFrame == NULL)) {
+        return STSE_SERVICE_INVALID_PARAMETER;
+    }
+
+    /* - Encrypted responses are decrypted in caller buffers */
+    stsafea_perso_info_get_rsp_encrypt_flag(&pSTSE->perso_info, cmd_header, &rsp_encryption_flag);
+    if (rsp_encryption_flag != 0) {
+        return STSE_SERVICE_INVALID_PARAMETER;
+    }
+
+    return STSE_OK;
+}
+#endif /* STSE_USE_ZERO_COPY_RSP */
+
+static stse_ReturnCode_t stsafea_frame_vectored_receive(stse_Handler_t *pSTSE,
+                                                        stse_frame_t *pFrame,
+                                                        PLAT_UI16 received_length) {
+    stse_ReturnCode_t ret = STSE_PLATFORM_BUS_ACK_ERROR;
+    stse_retry_t retry;
+    stse_io_vector_t io_vector[STSE_CONF_FRAME_MAX_ELEMENT_COUNT];
+    PLAT_UI8 vector_count;
+
+    /* - Fit frame elements (CRC excluded) to the received response length */
+    stsafea_frame_fit_to_length(pFrame, received_length - STSE_RSP_FRAME_HEADER_SIZE);
+
+    /* - Describe response header, discarded length and frame elements as bus I/O vector */
+    io_vector[0].pData = pFrame->first_element->pData;
+    io_vector[0].length = STSE_RSP_FRAME_HEADER_SIZE;
+    io_vector[1].pData = NULL;
+    io_vector[1].length = STSE_FRAME_LENGTH_SIZE;
+    vector_count = 2 + stse_frame_io_vector_fill(pFrame, pFrame->first_element->next, &io_vector[2]);
+
+    stse_retry_init(pSTSE, &retry, STSE_MAX_POLLING_RETRY);
+    do {
+        ret = pSTSE->io.BusRecvV(
+            pSTSE->io.busID,
+            pSTSE->io.Devaddr,
+            pSTSE->io.BusSpeed,
+            io_vector,
+            vector_count);
+    } while ((ret == STSE_PLATFORM_BUS_ACK_ERROR) && (stse_retry_wait(pSTSE, &retry) != 0));
+
+    return ret;
+}
+
+static stse_ReturnCode_t stsafea_frame_receive_attempt(stse_Handler_t *pSTSE,
+                                                       stse_frame_t *pFrame,
+                                                       PLAT_UI8 *pRsp_ready) {
+    stse_ReturnCode_t ret = STSE_PLATFORM_BUS_ACK_ERROR;
+    stse_frame_element_t *pCurrent_element;
+    PLAT_UI8 received_header;
+    PLAT_UI16 received_length;
+    PLAT_UI8 received_crc[STSE_FRAME_CRC_SIZE];
+    PLAT_UI16 computed_crc;
+    PLAT_UI16 filler_size = 0;
+    stse_retry_t retry;
+    PLAT_UI8 length_value[STSE_FRAME_LENGTH_SIZE];
+    PLAT_UI8 frame_received = 0;
+    PLAT_UI8 crc_accumulated = 0;
+
+    *pRsp_ready = 0;
+
+#ifdef STSE_USE_SPECULATIVE_RSP_READ
+    /* ================================================================================= */
+    /* ====== Speculative read of the expected response in a single bus transaction ==== */
+
+#ifdef STSE_USE_ZERO_COPY_RSP
+    if ((pSTSE->io.BusRecvFrame == NULL) && (stsafea_frame_speculative_allowed(pFrame) != 0)) {
+#else
+    if (stsafea_frame_speculative_allowed(pFrame) != 0) {
+#endif /* STSE_USE_ZERO_COPY_RSP */
+        /* - Append potential CRC element to the RSP Frame (valid only in Receive Scope) */
+        stse_frame_element_allocate_push(pFrame, eSpeculative_crc, STSE_FRAME_CRC_SIZE, received_crc);
+
+        ret = stsafea_frame_speculative_read(pSTSE, pFrame, length_value);
+
+        if (ret == STSE_OK) {
+            received_header = pFrame->first_element->pData[0];
+            received_length = (length_value[0] << 8) + length_value[1];
+            /* - Retrieve CRC when response length fits the expected one (fallback to two-phase read otherwise) */
+            if (received_length >= STSE_FRAME_CRC_SIZE) {
+                frame_received = stsafea_frame_speculative_crc_get(pFrame,
+                                                                   received_length - STSE_FRAME_CRC_SIZE,
+                                                                   received_crc);
+            }
+        }
+
+        /* - Pop potential CRC element from Frame*/
+        stse_frame_pop_element(pFrame);
+
+        /* - Response not available yet */
+        if (ret != STSE_OK) {
+            return ret;
+        }
+    }
+#endif /* STSE_USE_SPECULATIVE_RSP_READ */
+
+    /* ================================================================================= */
+    /* ============== Get the total frame length + 2 bytes (potential CRC) ============= */
+    stse_io_vector_t length_vector[] = {
+        {&received_header, STSE_RSP_FRAME_HEADER_SIZE},
+        {length_value, STSE_FRAME_LENGTH_SIZE},
+        {received_crc, STSE_FRAME_CRC_SIZE}};
+
+    if (frame_received == 0) {
+        if (pSTSE->io.BusRecvV != NULL) {
+            /* - Receive response header, frame length and potential CRC in a single bus transaction */
+            ret = pSTSE->io.BusRecvV(
+                pSTSE->io.busID,
+                pSTSE->io.Devaddr,
+                pSTSE->io.BusSpeed,
+                length_vector,
+                sizeof(length_vector) / sizeof(length_vector[0]));
+        } else {
+            /* - Receive frame length from target STSAFE */
+            ret = pSTSE->io.BusRecvStart(
+                pSTSE->io.busID,
+                pSTSE->io.Devaddr,
+                pSTSE->io.BusSpeed,
+                STSE_FRAME_LENGTH_SIZE + STSE_RSP_FRAME_HEADER_SIZE + STSE_FRAME_CRC_SIZE);
+        }
+    }
+
+    /* - Verify correct reception*/
     if (ret != STSE_OK) {
         return ret;
     }
+    *pRsp_ready = 1;
+
+    if ((frame_received == 0) && (pSTSE->io.BusRecvV == NULL)) {
+        /* Discard response header */
+        ret = pSTSE->io.BusRecvContinue(
+            pSTSE->io.busID,
+            pSTSE->io.Devaddr,
+            pSTSE->io.BusSpeed,
+            &received_header,
+            STSE_RSP_FRAME_HEADER_SIZE);
+        if (ret != STSE_OK) {
+            return ret;
+        }
+
+        /* - Get STSAFE Response Length */
+        ret = pSTSE->io.BusRecvContinue(
+            pSTSE->io.busID,
+            pSTSE->io.Devaddr,
+            pSTSE->io.BusSpeed,
+            length_value,
+            STSE_FRAME_LENGTH_SIZE);
+        if (ret != STSE_OK) {
+            return ret;
+        }
+
+        /* - Get STSAFE Response Potential CRC */
+        ret = pSTSE->io.BusRecvStop(
+            pSTSE->io.busID,
+            pSTSE->io.Devaddr,
+            pSTSE->io.BusSpeed,
+            received_crc,
+            STSE_FRAME_CRC_SIZE);
+        if (ret != STSE_OK) {
+            return ret;
+        }
+    }
 
     /* - Store response Length */
     received_length = ((length_value[0] << 8) + length_value[1]) - STSE_FRAME_CRC_SIZE + STSE_RSP_FRAME_HEADER_SIZE;
@@ -220,7 +574,10 @@ stse_ReturnCode_t stsafea_frame_receive(stse_Handler_t *pSTSE, stse_frame_t *pFr
         /* ====================================================== */
         /* ====== compute CRC for response without payload ====== */
 
-        computed_crc = stse_platform_Crc16_Calculate(&received_header, STSE_RSP_FRAME_HEADER_SIZE);
+        ret = stse_frame_crc16_accumulate(&received_header, STSE_RSP_FRAME_HEADER_SIZE, 1, &computed_crc);
+        if (ret != STSE_OK) {
+            return ret;
+        }
 
 #ifdef STSE_FRAME_DEBUG_LOG
         printf("\n\r STSAFE Frame <  (%d-byte) : { 0x%02X } { 0x%02X 0x%02X }\n\r",
@@ -262,83 +619,101 @@ stse_ReturnCode_t stsafea_frame_receive(stse_Handler_t *pSTSE, stse_frame_t *pFr
         /* ======================================================= */
         /* ========= Receive the frame in frame elements ========= */
 
-        ret = STSE_PLATFORM_BUS_ACK_ERROR;
-        retry_count = STSE_MAX_POLLING_RETRY;
-        while ((retry_count != 0) && (ret == STSE_PLATFORM_BUS_ACK_ERROR)) {
-            /* - Receive frame length from target STSAFE */
-            ret = pSTSE->io.BusRecvStart(
-                pSTSE->io.busID,
-                pSTSE->io.Devaddr,
-                pSTSE->io.BusSpeed,
-                STSE_FRAME_LENGTH_SIZE + received_length + STSE_FRAME_CRC_SIZE);
+        stse_frame_element_allocate(eCRC, STSE_FRAME_CRC_SIZE, received_crc);
 
-            if (ret != STSE_OK) {
-                retry_count--;
-                stse_platform_Delay_ms(STSE_POLLING_RETRY_INTERVAL);
-            }
-        }
+        if (frame_received != 0) {
+            /* - Append CRC element to the RSP Frame (already received) */
+            stse_frame_push_element(pFrame, &eCRC);
 
-        /* - Verify correct reception*/
-        if (ret != STSE_OK) {
-            /* - Pop Filler element from Frame*/
-            if (filler_size > 0) {
+            /* - Fit frame elements to the received response length */
+            stsafea_frame_fit_to_length(pFrame, received_length - STSE_RSP_FRAME_HEADER_SIZE);
+#ifdef STSE_USE_ZERO_COPY_RSP
+        } else if (pSTSE->io.BusRecvFrame != NULL) {
+            /* - Append CRC element to the RSP Frame (valid only in Receive Scope) */
+            stse_frame_push_element(pFrame, &eCRC);
+
+            /* - Receive the whole frame in the driver buffer (elements without buffer are not copied) */
+            ret = stsafea_frame_zero_copy_receive(pSTSE, pFrame, received_length, &computed_crc);
+            if (ret != STSE_OK) {
+                /* - Pop CRC element from Frame*/
                 stse_frame_pop_element(pFrame);
+                /* - Pop Filler element from Frame*/
+                if (filler_size > 0) {
+                    stse_frame_pop_element(pFrame);
+                }
+                return ret;
             }
-            return ret;
-        }
-
-        /* Receive response header */
-        ret = pSTSE->io.BusRecvContinue(
-            pSTSE->io.busID,
-            pSTSE->io.Devaddr,
-            pSTSE->io.BusSpeed,
-            pFrame->first_element->pData,
-            STSE_RSP_FRAME_HEADER_SIZE);
+            crc_accumulated = 1;
+#endif /* STSE_USE_ZERO_COPY_RSP */
+        } else if ((pSTSE->io.BusRecvV != NULL) && ((pFrame->element_count + 2U) <= STSE_CONF_FRAME_MAX_ELEMENT_COUNT)) {
+            /* - Append CRC element to the RSP Frame (valid only in Receive Scope) */
+            stse_frame_push_element(pFrame, &eCRC);
 
-        if (ret != STSE_OK) {
-            /* - Pop Filler element from Frame*/
-            if (filler_size > 0) {
+            /* - Receive the whole frame in a single bus transaction */
+            ret = stsafea_frame_vectored_receive(pSTSE, pFrame, received_length);
+            if (ret != STSE_OK) {
+                /* - Pop CRC element from Frame*/
                 stse_frame_pop_element(pFrame);
+                /* - Pop Filler element from Frame*/
+                if (filler_size > 0) {
+                    stse_frame_pop_element(pFrame);
+                }
+                return ret;
             }
-            return ret;
-        }
-
-        /* Substract response header already read in STSAFE-A */
-        received_length -= STSE_RSP_FRAME_HEADER_SIZE;
+        } else {
+            stse_retry_init(pSTSE, &retry, STSE_MAX_POLLING_RETRY);
+            do {
+                /* - Receive frame length from target STSAFE */
+                ret = pSTSE->io.BusRecvStart(
+                    pSTSE->io.busID,
+                    pSTSE->io.Devaddr,
+                    pSTSE->io.BusSpeed,
+                    STSE_FRAME_LENGTH_SIZE + received_length + STSE_FRAME_CRC_SIZE);
+            } while ((ret == STSE_PLATFORM_BUS_ACK_ERROR) && (stse_retry_wait(pSTSE, &retry) != 0));
 
-        /* Receive and discard length (already stored) */
-        ret = pSTSE->io.BusRecvContinue(
-            pSTSE->io.busID,
-            pSTSE->io.Devaddr,
-            pSTSE->io.BusSpeed,
-            NULL,
-            STSE_FRAME_LENGTH_SIZE);
-        if (ret != STSE_OK) {
-            /* - Pop Filler element from Frame*/
-            if (filler_size > 0) {
-                stse_frame_pop_element(pFrame);
+            /* - Verify correct reception*/
+            if (ret != STSE_OK) {
+                /* - Pop Filler element from Frame*/
+                if (filler_size > 0) {
+                    stse_frame_pop_element(pFrame);
+                }
+                return ret;
             }
-            return ret;
-        }
 
-        /* - Append CRC element to the RSP Frame (valid only in Receive Scope) */
-        stse_frame_element_allocate_push(pFrame, eCRC, STSE_FRAME_CRC_SIZE, received_crc);
+            /* Receive response header */
+            ret = pSTSE->io.BusRecvContinue(
+                pSTSE->io.busID,
+                pSTSE->io.Devaddr,
+                pSTSE->io.BusSpeed,
+                pFrame->first_element->pData,
+                STSE_RSP_FRAME_HEADER_SIZE);
+#ifdef STSE_USE_INCREMENTAL_CRC
+            if (ret == STSE_OK) {
+                /* - Start frame CRC computation on received response header */
+                ret = stse_frame_crc16_accumulate(pFrame->first_element->pData, STSE_RSP_FRAME_HEADER_SIZE, 1, &computed_crc);
+                crc_accumulated = 1;
+            }
+#endif /* STSE_USE_INCREMENTAL_CRC */
 
-        /* - Perform frame element reception and populate local RSP Frame */
-        pCurrent_element = pFrame->first_element->next;
-        while (pCurrent_element != pFrame->last_element) {
-            if (received_length < pCurrent_element->length) {
-                pCurrent_element->length = received_length;
+            if (ret != STSE_OK) {
+                /* - Pop Filler element from Frame*/
+                if (filler_size > 0) {
+                    stse_frame_pop_element(pFrame);
+                }
+                return ret;
             }
+
+            /* Substract response header already read in STSAFE-A */
+            received_length -= STSE_RSP_FRAME_HEADER_SIZE;
+
+            /* Receive and discard length (already stored) */
             ret = pSTSE->io.BusRecvContinue(
                 pSTSE->io.busID,
                 pSTSE->io.Devaddr,
                 pSTSE->io.BusSpeed,
-                pCurrent_element->pData,
-                pCurrent_element->length);
+                NULL,
+                STSE_FRAME_LENGTH_SIZE);
             if (ret != STSE_OK) {
-                /* - Pop CRC element from Frame*/
-                stse_frame_pop_element(pFrame);
                 /* - Pop Filler element from Frame*/
                 if (filler_size > 0) {
                     stse_frame_pop_element(pFrame);
@@ -346,24 +721,56 @@ stse_ReturnCode_t stsafea_frame_receive(stse_Handler_t *pSTSE, stse_frame_t *pFr
                 return ret;
             }
 
-            received_length -= pCurrent_element->length;
-            pCurrent_element = pCurrent_element->next;
-        }
+            /* - Append CRC element to the RSP Frame (valid only in Receive Scope) */
+            stse_frame_push_element(pFrame, &eCRC);
 
-        ret = pSTSE->io.BusRecvStop(
-            pSTSE->io.busID,
-            pSTSE->io.Devaddr,
-            pSTSE->io.BusSpeed,
-            pCurrent_element->pData,
-            pCurrent_element->length);
-        if (ret != STSE_OK) {
-            /* - Pop CRC element from Frame*/
-            stse_frame_pop_element(pFrame);
-            /* - Pop Filler element from Frame*/
-            if (filler_size > 0) {
+            /* - Perform frame element reception and populate local RSP Frame */
+            pCurrent_element = pFrame->first_element->next;
+            while (pCurrent_element != pFrame->last_element) {
+                if (received_length < pCurrent_element->length) {
+                    pCurrent_element->length = received_length;
+                }
+                ret = pSTSE->io.BusRecvContinue(
+                    pSTSE->io.busID,
+                    pSTSE->io.Devaddr,
+                    pSTSE->io.BusSpeed,
+                    pCurrent_element->pData,
+                    pCurrent_element->length);
+#ifdef STSE_USE_INCREMENTAL_CRC
+                if (ret == STSE_OK) {
+                    /* - Fold received element in frame CRC */
+                    ret = stse_frame_crc16_accumulate(pCurrent_element->pData, pCurrent_element->length, 0, &computed_crc);
+                }
+#endif /* STSE_USE_INCREMENTAL_CRC */
+                if (ret != STSE_OK) {
+                    /* - Pop CRC element from Frame*/
+                    stse_frame_pop_element(pFrame);
+                    /* - Pop Filler element from Frame*/
+                    if (filler_size > 0) {
+                        stse_frame_pop_element(pFrame);
+                    }
+                    return ret;
+                }
+
+                received_length -= pCurrent_element->length;
+                pCurrent_element = pCurrent_element->next;
+            }
+
+            ret = pSTSE->io.BusRecvStop(
+                pSTSE->io.busID,
+                pSTSE->io.Devaddr,
+                pSTSE->io.BusSpeed,
+                pCurrent_element->pData,
+                pCurrent_element->length);
+            if (ret != STSE_OK) {
+                /* - Pop CRC element from Frame*/
                 stse_frame_pop_element(pFrame);
+                /* - Pop Filler element from Frame*/
+                if (filler_size > 0) {
+                    stse_frame_pop_element(pFrame);
+                }
+                return ret;
             }
-            return ret;
         }
 
 #ifdef STSE_FRAME_DEBUG_LOG
@@ -378,8 +785,10 @@ stse_ReturnCode_t stsafea_frame_receive(stse_Handler_t *pSTSE, stse_frame_t *pFr
         /* - Pop CRC element from Frame*/
         stse_frame_pop_element(pFrame);
 
-        /* - Compute CRC */
-        ret = stse_frame_crc16_compute(pFrame, &computed_crc);
+        /* - Compute CRC (unless accumulated during frame elements reception) */
+        if (crc_accumulated == 0) {
+            ret = stse_frame_crc16_compute(pFrame, &computed_crc);
+        }
 
         /* - Pop Filler element from Frame*/
         if (filler_size > 0) {
@@ -401,94 +810,667 @@ stse_ReturnCode_t stsafea_frame_receive(stse_Handler_t *pSTSE, stse_frame_t *pFr
     return ret;
 }
 
-stse_ReturnCode_t stsafea_frame_raw_transfer(stse_Handler_t *pSTSE,
+static stse_ReturnCode_t stsafea_frame_receive_polled(stse_Handler_t *pSTSE,
+                                                      stse_frame_t *pFrame,
+                                                      PLAT_UI16 polling_retry,
+                                                      PLAT_UI16 *pPoll_count) {
+    stse_ReturnCode_t ret;
+    stse_retry_t retry;
+    PLAT_UI8 rsp_ready = 0;
+
+    /*- Verify Parameters */
+    if ((pSTSE == NULL) || (pFrame == NULL)) {
+        return STSE_SERVICE_INVALID_PARAMETER;
+    }
+    /* - Verify Frame length */
+    if (pFrame->element_count == 0) {
+        return (STSE_SERVICE_INVALID_PARAMETER);
+    }
+    /* - Verify First Frame Element */
+    if ((pFrame->first_element == NULL) || (pFrame->first_element->pData == NULL) || (pFrame->first_element->length != STSE_RSP_FRAME_HEADER_SIZE)) {
+        return (STSE_SERVICE_INVALID_PARAMETER);
+    }
+    /* - Verify Device type */
+    if (pSTSE->device_type >= (STSE_DEVICE_STSAFEA_FAMILY_INDEX + STSAFEA_PRODUCT_COUNT)) {
+        return STSE_SERVICE_INVALID_PARAMETER;
+    }
+
+    /* - Poll target STSAFE until response is available (bus released between polls) */
+    stse_retry_init(pSTSE, &retry, polling_retry);
+    do {
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+        ret = stse_bus_lock(pSTSE);
+        if (ret != STSE_OK) {
+            return ret;
+        }
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
+
+#ifdef STSE_CMD_METRICS
+        stse_cmd_metrics_rx_start(pSTSE);
+#endif /* STSE_CMD_METRICS */
+
+        ret = stsafea_frame_receive_attempt(pSTSE, pFrame, &rsp_ready);
+
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+        stse_bus_unlock(pSTSE);
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
+    } while ((ret == STSE_PLATFORM_BUS_ACK_ERROR) && (rsp_ready == 0) && (stse_retry_wait(pSTSE, &retry) != 0));
+
+    /* - Report number of polls NACKed by the target device */
+    if (pPoll_count != NULL) {
+        *pPoll_count = retry.failed_attempt;
+    }
+#ifdef STSE_USE_ADAPTIVE_RSP_POLLING
+    pSTSE->exec_time.rsp_poll_count = retry.failed_attempt;
+#endif /* STSE_USE_ADAPTIVE_RSP_POLLING */
+
+    return ret;
+}
+
+stse_ReturnCode_t stsafea_frame_receive(stse_Handler_t *pSTSE, stse_frame_t *pFrame) {
+#ifdef STSE_FRAME_TRACE
+    stse_ReturnCode_t ret;
+
+    ret = stsafea_frame_receive_polled(pSTSE, pFrame, STSE_MAX_POLLING_RETRY, NULL);
+    if ((pSTSE != NULL) && (pFrame != NULL)) {
+        stse_frame_trace_record(pSTSE, STSE_FRAME_TRACE_RSP, pFrame, ret);
+    }
+
+    return ret;
+#else
+    return stsafea_frame_receive_polled(pSTSE, pFrame, STSE_MAX_POLLING_RETRY, NULL);
+#endif /* STSE_FRAME_TRACE */
+}
+
+static PLAT_UI16 stsafea_frame_rsp_delay_get(stse_Handler_t *pSTSE,
                                              stse_frame_t *pCmdFrame,
-                                             stse_frame_t *pRspFrame,
                                              PLAT_UI16 inter_frame_delay) {
-    stse_ReturnCode_t ret = STSE_SERVICE_INVALID_PARAMETER;
+#if defined(STSE_USE_ADAPTIVE_RSP_POLLING)
+    PLAT_UI8 ext_cmd_header = 0;
 
-#ifdef STSE_USE_RSP_POLLING
+    /* - Learned command execution time (static timing until first execution) */
+    if (pCmdFrame->first_element->length >= STSAFEA_EXT_HEADER_SIZE) {
+        ext_cmd_header = pCmdFrame->first_element->pData[1];
+    }
+    return stsafea_exec_time_estimate(pSTSE, pCmdFrame->first_element->pData[0], ext_cmd_header, inter_frame_delay);
+#elif defined(STSE_USE_RSP_POLLING)
+    (void)pSTSE;
+    (void)pCmdFrame;
     (void)inter_frame_delay;
-#endif /* STSE_USE_RSP_POLLING */
+    return STSE_FIRST_POLLING_INTERVAL;
+#else
+    (void)pSTSE;
+    (void)pCmdFrame;
+    return inter_frame_delay;
+#endif /* STSE_USE_ADAPTIVE_RSP_POLLING */
+}
+
+static PLAT_UI16 stsafea_frame_rsp_wait(stse_Handler_t *pSTSE,
+                                        stse_frame_t *pCmdFrame,
+                                        PLAT_UI16 inter_frame_delay) {
+    PLAT_UI16 rsp_delay;
+#ifdef STSE_USE_IO_LINE_RSP_WAIT
+    PLAT_UI16 timeout = inter_frame_delay + STSE_POLLING_RETRY_INTERVAL;
+    PLAT_UI16 waited_time = 0;
+
+    /* - Block on device ready line : reception starts as soon as the command is executed */
+    if (pSTSE->io.IOLineWait != NULL) {
+        if (pSTSE->io.IOLineWait(pSTSE->io.busID, pSTSE->io.Devaddr, timeout, &waited_time) != STSE_OK) {
+            waited_time = timeout;
+        }
+        return waited_time;
+    }
+
+    /* - Sample device ready line every ms (no bus traffic while the command is executed) */
+    if (pSTSE->io.IOLineReady != NULL) {
+        while ((pSTSE->io.IOLineReady(pSTSE->io.busID, pSTSE->io.Devaddr) != STSE_OK) && (waited_time < timeout)) {
+            stse_platform_Delay_ms(1);
+            waited_time++;
+        }
+        return waited_time;
+    }
+#endif /* STSE_USE_IO_LINE_RSP_WAIT */
+
+    /* - Timed wait then response polling */
+    rsp_delay = stsafea_frame_rsp_delay_get(pSTSE, pCmdFrame, inter_frame_delay);
+    stse_platform_Delay_ms(rsp_delay);
+
+    return rsp_delay;
+}
+
+#ifdef STSE_USE_ADAPTIVE_RSP_POLLING
+static void stsafea_frame_rsp_delay_record(stse_Handler_t *pSTSE,
+                                           stse_frame_t *pCmdFrame,
+                                           PLAT_UI16 waited_time,
+                                           PLAT_UI16 poll_count) {
+    PLAT_UI8 ext_cmd_header = 0;
+
+    if (pCmdFrame->first_element->length >= STSAFEA_EXT_HEADER_SIZE) {
+        ext_cmd_header = pCmdFrame->first_element->pData[1];
+    }
+    stsafea_exec_time_record(pSTSE, pCmdFrame->first_element->pData[0], ext_cmd_header, waited_time, poll_count);
+}
+#endif /* STSE_USE_ADAPTIVE_RSP_POLLING */
+
+static stse_ReturnCode_t stsafea_frame_raw_transfer_timed(stse_Handler_t *pSTSE,
+                                                          stse_frame_t *pCmdFrame,
+                                                          stse_frame_t *pRspFrame,
+                                                          stsafea_session_transfer_ctx_t *pSession_ctx,
+                                                          PLAT_UI16 inter_frame_delay,
+                                                          PLAT_UI16 *pProcessing_time,
+                                                          PLAT_UI16 *pPoll_count) {
+    stse_ReturnCode_t ret = STSE_SERVICE_INVALID_PARAMETER;
+    PLAT_UI16 poll_count = 0;
+
+#ifdef STSE_USE_RETRY_POLICY
+    stse_retry_command_start(pSTSE);
+#endif /* STSE_USE_RETRY_POLICY */
+#ifdef STSE_CMD_METRICS
+    stse_cmd_metrics_command_start(pSTSE);
+#endif /* STSE_CMD_METRICS */
 
     /* - Send Non-protected Frame */
     ret = stsafea_frame_transmit(pSTSE, pCmdFrame);
+#ifdef STSE_CMD_METRICS
+    stse_cmd_metrics_tx_end(pSTSE);
+#endif /* STSE_CMD_METRICS */
     if (ret == STSE_OK) {
-#ifdef STSE_USE_RSP_POLLING
-        /* - Wait for command to be executed by target STSAFE  */
-        stse_platform_Delay_ms(STSE_FIRST_POLLING_INTERVAL);
+#if defined(STSE_CONF_USE_HOST_SESSION) && defined(STSE_CONF_USE_PLATFORM_AES_CMAC_CTX)
+        /* - Precompute response protection while target STSAFE executes the command
+         *   (on failure , precomputation is performed again and reported by session transfer finalization).
+         *   Not done over the legacy platform CMAC sequence API : its single computation must not stay
+         *   open while other transfers run */
+        if (pSession_ctx != NULL) {
+            (void)stsafea_session_transfer_rsp_precompute(pSession_ctx, pCmdFrame);
+        }
 #else
+        (void)pSession_ctx;
+#endif /* STSE_CONF_USE_HOST_SESSION && STSE_CONF_USE_PLATFORM_AES_CMAC_CTX */
+
         /* - Wait for command to be executed by target STSAFE  */
-        stse_platform_Delay_ms(inter_frame_delay);
-#endif /* STSE_USE_RSP_POLLING */
+        inter_frame_delay = stsafea_frame_rsp_wait(pSTSE, pCmdFrame, inter_frame_delay);
+
         /* - Receive non protected Frame */
-        ret = stsafea_frame_receive(pSTSE, pRspFrame);
+        ret = stsafea_frame_receive_polled(pSTSE, pRspFrame, STSE_MAX_POLLING_RETRY, &poll_count);
+#ifdef STSE_FRAME_TRACE
+        stse_frame_trace_record(pSTSE, STSE_FRAME_TRACE_RSP, pRspFrame, ret);
+#endif /* STSE_FRAME_TRACE */
+
+#ifdef STSE_USE_ADAPTIVE_RSP_POLLING
+        /* - Update command execution time statistics when target STSAFE has responded */
+        if (ret <= 0xFF) {
+            stsafea_frame_rsp_delay_record(pSTSE, pCmdFrame, inter_frame_delay, poll_count);
+        }
+#endif /* STSE_USE_ADAPTIVE_RSP_POLLING */
+
+        if (pProcessing_time != NULL) {
+            *pProcessing_time = inter_frame_delay;
+        }
+        if (pPoll_count != NULL) {
+            *pPoll_count = poll_count;
+        }
     }
 
+#ifdef STSE_USE_RETRY_POLICY
+    stse_retry_command_end(pSTSE);
+#endif /* STSE_USE_RETRY_POLICY */
+#ifdef STSE_CMD_METRICS
+    stse_cmd_metrics_command_end(pSTSE, pCmdFrame, pRspFrame, ret);
+#endif /* STSE_CMD_METRICS */
+
     return ret;
 }
 
-stse_ReturnCode_t stsafea_frame_transfer(stse_Handler_t *pSTSE, stse_frame_t *pCmdFrame,
-                                         stse_frame_t *pRspFrame) {
+stse_ReturnCode_t stsafea_frame_raw_transfer_unlocked(stse_Handler_t *pSTSE,
+                                                      stse_frame_t *pCmdFrame,
+                                                      stse_frame_t *pRspFrame,
+                                                      PLAT_UI16 inter_frame_delay) {
+    return stsafea_frame_raw_transfer_timed(pSTSE, pCmdFrame, pRspFrame, NULL, inter_frame_delay, NULL, NULL);
+}
+
+#ifdef STSE_CONF_USE_HOST_SESSION
+stse_ReturnCode_t stsafea_frame_session_raw_transfer_unlocked(stse_Handler_t *pSTSE,
+                                                              stse_frame_t *pCmdFrame,
+                                                              stse_frame_t *pRspFrame,
+                                                              stsafea_session_transfer_ctx_t *pSession_ctx,
+                                                              PLAT_UI16 inter_frame_delay) {
+    return stsafea_frame_raw_transfer_timed(pSTSE, pCmdFrame, pRspFrame, pSession_ctx, inter_frame_delay, NULL, NULL);
+}
+#endif /* STSE_CONF_USE_HOST_SESSION */
+
+stse_ReturnCode_t stsafea_frame_raw_transfer(stse_Handler_t *pSTSE,
+                                             stse_frame_t *pCmdFrame,
+                                             stse_frame_t *pRspFrame,
+                                             PLAT_UI16 inter_frame_delay) {
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+    stse_ReturnCode_t ret;
+
+    ret = stse_handler_lock(pSTSE);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+
+    ret = stsafea_frame_raw_transfer_timed(pSTSE, pCmdFrame, pRspFrame, NULL, inter_frame_delay, NULL, NULL);
+
+    stse_handler_unlock(pSTSE);
+
+    return ret;
+#else
+    return stsafea_frame_raw_transfer_timed(pSTSE, pCmdFrame, pRspFrame, NULL, inter_frame_delay, NULL, NULL);
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
+}
+
+static stse_ReturnCode_t stsafea_frame_cmd_info_get(stse_Handler_t *pSTSE,
+                                                    stse_frame_t *pCmdFrame,
+                                                    stsafea_frame_cmd_info_t *pCmd_info) {
     stse_ReturnCode_t ret = STSE_SERVICE_INVALID_PARAMETER;
-    PLAT_UI16 inter_frame_delay = STSAFEA_EXEC_TIME_DEFAULT;
 
+    pCmd_info->inter_frame_delay = STSAFEA_EXEC_TIME_DEFAULT;
 #ifdef STSE_CONF_USE_HOST_SESSION
-    stse_cmd_access_conditions_t cmd_ac_info;
-    PLAT_UI8 cmd_encryption_flag = 0;
-    PLAT_UI8 rsp_encryption_flag = 0;
+    pCmd_info->cmd_ac_info = STSE_CMD_AC_FREE;
+    pCmd_info->cmd_encryption_flag = 0;
+    pCmd_info->rsp_encryption_flag = 0;
 #endif /* STSE_CONF_USE_HOST_SESSION */
 
     if (pCmdFrame->first_element != NULL && pCmdFrame->first_element->pData != NULL) {
         if (pCmdFrame->first_element->length == STSAFEA_EXT_HEADER_SIZE && pCmdFrame->first_element->pData[0] == STSAFEA_EXTENDED_COMMAND_PREFIX) {
-            inter_frame_delay = stsafea_extended_cmd_timings[pSTSE->device_type][pCmdFrame->first_element->pData[1]];
+            pCmd_info->inter_frame_delay = stsafea_extended_cmd_timings[pSTSE->device_type][pCmdFrame->first_element->pData[1]];
 #ifdef STSE_CONF_USE_HOST_SESSION
-            stsafea_perso_info_get_ext_cmd_AC(&pSTSE->perso_info, pCmdFrame->first_element->pData[1], &cmd_ac_info);
-            stsafea_perso_info_get_ext_cmd_encrypt_flag(&pSTSE->perso_info, pCmdFrame->first_element->pData[1], &cmd_encryption_flag);
-            stsafea_perso_info_get_ext_rsp_encrypt_flag(&pSTSE->perso_info, pCmdFrame->first_element->pData[1], &rsp_encryption_flag);
+            stsafea_perso_info_get_ext_cmd_AC(&pSTSE->perso_info, pCmdFrame->first_element->pData[1], &pCmd_info->cmd_ac_info);
+            stsafea_perso_info_get_ext_cmd_encrypt_flag(&pSTSE->perso_info, pCmdFrame->first_element->pData[1], &pCmd_info->cmd_encryption_flag);
+            stsafea_perso_info_get_ext_rsp_encrypt_flag(&pSTSE->perso_info, pCmdFrame->first_element->pData[1], &pCmd_info->rsp_encryption_flag);
 #endif /* STSE_CONF_USE_HOST_SESSION */
             ret = STSE_OK;
         } else if (pCmdFrame->first_element->length == STSAFEA_HEADER_SIZE && pCmdFrame->first_element->pData[0] != STSAFEA_EXTENDED_COMMAND_PREFIX) {
-            inter_frame_delay = stsafea_cmd_timings[pSTSE->device_type][pCmdFrame->first_element->pData[0]];
+            pCmd_info->inter_frame_delay = stsafea_cmd_timings[pSTSE->device_type][pCmdFrame->first_element->pData[0]];
 #ifdef STSE_CONF_USE_HOST_SESSION
-            stsafea_perso_info_get_cmd_AC(&pSTSE->perso_info, pCmdFrame->first_element->pData[0], &cmd_ac_info);
-            stsafea_perso_info_get_cmd_encrypt_flag(&pSTSE->perso_info, pCmdFrame->first_element->pData[0], &cmd_encryption_flag);
-            stsafea_perso_info_get_rsp_encrypt_flag(&pSTSE->perso_info, pCmdFrame->first_element->pData[0], &rsp_encryption_flag);
+            stsafea_perso_info_get_cmd_AC(&pSTSE->perso_info, pCmdFrame->first_element->pData[0], &pCmd_info->cmd_ac_info);
+            stsafea_perso_info_get_cmd_encrypt_flag(&pSTSE->perso_info, pCmdFrame->first_element->pData[0], &pCmd_info->cmd_encryption_flag);
+            stsafea_perso_info_get_rsp_encrypt_flag(&pSTSE->perso_info, pCmdFrame->first_element->pData[0], &pCmd_info->rsp_encryption_flag);
 #endif /* STSE_CONF_USE_HOST_SESSION */
             ret = STSE_OK;
         }
     }
 
+    return ret;
+}
+
+#ifdef STSE_CONF_USE_HOST_SESSION
+static stse_ReturnCode_t stsafea_frame_session_transfer(stse_Handler_t *pSTSE,
+                                                       stse_frame_t *pCmdFrame,
+                                                       stse_frame_t *pRspFrame,
+                                                       stsafea_frame_cmd_info_t *pCmd_info,
+                                                       PLAT_UI8 *pEncrypted_cmd_payload,
+                                                       PLAT_UI8 *pEncrypted_rsp_payload,
+                                                       PLAT_UI16 *pProcessing_time,
+                                                       PLAT_UI16 *pPoll_count) {
+    stse_ReturnCode_t ret;
+    stsafea_session_transfer_ctx_t session_ctx;
+
+    ret = stsafea_session_transfer_prepare(&session_ctx,
+                                           pSTSE->pActive_host_session,
+                                           pCmdFrame,
+                                           pRspFrame,
+                                           pCmd_info->cmd_encryption_flag,
+                                           pCmd_info->rsp_encryption_flag,
+                                           pEncrypted_cmd_payload,
+                                           pEncrypted_rsp_payload);
     if (ret != STSE_OK) {
         return ret;
     }
 
+    if (pSTSE->pActive_host_session->type == STSE_HOST_SESSION) {
+        ret = stsafea_frame_raw_transfer_timed(pSTSE,
+                                               pCmdFrame,
+                                               pRspFrame,
+                                               &session_ctx,
+                                               pCmd_info->inter_frame_delay,
+                                               pProcessing_time,
+                                               pPoll_count);
+    } else {
+        ret = STSE_SERVICE_SESSION_ERROR;
+    }
+
+    return stsafea_session_transfer_finalize(&session_ctx, pCmdFrame, pRspFrame, ret);
+}
+#endif /* STSE_CONF_USE_HOST_SESSION */
+
+static stse_ReturnCode_t stsafea_frame_transfer_execute(stse_Handler_t *pSTSE,
+                                                        stse_frame_t *pCmdFrame,
+                                                        stse_frame_t *pRspFrame,
+                                                        stsafea_frame_cmd_info_t *pCmd_info,
+                                                        PLAT_UI16 *pProcessing_time,
+                                                        PLAT_UI16 *pPoll_count) {
+    stse_ReturnCode_t ret;
+
     /*- Perform Transfer*/
 #ifdef STSE_CONF_USE_HOST_SESSION
-    if (cmd_encryption_flag || rsp_encryption_flag) {
-        ret = stsafea_session_encrypted_transfer(pSTSE->pActive_host_session,
-                                                 pCmdFrame,
-                                                 pRspFrame,
-                                                 cmd_encryption_flag,
-                                                 rsp_encryption_flag,
-                                                 cmd_ac_info,
-                                                 inter_frame_delay);
-    } else if (cmd_ac_info != STSE_CMD_AC_FREE) {
-        ret = stsafea_session_authenticated_transfer(pSTSE->pActive_host_session,
-                                                     pCmdFrame,
-                                                     pRspFrame,
-                                                     cmd_ac_info,
-                                                     inter_frame_delay);
+    if (pCmd_info->cmd_encryption_flag || pCmd_info->rsp_encryption_flag) {
+        PLAT_UI16 encrypted_cmd_payload_size = 0;
+        PLAT_UI16 encrypted_rsp_payload_size = stsafea_session_rsp_staging_size(pRspFrame, pCmd_info->rsp_encryption_flag);
+
+        if (pCmd_info->cmd_encryption_flag == 1) {
+            encrypted_cmd_payload_size = stsafea_session_encrypted_payload_size(pCmdFrame);
+        }
+
+        PLAT_UI8 encrypted_cmd_payload[encrypted_cmd_payload_size];
+        PLAT_UI8 encrypted_rsp_payload[encrypted_rsp_payload_size];
+
+        ret = stsafea_frame_session_transfer(pSTSE,
+                                             pCmdFrame,
+                                             pRspFrame,
+                                             pCmd_info,
+                                             encrypted_cmd_payload,
+                                             encrypted_rsp_payload,
+                                             pProcessing_time,
+                                             pPoll_count);
+    } else if (pCmd_info->cmd_ac_info != STSE_CMD_AC_FREE) {
+        ret = stsafea_frame_session_transfer(pSTSE,
+                                             pCmdFrame,
+                                             pRspFrame,
+                                             pCmd_info,
+                                             NULL,
+                                             NULL,
+                                             pProcessing_time,
+                                             pPoll_count);
     } else
 #endif /* STSE_CONF_USE_HOST_SESSION */
     {
-        ret = stsafea_frame_raw_transfer(pSTSE,
-                                         pCmdFrame,
-                                         pRspFrame,
-                                         inter_frame_delay);
+        ret = stsafea_frame_raw_transfer_timed(pSTSE,
+                                               pCmdFrame,
+                                               pRspFrame,
+                                               NULL,
+                                               pCmd_info->inter_frame_delay,
+                                               pProcessing_time,
+                                               pPoll_count);
+    }
+
+    return ret;
+}
+
+stse_ReturnCode_t stsafea_frame_transfer(stse_Handler_t *pSTSE, stse_frame_t *pCmdFrame,
+                                         stse_frame_t *pRspFrame) {
+    stse_ReturnCode_t ret;
+    stsafea_frame_cmd_info_t cmd_info;
+
+    ret = stsafea_frame_cmd_info_get(pSTSE, pCmdFrame, &cmd_info);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+    ret = stse_handler_lock(pSTSE);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+
+    ret = stsafea_frame_transfer_execute(pSTSE, pCmdFrame, pRspFrame, &cmd_info, NULL, NULL);
+
+    stse_handler_unlock(pSTSE);
+
+    return ret;
+#else
+    return stsafea_frame_transfer_execute(pSTSE, pCmdFrame, pRspFrame, &cmd_info, NULL, NULL);
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
+}
+
+stse_ReturnCode_t stsafea_frame_transfer_batch(stse_Handler_t *pSTSE,
+                                               stsafea_frame_batch_entry_t *pEntries,
+                                               PLAT_UI8 entry_count) {
+    stse_ReturnCode_t ret = STSE_OK;
+    PLAT_UI8 i;
+
+    /*- Verify Parameters */
+    if ((pSTSE == NULL) || (pEntries == NULL) || (entry_count == 0)) {
+        return STSE_SERVICE_INVALID_PARAMETER;
+    }
+    /*- Verify Device type */
+    if (pSTSE->device_type >= (STSE_DEVICE_STSAFEA_FAMILY_INDEX + STSAFEA_PRODUCT_COUNT)) {
+        return STSE_SERVICE_INVALID_PARAMETER;
+    }
+
+    stsafea_frame_cmd_info_t cmd_info[entry_count];
+
+    /*- Verify all frames and resolve command timings / protections before first transfer */
+    for (i = 0; i < entry_count; i++) {
+        pEntries[i].status = STSE_SERVICE_TRANSFER_PENDING;
+        pEntries[i].processing_time = 0;
+        pEntries[i].poll_count = 0;
+    }
+    for (i = 0; i < entry_count; i++) {
+        if ((pEntries[i].pCmdFrame == NULL) || (pEntries[i].pRspFrame == NULL)) {
+            ret = STSE_SERVICE_INVALID_PARAMETER;
+        } else if (pEntries[i].pCmdFrame->length > stsafea_maximum_frame_length[pSTSE->device_type - STSE_DEVICE_STSAFEA_FAMILY_INDEX]) {
+            ret = STSE_SERVICE_FRAME_SIZE_ERROR;
+        } else {
+            ret = stsafea_frame_cmd_info_get(pSTSE, pEntries[i].pCmdFrame, &cmd_info[i]);
+        }
+        if (ret != STSE_OK) {
+            pEntries[i].status = ret;
+            return ret;
+        }
+    }
+
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+    ret = stse_handler_lock(pSTSE);
+    if (ret != STSE_OK) {
+        return ret;
     }
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
+
+    /*- Perform Transfers (stop on first error) */
+    for (i = 0; i < entry_count; i++) {
+        ret = stsafea_frame_transfer_execute(pSTSE,
+                                             pEntries[i].pCmdFrame,
+                                             pEntries[i].pRspFrame,
+                                             &cmd_info[i],
+                                             &pEntries[i].processing_time,
+                                             &pEntries[i].poll_count);
+        pEntries[i].status = ret;
+        if (ret != STSE_OK) {
+            break;
+        }
+    }
+
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+    stse_handler_unlock(pSTSE);
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
 
     return ret;
 }
 
+#ifdef STSE_CONF_USE_ASYNC_TRANSFER
+
+static stse_ReturnCode_t stsafea_frame_transfer_start(stse_Handler_t *pSTSE,
+                                                      stsafea_transfer_t *pTransfer,
+                                                      stse_frame_t *pCmdFrame,
+                                                      stse_frame_t *pRspFrame,
+                                                      stsafea_frame_cmd_info_t *pCmd_info) {
+    stse_ReturnCode_t ret;
+
+    pTransfer->pSTSE = pSTSE;
+    pTransfer->pCmdFrame = pCmdFrame;
+    pTransfer->pRspFrame = pRspFrame;
+    pTransfer->poll_count = 0;
+    pTransfer->poll_interval = STSE_POLLING_RETRY_INTERVAL;
+    pTransfer->state = STSAFEA_TRANSFER_IDLE;
+    stse_retry_init(pSTSE, &pTransfer->retry, STSE_MAX_POLLING_RETRY);
+#ifdef STSE_USE_RETRY_POLICY
+    stse_retry_command_start(pSTSE);
+#endif /* STSE_USE_RETRY_POLICY */
+#ifdef STSE_CMD_METRICS
+    stse_cmd_metrics_command_start(pSTSE);
+#endif /* STSE_CMD_METRICS */
+
+    ret = STSE_OK;
+#ifdef STSE_CONF_USE_HOST_SESSION
+    /* - Protect command and response frames under active host session */
+    pTransfer->protected_transfer = (pCmd_info->cmd_encryption_flag || pCmd_info->rsp_encryption_flag || (pCmd_info->cmd_ac_info != STSE_CMD_AC_FREE));
+    if (pTransfer->protected_transfer) {
+        if ((pSTSE->pActive_host_session == NULL) || (pSTSE->pActive_host_session->type != STSE_HOST_SESSION)) {
+            ret = STSE_SERVICE_SESSION_ERROR;
+        } else if (((pCmd_info->cmd_encryption_flag == 1) && (stsafea_session_encrypted_payload_size(pCmdFrame) > STSE_CONF_ASYNC_TRANSFER_BUFFER_SIZE)) ||
+                   (stsafea_session_rsp_staging_size(pRspFrame, pCmd_info->rsp_encryption_flag) > STSE_CONF_ASYNC_TRANSFER_BUFFER_SIZE)) {
+            ret = STSE_SERVICE_FRAME_SIZE_ERROR;
+        } else {
+            ret = stsafea_session_transfer_prepare(&pTransfer->session_ctx,
+                                                   pSTSE->pActive_host_session,
+                                                   pCmdFrame,
+                                                   pRspFrame,
+                                                   pCmd_info->cmd_encryption_flag,
+                                                   pCmd_info->rsp_encryption_flag,
+                                                   pTransfer->encrypted_cmd_payload,
+                                                   pTransfer->encrypted_rsp_payload);
+        }
+    }
+#endif /* STSE_CONF_USE_HOST_SESSION */
+
+    if (ret == STSE_OK) {
+        /* - Send command Frame */
+        ret = stsafea_frame_transmit(pSTSE, pCmdFrame);
+#ifdef STSE_CMD_METRICS
+        stse_cmd_metrics_tx_end(pSTSE);
+#endif /* STSE_CMD_METRICS */
+#ifdef STSE_CONF_USE_HOST_SESSION
+        if ((ret != STSE_OK) && pTransfer->protected_transfer) {
+            ret = stsafea_session_transfer_finalize(&pTransfer->session_ctx, pCmdFrame, pRspFrame, ret);
+        }
+#endif /* STSE_CONF_USE_HOST_SESSION */
+    }
+
+    /* - Close the command retry and metrics records when the transfer is not started */
+    if (ret != STSE_OK) {
+#ifdef STSE_USE_RETRY_POLICY
+        stse_retry_command_end(pSTSE);
+#endif /* STSE_USE_RETRY_POLICY */
+#ifdef STSE_CMD_METRICS
+        stse_cmd_metrics_command_end(pSTSE, pCmdFrame, pRspFrame, ret);
+#endif /* STSE_CMD_METRICS */
+        return ret;
+    }
+
+#if defined(STSE_CONF_USE_HOST_SESSION) && defined(STSE_CONF_USE_PLATFORM_AES_CMAC_CTX)
+    /* - Precompute response protection while target STSAFE executes the command
+     *   (on failure , precomputation is performed again and reported by session transfer finalization) */
+    if (pTransfer->protected_transfer) {
+        (void)stsafea_session_transfer_rsp_precompute(&pTransfer->session_ctx, pCmdFrame);
+    }
+#endif /* STSE_CONF_USE_HOST_SESSION && STSE_CONF_USE_PLATFORM_AES_CMAC_CTX */
+
+    /* - Report delay to wait before first response poll */
+    pTransfer->processing_time = stsafea_frame_rsp_delay_get(pSTSE, pCmdFrame, pCmd_info->inter_frame_delay);
+    pTransfer->state = STSAFEA_TRANSFER_PENDING;
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stsafea_frame_transfer_submit(stse_Handler_t *pSTSE,
+                                                stsafea_transfer_t *pTransfer,
+                                                stse_frame_t *pCmdFrame,
+                                                stse_frame_t *pRspFrame,
+                                                stsafea_transfer_callback_t pCallback,
+                                                void *pUser_context) {
+    stse_ReturnCode_t ret;
+    stsafea_frame_cmd_info_t cmd_info;
+
+    /*- Verify Parameters */
+    if ((pSTSE == NULL) || (pTransfer == NULL) || (pCmdFrame == NULL) || (pRspFrame == NULL)) {
+        return STSE_SERVICE_INVALID_PARAMETER;
+    }
+
+    ret = stsafea_frame_cmd_info_get(pSTSE, pCmdFrame, &cmd_info);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+
+    pTransfer->pCallback = pCallback;
+    pTransfer->pUser_context = pUser_context;
+
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+    /* - Device lock is held until transfer completion */
+    ret = stse_handler_lock(pSTSE);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+
+    ret = stsafea_frame_transfer_start(pSTSE, pTransfer, pCmdFrame, pRspFrame, &cmd_info);
+    if (ret != STSE_OK) {
+        stse_handler_unlock(pSTSE);
+    }
+
+    return ret;
+#else
+    return stsafea_frame_transfer_start(pSTSE, pTransfer, pCmdFrame, pRspFrame, &cmd_info);
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
+}
+
+stse_ReturnCode_t stsafea_frame_transfer_poll(stsafea_transfer_t *pTransfer) {
+    stse_ReturnCode_t ret;
+
+    /*- Verify Parameters */
+    if ((pTransfer == NULL) || (pTransfer->state != STSAFEA_TRANSFER_PENDING)) {
+        return STSE_SERVICE_INVALID_PARAMETER;
+    }
+
+#ifdef STSE_USE_IO_LINE_RSP_WAIT
+    /* - No bus transaction while device ready line is not asserted */
+    if ((pTransfer->pSTSE->io.IOLineReady != NULL) &&
+        (pTransfer->pSTSE->io.IOLineReady(pTransfer->pSTSE->io.busID, pTransfer->pSTSE->io.Devaddr) != STSE_OK)) {
+        pTransfer->poll_count++;
+        if (stse_retry_next(pTransfer->pSTSE, &pTransfer->retry, &pTransfer->poll_interval) != 0) {
+            return STSE_SERVICE_TRANSFER_PENDING;
+        }
+    }
+#endif /* STSE_USE_IO_LINE_RSP_WAIT */
+
+    /* - Single response reception attempt */
+    ret = stsafea_frame_receive_polled(pTransfer->pSTSE, pTransfer->pRspFrame, 1, NULL);
+    if (ret == STSE_PLATFORM_BUS_ACK_ERROR) {
+        pTransfer->poll_count++;
+        if (stse_retry_next(pTransfer->pSTSE, &pTransfer->retry, &pTransfer->poll_interval) != 0) {
+            return STSE_SERVICE_TRANSFER_PENDING;
+        }
+    }
+
+#ifdef STSE_FRAME_TRACE
+    stse_frame_trace_record(pTransfer->pSTSE, STSE_FRAME_TRACE_RSP, pTransfer->pRspFrame, ret);
+#endif /* STSE_FRAME_TRACE */
+
+#ifdef STSE_USE_RETRY_POLICY
+    stse_retry_command_end(pTransfer->pSTSE);
+#endif /* STSE_USE_RETRY_POLICY */
+#ifdef STSE_CMD_METRICS
+    stse_cmd_metrics_command_end(pTransfer->pSTSE, pTransfer->pCmdFrame, pTransfer->pRspFrame, ret);
+#endif /* STSE_CMD_METRICS */
+
+#ifdef STSE_USE_ADAPTIVE_RSP_POLLING
+    /* - Update command execution time statistics when target STSAFE has responded */
+    if (ret <= 0xFF) {
+        stsafea_frame_rsp_delay_record(pTransfer->pSTSE, pTransfer->pCmdFrame, pTransfer->processing_time, pTransfer->poll_count);
+    }
+#endif /* STSE_USE_ADAPTIVE_RSP_POLLING */
+
+#ifdef STSE_CONF_USE_HOST_SESSION
+    /* - Verify and decrypt response under active host session */
+    if (pTransfer->protected_transfer) {
+        ret = stsafea_session_transfer_finalize(&pTransfer->session_ctx, pTransfer->pCmdFrame, pTransfer->pRspFrame, ret);
+    }
+#endif /* STSE_CONF_USE_HOST_SESSION */
+
+    pTransfer->state = STSAFEA_TRANSFER_IDLE;
+
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+    stse_handler_unlock(pTransfer->pSTSE);
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
+
+    /* - Notify transfer completion */
+    if (pTransfer->pCallback != NULL) {
+        pTransfer->pCallback(pTransfer, ret);
+    }
+
+    return ret;
+}
+
+#endif /* STSE_CONF_USE_ASYNC_TRANSFER */
+
 #endif /* STSE_CONF_STSAFE_A_SUPPORT **/
@@ -26,13 +26,74 @@
 
 #include "core/stse_device.h"
 #include "core/stse_platform.h"
+#include "core/stse_retry.h"
 #include "core/stse_return_codes.h"
 #include "core/stse_util.h"
+#include "services/stsafea/stsafea_sessions.h"
 
 #define STSAFEA_PRODUCT_COUNT 3U
 
 extern const PLAT_UI16 stsafea_maximum_frame_length[STSAFEA_PRODUCT_COUNT];
 
+/*!
+ * \brief STSAFE-A frame batch entry
+ * \details Command / response frame pair of a \ref stsafea_frame_transfer_batch call and its individual report
+ */
+typedef struct stsafea_frame_batch_entry_t {
+    stse_frame_t *pCmdFrame;   /*!< Command frame */
+    stse_frame_t *pRspFrame;   /*!< Response frame */
+    stse_ReturnCode_t status;  /*!< Transfer status (\ref STSE_SERVICE_TRANSFER_PENDING if not performed) */
+    PLAT_UI16 processing_time; /*!< Delay waited before first response poll (in ms) */
+    PLAT_UI16 poll_count;      /*!< Number of response polls NACKed by target STSAFE */
+} stsafea_frame_batch_entry_t;
+
+#ifdef STSE_CONF_USE_ASYNC_TRANSFER
+
+#ifndef STSE_CONF_ASYNC_TRANSFER_BUFFER_SIZE
+#define STSE_CONF_ASYNC_TRANSFER_BUFFER_SIZE STSAFEA_MAX_FRAME_LENGTH_A120 /*!< Size of the encrypted command payload buffer of an asynchronous transfer */
+#endif /* STSE_CONF_ASYNC_TRANSFER_BUFFER_SIZE */
+
+typedef struct stsafea_transfer_t stsafea_transfer_t;
+
+/*!
+ * \brief STSAFE-A asynchronous transfer completion callback
+ */
+typedef void (*stsafea_transfer_callback_t)(stsafea_transfer_t *pTransfer, stse_ReturnCode_t status);
+
+/*!
+ * \brief STSAFE-A asynchronous transfer state
+ */
+typedef enum stsafea_transfer_state_t {
+    STSAFEA_TRANSFER_IDLE = 0, /*!< No transfer in progress */
+    STSAFEA_TRANSFER_PENDING   /*!< Command sent, waiting for target STSAFE response */
+} stsafea_transfer_state_t;
+
+/*!
+ * \brief STSAFE-A asynchronous transfer context
+ * \details The context, the command frame and the response frame (including all their elements) must remain
+ *          valid from \ref stsafea_frame_transfer_submit until transfer completion
+ */
+struct stsafea_transfer_t {
+    stse_Handler_t *pSTSE;                 /*!< Target STSE handler */
+    stse_frame_t *pCmdFrame;               /*!< Command frame */
+    stse_frame_t *pRspFrame;               /*!< Response frame */
+    stsafea_transfer_state_t state;        /*!< Transfer state */
+    PLAT_UI16 processing_time;             /*!< Delay to wait before first response poll (in ms) */
+    PLAT_UI16 poll_count;                  /*!< Number of response polls NACKed by target STSAFE */
+    PLAT_UI16 poll_interval;               /*!< Delay to wait before next response poll (in ms) */
+    stse_retry_t retry;                    /*!< Response polling retry state */
+    stsafea_transfer_callback_t pCallback; /*!< Completion callback (optional) */
+    void *pUser_context;                   /*!< Completion callback user context */
+#ifdef STSE_CONF_USE_HOST_SESSION
+    PLAT_UI8 protected_transfer;                                          /*!< Transfer protected under active host session */
+    stsafea_session_transfer_ctx_t session_ctx;                           /*!< Session transfer context */
+    PLAT_UI8 encrypted_cmd_payload[STSE_CONF_ASYNC_TRANSFER_BUFFER_SIZE]; /*!< Encrypted command payload buffer */
+    PLAT_UI8 encrypted_rsp_payload[STSE_CONF_ASYNC_TRANSFER_BUFFER_SIZE]; /*!< Encrypted response staging buffer */
+#endif                                                                    /* STSE_CONF_USE_HOST_SESSION */
+};
+
+#endif /* STSE_CONF_USE_ASYNC_TRANSFER */
+
 /**
  * \brief 			Transmit frame from target STSAFE-Axxx
  * \details 		This core function prepare frame CRC and send frame to target STSAFE-Axxx device
@@ -67,6 +128,40 @@ stse_ReturnCode_t stsafea_frame_raw_transfer(stse_Handler_t *pSTSE,
                                              stse_frame_t *pRspFrame,
                                              PLAT_UI16 inter_frame_delay);
 
+/**
+ * \brief 			Transfer Raw Frames to/from target STSAFE-Axx (device lock held by caller)
+ * \details 		Same as \ref stsafea_frame_raw_transfer without taking the device lock. To be used by services
+ *                  performing a command transaction under \ref stse_handler_lock (STSE_CONF_USE_THREAD_SAFETY)
+ * \param[in] 		pSTSE 			Pointer to STSE Handler
+ * \param[in] 		pCmdFrame 			Pointer to the command frame
+ * \param[in,out] 	pRspFrame 			Pointer to the response frame
+ * \param[in] 		inter_frame_delay 	Delay between command and response frame (in ms)
+ * \return 			\ref STSE_OK on success ; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stsafea_frame_raw_transfer_unlocked(stse_Handler_t *pSTSE,
+                                                      stse_frame_t *pCmdFrame,
+                                                      stse_frame_t *pRspFrame,
+                                                      PLAT_UI16 inter_frame_delay);
+
+#ifdef STSE_CONF_USE_HOST_SESSION
+/**
+ * \brief 			Transfer session protected Frames to/from target STSAFE-Axx (device lock held by caller)
+ * \details 		Same as \ref stsafea_frame_raw_transfer_unlocked , the response protection of the session transfer
+ *                  context is precomputed (\ref stsafea_session_transfer_rsp_precompute) while target STSAFE executes the command
+ * \param[in] 		pSTSE 			Pointer to STSE Handler
+ * \param[in] 		pCmdFrame 			Pointer to the command frame (prepared by \ref stsafea_session_transfer_prepare)
+ * \param[in,out] 	pRspFrame 			Pointer to the response frame (prepared by \ref stsafea_session_transfer_prepare)
+ * \param[in,out] 	pSession_ctx 		Pointer to the session transfer context
+ * \param[in] 		inter_frame_delay 	Delay between command and response frame (in ms)
+ * \return 			\ref STSE_OK on success ; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stsafea_frame_session_raw_transfer_unlocked(stse_Handler_t *pSTSE,
+                                                              stse_frame_t *pCmdFrame,
+                                                              stse_frame_t *pRspFrame,
+                                                              stsafea_session_transfer_ctx_t *pSession_ctx,
+                                                              PLAT_UI16 inter_frame_delay);
+#endif /* STSE_CONF_USE_HOST_SESSION */
+
 /**
  * \brief 			Transfer Frames to/from target STSAFE-Axx
  * \details 		This core function send and receive frame to/from target STSAFE-Axxx device
@@ -79,6 +174,71 @@ stse_ReturnCode_t stsafea_frame_transfer(stse_Handler_t *pSTSE,
                                          stse_frame_t *pCmdFrame,
                                          stse_frame_t *pRspFrame);
 
+/**
+ * \brief 			Transfer a batch of Frames to/from target STSAFE-Axx
+ * \details 		This core function verifies all command frames and resolves their processing time and
+ *                  protection (host session) attributes before sending the first one, then performs the transfers
+ *                  back to back. The batch is stopped on the first failing transfer.
+ * \param[in] 		pSTSE 			Pointer to STSE Handler
+ * \param[in,out] 	pEntries 		Array of batch entries (status, processing time and poll count are updated)
+ * \param[in] 		entry_count 	Number of batch entries
+ * \return 			\ref STSE_OK when all transfers succeed ; status of the first failing entry otherwise
+ */
+stse_ReturnCode_t stsafea_frame_transfer_batch(stse_Handler_t *pSTSE,
+                                               stsafea_frame_batch_entry_t *pEntries,
+                                               PLAT_UI8 entry_count);
+
+#ifdef STSE_USE_ZERO_COPY_RSP
+/**
+ * \brief 			Check response view support for a command
+ * \details 		Response frame elements allocated with a NULL data pointer are returned as views on the received
+ *                  frame (driver owned buffer valid until the next bus transaction) when the platform provides the
+ *                  zero-copy receive callback (\ref stse_io_t::BusRecvFrame) and the command response is not encrypted
+ * \param[in] 		pSTSE 			Pointer to STSE Handler
+ * \param[in] 		cmd_header 		Command code
+ * \return 			\ref STSE_OK when response views are supported ; \ref STSE_SERVICE_INVALID_PARAMETER otherwise
+ */
+stse_ReturnCode_t stsafea_frame_rsp_view_check(stse_Handler_t *pSTSE, PLAT_UI8 cmd_header);
+#endif /* STSE_USE_ZERO_COPY_RSP */
+
+#ifdef STSE_CONF_USE_ASYNC_TRANSFER
+
+/**
+ * \brief 			Submit Frames transfer to target STSAFE-Axx
+ * \details 		This core function protects the command frame under the active host session (if required by
+ *                  the command access conditions) and sends it to the target STSAFE-Axxx device without waiting
+ *                  for the command execution. The response is then collected using \ref stsafea_frame_transfer_poll
+ *                  once pTransfer->processing_time has elapsed. When STSE_CONF_USE_THREAD_SAFETY is defined, the
+ *                  device lock is held until transfer completion (submit and poll from the same thread).
+ * \param[in] 		pSTSE 				Pointer to STSE Handler
+ * \param[out] 		pTransfer 			Pointer to the asynchronous transfer context
+ * \param[in] 		pCmdFrame 			Pointer to the command frame
+ * \param[in,out] 	pRspFrame 			Pointer to the response frame
+ * \param[in] 		pCallback 			Completion callback (NULL if not used)
+ * \param[in] 		pUser_context 		Completion callback user context
+ * \return 			\ref STSE_OK on success ; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stsafea_frame_transfer_submit(stse_Handler_t *pSTSE,
+                                                stsafea_transfer_t *pTransfer,
+                                                stse_frame_t *pCmdFrame,
+                                                stse_frame_t *pRspFrame,
+                                                stsafea_transfer_callback_t pCallback,
+                                                void *pUser_context);
+
+/**
+ * \brief 			Poll submitted Frames transfer
+ * \details 		This core function performs a single response reception attempt without blocking delay. On reception,
+ *                  the response is verified (and decrypted) under the active host session and the completion callback
+ *                  is called. The transfer fails with the bus NACK code once the response polling retries are exhausted,
+ *                  next polling is then expected after pTransfer->poll_interval ms.
+ * \param[in,out] 	pTransfer 			Pointer to the asynchronous transfer context
+ * \return 			\ref STSE_SERVICE_TRANSFER_PENDING while target STSAFE is processing the command ;
+ *                  transfer status (\ref STSE_OK on success ; \ref stse_ReturnCode_t error code otherwise) on completion
+ */
+stse_ReturnCode_t stsafea_frame_transfer_poll(stsafea_transfer_t *pTransfer);
+
+#endif /* STSE_CONF_USE_ASYNC_TRANSFER */
+
 /*! @}*/
 
 #endif /* STSAFEA_FRAME_TRANSFER_H */
@@ -21,6 +21,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "core/stse_cmd_metrics.h"
 #include "services/stsafea/stsafea_aes.h"
 #include "services/stsafea/stsafea_commands.h"
 #include "services/stsafea/stsafea_frame_transfer.h"
@@ -35,6 +36,16 @@
 #define STSAFEA_AES_SUBJECT_HOST_ENCRYPT 0x80U
 #define STSAFEA_AES_FIRST_PADDING_BYTE 0x80U
 
+/* Private typedef -----------------------------------------------------------*/
+
+/*
+ * Frame element cursor : walks the payload bytes of a frame element chain , consumed and empty elements are skipped
+ */
+typedef struct {
+    stse_frame_element_t *pElement;
+    PLAT_UI16 offset;
+} stsafea_session_element_cursor_t;
+
 /* Private variables ---------------------------------------------------------*/
 
 /* Public functions ----------------------------------------------------------*/
@@ -43,6 +54,11 @@
 
 stse_ReturnCode_t stsafea_open_host_session(stse_Handler_t *pSTSE, stse_session_t *pSession, PLAT_UI8 *pHost_MAC_key, PLAT_UI8 *pHost_cypher_key) {
     stse_ReturnCode_t ret;
+#ifdef STSE_CONF_USE_HOST_SESSION_KEY_HANDLES
+    PLAT_UI16 key_length;
+    stse_platform_aes_key_handle_t MAC_key_handle;
+    stse_platform_aes_key_handle_t cypher_key_handle;
+#endif /* STSE_CONF_USE_HOST_SESSION_KEY_HANDLES */
 
     if (pSTSE == NULL) {
         return STSE_SERVICE_HANDLER_NOT_INITIALISED;
@@ -80,6 +96,22 @@ stse_ReturnCode_t stsafea_open_host_session(stse_Handler_t *pSTSE, stse_session_
         pSession->context.host.MAC_counter = ARRAY_3B_SWAP_TO_UI32(host_key_slot.cmac_sequence_counter);
     }
 
+#ifdef STSE_CONF_USE_HOST_SESSION_KEY_HANDLES
+    /* - Expand host keys once for the session lifetime */
+    key_length = (pSession->context.host.key_type == STSE_AES_128_KT) ? STSE_AES_128_KEY_SIZE : STSE_AES_256_KEY_SIZE;
+    ret = stse_platform_aes_key_handle_create(pHost_MAC_key, key_length, &MAC_key_handle);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+    ret = stse_platform_aes_key_handle_create(pHost_cypher_key, key_length, &cypher_key_handle);
+    if (ret != STSE_OK) {
+        stse_platform_aes_key_handle_destroy(MAC_key_handle);
+        return ret;
+    }
+    pSession->context.host.pHost_MAC_key_handle = MAC_key_handle;
+    pSession->context.host.pHost_cypher_key_handle = cypher_key_handle;
+#endif /* STSE_CONF_USE_HOST_SESSION_KEY_HANDLES */
+
     pSession->type = STSE_HOST_SESSION;
     pSession->context.host.pHost_MAC_key = pHost_MAC_key;
     pSession->context.host.pHost_cypher_key = pHost_cypher_key;
@@ -101,6 +133,16 @@ void stsafea_close_host_session(stse_session_t *pSession) {
         pSession->context.host.pSTSE->pActive_host_session = NULL;
     }
 
+#ifdef STSE_CONF_USE_HOST_SESSION_KEY_HANDLES
+    /* - Release pre-expanded host keys */
+    if (pSession->context.host.pHost_MAC_key_handle != NULL) {
+        stse_platform_aes_key_handle_destroy(pSession->context.host.pHost_MAC_key_handle);
+    }
+    if (pSession->context.host.pHost_cypher_key_handle != NULL) {
+        stse_platform_aes_key_handle_destroy(pSession->context.host.pHost_cypher_key_handle);
+    }
+#endif /* STSE_CONF_USE_HOST_SESSION_KEY_HANDLES */
+
     /* - Clear session context */
     stsafea_session_clear_context(pSession);
 }
@@ -130,169 +172,437 @@ stse_ReturnCode_t stsafea_set_active_host_session(stse_Handler_t *pSTSE, stse_se
     return (STSE_OK);
 }
 
-stse_ReturnCode_t stsafea_session_frame_encrypt(stse_session_t *pSession,
-                                                stse_frame_t *pFrame,
-                                                stse_frame_element_t *pEnc_payload_element) {
-    stse_ReturnCode_t ret;
-    PLAT_UI8 initial_value[STSAFEA_HOST_AES_BLOCK_SIZE];
-    stse_frame_element_t *pElement;
+static stse_ReturnCode_t stsafea_session_ecb_enc(stse_session_t *pSession,
+                                                 PLAT_UI8 *pPlaintext,
+                                                 PLAT_UI16 plaintext_length,
+                                                 PLAT_UI8 *pEncryptedtext,
+                                                 PLAT_UI16 *pEncryptedtext_length) {
+#ifdef STSE_CONF_USE_HOST_SESSION_KEY_HANDLES
+    return stse_platform_aes_key_handle_ecb_enc(pSession->context.host.pHost_cypher_key_handle,
+                                                pPlaintext,
+                                                plaintext_length,
+                                                pEncryptedtext,
+                                                pEncryptedtext_length);
+#else
+    return stse_platform_aes_ecb_enc(pPlaintext,
+                                     plaintext_length,
+                                     pSession->context.host.pHost_cypher_key,
+                                     (pSession->context.host.key_type == STSE_AES_128_KT) ? STSE_AES_128_KEY_SIZE : STSE_AES_256_KEY_SIZE,
+                                     pEncryptedtext,
+                                     pEncryptedtext_length);
+#endif /* STSE_CONF_USE_HOST_SESSION_KEY_HANDLES */
+}
+
+static stse_ReturnCode_t stsafea_session_cbc_enc(stse_session_t *pSession,
+                                                 PLAT_UI8 *pPlaintext,
+                                                 PLAT_UI16 plaintext_length,
+                                                 PLAT_UI8 *pInitial_value,
+                                                 PLAT_UI8 *pEncryptedtext,
+                                                 PLAT_UI16 *pEncryptedtext_length) {
+#ifdef STSE_CONF_USE_HOST_SESSION_KEY_HANDLES
+    return stse_platform_aes_key_handle_cbc_enc(pSession->context.host.pHost_cypher_key_handle,
+                                                pPlaintext,
+                                                plaintext_length,
+                                                pInitial_value,
+                                                pEncryptedtext,
+                                                pEncryptedtext_length);
+#else
+    return stse_platform_aes_cbc_enc(pPlaintext,
+                                     plaintext_length,
+                                     pInitial_value,
+                                     pSession->context.host.pHost_cypher_key,
+                                     (pSession->context.host.key_type == STSE_AES_128_KT) ? STSE_AES_128_KEY_SIZE : STSE_AES_256_KEY_SIZE,
+                                     pEncryptedtext,
+                                     pEncryptedtext_length);
+#endif /* STSE_CONF_USE_HOST_SESSION_KEY_HANDLES */
+}
+
+static stse_ReturnCode_t stsafea_session_cbc_dec(stse_session_t *pSession,
+                                                 PLAT_UI8 *pEncryptedtext,
+                                                 PLAT_UI16 encryptedtext_length,
+                                                 PLAT_UI8 *pInitial_value,
+                                                 PLAT_UI8 *pPlaintext,
+                                                 PLAT_UI16 *pPlaintext_length) {
+#ifdef STSE_CONF_USE_HOST_SESSION_KEY_HANDLES
+    return stse_platform_aes_key_handle_cbc_dec(pSession->context.host.pHost_cypher_key_handle,
+                                                pEncryptedtext,
+                                                encryptedtext_length,
+                                                pInitial_value,
+                                                pPlaintext,
+                                                pPlaintext_length);
+#else
+    return stse_platform_aes_cbc_dec(pEncryptedtext,
+                                     encryptedtext_length,
+                                     pInitial_value,
+                                     pSession->context.host.pHost_cypher_key,
+                                     (pSession->context.host.key_type == STSE_AES_128_KT) ? STSE_AES_128_KEY_SIZE : STSE_AES_256_KEY_SIZE,
+                                     pPlaintext,
+                                     pPlaintext_length);
+#endif /* STSE_CONF_USE_HOST_SESSION_KEY_HANDLES */
+}
+
+static stse_ReturnCode_t stsafea_session_cmac_init(stse_session_t *pSession,
+                                                   stse_platform_aes_cmac_ctx_t *pCmac_ctx) {
+#ifdef STSE_CONF_USE_HOST_SESSION_KEY_HANDLES
+    return stse_platform_aes_key_handle_cmac_init(pCmac_ctx,
+                                                  pSession->context.host.pHost_MAC_key_handle,
+                                                  STSAFEA_MAC_SIZE);
+#else
+    return stse_platform_aes_cmac_ctx_init(pCmac_ctx,
+                                           pSession->context.host.pHost_MAC_key,
+                                           (pSession->context.host.key_type == STSE_AES_128_KT) ? STSE_AES_128_KEY_SIZE : STSE_AES_256_KEY_SIZE,
+                                           STSAFEA_MAC_SIZE);
+#endif /* STSE_CONF_USE_HOST_SESSION_KEY_HANDLES */
+}
+
+static void stsafea_session_block_prepare(stse_session_t *pSession,
+                                          PLAT_UI32 counter,
+                                          PLAT_UI8 subject,
+                                          PLAT_UI8 *pBlock) {
+    PLAT_UI8 i = 0;
+
+    /*- [MAC COUNTER] [SUBJECT] [0x80] [0x00 padding] */
+    if (pSession->context.host.pSTSE->device_type == STSAFE_A120) {
+        pBlock[i++] = UI32_B3(counter);
+    }
+    pBlock[i++] = UI32_B2(counter);
+    pBlock[i++] = UI32_B1(counter);
+    pBlock[i++] = UI32_B0(counter);
+    pBlock[i++] = subject;
+    pBlock[i++] = STSAFEA_AES_FIRST_PADDING_BYTE;
+    (void)memset(&pBlock[i], 0x00, STSAFEA_HOST_AES_BLOCK_SIZE - i);
+}
+
+static PLAT_UI16 stsafea_session_cursor_run(stsafea_session_element_cursor_t *pCursor) {
+    /*- Skip consumed and empty elements */
+    while ((pCursor->pElement != NULL) && (pCursor->offset == pCursor->pElement->length)) {
+        pCursor->pElement = pCursor->pElement->next;
+        pCursor->offset = 0;
+    }
+
+    if (pCursor->pElement == NULL) {
+        return 0;
+    }
+
+    return pCursor->pElement->length - pCursor->offset;
+}
+
+static PLAT_UI16 stsafea_session_cursor_read(stsafea_session_element_cursor_t *pCursor,
+                                             PLAT_UI8 *pBlock,
+                                             PLAT_UI16 length) {
+    PLAT_UI16 chunk_length;
     PLAT_UI16 i = 0;
 
+    while (i < length) {
+        chunk_length = stsafea_session_cursor_run(pCursor);
+        if (chunk_length == 0) {
+            break;
+        }
+        if (chunk_length > (length - i)) {
+            chunk_length = length - i;
+        }
+        memcpy(pBlock + i, pCursor->pElement->pData + pCursor->offset, chunk_length);
+        pCursor->offset += chunk_length;
+        i += chunk_length;
+    }
+
+    return i;
+}
+
+static void stsafea_session_cursor_write(stsafea_session_element_cursor_t *pCursor,
+                                         PLAT_UI8 *pBlock,
+                                         PLAT_UI16 length) {
+    PLAT_UI16 chunk_length;
+
+    while (length != 0) {
+        chunk_length = stsafea_session_cursor_run(pCursor);
+        if (chunk_length == 0) {
+            break;
+        }
+        if (chunk_length > length) {
+            chunk_length = length;
+        }
+        memcpy(pCursor->pElement->pData + pCursor->offset, pBlock, chunk_length);
+        pCursor->offset += chunk_length;
+        pBlock += chunk_length;
+        length -= chunk_length;
+    }
+}
+
+static stse_ReturnCode_t stsafea_session_cmac_feed(stsafea_session_cmac_feeder_t *pFeeder,
+                                                   PLAT_UI8 *pData,
+                                                   PLAT_UI16 length) {
+    stse_ReturnCode_t ret;
+    PLAT_UI16 chunk_length;
+
+    /*- Complete the staged block first */
+    if (pFeeder->block_length != 0) {
+        chunk_length = STSAFEA_HOST_AES_BLOCK_SIZE - pFeeder->block_length;
+        if (chunk_length > length) {
+            chunk_length = length;
+        }
+        memcpy(pFeeder->block + pFeeder->block_length, pData, chunk_length);
+        pFeeder->block_length += chunk_length;
+        pData += chunk_length;
+        length -= chunk_length;
+
+        if (pFeeder->block_length < STSAFEA_HOST_AES_BLOCK_SIZE) {
+            return STSE_OK;
+        }
+        ret = stse_platform_aes_cmac_ctx_append(pFeeder->pCmac_ctx, pFeeder->block, STSAFEA_HOST_AES_BLOCK_SIZE);
+        if (ret != STSE_OK) {
+            return ret;
+        }
+        pFeeder->block_length = 0;
+    }
+
+    /*- Pass whole blocks straight from the source buffer */
+    chunk_length = length - (length % STSAFEA_HOST_AES_BLOCK_SIZE);
+    if (chunk_length != 0) {
+        ret = stse_platform_aes_cmac_ctx_append(pFeeder->pCmac_ctx, pData, chunk_length);
+        if (ret != STSE_OK) {
+            return ret;
+        }
+        pData += chunk_length;
+        length -= chunk_length;
+    }
+
+    /*- Stage the remaining bytes */
+    memcpy(pFeeder->block, pData, length);
+    pFeeder->block_length = (PLAT_UI8)length;
+
+    return STSE_OK;
+}
+
+static stse_ReturnCode_t stsafea_session_cmac_feed_elements(stsafea_session_cmac_feeder_t *pFeeder,
+                                                            stse_frame_element_t *pElement) {
+    stse_ReturnCode_t ret = STSE_OK;
+
+    while ((pElement != NULL) && (ret == STSE_OK)) {
+        if (pElement->length != 0) {
+            ret = stsafea_session_cmac_feed(pFeeder, pElement->pData, pElement->length);
+        }
+        pElement = pElement->next;
+    }
+
+    return ret;
+}
+
+static stse_ReturnCode_t stsafea_session_cmac_flush(stsafea_session_cmac_feeder_t *pFeeder) {
+    stse_ReturnCode_t ret = STSE_OK;
+
+    /*- Flush the staged bytes */
+    if (pFeeder->block_length != 0) {
+        ret = stse_platform_aes_cmac_ctx_append(pFeeder->pCmac_ctx, pFeeder->block, pFeeder->block_length);
+        pFeeder->block_length = 0;
+    }
+
+    return ret;
+}
+
+static stse_ReturnCode_t stsafea_session_frame_encrypt(stse_session_t *pSession,
+                                                       stse_frame_t *pFrame,
+                                                       stse_frame_element_t *pEnc_payload_element,
+                                                       stsafea_session_cmac_feeder_t *pFeeder) {
+    stse_ReturnCode_t ret;
+    stsafea_session_element_cursor_t cursor;
+    PLAT_UI8 chaining_value[STSAFEA_HOST_AES_BLOCK_SIZE];
+    PLAT_UI8 block[STSAFEA_HOST_AES_BLOCK_SIZE];
+    PLAT_UI8 *pPlaintext;
+    PLAT_UI8 *pEncrypted;
+    PLAT_UI16 remaining_length;
+    PLAT_UI16 chunk_length;
+    PLAT_UI16 out_length;
+    PLAT_UI8 padding_added = 0;
+
     /* - Verify parameters */
     if ((pSession == NULL) ||
         (pFrame == NULL) ||
         (pEnc_payload_element == NULL) ||
+        (pFeeder == NULL) ||
         (pEnc_payload_element->length < (pFrame->length - pFrame->first_element->length + (16 - (pFrame->length - pFrame->first_element->length) % 16)))) {
         return (STSE_SERVICE_INVALID_PARAMETER);
     }
 
     /* - Prepare specific STSAFE AES IV */
-    if (pSession->context.host.pSTSE->device_type == STSAFE_A120) {
-        initial_value[0] = UI32_B3(pSession->context.host.MAC_counter + 1);
-        initial_value[1] = UI32_B2(pSession->context.host.MAC_counter + 1);
-        initial_value[2] = UI32_B1(pSession->context.host.MAC_counter + 1);
-        initial_value[3] = UI32_B0(pSession->context.host.MAC_counter + 1);
-        initial_value[4] = STSAFEA_AES_SUBJECT_HOST_ENCRYPT;
-        initial_value[5] = STSAFEA_AES_FIRST_PADDING_BYTE;
-        (void)memset(&initial_value[6], 0x00, (STSAFEA_HOST_AES_BLOCK_SIZE)-6U);
-    } else {
-        initial_value[0] = UI32_B2(pSession->context.host.MAC_counter + 1);
-        initial_value[1] = UI32_B1(pSession->context.host.MAC_counter + 1);
-        initial_value[2] = UI32_B0(pSession->context.host.MAC_counter + 1);
-        initial_value[3] = STSAFEA_AES_SUBJECT_HOST_ENCRYPT;
-        initial_value[4] = STSAFEA_AES_FIRST_PADDING_BYTE;
-        (void)memset(&initial_value[5], 0x00, (STSAFEA_HOST_AES_BLOCK_SIZE)-5U);
-    }
-
-    PLAT_UI16 encrypted_iv_len = STSAFEA_HOST_AES_BLOCK_SIZE;
+    stsafea_session_block_prepare(pSession,
+                                  pSession->context.host.MAC_counter + 1,
+                                  STSAFEA_AES_SUBJECT_HOST_ENCRYPT,
+                                  chaining_value);
 
     /* - Perform first AES ECB round on IV */
-    ret = stse_platform_aes_ecb_enc(initial_value,
-                                    STSAFEA_HOST_AES_BLOCK_SIZE,
-                                    pSession->context.host.pHost_cypher_key,
-                                    (pSession->context.host.key_type == STSE_AES_128_KT) ? STSE_AES_128_KEY_SIZE : STSE_AES_256_KEY_SIZE,
-                                    initial_value,
-                                    &encrypted_iv_len);
+    out_length = STSAFEA_HOST_AES_BLOCK_SIZE;
+    ret = stsafea_session_ecb_enc(pSession,
+                                  chaining_value,
+                                  STSAFEA_HOST_AES_BLOCK_SIZE,
+                                  chaining_value,
+                                  &out_length);
     if (ret != STSE_OK) {
         return (ret);
     }
-    /* - Copy Plain text Frame payload content in Ciphered   */
-    pElement = pFrame->first_element->next;
-    while (pElement != NULL) {
-        memcpy(pEnc_payload_element->pData + i,
-               pElement->pData,
-               pElement->length);
 
-        i += pElement->length;
-        pElement = pElement->next;
-    }
-    /* - Add First padding byte */
-    *(pEnc_payload_element->pData + i++) = 0x80;
+    /* - Encrypt Frame payload in a single pass , feeding each cipher block to the C-MAC */
+    cursor.pElement = pFrame->first_element->next;
+    cursor.offset = 0;
+    pEncrypted = pEnc_payload_element->pData;
+    remaining_length = pEnc_payload_element->length;
+    while (remaining_length != 0) {
+        chunk_length = stsafea_session_cursor_run(&cursor);
+        if (chunk_length >= STSAFEA_HOST_AES_BLOCK_SIZE) {
+            /* - Encrypt whole blocks straight from the plain text element */
+            chunk_length -= chunk_length % STSAFEA_HOST_AES_BLOCK_SIZE;
+            pPlaintext = cursor.pElement->pData + cursor.offset;
+            cursor.offset += chunk_length;
+        } else {
+            /* - Gather next block across elements and add padding after the last plain text byte */
+            out_length = stsafea_session_cursor_read(&cursor, block, STSAFEA_HOST_AES_BLOCK_SIZE);
+            if (out_length < STSAFEA_HOST_AES_BLOCK_SIZE) {
+                if (padding_added == 0) {
+                    block[out_length++] = STSAFEA_AES_FIRST_PADDING_BYTE;
+                    padding_added = 1;
+                }
+                (void)memset(&block[out_length], 0x00, STSAFEA_HOST_AES_BLOCK_SIZE - out_length);
+            }
+            chunk_length = STSAFEA_HOST_AES_BLOCK_SIZE;
+            pPlaintext = block;
+        }
 
-    /* - Add padding  */
-    while (i < pEnc_payload_element->length) {
-        *(pEnc_payload_element->pData + i++) = 0x00;
-    }
+        out_length = chunk_length;
+        ret = stsafea_session_cbc_enc(pSession,
+                                      pPlaintext,
+                                      chunk_length,
+                                      chaining_value,
+                                      pEncrypted,
+                                      &out_length);
+        if (ret != STSE_OK) {
+            return (STSE_SESSION_ERROR);
+        }
 
-    PLAT_UI16 encrypted_payload_len = pEnc_payload_element->length;
+        /* - Chain next blocks on last cipher block */
+        memcpy(chaining_value, pEncrypted + chunk_length - STSAFEA_HOST_AES_BLOCK_SIZE, STSAFEA_HOST_AES_BLOCK_SIZE);
 
-    /* - Encrypt pEncFrame content */
-    ret = stse_platform_aes_cbc_enc(
-        pEnc_payload_element->pData,
-        pEnc_payload_element->length,
-        initial_value,
-        pSession->context.host.pHost_cypher_key,
-        (pSession->context.host.key_type == STSE_AES_128_KT) ? STSE_AES_128_KEY_SIZE : STSE_AES_256_KEY_SIZE,
-        pEnc_payload_element->pData,
-        &encrypted_payload_len);
-    if (ret != 0) {
-        return (STSE_SESSION_ERROR);
-    } else {
-        return (STSE_OK);
+        ret = stsafea_session_cmac_feed(pFeeder, pEncrypted, chunk_length);
+        if (ret != STSE_OK) {
+            return ret;
+        }
+
+        pEncrypted += chunk_length;
+        remaining_length -= chunk_length;
     }
+
+    return (STSE_OK);
 }
 
-static stse_ReturnCode_t stsafea_session_frame_decrypt(stse_session_t *pSession, stse_frame_t *pFrame) {
+static stse_ReturnCode_t stsafea_session_frame_decrypt(stse_session_t *pSession,
+                                                       stse_frame_t *pFrame,
+                                                       PLAT_UI8 *pInitial_value) {
     stse_ReturnCode_t ret;
-    PLAT_UI8 initial_value[STSAFEA_HOST_AES_BLOCK_SIZE];
-    stse_frame_element_t *pElement;
-    PLAT_UI16 i = 0;
-    PLAT_UI16 encrypted_payload_len;
-
-    pElement = pFrame->first_element->next;
-    if (pElement == NULL) {
+    stsafea_session_element_cursor_t cursor;
+    stsafea_session_element_cursor_t block_cursor;
+    PLAT_UI8 chaining_value[STSAFEA_HOST_AES_BLOCK_SIZE];
+    PLAT_UI8 next_chaining_value[STSAFEA_HOST_AES_BLOCK_SIZE];
+    PLAT_UI8 block[STSAFEA_HOST_AES_BLOCK_SIZE];
+    PLAT_UI8 *pEncrypted;
+    PLAT_UI16 remaining_length;
+    PLAT_UI16 chunk_length;
+    PLAT_UI16 out_length;
+
+    if (pFrame->first_element->next == NULL) {
         return STSE_OK;
     }
 
-    /* Total length of the encrypted part of the frame */
-    encrypted_payload_len = pFrame->length - pFrame->first_element->length;
-
-    /* Fill decrypt buffer with encrypted payload content */
-    PLAT_UI8 decrypt_buffer[encrypted_payload_len];
+    /* Total length of the encrypted part of the frame (response elements and padding element) */
+    remaining_length = pFrame->length - pFrame->first_element->length;
+    if ((remaining_length % STSAFEA_HOST_AES_BLOCK_SIZE) != 0) {
+        return STSE_SERVICE_SESSION_ERROR;
+    }
 
-    while (pElement != NULL) {
-        if (pElement->length != 0) {
-            memcpy(decrypt_buffer + i, pElement->pData, pElement->length);
-            i += pElement->length;
+    /* - Chain first block on the AES ECB transformed IV */
+    memcpy(chaining_value, pInitial_value, STSAFEA_HOST_AES_BLOCK_SIZE);
+
+    /* - Decrypt payload using CBC in place in the response frame elements */
+    cursor.pElement = pFrame->first_element->next;
+    cursor.offset = 0;
+    while (remaining_length != 0) {
+        chunk_length = stsafea_session_cursor_run(&cursor);
+        if (chunk_length >= STSAFEA_HOST_AES_BLOCK_SIZE) {
+            /* - Decrypt whole blocks held by a single element */
+            chunk_length -= chunk_length % STSAFEA_HOST_AES_BLOCK_SIZE;
+            if (chunk_length > remaining_length) {
+                chunk_length = remaining_length;
+            }
+            pEncrypted = cursor.pElement->pData + cursor.offset;
+            memcpy(next_chaining_value, pEncrypted + chunk_length - STSAFEA_HOST_AES_BLOCK_SIZE, STSAFEA_HOST_AES_BLOCK_SIZE);
+            out_length = chunk_length;
+            ret = stsafea_session_cbc_dec(pSession,
+                                          pEncrypted,
+                                          chunk_length,
+                                          chaining_value,
+                                          pEncrypted,
+                                          &out_length);
+            cursor.offset += chunk_length;
+        } else {
+            /* - Gather block spread across elements , decrypt it and scatter it back */
+            block_cursor = cursor;
+            chunk_length = stsafea_session_cursor_read(&cursor, block, STSAFEA_HOST_AES_BLOCK_SIZE);
+            if (chunk_length != STSAFEA_HOST_AES_BLOCK_SIZE) {
+                return STSE_SERVICE_SESSION_ERROR;
+            }
+            memcpy(next_chaining_value, block, STSAFEA_HOST_AES_BLOCK_SIZE);
+            out_length = STSAFEA_HOST_AES_BLOCK_SIZE;
+            ret = stsafea_session_cbc_dec(pSession,
+                                          block,
+                                          STSAFEA_HOST_AES_BLOCK_SIZE,
+                                          chaining_value,
+                                          block,
+                                          &out_length);
+            stsafea_session_cursor_write(&block_cursor, block, STSAFEA_HOST_AES_BLOCK_SIZE);
+        }
+        if (ret != STSE_OK) {
+            return ret;
         }
-        pElement = pElement->next;
-    }
 
-    /* - Prepare Plain text info for AES IV */
-    if (pSession->context.host.pSTSE->device_type == STSAFE_A120) {
-        initial_value[0] = UI32_B3(pSession->context.host.MAC_counter);
-        initial_value[1] = UI32_B2(pSession->context.host.MAC_counter);
-        initial_value[2] = UI32_B1(pSession->context.host.MAC_counter);
-        initial_value[3] = UI32_B0(pSession->context.host.MAC_counter);
-        initial_value[4] = STSAFEA_AES_SUBJECT_HOST_DECRYPT;
-        initial_value[5] = STSAFEA_AES_FIRST_PADDING_BYTE;
-        (void)memset(&initial_value[6], 0x00, (STSAFEA_HOST_AES_BLOCK_SIZE)-6U);
-    } else {
-        initial_value[0] = UI32_B2(pSession->context.host.MAC_counter);
-        initial_value[1] = UI32_B1(pSession->context.host.MAC_counter);
-        initial_value[2] = UI32_B0(pSession->context.host.MAC_counter);
-        initial_value[3] = STSAFEA_AES_SUBJECT_HOST_DECRYPT;
-        initial_value[4] = STSAFEA_AES_FIRST_PADDING_BYTE;
-        (void)memset(&initial_value[5], 0x00, (STSAFEA_HOST_AES_BLOCK_SIZE)-5U);
+        memcpy(chaining_value, next_chaining_value, STSAFEA_HOST_AES_BLOCK_SIZE);
+        remaining_length -= chunk_length;
     }
 
-    PLAT_UI16 out_len = STSAFEA_HOST_AES_BLOCK_SIZE;
+    /* - Remove padding element from the response frame */
+    stse_frame_pop_element(pFrame);
 
-    /* - Transform IV using AES ECB */
-    ret = stse_platform_aes_ecb_enc(initial_value,
-                                    STSAFEA_HOST_AES_BLOCK_SIZE,
-                                    pSession->context.host.pHost_cypher_key,
-                                    (pSession->context.host.key_type == STSE_AES_128_KT) ? STSE_AES_128_KEY_SIZE : STSE_AES_256_KEY_SIZE,
-                                    initial_value,
-                                    &out_len);
+    return STSE_OK;
+}
+
+static stse_ReturnCode_t stsafea_session_frame_decrypt_staged(stse_session_t *pSession,
+                                                              stse_frame_t *pFrame,
+                                                              stse_frame_element_t *pEncrypted_payload_element,
+                                                              PLAT_UI8 *pInitial_value) {
+    stse_ReturnCode_t ret;
+    stse_frame_element_t *pElement;
+    PLAT_UI16 out_length = pEncrypted_payload_element->length;
+    PLAT_UI16 i = 0;
 
-    if (ret != 0) {
+    if ((pEncrypted_payload_element->length % STSAFEA_HOST_AES_BLOCK_SIZE) != 0) {
         return STSE_SERVICE_SESSION_ERROR;
     }
 
-    /* - Decrypt payload using CBC */
-    PLAT_UI16 decrypted_payload_len = encrypted_payload_len;
-
-    ret = stse_platform_aes_cbc_dec(decrypt_buffer,
-                                    encrypted_payload_len,
-                                    initial_value,
-                                    pSession->context.host.pHost_cypher_key,
-                                    (pSession->context.host.key_type == STSE_AES_128_KT) ? STSE_AES_128_KEY_SIZE : STSE_AES_256_KEY_SIZE,
-                                    decrypt_buffer,
-                                    &decrypted_payload_len);
-
+    /* - Decrypt payload using CBC in the staging buffer */
+    ret = stsafea_session_cbc_dec(pSession,
+                                  pEncrypted_payload_element->pData,
+                                  pEncrypted_payload_element->length,
+                                  pInitial_value,
+                                  pEncrypted_payload_element->pData,
+                                  &out_length);
     if (ret != STSE_OK) {
         return ret;
     }
 
-    /* - Copy Decrypted payload content in un-strapped Frame  */
+    /* - Copy decrypted payload content in un-strapped frame (elements without buffer are skipped) */
     stse_frame_unstrap(pFrame);
     pElement = pFrame->first_element->next;
-    i = 0;
     while (pElement != NULL) {
-        memcpy(pElement->pData,
-               decrypt_buffer + i,
-               pElement->length);
+        if (pElement->pData != NULL) {
+            memcpy(pElement->pData, pEncrypted_payload_element->pData + i, pElement->length);
+        }
         i += pElement->length;
         pElement = pElement->next;
     }
@@ -300,96 +610,64 @@ static stse_ReturnCode_t stsafea_session_frame_decrypt(stse_session_t *pSession,
     return STSE_OK;
 }
 
-static stse_ReturnCode_t stsafea_session_frame_c_mac_compute(stse_session_t *pSession,
-                                                             stse_frame_t *pCmd_frame,
-                                                             PLAT_UI8 *pMAC) {
+static stse_ReturnCode_t stsafea_session_frame_c_mac_start(stse_session_t *pSession,
+                                                           stsafea_session_cmac_feeder_t *pFeeder,
+                                                           stse_frame_element_t *pCmd_header,
+                                                           PLAT_UI16 cmd_payload_length) {
+    stse_ReturnCode_t ret;
     PLAT_UI8 aes_cmac_block[STSAFEA_HOST_AES_BLOCK_SIZE];
-    PLAT_UI8 mac_output_length;
-    PLAT_UI8 mac_type = 0x00;
-    stse_frame_element_t *pElement;
-    PLAT_UI8 aes_block_idx = 0;
-    PLAT_UI16 i;
-    PLAT_UI16 cmd_payload_length = pCmd_frame->length - pCmd_frame->first_element->length;
-    stse_ReturnCode_t ret = STSE_SERVICE_INVALID_PARAMETER;
-
-    if ((pSession == NULL) || (pCmd_frame == NULL) || (pMAC == NULL)) {
-        return STSE_SERVICE_SESSION_ERROR;
-    }
-
-    /*- create C-MAC Frame : [0x00] [CMD HEADER] [CMD PAYLOAD LENGTH] [CMD PAYLOAD] */
-    stse_frame_allocate(c_mac_frame);
-    stse_frame_element_allocate_push(&c_mac_frame, eMACType, 1, &mac_type);
-    stse_frame_element_allocate_push(&c_mac_frame,
-                                     eCMD_HEADER,
-                                     pCmd_frame->first_element->length,
-                                     pCmd_frame->first_element->pData);
-    stse_frame_element_allocate_push(&c_mac_frame,
-                                     eCmdPayloadLength,
-                                     STSAFEA_CMD_RSP_LEN_SIZE,
-                                     (PLAT_UI8 *)&cmd_payload_length);
-    stse_frame_element_swap_byte_order(&eCmdPayloadLength);
-    eCmdPayloadLength.next = pCmd_frame->first_element->next;
-    stse_frame_update(&c_mac_frame);
+    PLAT_UI8 mac_type = STSAFEA_AES_SUBJECT_HOST_CMAC;
+    PLAT_UI8 length_value[STSAFEA_CMD_RSP_LEN_SIZE];
 
     /*- Initialize AES C-MAC computation */
-
-    ret = stse_platform_aes_cmac_init(pSession->context.host.pHost_MAC_key,
-                                      (pSession->context.host.key_type == STSE_AES_128_KT) ? STSE_AES_128_KEY_SIZE : STSE_AES_256_KEY_SIZE,
-                                      STSAFEA_MAC_SIZE);
+    ret = stsafea_session_cmac_init(pSession, pFeeder->pCmac_ctx);
     if (ret != STSE_OK) {
         return ret;
     }
 
     /*- Perform First AES-CMAC round with MAC subject info */
-    if (pSession->context.host.pSTSE->device_type == STSAFE_A120) {
-        aes_cmac_block[0] = UI32_B3(pSession->context.host.MAC_counter);
-        aes_cmac_block[1] = UI32_B2(pSession->context.host.MAC_counter);
-        aes_cmac_block[2] = UI32_B1(pSession->context.host.MAC_counter);
-        aes_cmac_block[3] = UI32_B0(pSession->context.host.MAC_counter);
-        aes_cmac_block[4] = STSAFEA_AES_SUBJECT_HOST_CMAC;  /* Subject : Host C-MAC */
-        aes_cmac_block[5] = STSAFEA_AES_FIRST_PADDING_BYTE; /* First byte of padding */
-        for (i = 6; i < STSAFEA_HOST_AES_BLOCK_SIZE; i++) {
-            aes_cmac_block[i] = 0x00U; /* 0x00 padding */
-        }
-    } else {
-        aes_cmac_block[0] = UI32_B2(pSession->context.host.MAC_counter);
-        aes_cmac_block[1] = UI32_B1(pSession->context.host.MAC_counter);
-        aes_cmac_block[2] = UI32_B0(pSession->context.host.MAC_counter);
-        aes_cmac_block[3] = STSAFEA_AES_SUBJECT_HOST_CMAC;  /* Subject : Host C-MAC */
-        aes_cmac_block[4] = STSAFEA_AES_FIRST_PADDING_BYTE; /* First byte of padding */
-        for (i = 5; i < STSAFEA_HOST_AES_BLOCK_SIZE; i++) {
-            aes_cmac_block[i] = 0x00U; /* 0x00 padding */
-        }
+    stsafea_session_block_prepare(pSession,
+                                  pSession->context.host.MAC_counter,
+                                  STSAFEA_AES_SUBJECT_HOST_CMAC,
+                                  aes_cmac_block);
+    ret = stse_platform_aes_cmac_ctx_append(pFeeder->pCmac_ctx, aes_cmac_block, STSAFEA_HOST_AES_BLOCK_SIZE);
+    if (ret != STSE_OK) {
+        stse_platform_aes_cmac_ctx_abort(pFeeder->pCmac_ctx);
+        return ret;
     }
 
-    ret = stse_platform_aes_cmac_append(aes_cmac_block, STSAFEA_HOST_AES_BLOCK_SIZE);
+    /*- Feed C-MAC head : [0x00] [CMD HEADER] [CMD PAYLOAD LENGTH] , payload is fed by the caller */
+    length_value[0] = UI16_B1(cmd_payload_length);
+    length_value[1] = UI16_B0(cmd_payload_length);
+    pFeeder->block_length = 0;
+    ret = stsafea_session_cmac_feed(pFeeder, &mac_type, 1);
+    if (ret == STSE_OK) {
+        ret = stsafea_session_cmac_feed(pFeeder, pCmd_header->pData, pCmd_header->length);
+    }
+    if (ret == STSE_OK) {
+        ret = stsafea_session_cmac_feed(pFeeder, length_value, STSAFEA_CMD_RSP_LEN_SIZE);
+    }
     if (ret != STSE_OK) {
-        return ret;
+        stse_platform_aes_cmac_ctx_abort(pFeeder->pCmac_ctx);
     }
 
-    pElement = c_mac_frame.first_element;
+    return ret;
+}
 
-    /*- Perform additional AES-CMAC round(s) for frame to Authenticate */
-    while (pElement != NULL) {
-        for (i = 0; i < pElement->length; i++) {
-            if (aes_block_idx == STSAFEA_HOST_AES_BLOCK_SIZE) {
-                stse_platform_aes_cmac_append(aes_cmac_block, STSAFEA_HOST_AES_BLOCK_SIZE);
-                aes_block_idx = 0;
-            }
-            aes_cmac_block[aes_block_idx] = *(pElement->pData + i);
-            aes_block_idx++;
-        }
-        pElement = pElement->next;
-    }
-    if (aes_block_idx != 0) {
-        ret = stse_platform_aes_cmac_append(aes_cmac_block, aes_block_idx);
-        if (ret != STSE_OK) {
-            return ret;
-        }
+static stse_ReturnCode_t stsafea_session_frame_c_mac_finish(stsafea_session_cmac_feeder_t *pFeeder,
+                                                            PLAT_UI8 *pMAC) {
+    stse_ReturnCode_t ret;
+    PLAT_UI8 aes_cmac_block[STSAFEA_HOST_AES_BLOCK_SIZE];
+    PLAT_UI8 mac_output_length;
+
+    ret = stsafea_session_cmac_flush(pFeeder);
+    if (ret != STSE_OK) {
+        stse_platform_aes_cmac_ctx_abort(pFeeder->pCmac_ctx);
+        return ret;
     }
 
     /*- Finish AES MAC computation */
-    ret = stse_platform_aes_cmac_compute_finish(aes_cmac_block, &mac_output_length);
+    ret = stse_platform_aes_cmac_ctx_compute_finish(pFeeder->pCmac_ctx, aes_cmac_block, &mac_output_length);
     if (ret != STSE_OK) {
         return ret;
     } else if (mac_output_length != STSAFEA_MAC_SIZE) {
@@ -400,151 +678,122 @@ static stse_ReturnCode_t stsafea_session_frame_c_mac_compute(stse_session_t *pSe
     return ret;
 }
 
-static stse_ReturnCode_t stsafea_session_frame_r_mac_verify(stse_session_t *pSession,
-                                                            stse_frame_t *pCmd_frame,
-                                                            stse_frame_t *pRsp_frame,
-                                                            PLAT_UI8 *pMAC) {
-    stse_ReturnCode_t ret = STSE_SERVICE_INVALID_PARAMETER;
+static stse_ReturnCode_t stsafea_session_frame_r_mac_verify(stsafea_session_transfer_ctx_t *pCtx,
+                                                            stse_frame_t *pRsp_frame) {
+    stse_ReturnCode_t ret;
     PLAT_UI8 aes_cmac_block[STSAFEA_HOST_AES_BLOCK_SIZE];
-    PLAT_UI16 cmd_payload_length = pCmd_frame->length - pCmd_frame->first_element->length;
-    PLAT_UI8 aes_block_idx = 0;
-    PLAT_UI16 i;
-    PLAT_UI8 mac_type = 0x80;
-    stse_frame_element_t *pElement;
+    PLAT_UI8 length_value[STSAFEA_CMD_RSP_LEN_SIZE];
+    PLAT_UI16 rsp_payload_length;
 
-    if ((pSession == NULL) || (pCmd_frame == NULL) || (pRsp_frame == NULL)) {
-        return STSE_SERVICE_SESSION_ERROR;
+    /*- R-MAC computation has been started on the command part of the R-MAC input */
+    if (pCtx->rsp_mac_started == 0) {
+        return STSE_SERVICE_INVALID_PARAMETER;
     }
+    pCtx->rsp_mac_started = 0;
 
-    if (*(pCmd_frame->first_element->pData) & STSAFEA_PROT_RSP_Msk) {
+    /*- Pop R-MAC from frame*/
+    stse_frame_pop_element(pRsp_frame);
 
-        /*- Pop R-MAC from frame*/
-        stse_frame_pop_element(pRsp_frame);
+    rsp_payload_length = pRsp_frame->length - pRsp_frame->first_element->length;
+    length_value[0] = UI16_B1(rsp_payload_length);
+    length_value[1] = UI16_B0(rsp_payload_length);
 
-        PLAT_UI16 rsp_payload_length = (pRsp_frame->length - (pRsp_frame->first_element->length));
+    /*- Feed R-MAC tail : [RSP HEADER] [RSP PAYLOAD LENGTH] [RSP PAYLOAD] */
+    ret = stsafea_session_cmac_feed(&pCtx->cmac_feeder, pRsp_frame->first_element->pData, pRsp_frame->first_element->length);
+    if (ret == STSE_OK) {
+        ret = stsafea_session_cmac_feed(&pCtx->cmac_feeder, length_value, STSAFEA_CMD_RSP_LEN_SIZE);
+    }
+    if (ret == STSE_OK) {
+        ret = stsafea_session_cmac_feed_elements(&pCtx->cmac_feeder, pRsp_frame->first_element->next);
+    }
+    if (ret == STSE_OK) {
+        ret = stsafea_session_cmac_flush(&pCtx->cmac_feeder);
+    }
+    if (ret != STSE_OK) {
+        stse_platform_aes_cmac_ctx_abort(&pCtx->cmac_ctx);
+        return ret;
+    }
 
-        /*- Initialize AES CMAC computation */
-        stse_platform_aes_cmac_init(
-            pSession->context.host.pHost_MAC_key,
-            (pSession->context.host.key_type == STSE_AES_128_KT) ? STSE_AES_128_KEY_SIZE : STSE_AES_256_KEY_SIZE,
-            STSAFEA_MAC_SIZE);
+    memcpy(aes_cmac_block, pCtx->Rsp_MAC, STSAFEA_MAC_SIZE);
+    return stse_platform_aes_cmac_ctx_verify_finish(&pCtx->cmac_ctx, aes_cmac_block);
+}
 
-        /*- Perform First AES-CMAC round */
-        if (pSession->context.host.pSTSE->device_type == STSAFE_A120) {
-            aes_cmac_block[0] = UI32_B3(pSession->context.host.MAC_counter);
-            aes_cmac_block[1] = UI32_B2(pSession->context.host.MAC_counter);
-            aes_cmac_block[2] = UI32_B1(pSession->context.host.MAC_counter);
-            aes_cmac_block[3] = UI32_B0(pSession->context.host.MAC_counter);
-            aes_cmac_block[4] = STSAFEA_AES_SUBJECT_HOST_RMAC;
-            aes_cmac_block[5] = STSAFEA_AES_FIRST_PADDING_BYTE;
-            for (i = 6; i < STSAFEA_HOST_AES_BLOCK_SIZE; i++) {
-                aes_cmac_block[i] = 0x00U; /* 0x00 padding */
-            }
-        } else {
-            aes_cmac_block[0] = UI32_B2(pSession->context.host.MAC_counter);
-            aes_cmac_block[1] = UI32_B1(pSession->context.host.MAC_counter);
-            aes_cmac_block[2] = UI32_B0(pSession->context.host.MAC_counter);
-            aes_cmac_block[3] = STSAFEA_AES_SUBJECT_HOST_RMAC;
-            aes_cmac_block[4] = STSAFEA_AES_FIRST_PADDING_BYTE;
-            for (i = 5; i < STSAFEA_HOST_AES_BLOCK_SIZE; i++) {
-                aes_cmac_block[i] = 0x00U; /* 0x00 padding */
-            }
-        }
+PLAT_UI16 stsafea_session_encrypted_payload_size(stse_frame_t *pFrame) {
+    PLAT_UI16 plaintext_payload_size;
+    PLAT_UI8 padding = 16;
 
-        stse_platform_aes_cmac_append(aes_cmac_block, STSAFEA_HOST_AES_BLOCK_SIZE);
+    if ((pFrame == NULL) || (pFrame->first_element == NULL)) {
+        return 0;
+    }
 
-        /*- Prepare AES CMAC input for response MAC verification  */
-        stse_frame_allocate(r_mac_frame);
+    plaintext_payload_size = pFrame->length - pFrame->first_element->length;
+    if ((plaintext_payload_size % 16) != 0) {
+        padding = 16 - (plaintext_payload_size % 16);
+    }
 
-        /*- Create r_mac_frame head :[MAC TYPE] [CMD HEADER] [CMD PAYLOAD LENGTH] [CMD PAYLOAD] ... */
-        stse_frame_element_allocate_push(
-            &r_mac_frame,
-            eMACType,
-            1,
-            &mac_type);
+    return plaintext_payload_size + padding;
+}
 
-        stse_frame_element_allocate_push(
-            &r_mac_frame,
-            eCMD_header,
-            pCmd_frame->first_element->length,
-            pCmd_frame->first_element->pData);
+PLAT_UI16 stsafea_session_rsp_staging_size(stse_frame_t *pRspFrame, PLAT_UI8 rsp_encryption_flag) {
+    stse_frame_element_t *pElement;
+    stse_frame_element_t *pOther;
 
-        stse_frame_element_allocate_push(
-            &r_mac_frame,
-            eCMD_Length,
-            STSAFEA_CMD_RSP_LEN_SIZE,
-            (PLAT_UI8 *)&cmd_payload_length);
-        stse_frame_element_swap_byte_order(&eCMD_Length);
+    if ((rsp_encryption_flag != 1) || (pRspFrame == NULL) || (pRspFrame->first_element == NULL)) {
+        return 0;
+    }
 
-        if (pCmd_frame->first_element->next->length == 0) {
-            eCMD_Length.next = pCmd_frame->first_element->next->next;
-        } else {
-            eCMD_Length.next = pCmd_frame->first_element->next;
-        }
-
-        stse_frame_update(&r_mac_frame);
-
-        /*- Create r_mac_frame head : ... [RSP HEADER] [RSP PAYLOAD LENGTH] [RSP PAYLOAD] */
-        stse_frame_element_allocate_push(
-            &r_mac_frame,
-            eRSP_header,
-            pRsp_frame->first_element->length,
-            pRsp_frame->first_element->pData);
-
-        stse_frame_element_allocate_push(
-            &r_mac_frame,
-            eRsp_Length,
-            STSAFEA_CMD_RSP_LEN_SIZE,
-            (PLAT_UI8 *)&rsp_payload_length);
-        stse_frame_element_swap_byte_order(&eRsp_Length);
-
-        eRsp_Length.next = pRsp_frame->first_element->next;
-        stse_frame_update(&r_mac_frame);
-        pElement = r_mac_frame.first_element;
-
-        /*- Perform additional AES-CMAC round(s) on R-MAC verification frame*/
-        while (pElement != NULL) {
-            for (i = 0; i < pElement->length; i++) {
-                if (aes_block_idx == STSAFEA_HOST_AES_BLOCK_SIZE) {
-                    stse_platform_aes_cmac_append(aes_cmac_block, STSAFEA_HOST_AES_BLOCK_SIZE);
-                    aes_block_idx = 0;
-                }
-                aes_cmac_block[aes_block_idx] = *(pElement->pData + i);
-                aes_block_idx++;
-            }
-            pElement = pElement->next;
+    /* - In place reception requires distinct buffers for all response elements */
+    for (pElement = pRspFrame->first_element; pElement != NULL; pElement = pElement->next) {
+        if (pElement->length == 0) {
+            continue;
+        }
+        if (pElement->pData == NULL) {
+            return stsafea_session_encrypted_payload_size(pRspFrame);
         }
-        if (aes_block_idx != 0) {
-            ret = stse_platform_aes_cmac_append(aes_cmac_block, aes_block_idx);
-            if (ret != STSE_OK) {
-                return ret;
+        for (pOther = pElement->next; pOther != NULL; pOther = pOther->next) {
+            if ((pOther->length != 0) && (pOther->pData != NULL) &&
+                (pOther->pData < (pElement->pData + pElement->length)) &&
+                (pElement->pData < (pOther->pData + pOther->length))) {
+                return stsafea_session_encrypted_payload_size(pRspFrame);
             }
         }
-
-        memcpy(aes_cmac_block, pMAC, STSAFEA_MAC_SIZE);
-        ret = stse_platform_aes_cmac_verify_finish(aes_cmac_block);
     }
-    return ret;
+
+    return 0;
 }
 
-stse_ReturnCode_t stsafea_session_encrypted_transfer(stse_session_t *pSession,
-                                                     stse_frame_t *pCmdFrame,
-                                                     stse_frame_t *pRspFrame,
-                                                     PLAT_UI8 cmd_encryption_flag,
-                                                     PLAT_UI8 rsp_encryption_flag,
-                                                     stse_cmd_access_conditions_t cmd_ac_info,
-                                                     PLAT_UI16 processing_time) {
+stse_ReturnCode_t stsafea_session_transfer_prepare(stsafea_session_transfer_ctx_t *pCtx,
+                                                   stse_session_t *pSession,
+                                                   stse_frame_t *pCmdFrame,
+                                                   stse_frame_t *pRspFrame,
+                                                   PLAT_UI8 cmd_encryption_flag,
+                                                   PLAT_UI8 rsp_encryption_flag,
+                                                   PLAT_UI8 *pEncrypted_cmd_payload,
+                                                   PLAT_UI8 *pEncrypted_rsp_payload) {
     stse_ReturnCode_t ret;
-    PLAT_UI16 encrypted_cmd_payload_size = 0;
-    PLAT_UI16 encrypted_rsp_payload_size = 0;
-    PLAT_UI8 padding = 16;
+    PLAT_UI16 cmd_payload_length;
+    PLAT_UI16 rsp_staging_size;
+#ifdef STSE_CMD_METRICS
+    PLAT_UI32 crypto_start = stse_platform_get_timestamp();
+#endif /* STSE_CMD_METRICS */
 
-    if (pSession == NULL || pCmdFrame == NULL || pRspFrame == NULL ||
+    if (pCtx == NULL || pSession == NULL || pCmdFrame == NULL || pRspFrame == NULL ||
         pCmdFrame->first_element == NULL || pCmdFrame->first_element->pData == NULL ||
         pRspFrame->first_element == NULL || pRspFrame->first_element->pData == NULL) {
         return STSE_SERVICE_SESSION_ERROR;
     }
 
+    pCtx->pSession = pSession;
+    pCtx->rsp_encryption_flag = rsp_encryption_flag;
+    pCtx->rsp_precomputed = 0;
+    pCtx->rsp_mac_started = 0;
+    pCtx->rsp_staged = 0;
+
+    rsp_staging_size = stsafea_session_rsp_staging_size(pRspFrame, rsp_encryption_flag);
+    if ((rsp_staging_size != 0) && (pEncrypted_rsp_payload == NULL)) {
+        return STSE_SERVICE_INVALID_PARAMETER;
+    }
+
     if (cmd_encryption_flag == 1) {
 #ifdef STSE_FRAME_DEBUG_LOG
         printf("\n\r STSAFE Plaintext Frame > ");
@@ -552,52 +801,237 @@ stse_ReturnCode_t stsafea_session_encrypted_transfer(stse_session_t *pSession,
         printf("\n\r");
 #endif /* STSE_FRAME_DEBUG_LOG */
 
-        PLAT_UI16 plaintext_payload_size = pCmdFrame->length - pCmdFrame->first_element->length;
-        if ((plaintext_payload_size % 16) != 0) {
-            padding = 16 - (plaintext_payload_size % 16);
-        }
-        encrypted_cmd_payload_size = plaintext_payload_size + padding;
+        cmd_payload_length = stsafea_session_encrypted_payload_size(pCmdFrame);
+    } else {
+        cmd_payload_length = pCmdFrame->length - pCmdFrame->first_element->length;
     }
 
-    PLAT_UI8 encrypted_cmd_payload[encrypted_cmd_payload_size];
-    stse_frame_element_allocate(eEncrypted_cmd_payload, encrypted_cmd_payload_size, encrypted_cmd_payload);
-    stse_frame_strap_allocate(S1);
+    /* - Set command header protection bits */
+    if (pSession->type == STSE_HOST_SESSION) {
+        *(pCmdFrame->first_element->pData) |= (1 << 5);
+    }
+
+    *(pCmdFrame->first_element->pData) |= ((1 << 7) | (1 << 6));
+
+    /* - Start C-MAC computation on command header and payload length */
+    pCtx->cmac_feeder.pCmac_ctx = &pCtx->cmac_ctx;
+    ret = stsafea_session_frame_c_mac_start(pSession, &pCtx->cmac_feeder, pCmdFrame->first_element, cmd_payload_length);
+    if (ret != STSE_OK) {
+        return ret;
+    }
 
     if (cmd_encryption_flag == 1) {
-        ret = stsafea_session_frame_encrypt(pSession, pCmdFrame, &eEncrypted_cmd_payload);
+        /* - Encrypt command payload (C-MAC fed in the same pass) and strap it to the command frame header */
+        pCtx->eEncrypted_cmd_payload.length = cmd_payload_length;
+        pCtx->eEncrypted_cmd_payload.pData = pEncrypted_cmd_payload;
+        pCtx->eEncrypted_cmd_payload.next = NULL;
+        ret = stsafea_session_frame_encrypt(pSession, pCmdFrame, &pCtx->eEncrypted_cmd_payload, &pCtx->cmac_feeder);
         if (ret != STSE_OK) {
+            stse_platform_aes_cmac_ctx_abort(&pCtx->cmac_ctx);
             return ret;
         }
-        stse_frame_insert_strap(&S1, pCmdFrame->first_element, &eEncrypted_cmd_payload);
+        pCtx->sCmd_strap.length = 0;
+        stse_frame_insert_strap(&pCtx->sCmd_strap, pCmdFrame->first_element, &pCtx->eEncrypted_cmd_payload);
         stse_frame_update(pCmdFrame);
+    } else {
+        ret = stsafea_session_cmac_feed_elements(&pCtx->cmac_feeder, pCmdFrame->first_element->next);
+        if (ret != STSE_OK) {
+            stse_platform_aes_cmac_ctx_abort(&pCtx->cmac_ctx);
+            return ret;
+        }
+    }
+
+    /* - Finish C-MAC computation */
+    ret = stsafea_session_frame_c_mac_finish(&pCtx->cmac_feeder, pCtx->Cmd_MAC);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+
+    if (rsp_staging_size != 0) {
+        /* - Strap staging element to the response frame header (response cipher text is received in the staging buffer) */
+        pCtx->eEncrypted_rsp_payload.length = rsp_staging_size;
+        pCtx->eEncrypted_rsp_payload.pData = pEncrypted_rsp_payload;
+        pCtx->eEncrypted_rsp_payload.next = NULL;
+        pCtx->sRsp_strap.length = 0;
+        stse_frame_insert_strap(&pCtx->sRsp_strap, pRspFrame->first_element, &pCtx->eEncrypted_rsp_payload);
+        stse_frame_update(pRspFrame);
+        pCtx->rsp_staged = 1;
+    } else if (rsp_encryption_flag == 1 && pRspFrame->first_element->next != NULL) {
+        /* - Append padding element to the response frame (response cipher text is received in the response elements) */
+        pCtx->eRsp_padding.length = stsafea_session_encrypted_payload_size(pRspFrame) - (pRspFrame->length - pRspFrame->first_element->length);
+        pCtx->eRsp_padding.pData = pCtx->Rsp_padding;
+        pCtx->eRsp_padding.next = NULL;
+        stse_frame_push_element(pRspFrame, &pCtx->eRsp_padding);
+    }
+
+    /* - Append R-MAC element to the response frame */
+    pCtx->eRsp_MAC.length = STSAFEA_MAC_SIZE;
+    pCtx->eRsp_MAC.pData = pCtx->Rsp_MAC;
+    pCtx->eRsp_MAC.next = NULL;
+    stse_frame_push_element(pRspFrame, &pCtx->eRsp_MAC);
+
+    /* - Append C-MAC to the command frame */
+    pCtx->eCmd_MAC.length = STSAFEA_MAC_SIZE;
+    pCtx->eCmd_MAC.pData = pCtx->Cmd_MAC;
+    pCtx->eCmd_MAC.next = NULL;
+    stse_frame_push_element(pCmdFrame, &pCtx->eCmd_MAC);
+
+#ifdef STSE_CMD_METRICS
+    stse_cmd_metrics_crypto_record(pSession->context.host.pSTSE, pCmdFrame, crypto_start);
+#endif /* STSE_CMD_METRICS */
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stsafea_session_transfer_rsp_precompute(stsafea_session_transfer_ctx_t *pCtx,
+                                                          stse_frame_t *pCmdFrame) {
+    stse_ReturnCode_t ret;
+    stse_session_t *pSession;
+    stse_frame_element_t *pElement;
+    PLAT_UI8 aes_cmac_block[STSAFEA_HOST_AES_BLOCK_SIZE];
+    PLAT_UI8 length_value[STSAFEA_CMD_RSP_LEN_SIZE];
+    PLAT_UI8 mac_type = 0x80;
+    PLAT_UI16 cmd_payload_length = 0;
+    PLAT_UI16 out_length;
+    PLAT_UI32 rsp_MAC_counter;
+#ifdef STSE_CMD_METRICS
+    PLAT_UI32 crypto_start = stse_platform_get_timestamp();
+#endif /* STSE_CMD_METRICS */
+
+    if (pCtx == NULL || pCtx->pSession == NULL || pCmdFrame == NULL || pCmdFrame->first_element == NULL) {
+        return STSE_SERVICE_SESSION_ERROR;
+    }
+
+    if (pCtx->rsp_precomputed != 0) {
+        return STSE_OK;
+    }
+
+    /* - Response is protected with the MAC counter value updated by the command */
+    pSession = pCtx->pSession;
+    rsp_MAC_counter = pSession->context.host.MAC_counter + 1;
+
+    if (*(pCmdFrame->first_element->pData) & STSAFEA_PROT_RSP_Msk) {
+        /*- Command payload length (command MAC excluded) */
+        for (pElement = pCmdFrame->first_element->next;
+             (pElement != NULL) && (pElement != &pCtx->eCmd_MAC);
+             pElement = pElement->next) {
+            cmd_payload_length += pElement->length;
+        }
+        length_value[0] = UI16_B1(cmd_payload_length);
+        length_value[1] = UI16_B0(cmd_payload_length);
+
+        /*- Initialize AES CMAC computation */
+        pCtx->cmac_feeder.pCmac_ctx = &pCtx->cmac_ctx;
+        pCtx->cmac_feeder.block_length = 0;
+        ret = stsafea_session_cmac_init(pSession, &pCtx->cmac_ctx);
+        if (ret != STSE_OK) {
+            return ret;
+        }
+
+        /*- Perform First AES-CMAC round */
+        stsafea_session_block_prepare(pSession, rsp_MAC_counter, STSAFEA_AES_SUBJECT_HOST_RMAC, aes_cmac_block);
+        ret = stse_platform_aes_cmac_ctx_append(&pCtx->cmac_ctx, aes_cmac_block, STSAFEA_HOST_AES_BLOCK_SIZE);
+
+        /*- Feed R-MAC head : [0x80] [CMD HEADER] [CMD PAYLOAD LENGTH] [CMD PAYLOAD] */
+        if (ret == STSE_OK) {
+            ret = stsafea_session_cmac_feed(&pCtx->cmac_feeder, &mac_type, 1);
+        }
+        if (ret == STSE_OK) {
+            ret = stsafea_session_cmac_feed(&pCtx->cmac_feeder, pCmdFrame->first_element->pData, pCmdFrame->first_element->length);
+        }
+        if (ret == STSE_OK) {
+            ret = stsafea_session_cmac_feed(&pCtx->cmac_feeder, length_value, STSAFEA_CMD_RSP_LEN_SIZE);
+        }
+        pElement = pCmdFrame->first_element->next;
+        while ((ret == STSE_OK) && (pElement != NULL) && (pElement != &pCtx->eCmd_MAC)) {
+            if (pElement->length != 0) {
+                ret = stsafea_session_cmac_feed(&pCtx->cmac_feeder, pElement->pData, pElement->length);
+            }
+            pElement = pElement->next;
+        }
+        if (ret != STSE_OK) {
+            stse_platform_aes_cmac_ctx_abort(&pCtx->cmac_ctx);
+            return ret;
+        }
+        pCtx->rsp_mac_started = 1;
     }
 
-    if (rsp_encryption_flag == 1) {
-        padding = 16;
-        PLAT_UI16 plaintext_payload_size = pRspFrame->length - pRspFrame->first_element->length;
-        if ((plaintext_payload_size % 16) != 0) {
-            padding = 16 - (plaintext_payload_size % 16);
+    if (pCtx->rsp_encryption_flag == 1) {
+        /* - Prepare Plain text info for AES IV and transform it using AES ECB */
+        stsafea_session_block_prepare(pSession, rsp_MAC_counter, STSAFEA_AES_SUBJECT_HOST_DECRYPT, pCtx->Rsp_initial_value);
+        out_length = STSAFEA_HOST_AES_BLOCK_SIZE;
+        ret = stsafea_session_ecb_enc(pSession,
+                                      pCtx->Rsp_initial_value,
+                                      STSAFEA_HOST_AES_BLOCK_SIZE,
+                                      pCtx->Rsp_initial_value,
+                                      &out_length);
+        if (ret != STSE_OK) {
+            if (pCtx->rsp_mac_started != 0) {
+                stse_platform_aes_cmac_ctx_abort(&pCtx->cmac_ctx);
+                pCtx->rsp_mac_started = 0;
+            }
+            return STSE_SERVICE_SESSION_ERROR;
         }
-        encrypted_rsp_payload_size = plaintext_payload_size + padding;
     }
 
-    PLAT_UI8 encrypted_rsp_payload[encrypted_rsp_payload_size];
-    stse_frame_element_allocate(eEncrypted_rsp_payload, encrypted_rsp_payload_size, encrypted_rsp_payload);
-    stse_frame_strap_allocate(S2);
+    pCtx->rsp_precomputed = 1;
 
-    if (rsp_encryption_flag == 1 && pRspFrame->first_element->next != NULL) {
-        stse_frame_insert_strap(&S2, pRspFrame->first_element, &eEncrypted_rsp_payload);
-        stse_frame_update(pRspFrame);
+#ifdef STSE_CMD_METRICS
+    stse_cmd_metrics_crypto_record(pSession->context.host.pSTSE, pCmdFrame, crypto_start);
+#endif /* STSE_CMD_METRICS */
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stsafea_session_transfer_finalize(stsafea_session_transfer_ctx_t *pCtx,
+                                                    stse_frame_t *pCmdFrame,
+                                                    stse_frame_t *pRspFrame,
+                                                    stse_ReturnCode_t transfer_ret) {
+    stse_ReturnCode_t ret = transfer_ret;
+    stse_ReturnCode_t precompute_ret = STSE_OK;
+#ifdef STSE_CMD_METRICS
+    PLAT_UI32 crypto_start;
+#endif /* STSE_CMD_METRICS */
+
+    if (pCtx == NULL || pCtx->pSession == NULL || pCmdFrame == NULL || pRspFrame == NULL) {
+        return STSE_SERVICE_SESSION_ERROR;
+    }
+
+    /* - Precompute response protection if not done while target STSAFE executed the command (before MAC counter update) */
+    if (ret == STSE_OK) {
+        precompute_ret = stsafea_session_transfer_rsp_precompute(pCtx, pCmdFrame);
+    }
+
+#ifdef STSE_CMD_METRICS
+    crypto_start = stse_platform_get_timestamp();
+#endif /* STSE_CMD_METRICS */
+
+    /* - Update MAC counter when command has been processed by target STSAFE */
+    if (ret <= 0xFF && ret != STSE_INVALID_C_MAC && ret != STSE_COMMUNICATION_ERROR) {
+        pCtx->pSession->context.host.MAC_counter++;
+    }
+
+    /*- Pop C-MAC from frame*/
+    stse_frame_pop_element(pCmdFrame);
+
+    if (ret == STSE_OK) {
+        ret = precompute_ret;
     }
 
-    ret = stsafea_session_authenticated_transfer(pSession,
-                                                 pCmdFrame,
-                                                 pRspFrame,
-                                                 cmd_ac_info,
-                                                 processing_time);
+    if (ret == STSE_OK) {
+        ret = stsafea_session_frame_r_mac_verify(pCtx, pRspFrame);
+    } else if (pCtx->rsp_mac_started != 0) {
+        /* - Response is not verified : release R-MAC computation context */
+        stse_platform_aes_cmac_ctx_abort(&pCtx->cmac_ctx);
+        pCtx->rsp_mac_started = 0;
+    }
 
-    if ((ret == STSE_OK) && (rsp_encryption_flag == 1)) {
-        ret = stsafea_session_frame_decrypt(pSession, pRspFrame);
+    if ((ret == STSE_OK) && (pCtx->rsp_encryption_flag == 1)) {
+        if (pCtx->rsp_staged == 1) {
+            ret = stsafea_session_frame_decrypt_staged(pCtx->pSession, pRspFrame, &pCtx->eEncrypted_rsp_payload, pCtx->Rsp_initial_value);
+        } else {
+            ret = stsafea_session_frame_decrypt(pCtx->pSession, pRspFrame, pCtx->Rsp_initial_value);
+        }
 
 #ifdef STSE_FRAME_DEBUG_LOG
         printf("\n\r STSAFE Plaintext Frame < ");
@@ -606,62 +1040,119 @@ stse_ReturnCode_t stsafea_session_encrypted_transfer(stse_session_t *pSession,
 #endif /* STSE_FRAME_DEBUG_LOG */
     }
 
+#ifdef STSE_CMD_METRICS
+    stse_cmd_metrics_crypto_record(pCtx->pSession->context.host.pSTSE, pCmdFrame, crypto_start);
+#endif /* STSE_CMD_METRICS */
+
     return ret;
 }
 
-stse_ReturnCode_t stsafea_session_authenticated_transfer(stse_session_t *pSession,
-                                                         stse_frame_t *pCmdFrame,
-                                                         stse_frame_t *pRspFrame,
-                                                         stse_cmd_access_conditions_t cmd_ac_info,
-                                                         PLAT_UI16 processing_time) {
-    (void)cmd_ac_info;
+static stse_ReturnCode_t stsafea_session_transfer(stse_session_t *pSession,
+                                                  stse_frame_t *pCmdFrame,
+                                                  stse_frame_t *pRspFrame,
+                                                  PLAT_UI8 cmd_encryption_flag,
+                                                  PLAT_UI8 rsp_encryption_flag,
+                                                  PLAT_UI8 *pEncrypted_cmd_payload,
+                                                  PLAT_UI8 *pEncrypted_rsp_payload,
+                                                  PLAT_UI16 processing_time) {
     stse_ReturnCode_t ret;
-    PLAT_UI8 Cmd_MAC[STSAFEA_MAC_SIZE];
-    PLAT_UI8 Rsp_MAC[STSAFEA_MAC_SIZE];
+    stsafea_session_transfer_ctx_t transfer_ctx;
 
-    if (pSession == NULL || pCmdFrame == NULL || pRspFrame == NULL ||
-        pCmdFrame->first_element == NULL || pCmdFrame->first_element->pData == NULL ||
-        pRspFrame->first_element == NULL || pRspFrame->first_element->pData == NULL) {
-        return STSE_SERVICE_SESSION_ERROR;
-    }
-
-    if (pSession->type == STSE_HOST_SESSION) {
-        *(pCmdFrame->first_element->pData) |= (1 << 5);
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+    /* - Hold device lock from C-MAC computation to MAC counter update */
+    ret = stse_handler_lock(pSession->context.host.pSTSE);
+    if (ret != STSE_OK) {
+        return ret;
     }
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
+
+    ret = stsafea_session_transfer_prepare(&transfer_ctx,
+                                           pSession,
+                                           pCmdFrame,
+                                           pRspFrame,
+                                           cmd_encryption_flag,
+                                           rsp_encryption_flag,
+                                           pEncrypted_cmd_payload,
+                                           pEncrypted_rsp_payload);
+    if (ret == STSE_OK) {
+        switch (pSession->type) {
 
-    *(pCmdFrame->first_element->pData) |= ((1 << 7) | (1 << 6));
+        case STSE_HOST_SESSION:
+            ret = stsafea_frame_session_raw_transfer_unlocked(pSession->context.host.pSTSE, pCmdFrame, pRspFrame, &transfer_ctx, processing_time);
+            break;
 
-    stse_frame_element_allocate_push(pRspFrame, eRspMAC, STSAFEA_MAC_SIZE, Rsp_MAC);
+        default:
+            ret = STSE_SERVICE_SESSION_ERROR;
+            break;
+        }
 
-    ret = stsafea_session_frame_c_mac_compute(pSession, pCmdFrame, Cmd_MAC);
-    if (ret != STSE_OK) {
-        return ret;
+        ret = stsafea_session_transfer_finalize(&transfer_ctx, pCmdFrame, pRspFrame, ret);
     }
 
-    stse_frame_element_allocate_push(pCmdFrame, eCmdMAC, STSAFEA_MAC_SIZE, Cmd_MAC);
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+    stse_handler_unlock(pSession->context.host.pSTSE);
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
 
-    switch (pSession->type) {
+    return ret;
+}
 
-    case STSE_HOST_SESSION:
-        ret = stsafea_frame_raw_transfer(pSession->context.host.pSTSE, pCmdFrame, pRspFrame, processing_time);
-        if (ret <= 0xFF && ret != STSE_INVALID_C_MAC && ret != STSE_COMMUNICATION_ERROR) {
-            pSession->context.host.MAC_counter++;
-        }
-        break;
+stse_ReturnCode_t stsafea_session_encrypted_transfer(stse_session_t *pSession,
+                                                     stse_frame_t *pCmdFrame,
+                                                     stse_frame_t *pRspFrame,
+                                                     PLAT_UI8 cmd_encryption_flag,
+                                                     PLAT_UI8 rsp_encryption_flag,
+                                                     stse_cmd_access_conditions_t cmd_ac_info,
+                                                     PLAT_UI16 processing_time) {
+    (void)cmd_ac_info;
+    PLAT_UI16 encrypted_cmd_payload_size = 0;
+    PLAT_UI16 encrypted_rsp_payload_size;
 
-    default:
-        ret = STSE_SERVICE_SESSION_ERROR;
-        break;
+    if (pSession == NULL || pCmdFrame == NULL || pRspFrame == NULL ||
+        pCmdFrame->first_element == NULL || pCmdFrame->first_element->pData == NULL ||
+        pRspFrame->first_element == NULL || pRspFrame->first_element->pData == NULL) {
+        return STSE_SERVICE_SESSION_ERROR;
     }
 
-    /*- Pop C-MAC from frame*/
-    stse_frame_pop_element(pCmdFrame);
+    if (cmd_encryption_flag == 1) {
+        encrypted_cmd_payload_size = stsafea_session_encrypted_payload_size(pCmdFrame);
+    }
 
-    if (ret == STSE_OK) {
-        ret = stsafea_session_frame_r_mac_verify(pSession, pCmdFrame, pRspFrame, Rsp_MAC);
+    /* - The transmitted command cipher text needs a buffer , the response is decrypted in place unless staging is required */
+    encrypted_rsp_payload_size = stsafea_session_rsp_staging_size(pRspFrame, rsp_encryption_flag);
+    PLAT_UI8 encrypted_cmd_payload[encrypted_cmd_payload_size];
+    PLAT_UI8 encrypted_rsp_payload[encrypted_rsp_payload_size];
+
+    return stsafea_session_transfer(pSession,
+                                    pCmdFrame,
+                                    pRspFrame,
+                                    cmd_encryption_flag,
+                                    rsp_encryption_flag,
+                                    encrypted_cmd_payload,
+                                    encrypted_rsp_payload,
+                                    processing_time);
+}
+
+stse_ReturnCode_t stsafea_session_authenticated_transfer(stse_session_t *pSession,
+                                                         stse_frame_t *pCmdFrame,
+                                                         stse_frame_t *pRspFrame,
+                                                         stse_cmd_access_conditions_t cmd_ac_info,
+                                                         PLAT_UI16 processing_time) {
+    (void)cmd_ac_info;
+
+    if (pSession == NULL || pCmdFrame == NULL || pRspFrame == NULL ||
+        pCmdFrame->first_element == NULL || pCmdFrame->first_element->pData == NULL ||
+        pRspFrame->first_element == NULL || pRspFrame->first_element->pData == NULL) {
+        return STSE_SERVICE_SESSION_ERROR;
     }
 
-    return ret;
+    return stsafea_session_transfer(pSession,
+                                    pCmdFrame,
+                                    pRspFrame,
+                                    0,
+                                    0,
+                                    NULL,
+                                    NULL,
+                                    processing_time);
 }
 
 #endif /* STSE_CONF_USE_HOST_SESSION */
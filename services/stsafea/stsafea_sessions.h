@@ -24,6 +24,50 @@
 #include "core/stse_generic_typedef.h"
 #include "core/stse_platform.h"
 #include "core/stse_return_codes.h"
+#include "services/stsafea/stsafea_commands.h"
+
+#define STSAFEA_SESSION_AES_BLOCK_SIZE 16U /*!< Session AES block size */
+
+#ifdef STSE_CONF_USE_HOST_SESSION
+/*!
+ * \brief STSAFE-A session AES CMAC feeder
+ * \details Streams frame data to a platform AES CMAC context. Whole AES blocks are passed straight from the frame
+ *          element buffers , only the bytes not completing a block are staged in the feeder block
+ */
+typedef struct stsafea_session_cmac_feeder_t {
+    stse_platform_aes_cmac_ctx_t *pCmac_ctx;        /*!< Platform AES CMAC context */
+    PLAT_UI8 block[STSAFEA_SESSION_AES_BLOCK_SIZE]; /*!< Staged bytes */
+    PLAT_UI8 block_length;                          /*!< Number of staged bytes */
+} stsafea_session_cmac_feeder_t;
+#endif /* STSE_CONF_USE_HOST_SESSION */
+
+/*!
+ * \brief STSAFE-A session transfer context
+ * \details Holds the protection elements attached to the command and response frames and the response protection
+ *          state between \ref stsafea_session_transfer_prepare and \ref stsafea_session_transfer_finalize
+ */
+typedef struct stsafea_session_transfer_ctx_t {
+    stse_session_t *pSession;                                   /*!< Session used for the transfer */
+    PLAT_UI8 rsp_encryption_flag;                               /*!< Response encryption flag */
+    PLAT_UI8 rsp_precomputed;                                   /*!< Response protection precomputed flag */
+    PLAT_UI8 rsp_mac_started;                                   /*!< R-MAC computation started in the CMAC context */
+    PLAT_UI8 rsp_staged;                                        /*!< Encrypted response received in the staging buffer */
+    PLAT_UI8 Cmd_MAC[STSAFEA_MAC_SIZE];                         /*!< Command MAC */
+    PLAT_UI8 Rsp_MAC[STSAFEA_MAC_SIZE];                         /*!< Response MAC */
+    PLAT_UI8 Rsp_padding[STSAFEA_SESSION_AES_BLOCK_SIZE];       /*!< Encrypted response padding */
+    PLAT_UI8 Rsp_initial_value[STSAFEA_SESSION_AES_BLOCK_SIZE]; /*!< Response decryption IV (AES ECB transformed) */
+    stse_frame_element_t eCmd_MAC;                              /*!< Command MAC frame element */
+    stse_frame_element_t eRsp_MAC;                              /*!< Response MAC frame element */
+    stse_frame_element_t eRsp_padding;                          /*!< Encrypted response padding frame element */
+    stse_frame_element_t eEncrypted_cmd_payload;                /*!< Encrypted command payload frame element */
+    stse_frame_element_t eEncrypted_rsp_payload;                /*!< Staged encrypted response payload frame element */
+    stse_frame_element_t sCmd_strap;                            /*!< Command frame strap */
+    stse_frame_element_t sRsp_strap;                            /*!< Response frame strap (staged encrypted response) */
+#ifdef STSE_CONF_USE_HOST_SESSION
+    stse_platform_aes_cmac_ctx_t cmac_ctx;     /*!< C-MAC then R-MAC computation context */
+    stsafea_session_cmac_feeder_t cmac_feeder; /*!< CMAC context feeder */
+#endif                                         /* STSE_CONF_USE_HOST_SESSION */
+} stsafea_session_transfer_ctx_t;
 
 /*!
  * \brief 		This Core function Create a session context and associate it to STSAFE handler
@@ -89,4 +133,80 @@ stse_ReturnCode_t stsafea_session_authenticated_transfer(stse_session_t *pSessio
                                                          stse_cmd_access_conditions_t cmd_ac_info,
                                                          PLAT_UI16 processing_time);
 
+/**
+ * \brief 		Get encrypted payload size of a frame
+ * \details 	This service returns the size of the frame payload (all elements but the header) once padded to the AES block size
+ * \param[in] 	pFrame					Pointer to frame
+ * \return 		Encrypted payload size in bytes
+ */
+PLAT_UI16 stsafea_session_encrypted_payload_size(stse_frame_t *pFrame);
+
+/**
+ * \brief 		Get the staging buffer size of an encrypted response
+ * \details 	Encrypted responses are received and decrypted in place in the response frame elements. When response
+ *              elements share buffer bytes (e.g. two length fields received in the same variable) or when an element
+ *              has no buffer (discarded field) , the cipher text is received in a staging buffer , decrypted and then
+ *              copied to the response elements
+ * \param[in] 	pRspFrame				Pointer to response frame
+ * \param[in] 	rsp_encryption_flag		Response encryption flag
+ * \return 		Staging buffer size in bytes (0 when the response is decrypted in place)
+ */
+PLAT_UI16 stsafea_session_rsp_staging_size(stse_frame_t *pRspFrame, PLAT_UI8 rsp_encryption_flag);
+
+/**
+ * \brief 		Prepare session protected transfer
+ * \details 	This service sets the command protection bits, encrypts the command payload (if required) while computing
+ *              the command MAC in the same pass, straps the encrypted payload to the command frame and appends the MAC elements.
+ *              Encrypted responses are received in the response frame elements (followed by a padding element) and decrypted in place ,
+ *              or received in the staging buffer when \ref stsafea_session_rsp_staging_size of the response frame is not 0
+ * \param[out] 	pCtx					Pointer to session transfer context (must remain valid until \ref stsafea_session_transfer_finalize)
+ * \param[in] 	pSession				Pointer to session structure
+ * \param[in,out] pCmdFrame				Pointer to command frame
+ * \param[in,out] pRspFrame				Pointer to response frame
+ * \param[in] 	cmd_encryption_flag		Command encryption flag
+ * \param[in] 	rsp_encryption_flag		Response encryption flag
+ * \param[in] 	pEncrypted_cmd_payload	Encrypted command payload buffer (\ref stsafea_session_encrypted_payload_size of command frame)
+ * \param[in] 	pEncrypted_rsp_payload	Encrypted response staging buffer (\ref stsafea_session_rsp_staging_size of response frame ,
+ *                                      may be NULL when 0)
+ * \return 		\ref STSE_OK on success ; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stsafea_session_transfer_prepare(stsafea_session_transfer_ctx_t *pCtx,
+                                                   stse_session_t *pSession,
+                                                   stse_frame_t *pCmdFrame,
+                                                   stse_frame_t *pRspFrame,
+                                                   PLAT_UI8 cmd_encryption_flag,
+                                                   PLAT_UI8 rsp_encryption_flag,
+                                                   PLAT_UI8 *pEncrypted_cmd_payload,
+                                                   PLAT_UI8 *pEncrypted_rsp_payload);
+
+/**
+ * \brief 		Precompute session transfer response protection
+ * \details 	This service starts the response MAC computation (key setup , MAC subject block and command part of the
+ *              R-MAC input) and computes the response decryption IV. Both only depend on the session MAC counter and on
+ *              the transmitted command , it is intended to be called while target STSAFE executes the command.
+ *              When not called , the precomputation is performed by \ref stsafea_session_transfer_finalize.
+ *              Frame transfer services only call it during command execution when STSE_CONF_USE_PLATFORM_AES_CMAC_CTX
+ *              is defined (the R-MAC computation stays open until the response is received)
+ * \param[in,out] pCtx					Pointer to session transfer context (prepared by \ref stsafea_session_transfer_prepare)
+ * \param[in] 	pCmdFrame				Pointer to command frame
+ * \return 		\ref STSE_OK on success ; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stsafea_session_transfer_rsp_precompute(stsafea_session_transfer_ctx_t *pCtx,
+                                                          stse_frame_t *pCmdFrame);
+
+/**
+ * \brief 		Finalize session protected transfer
+ * \details 	This service updates the session MAC counter, removes the command MAC element, verifies the response MAC
+ *              and decrypts the response payload in place or from the staging buffer (if required)
+ * \param[in] 	pCtx					Pointer to session transfer context
+ * \param[in,out] pCmdFrame				Pointer to command frame
+ * \param[in,out] pRspFrame				Pointer to response frame
+ * \param[in] 	transfer_ret			Return code of the raw frame transfer
+ * \return 		\ref STSE_OK on success ; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stsafea_session_transfer_finalize(stsafea_session_transfer_ctx_t *pCtx,
+                                                    stse_frame_t *pCmdFrame,
+                                                    stse_frame_t *pRspFrame,
+                                                    stse_ReturnCode_t transfer_ret);
+
 #endif /* STSE_SESSION_MANAGER_H */
@@ -407,6 +407,7 @@ stse_ReturnCode_t stsafea_confirm_symmetric_key(
         return (STSE_SERVICE_INVALID_PARAMETER);
     }
 
+    stse_platform_aes_cmac_ctx_t cmac_ctx;
     PLAT_UI8 pConfirmation_mac[STSE_KEY_CONFIRMATION_MAC_SIZE];
     stse_frame_element_t eKey_information_list[key_count];
     PLAT_UI8 rsp_header;
@@ -415,7 +416,8 @@ stse_ReturnCode_t stsafea_confirm_symmetric_key(
     stse_frame_element_allocate_push(&CmdFrame, eCmd_header, STSAFEA_EXT_HEADER_SIZE, cmd_header);
     stse_frame_element_allocate_push(&CmdFrame, eConfirmation_mac, STSE_KEY_CONFIRMATION_MAC_SIZE, pConfirmation_mac);
 
-    ret = stse_platform_aes_cmac_init(
+    ret = stse_platform_aes_cmac_ctx_init(
+        &cmac_ctx,
         pMac_confirmation_key,
         STSAFEA_AES_256_KEY_SIZE,
         STSE_KEY_CONFIRMATION_MAC_SIZE);
@@ -423,7 +425,7 @@ stse_ReturnCode_t stsafea_confirm_symmetric_key(
         return (ret);
     }
 
-    for (PLAT_UI8 i = 0; i < key_count; i++) {
+    for (PLAT_UI8 i = 0; (i < key_count) && (ret == STSE_OK); i++) {
         PLAT_UI8 temp_buffer;
 
         eKey_information_list[i].length = pKey_information_list[i].info_length + STSAFEA_GENERIC_LENGTH_SIZE;
@@ -434,17 +436,20 @@ stse_ReturnCode_t stsafea_confirm_symmetric_key(
         eKey_information_list[i].pData[0] = eKey_information_list[i].pData[1];
         eKey_information_list[i].pData[1] = temp_buffer;
 
-        ret = stse_platform_aes_cmac_append(
+        ret = stse_platform_aes_cmac_ctx_append(
+            &cmac_ctx,
             eKey_information_list[i].pData,
             eKey_information_list[i].length);
-        if (ret != STSE_OK) {
-            return (ret);
-        }
 
         stse_frame_push_element(&CmdFrame, &eKey_information_list[i]);
     }
 
-    ret = stse_platform_aes_cmac_compute_finish(pConfirmation_mac, NULL);
+    if (ret != STSE_OK) {
+        stse_platform_aes_cmac_ctx_abort(&cmac_ctx);
+        return (ret);
+    }
+
+    ret = stse_platform_aes_cmac_ctx_compute_finish(&cmac_ctx, pConfirmation_mac, NULL);
     if (ret != STSE_OK) {
         return (ret);
     }
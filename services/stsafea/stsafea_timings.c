@@ -15,6 +15,8 @@
  ******************************************************************************
  */
 
+#include <string.h>
+
 #include "services/stsafea/stsafea_timings.h"
 
 #ifdef STSE_CONF_STSAFE_A_SUPPORT
@@ -22,6 +24,14 @@
 #define STSAFEA_BOOT_TIME_DEFAULT 10U
 #define STSAFEA_WAKEUP_TIME_DEFAULT 10U
 
+#ifdef STSE_USE_ADAPTIVE_RSP_POLLING
+#define STSAFEA_CMD_CODE_Msk 0x1FU
+#define STSAFEA_EXEC_TIME_FRAC_BITS 3U /* Statistics stored in 1/8 ms units */
+#define STSAFEA_EXEC_TIME_AVG_SHIFT 3U /* Average smoothing factor : 1/8 */
+#define STSAFEA_EXEC_TIME_DEV_SHIFT 2U /* Deviation smoothing factor : 1/4 */
+#define STSAFEA_EXEC_TIME_MAX 0xFFFF
+#endif /* STSE_USE_ADAPTIVE_RSP_POLLING */
+
 const PLAT_UI16 stsafea_cmd_timings[STSAFEA_PRODUCT_COUNT][STSAFEA_MAX_CMD_COUNT] = {
     /* STSAFE_A100 */
     {
@@ -227,4 +237,136 @@ const PLAT_UI16 stsafea_wakeup_time[STSAFEA_PRODUCT_COUNT] = {
     STSAFEA_WAKEUP_TIME_DEFAULT, /* STSAFE_A120 */
 };
 
+#ifdef STSE_USE_ADAPTIVE_RSP_POLLING
+
+static stse_exec_time_stat_t *stsafea_exec_time_get_stat(stse_Handler_t *pSTSE,
+                                                         PLAT_UI8 cmd_header,
+                                                         PLAT_UI8 ext_cmd_header) {
+    if (pSTSE == NULL) {
+        return NULL;
+    }
+
+    if ((cmd_header & STSAFEA_CMD_CODE_Msk) == STSAFEA_EXTENDED_COMMAND_PREFIX) {
+        if (ext_cmd_header >= STSE_EXEC_TIME_TRACKED_CMD_COUNT) {
+            return NULL;
+        }
+        return &pSTSE->exec_time.ext_cmd[ext_cmd_header];
+    }
+
+    return &pSTSE->exec_time.cmd[cmd_header & STSAFEA_CMD_CODE_Msk];
+}
+
+PLAT_UI16 stsafea_exec_time_estimate(stse_Handler_t *pSTSE,
+                                     PLAT_UI8 cmd_header,
+                                     PLAT_UI8 ext_cmd_header,
+                                     PLAT_UI16 static_exec_time) {
+    stse_exec_time_stat_t *pStat = stsafea_exec_time_get_stat(pSTSE, cmd_header, ext_cmd_header);
+    PLAT_UI32 expected_time;
+
+    /* - Fallback to static timing until a first execution is recorded */
+    if ((pStat == NULL) || (pStat->sample_count == 0)) {
+        return static_exec_time;
+    }
+
+    /* - Start polling one mean deviation before the smoothed execution time */
+    if (pStat->deviation >= pStat->average) {
+        expected_time = 0;
+    } else {
+        expected_time = (PLAT_UI32)(pStat->average - pStat->deviation) >> STSAFEA_EXEC_TIME_FRAC_BITS;
+    }
+
+    /* - Never wait longer than the worst case static timing */
+    if (expected_time > static_exec_time) {
+        expected_time = static_exec_time;
+    }
+
+    return (PLAT_UI16)expected_time;
+}
+
+void stsafea_exec_time_record(stse_Handler_t *pSTSE,
+                              PLAT_UI8 cmd_header,
+                              PLAT_UI8 ext_cmd_header,
+                              PLAT_UI16 waited_time,
+                              PLAT_UI16 poll_count) {
+    stse_exec_time_stat_t *pStat = stsafea_exec_time_get_stat(pSTSE, cmd_header, ext_cmd_header);
+    PLAT_I32 sample;
+    PLAT_I32 error;
+    PLAT_I32 average;
+    PLAT_I32 deviation;
+
+    if (pStat == NULL) {
+        return;
+    }
+
+    /* - Observed execution time : waited delay + NACKed polls duration (upper bound when first poll is ACKed) */
+    sample = ((PLAT_I32)waited_time + ((PLAT_I32)poll_count * STSE_POLLING_RETRY_INTERVAL)) << STSAFEA_EXEC_TIME_FRAC_BITS;
+    if (sample > STSAFEA_EXEC_TIME_MAX) {
+        sample = STSAFEA_EXEC_TIME_MAX;
+    }
+
+    if (pStat->sample_count == 0) {
+        /* - First sample : average = sample , deviation = sample / 2 */
+        average = sample;
+        deviation = sample >> 1;
+    } else {
+        average = pStat->average;
+        deviation = pStat->deviation;
+        error = sample - average;
+        if (error < 0) {
+            /* - Sample is an upper bound of the execution time : lower the average immediately */
+            average = sample;
+            error = -error;
+        } else {
+            /* - Exponentially weighted moving average */
+            average += error >> STSAFEA_EXEC_TIME_AVG_SHIFT;
+        }
+        /* - Exponentially weighted mean deviation */
+        deviation += (error - deviation) >> STSAFEA_EXEC_TIME_DEV_SHIFT;
+    }
+
+    pStat->average = (average > STSAFEA_EXEC_TIME_MAX) ? STSAFEA_EXEC_TIME_MAX : (PLAT_UI16)average;
+    pStat->deviation = (deviation > STSAFEA_EXEC_TIME_MAX) ? STSAFEA_EXEC_TIME_MAX : (PLAT_UI16)deviation;
+    if (pStat->sample_count < 0xFF) {
+        pStat->sample_count++;
+    }
+}
+
+stse_ReturnCode_t stsafea_exec_time_get_statistics(stse_Handler_t *pSTSE,
+                                                   PLAT_UI8 cmd_header,
+                                                   PLAT_UI8 ext_cmd_header,
+                                                   PLAT_UI16 *pAverage,
+                                                   PLAT_UI16 *pDeviation,
+                                                   PLAT_UI8 *pSample_count) {
+    stse_exec_time_stat_t *pStat;
+
+    if (pSTSE == NULL) {
+        return STSE_SERVICE_HANDLER_NOT_INITIALISED;
+    }
+
+    if ((pAverage == NULL) || (pDeviation == NULL) || (pSample_count == NULL)) {
+        return STSE_SERVICE_INVALID_PARAMETER;
+    }
+
+    pStat = stsafea_exec_time_get_stat(pSTSE, cmd_header, ext_cmd_header);
+    if (pStat == NULL) {
+        return STSE_SERVICE_INVALID_PARAMETER;
+    }
+
+    *pAverage = pStat->average >> STSAFEA_EXEC_TIME_FRAC_BITS;
+    *pDeviation = pStat->deviation >> STSAFEA_EXEC_TIME_FRAC_BITS;
+    *pSample_count = pStat->sample_count;
+
+    return STSE_OK;
+}
+
+void stsafea_exec_time_reset(stse_Handler_t *pSTSE) {
+    if (pSTSE == NULL) {
+        return;
+    }
+
+    memset(&pSTSE->exec_time, 0, sizeof(pSTSE->exec_time));
+}
+
+#endif /* STSE_USE_ADAPTIVE_RSP_POLLING */
+
 #endif /* STSE_CONF_STSAFE_A_SUPPORT */
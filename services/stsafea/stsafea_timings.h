@@ -40,6 +40,64 @@ extern const PLAT_UI16 stsafea_extended_cmd_timings[STSAFEA_PRODUCT_COUNT][STSAF
 extern const PLAT_UI16 stsafea_boot_time[STSAFEA_PRODUCT_COUNT];
 extern const PLAT_UI16 stsafea_wakeup_time[STSAFEA_PRODUCT_COUNT];
 
+#ifdef STSE_USE_ADAPTIVE_RSP_POLLING
+
+/**
+ * \brief 		Get the expected execution time of a command
+ * \details 	This service returns the learned execution time of a command (smoothed average minus mean deviation)
+ *              or the static timing value when no execution has been recorded yet for this command
+ * \param[in] 	pSTSE 				Pointer to STSE Handler
+ * \param[in] 	cmd_header 			Command header
+ * \param[in] 	ext_cmd_header 		Extended command header (only used for extended commands)
+ * \param[in] 	static_exec_time 	Static (worst case) command execution time in ms
+ * \return 		Expected command execution time in ms (never greater than static_exec_time)
+ */
+PLAT_UI16 stsafea_exec_time_estimate(stse_Handler_t *pSTSE,
+                                     PLAT_UI8 cmd_header,
+                                     PLAT_UI8 ext_cmd_header,
+                                     PLAT_UI16 static_exec_time);
+
+/**
+ * \brief 		Record an observed command execution time
+ * \details 	This service updates the command execution time statistics from the delay waited before
+ *              response reception and the number of polls NACKed by the target device
+ * \param[in] 	pSTSE 				Pointer to STSE Handler
+ * \param[in] 	cmd_header 			Command header
+ * \param[in] 	ext_cmd_header 		Extended command header (only used for extended commands)
+ * \param[in] 	waited_time 		Delay waited before first response poll in ms
+ * \param[in] 	poll_count 			Number of response polls NACKed by the target device
+ */
+void stsafea_exec_time_record(stse_Handler_t *pSTSE,
+                              PLAT_UI8 cmd_header,
+                              PLAT_UI8 ext_cmd_header,
+                              PLAT_UI16 waited_time,
+                              PLAT_UI16 poll_count);
+
+/**
+ * \brief 		Get the learned execution time statistics of a command
+ * \param[in] 	pSTSE 				Pointer to STSE Handler
+ * \param[in] 	cmd_header 			Command header
+ * \param[in] 	ext_cmd_header 		Extended command header (only used for extended commands)
+ * \param[out] 	pAverage 			Smoothed execution time in ms
+ * \param[out] 	pDeviation 			Smoothed execution time mean deviation in ms
+ * \param[out] 	pSample_count 		Number of recorded samples (saturated to 255)
+ * \return 		\ref STSE_OK on success ; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stsafea_exec_time_get_statistics(stse_Handler_t *pSTSE,
+                                                   PLAT_UI8 cmd_header,
+                                                   PLAT_UI8 ext_cmd_header,
+                                                   PLAT_UI16 *pAverage,
+                                                   PLAT_UI16 *pDeviation,
+                                                   PLAT_UI8 *pSample_count);
+
+/**
+ * \brief 		Clear all learned execution time statistics
+ * \param[in] 	pSTSE 				Pointer to STSE Handler
+ */
+void stsafea_exec_time_reset(stse_Handler_t *pSTSE);
+
+#endif /* STSE_USE_ADAPTIVE_RSP_POLLING */
+
 /** @}*/
 
 #ifdef __cplusplus
@@ -20,6 +20,9 @@
 #include <stddef.h>
 #include <stdio.h>
 
+#include "core/stse_cmd_metrics.h"
+#include "core/stse_frame_trace.h"
+#include "core/stse_retry.h"
 #include "services/stsafel/stsafel_frame_transfer.h"
 #include "services/stsafel/stsafel_timings.h"
 
@@ -31,10 +34,12 @@ const PLAT_UI16 stsafel_maximum_frame_length[STSAFEL_PRODUCT_COUNT] = {
 
 stse_ReturnCode_t stsafel_frame_transmit(stse_Handler_t *pSTSE, stse_frame_t *pFrame) {
     stse_ReturnCode_t ret = STSE_PLATFORM_BUS_ACK_ERROR;
-    PLAT_UI16 retry_count = STSE_MAX_POLLING_RETRY;
+    stse_retry_t retry;
     stse_frame_element_t *pCurrent_element;
     PLAT_UI16 crc_ret;
     PLAT_UI8 crc[STSE_FRAME_CRC_SIZE] = {0};
+    PLAT_UI8 crc_on_the_fly = 0;
+    PLAT_UI8 vectored_send;
 
     /*- Verify Parameters */
     if ((pSTSE == NULL) || (pFrame == NULL)) {
@@ -56,13 +61,21 @@ stse_ReturnCode_t stsafel_frame_transmit(stse_Handler_t *pSTSE, stse_frame_t *pF
     if (pFrame->length > stsafel_maximum_frame_length[pSTSE->device_type - STSE_DEVICE_STSAFEL_FAMILY_INDEX]) {
         return STSE_SERVICE_FRAME_SIZE_ERROR;
     }
-    /*- Compute frame crc */
-    ret = stse_frame_crc16_compute(pFrame, &crc_ret);
-    if (ret != STSE_OK) {
-        return ret;
+    /*- Send frame elements and CRC in a single bus transaction when supported (bounded I/O vector) */
+    vectored_send = ((pSTSE->io.BusSendV != NULL) && ((pFrame->element_count + 1U) <= STSE_CONF_FRAME_MAX_ELEMENT_COUNT));
+#if defined(STSE_USE_INCREMENTAL_CRC) && !defined(STSE_FRAME_DEBUG_LOG)
+    /*- Compute frame crc while sending frame elements (not applicable to vectored send) */
+    crc_on_the_fly = (vectored_send == 0);
+#endif /* STSE_USE_INCREMENTAL_CRC && !STSE_FRAME_DEBUG_LOG */
+    if (crc_on_the_fly == 0) {
+        /*- Compute frame crc */
+        ret = stse_frame_crc16_compute(pFrame, &crc_ret);
+        if (ret != STSE_OK) {
+            return ret;
+        }
+        crc[0] = (crc_ret >> 8) & 0xFF;
+        crc[1] = crc_ret & 0xFF;
     }
-    crc[0] = (crc_ret >> 8) & 0xFF;
-    crc[1] = crc_ret & 0xFF;
 
     /* - Append CRC element to the RSP Frame (valid only on Receive Scope) */
     stse_frame_element_allocate(crc_element, STSE_FRAME_CRC_SIZE, crc);
@@ -75,16 +88,38 @@ stse_ReturnCode_t stsafel_frame_transmit(stse_Handler_t *pSTSE, stse_frame_t *pF
 #endif /* STSE_FRAME_DEBUG_LOG */
 
     ret = STSE_PLATFORM_BUS_ACK_ERROR;
-    while ((retry_count != 0) && (ret == STSE_PLATFORM_BUS_ACK_ERROR)) {
-        ret = pSTSE->io.BusSendStart(
-            pSTSE->io.busID,
-            pSTSE->io.Devaddr,
-            pSTSE->io.BusSpeed,
-            pFrame->length);
+    stse_retry_init(pSTSE, &retry, STSE_MAX_POLLING_RETRY);
+    do {
+        if (vectored_send != 0) {
+            /* - Describe frame elements as bus I/O vector and send the whole frame in a single bus transaction */
+            stse_io_vector_t io_vector[STSE_CONF_FRAME_MAX_ELEMENT_COUNT];
+            ret = pSTSE->io.BusSendV(
+                pSTSE->io.busID,
+                pSTSE->io.Devaddr,
+                pSTSE->io.BusSpeed,
+                io_vector,
+                stse_frame_io_vector_fill(pFrame, pFrame->first_element, io_vector));
+        } else {
+            ret = pSTSE->io.BusSendStart(
+                pSTSE->io.busID,
+                pSTSE->io.Devaddr,
+                pSTSE->io.BusSpeed,
+                pFrame->length);
+        }
 
-        if (ret == STSE_OK) {
+        if ((ret == STSE_OK) && (vectored_send == 0)) {
             pCurrent_element = pFrame->first_element;
             while (pCurrent_element != pFrame->last_element) {
+                if (crc_on_the_fly != 0) {
+                    /*- Fold element in frame crc */
+                    ret = stse_frame_crc16_accumulate(pCurrent_element->pData,
+                                                      pCurrent_element->length,
+                                                      (pCurrent_element == pFrame->first_element),
+                                                      &crc_ret);
+                    if (ret != STSE_OK) {
+                        break;
+                    }
+                }
                 ret = pSTSE->io.BusSendContinue(
                     pSTSE->io.busID,
                     pSTSE->io.Devaddr,
@@ -96,6 +131,10 @@ stse_ReturnCode_t stsafel_frame_transmit(stse_Handler_t *pSTSE, stse_frame_t *pF
                 }
                 pCurrent_element = pCurrent_element->next;
             }
+            if ((ret == STSE_OK) && (crc_on_the_fly != 0)) {
+                crc[0] = (crc_ret >> 8) & 0xFF;
+                crc[1] = crc_ret & 0xFF;
+            }
             if (ret == STSE_OK) {
                 ret = pSTSE->io.BusSendStop(
                     pSTSE->io.busID,
@@ -105,19 +144,54 @@ stse_ReturnCode_t stsafel_frame_transmit(stse_Handler_t *pSTSE, stse_frame_t *pF
                     pCurrent_element->length);
             }
         }
-
-        if (ret != STSE_OK) {
-            retry_count--;
-            stse_platform_Delay_ms(STSE_POLLING_RETRY_INTERVAL);
-        }
-    }
+    } while ((ret == STSE_PLATFORM_BUS_ACK_ERROR) && (stse_retry_wait(pSTSE, &retry) != 0));
 
     /* - Pop CRC element from Frame*/
     stse_frame_pop_element(pFrame);
+
+#ifdef STSE_FRAME_TRACE
+    stse_frame_trace_record(pSTSE, STSE_FRAME_TRACE_CMD, pFrame, ret);
+#endif /* STSE_FRAME_TRACE */
+
     return ret;
 }
 
 #ifdef STSE_CONF_USE_I2C
+static stse_ReturnCode_t stsafel_frame_vectored_receive(stse_Handler_t *pSTSE,
+                                                        stse_frame_t *pFrame,
+                                                        PLAT_UI16 received_length) {
+    stse_ReturnCode_t ret = STSE_PLATFORM_BUS_ACK_ERROR;
+    stse_retry_t retry;
+    stse_frame_element_t *pCurrent_element;
+    stse_io_vector_t io_vector[STSE_CONF_FRAME_MAX_ELEMENT_COUNT];
+    PLAT_UI8 vector_count;
+
+    /* - Fit frame elements (CRC excluded) to the received response length */
+    pCurrent_element = pFrame->first_element;
+    while (pCurrent_element != pFrame->last_element) {
+        if (received_length < pCurrent_element->length) {
+            pCurrent_element->length = received_length;
+        }
+        received_length -= pCurrent_element->length;
+        pCurrent_element = pCurrent_element->next;
+    }
+
+    /* - Describe frame elements as bus I/O vector */
+    vector_count = stse_frame_io_vector_fill(pFrame, pFrame->first_element, io_vector);
+
+    stse_retry_init(pSTSE, &retry, STSE_MAX_POLLING_RETRY);
+    do {
+        ret = pSTSE->io.BusRecvV(
+            pSTSE->io.busID,
+            pSTSE->io.Devaddr,
+            pSTSE->io.BusSpeed,
+            io_vector,
+            vector_count);
+    } while ((ret == STSE_PLATFORM_BUS_ACK_ERROR) && (stse_retry_wait(pSTSE, &retry) != 0));
+
+    return ret;
+}
+
 stse_ReturnCode_t stsafel_i2c_frame_receive(stse_Handler_t *pSTSE, stse_frame_t *pFrame) {
     stse_ReturnCode_t ret = STSE_PLATFORM_BUS_ACK_ERROR;
     stse_frame_element_t *pCurrent_element;
@@ -126,8 +200,9 @@ stse_ReturnCode_t stsafel_i2c_frame_receive(stse_Handler_t *pSTSE, stse_frame_t
     PLAT_UI8 received_crc[STSE_FRAME_CRC_SIZE];
     PLAT_UI16 computed_crc;
     PLAT_UI16 filler_size = 0;
-    PLAT_UI16 retry_count = STSE_MAX_POLLING_RETRY;
+    stse_retry_t retry;
     PLAT_UI8 length_value[STSE_FRAME_LENGTH_SIZE];
+    PLAT_UI8 crc_accumulated = 0;
 
     /*- Verify Parameters */
     if ((pSTSE == NULL) || (pFrame == NULL)) {
@@ -148,19 +223,15 @@ stse_ReturnCode_t stsafel_i2c_frame_receive(stse_Handler_t *pSTSE, stse_frame_t
 
     /* ======================================================= */
     /* ============== Get the total frame length ============= */
-    while ((retry_count != 0) && (ret == STSE_PLATFORM_BUS_ACK_ERROR)) {
+    stse_retry_init(pSTSE, &retry, STSE_MAX_POLLING_RETRY);
+    do {
         /* - Receive frame length from target STSAFE */
         ret = pSTSE->io.BusRecvStart(
             pSTSE->io.busID,
             pSTSE->io.Devaddr,
             pSTSE->io.BusSpeed,
             STSE_FRAME_LENGTH_SIZE);
-
-        if (ret != STSE_OK) {
-            retry_count--;
-            stse_platform_Delay_ms(STSE_POLLING_RETRY_INTERVAL);
-        }
-    }
+    } while ((ret == STSE_PLATFORM_BUS_ACK_ERROR) && (stse_retry_wait(pSTSE, &retry) != 0));
 
     /* - Verify correct reception*/
     if ((ret & STSE_STSAFEL_RSP_STATUS_MASK) != STSE_OK) {
@@ -211,84 +282,138 @@ stse_ReturnCode_t stsafel_i2c_frame_receive(stse_Handler_t *pSTSE, stse_frame_t
     /* ======================================================= */
     /* ========= Receive the frame in frame elements ========= */
 
-    ret = STSE_PLATFORM_BUS_ACK_ERROR;
-    retry_count = STSE_MAX_POLLING_RETRY;
-    while ((retry_count != 0) && (ret == STSE_PLATFORM_BUS_ACK_ERROR)) {
-        /* - Receive frame length from target STSAFE */
-        ret = pSTSE->io.BusRecvStart(
-            pSTSE->io.busID,
-            pSTSE->io.Devaddr,
-            pSTSE->io.BusSpeed,
-            received_length + STSE_FRAME_CRC_SIZE);
+    stse_frame_element_allocate(eCRC, STSE_FRAME_CRC_SIZE, received_crc);
 
-        if (ret != STSE_OK) {
-            retry_count--;
-            stse_platform_Delay_ms(STSE_POLLING_RETRY_INTERVAL);
-        }
-    }
+    if ((pSTSE->io.BusRecvV != NULL) && ((pFrame->element_count + 1U) <= STSE_CONF_FRAME_MAX_ELEMENT_COUNT)) {
+        /* - Append CRC element to the RSP Frame (valid only in Receive Scope) */
+        stse_frame_push_element(pFrame, &eCRC);
 
-    /* - Verify correct reception*/
-    if (ret != STSE_OK) {
-        /* - Pop Filler element from Frame*/
-        if (filler_size > 0) {
-            stse_frame_pop_element(pFrame);
-        }
-        return ret;
-    }
-
-    /* Receive response header */
-    ret = pSTSE->io.BusRecvContinue(
-        pSTSE->io.busID,
-        pSTSE->io.Devaddr,
-        pSTSE->io.BusSpeed,
-        pFrame->first_element->pData,
-        STSE_RSP_FRAME_HEADER_SIZE);
-
-    if (ret != STSE_OK) {
-        /* - Pop Filler element from Frame*/
-        if (filler_size > 0) {
+        /* - Receive the whole frame in a single bus transaction */
+        ret = stsafel_frame_vectored_receive(pSTSE, pFrame, received_length);
+        if (ret != STSE_OK) {
+            /* - Pop CRC element from Frame*/
             stse_frame_pop_element(pFrame);
+            /* - Pop Filler element from Frame*/
+            if (filler_size > 0) {
+                stse_frame_pop_element(pFrame);
+            }
+            return ret;
         }
-        return ret;
-    }
-
-    received_header = (stse_ReturnCode_t)(pFrame->first_element->pData[0] & STSE_STSAFEL_RSP_STATUS_MASK);
-    if (received_header != STSE_OK) {
-        while (pFrame->element_count > 1) {
-            stse_frame_pop_element(pFrame);
+    } else {
+        ret = STSE_PLATFORM_BUS_ACK_ERROR;
+        stse_retry_init(pSTSE, &retry, STSE_MAX_POLLING_RETRY);
+        do {
+            /* - Receive frame length from target STSAFE */
+            ret = pSTSE->io.BusRecvStart(
+                pSTSE->io.busID,
+                pSTSE->io.Devaddr,
+                pSTSE->io.BusSpeed,
+                received_length + STSE_FRAME_CRC_SIZE);
+        } while ((ret == STSE_PLATFORM_BUS_ACK_ERROR) && (stse_retry_wait(pSTSE, &retry) != 0));
+
+        /* - Verify correct reception*/
+        if (ret != STSE_OK) {
+            /* - Pop Filler element from Frame*/
+            if (filler_size > 0) {
+                stse_frame_pop_element(pFrame);
+            }
+            return ret;
         }
-    }
-
-    /* - Append CRC element to the RSP Frame (valid only in Receive Scope) */
-    stse_frame_element_allocate_push(pFrame, eCRC, STSE_FRAME_CRC_SIZE, received_crc);
 
-    /* If first element is longer than just the header */
-    if (pFrame->first_element->length > STSE_RSP_FRAME_HEADER_SIZE) {
-        /* Receive missing bytes after discarding the 2 bytes length */
+        /* Receive response header */
         ret = pSTSE->io.BusRecvContinue(
             pSTSE->io.busID,
             pSTSE->io.Devaddr,
             pSTSE->io.BusSpeed,
-            pFrame->first_element->pData + STSE_RSP_FRAME_HEADER_SIZE,
-            pFrame->first_element->length - STSE_RSP_FRAME_HEADER_SIZE);
+            pFrame->first_element->pData,
+            STSE_RSP_FRAME_HEADER_SIZE);
+#ifdef STSE_USE_INCREMENTAL_CRC
+        if (ret == STSE_OK) {
+            /* - Start frame CRC computation on received response header */
+            ret = stse_frame_crc16_accumulate(pFrame->first_element->pData, STSE_RSP_FRAME_HEADER_SIZE, 1, &computed_crc);
+            crc_accumulated = 1;
+        }
+#endif /* STSE_USE_INCREMENTAL_CRC */
+
         if (ret != STSE_OK) {
-            /* - Pop CRC element from Frame*/
-            stse_frame_pop_element(pFrame);
             /* - Pop Filler element from Frame*/
             if (filler_size > 0) {
                 stse_frame_pop_element(pFrame);
             }
             return ret;
         }
-    }
 
-    /* - Perform frame element reception and populate local RSP Frame */
-    pCurrent_element = pFrame->first_element->next;
-    while (pCurrent_element != pFrame->last_element) {
-        if (received_length < pCurrent_element->length) {
-            pCurrent_element->length = received_length;
+        received_header = (stse_ReturnCode_t)(pFrame->first_element->pData[0] & STSE_STSAFEL_RSP_STATUS_MASK);
+        if (received_header != STSE_OK) {
+            while (pFrame->element_count > 1) {
+                stse_frame_pop_element(pFrame);
+            }
         }
-        ret = pSTSE->io.BusRecvContinue(
+
+        /* - Append CRC element to the RSP Frame (valid only in Receive Scope) */
+        stse_frame_push_element(pFrame, &eCRC);
+
+        /* If first element is longer than just the header */
+        if (pFrame->first_element->length > STSE_RSP_FRAME_HEADER_SIZE) {
+            /* Receive missing bytes after discarding the 2 bytes length */
+            ret = pSTSE->io.BusRecvContinue(
+                pSTSE->io.busID,
+                pSTSE->io.Devaddr,
+                pSTSE->io.BusSpeed,
+                pFrame->first_element->pData + STSE_RSP_FRAME_HEADER_SIZE,
+                pFrame->first_element->length - STSE_RSP_FRAME_HEADER_SIZE);
+#ifdef STSE_USE_INCREMENTAL_CRC
+            if (ret == STSE_OK) {
+                /* - Fold received first element remaining bytes in frame CRC */
+                ret = stse_frame_crc16_accumulate(pFrame->first_element->pData + STSE_RSP_FRAME_HEADER_SIZE,
+                                                  pFrame->first_element->length - STSE_RSP_FRAME_HEADER_SIZE,
+                                                  0,
+                                                  &computed_crc);
+            }
+#endif /* STSE_USE_INCREMENTAL_CRC */
+            if (ret != STSE_OK) {
+                /* - Pop CRC element from Frame*/
+                stse_frame_pop_element(pFrame);
+                /* - Pop Filler element from Frame*/
+                if (filler_size > 0) {
+                    stse_frame_pop_element(pFrame);
+                }
+                return ret;
+            }
+        }
+
+        /* - Perform frame element reception and populate local RSP Frame */
+        pCurrent_element = pFrame->first_element->next;
+        while (pCurrent_element != pFrame->last_element) {
+            if (received_length < pCurrent_element->length) {
+                pCurrent_element->length = received_length;
+            }
+            ret = pSTSE->io.BusRecvContinue(
+                pSTSE->io.busID,
+                pSTSE->io.Devaddr,
+                pSTSE->io.BusSpeed,
+                pCurrent_element->pData,
+                pCurrent_element->length);
+#ifdef STSE_USE_INCREMENTAL_CRC
+            if (ret == STSE_OK) {
+                /* - Fold received element in frame CRC */
+                ret = stse_frame_crc16_accumulate(pCurrent_element->pData, pCurrent_element->length, 0, &computed_crc);
+            }
+#endif /* STSE_USE_INCREMENTAL_CRC */
+            if (ret != STSE_OK) {
+                /* - Pop CRC element from Frame*/
+                stse_frame_pop_element(pFrame);
+                /* - Pop Filler element from Frame*/
+                if (filler_size > 0) {
+                    stse_frame_pop_element(pFrame);
+                }
+                return ret;
+            }
+
+            received_length -= pCurrent_element->length;
+            pCurrent_element = pCurrent_element->next;
+        }
+        ret = pSTSE->io.BusRecvStop(
             pSTSE->io.busID,
             pSTSE->io.Devaddr,
             pSTSE->io.BusSpeed,
@@ -303,24 +428,6 @@ stse_ReturnCode_t stsafel_i2c_frame_receive(stse_Handler_t *pSTSE, stse_frame_t
             }
             return ret;
         }
-
-        received_length -= pCurrent_element->length;
-        pCurrent_element = pCurrent_element->next;
-    }
-    ret = pSTSE->io.BusRecvStop(
-        pSTSE->io.busID,
-        pSTSE->io.Devaddr,
-        pSTSE->io.BusSpeed,
-        pCurrent_element->pData,
-        pCurrent_element->length);
-    if (ret != STSE_OK) {
-        /* - Pop CRC element from Frame*/
-        stse_frame_pop_element(pFrame);
-        /* - Pop Filler element from Frame*/
-        if (filler_size > 0) {
-            stse_frame_pop_element(pFrame);
-        }
-        return ret;
     }
 
 #ifdef STSE_FRAME_DEBUG_LOG
@@ -335,8 +442,10 @@ stse_ReturnCode_t stsafel_i2c_frame_receive(stse_Handler_t *pSTSE, stse_frame_t
     /* - Pop CRC element from Frame*/
     stse_frame_pop_element(pFrame);
 
-    /* - Compute CRC */
-    ret = stse_frame_crc16_compute(pFrame, &computed_crc);
+    /* - Compute CRC (unless accumulated during frame elements reception) */
+    if (crc_accumulated == 0) {
+        ret = stse_frame_crc16_compute(pFrame, &computed_crc);
+    }
 
     /* - Pop Filler element from Frame*/
     if (filler_size > 0) {
@@ -365,7 +474,7 @@ stse_ReturnCode_t stsafel_st1wire_frame_receive(stse_Handler_t *pSTSE, stse_fram
     PLAT_UI16 received_length;
     PLAT_UI8 received_crc[STSE_FRAME_CRC_SIZE];
     PLAT_UI16 computed_crc = 0;
-    PLAT_UI16 retry_count = STSE_MAX_POLLING_RETRY;
+    stse_retry_t retry;
 
     /*- Verify Parameters */
     if ((pSTSE == NULL) || (pFrame == NULL)) {
@@ -382,18 +491,14 @@ stse_ReturnCode_t stsafel_st1wire_frame_receive(stse_Handler_t *pSTSE, stse_fram
     /* - Store response Length */
     received_length = pFrame->length;
 
-    while ((retry_count != 0) && (ret == STSE_PLATFORM_BUS_ACK_ERROR)) {
+    stse_retry_init(pSTSE, &retry, STSE_MAX_POLLING_RETRY);
+    do {
         ret = pSTSE->io.BusRecvStart(
             pSTSE->io.busID,
             pSTSE->io.Devaddr,
             pSTSE->io.BusSpeed,
             pFrame->length);
-
-        if (ret != STSE_OK) {
-            retry_count--;
-            stse_platform_Delay_ms(STSE_POLLING_RETRY_INTERVAL);
-        }
-    }
+    } while ((ret == STSE_PLATFORM_BUS_ACK_ERROR) && (stse_retry_wait(pSTSE, &retry) != 0));
 
     /* - Receive response header */
     ret = pSTSE->io.BusRecvContinue(
@@ -419,6 +524,14 @@ stse_ReturnCode_t stsafel_st1wire_frame_receive(stse_Handler_t *pSTSE, stse_fram
         return ret;
     }
 
+#ifdef STSE_USE_INCREMENTAL_CRC
+    /* - Start frame CRC computation on received first element */
+    ret = stse_frame_crc16_accumulate(pFrame->first_element->pData, pFrame->first_element->length, 1, &computed_crc);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+#endif /* STSE_USE_INCREMENTAL_CRC */
+
     received_length--;
 
     /* - Perform frame element reception and populate local RSP Frame */
@@ -433,6 +546,12 @@ stse_ReturnCode_t stsafel_st1wire_frame_receive(stse_Handler_t *pSTSE, stse_fram
             pSTSE->io.BusSpeed,
             pCurrent_element->pData,
             pCurrent_element->length);
+#ifdef STSE_USE_INCREMENTAL_CRC
+        if (ret == STSE_OK) {
+            /* - Fold received element in frame CRC */
+            ret = stse_frame_crc16_accumulate(pCurrent_element->pData, pCurrent_element->length, 0, &computed_crc);
+        }
+#endif /* STSE_USE_INCREMENTAL_CRC */
         if (ret != STSE_OK) {
             return ret;
         }
@@ -462,11 +581,13 @@ stse_ReturnCode_t stsafel_st1wire_frame_receive(stse_Handler_t *pSTSE, stse_fram
     /* - Pop CRC element from Frame*/
     stse_frame_pop_element(pFrame);
 
+#ifndef STSE_USE_INCREMENTAL_CRC
     /* - Compute CRC */
     ret = stse_frame_crc16_compute(pFrame, &computed_crc);
     if (ret != STSE_OK) {
         return ret;
     }
+#endif /* STSE_USE_INCREMENTAL_CRC */
 
     /* - Verify CRC */
     if (computed_crc != *(PLAT_UI16 *)received_crc) {
@@ -489,8 +610,34 @@ stse_ReturnCode_t stsafel_frame_raw_transfer(stse_Handler_t *pSTSE,
     (void)inter_frame_delay;
 #endif /* STSE_USE_RSP_POLLING */
 
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+    ret = stse_handler_lock(pSTSE);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
+
+#ifdef STSE_USE_RETRY_POLICY
+    stse_retry_command_start(pSTSE);
+#endif /* STSE_USE_RETRY_POLICY */
+#ifdef STSE_CMD_METRICS
+    stse_cmd_metrics_command_start(pSTSE);
+#endif /* STSE_CMD_METRICS */
+
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+    ret = stse_bus_lock(pSTSE);
+    if (ret == STSE_OK) {
+        /* - Send Non-protected Frame */
+        ret = stsafel_frame_transmit(pSTSE, pCmdFrame);
+        stse_bus_unlock(pSTSE);
+    }
+#else
     /* - Send Non-protected Frame */
     ret = stsafel_frame_transmit(pSTSE, pCmdFrame);
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
+#ifdef STSE_CMD_METRICS
+    stse_cmd_metrics_tx_end(pSTSE);
+#endif /* STSE_CMD_METRICS */
     if (ret == STSE_OK) {
 #ifdef STSE_USE_RSP_POLLING
         /* - Wait for command to be executed by target STSAFE  */
@@ -500,6 +647,24 @@ stse_ReturnCode_t stsafel_frame_raw_transfer(stse_Handler_t *pSTSE,
         stse_platform_Delay_ms(inter_frame_delay);
 #endif /* STSE_USE_RSP_POLLING */
 
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+        ret = stse_bus_lock(pSTSE);
+        if (ret != STSE_OK) {
+#ifdef STSE_USE_RETRY_POLICY
+            stse_retry_command_end(pSTSE);
+#endif /* STSE_USE_RETRY_POLICY */
+#ifdef STSE_CMD_METRICS
+            stse_cmd_metrics_command_end(pSTSE, pCmdFrame, pRspFrame, ret);
+#endif /* STSE_CMD_METRICS */
+            stse_handler_unlock(pSTSE);
+            return ret;
+        }
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
+
+#ifdef STSE_CMD_METRICS
+        stse_cmd_metrics_rx_start(pSTSE);
+#endif /* STSE_CMD_METRICS */
+
         /* - Receive non protected Frame */
         switch (pSTSE->io.BusType) {
 #ifdef STSE_CONF_USE_I2C
@@ -515,8 +680,27 @@ stse_ReturnCode_t stsafel_frame_raw_transfer(stse_Handler_t *pSTSE,
         default:
             break;
         }
+
+#ifdef STSE_FRAME_TRACE
+        stse_frame_trace_record(pSTSE, STSE_FRAME_TRACE_RSP, pRspFrame, ret);
+#endif /* STSE_FRAME_TRACE */
+
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+        stse_bus_unlock(pSTSE);
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
     }
 
+#ifdef STSE_USE_RETRY_POLICY
+    stse_retry_command_end(pSTSE);
+#endif /* STSE_USE_RETRY_POLICY */
+#ifdef STSE_CMD_METRICS
+    stse_cmd_metrics_command_end(pSTSE, pCmdFrame, pRspFrame, ret);
+#endif /* STSE_CMD_METRICS */
+
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+    stse_handler_unlock(pSTSE);
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
+
     return ret;
 }
 
@@ -55,9 +55,12 @@ extern "C" {
 #include "api/stse_random.h"
 #include "api/stse_symmetric_keys_management.h"
 #include "certificate/stse_certificate.h"
+#include "core/stse_cmd_metrics.h"
 #include "core/stse_device.h"
 #include "core/stse_frame.h"
+#include "core/stse_frame_trace.h"
 #include "core/stse_platform.h"
+#include "core/stse_retry.h"
 #include "core/stse_return_codes.h"
 #include "core/stse_util.h"
 #include "services/stsafea/stsafea_aes.h"
@@ -67,6 +70,7 @@ extern "C" {
 #include "services/stsafea/stsafea_ecc.h"
 #include "services/stsafea/stsafea_echo.h"
 #include "services/stsafea/stsafea_entity_auth.h"
+#include "services/stsafea/stsafea_frame_scheduler.h"
 #include "services/stsafea/stsafea_hash.h"
 #include "services/stsafea/stsafea_host_key_slot.h"
 #include "services/stsafea/stsafea_low_power.h"
@@ -0,0 +1,52 @@
+/*!
+ * ******************************************************************************
+ * \file	stse_test.h
+ * \brief   STSELib host tests common definitions
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef STSE_TEST_H
+#define STSE_TEST_H
+
+#include <stdio.h>
+
+static int stse_test_failures;
+
+/* - Record a failed check and continue : every test reports all its failures */
+#define STSE_TEST_CHECK(condition)                                                    \
+    do {                                                                              \
+        if (!(condition)) {                                                           \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);               \
+            stse_test_failures++;                                                     \
+        }                                                                             \
+    } while (0)
+
+#define STSE_TEST_CHECK_RET(expression, expected)                                     \
+    do {                                                                              \
+        stse_ReturnCode_t stse_test_ret = (expression);                               \
+        if (stse_test_ret != (expected)) {                                            \
+            printf("FAIL %s:%d: %s returned 0x%04X (expected 0x%04X)\n", __FILE__,    \
+                   __LINE__, #expression, (unsigned)stse_test_ret, (unsigned)(expected)); \
+            stse_test_failures++;                                                     \
+        }                                                                             \
+    } while (0)
+
+static inline int stse_test_report(const char *pName) {
+    printf("%s: %s (%d failure%s)\n", pName, (stse_test_failures == 0) ? "PASSED" : "FAILED",
+           stse_test_failures, (stse_test_failures == 1) ? "" : "s");
+
+    return (stse_test_failures == 0) ? 0 : 1;
+}
+
+#endif /* STSE_TEST_H */
@@ -0,0 +1,139 @@
+/*!
+ * ******************************************************************************
+ * \file	test_adaptive_rsp_polling.c
+ * \brief   Adaptive response polling test against the STSAFE-A device simulator
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details A read command is repeated on a simulated device with a known processing latency (virtual host time).
+ *          The first command waits for the static execution time , the learned execution time must then converge
+ *          to the simulated latency and shorten the command duration. A latency above the static timing must keep
+ *          the response delay capped at the static timing and a statistics reset must restore the static timing.
+ */
+
+#include <string.h>
+
+#include "stselib.h"
+#include "tools/host/stse_platform_host.h"
+#include "tools/stse_simulator.h"
+#include "stse_test.h"
+
+#if !defined(STSE_USE_ADAPTIVE_RSP_POLLING)
+#error "test_adaptive_rsp_polling requires STSE_USE_ADAPTIVE_RSP_POLLING"
+#endif
+
+#define TEST_DATA_ZONE 1U
+#define TEST_ZONE_SIZE 32U
+#define TEST_ITERATIONS 32U
+#define TEST_FAST_LATENCY 10U
+#define TEST_SLOW_LATENCY_MARGIN 20U
+
+static stse_simulator_t test_sim;
+static stse_Handler_t test_handler;
+static PLAT_UI8 test_zone[TEST_ZONE_SIZE];
+
+/* - Read command duration in virtual host time */
+static PLAT_UI32 test_read(void) {
+    PLAT_UI8 data[TEST_ZONE_SIZE];
+    PLAT_UI32 start = stse_platform_host_time_ms();
+
+    memset(data, 0, sizeof(data));
+    STSE_TEST_CHECK_RET(stse_data_storage_read_data_zone(&test_handler, TEST_DATA_ZONE, 0, data, TEST_ZONE_SIZE, 0, STSE_NO_PROT),
+                        STSE_OK);
+    STSE_TEST_CHECK(memcmp(data, test_zone, TEST_ZONE_SIZE) == 0);
+
+    return stse_platform_host_time_ms() - start;
+}
+
+int main(void) {
+    PLAT_UI16 static_time;
+    PLAT_UI16 average;
+    PLAT_UI16 deviation;
+    PLAT_UI8 sample_count;
+    PLAT_UI32 first_duration;
+    PLAT_UI32 duration = 0;
+    PLAT_UI8 i;
+
+    for (i = 0; i < TEST_ZONE_SIZE; i++) {
+        test_zone[i] = (PLAT_UI8)(0x81 ^ i);
+    }
+    STSE_TEST_CHECK_RET(stse_platform_crypto_init(), STSE_OK);
+
+    /* - Simulated device with read command processing latency in virtual host time */
+    STSE_TEST_CHECK_RET(stse_simulator_init(&test_sim, STSAFE_A120), STSE_OK);
+    stse_simulator_set_zone(&test_sim, TEST_DATA_ZONE, 0, STSE_AC_ALWAYS, STSE_AC_ALWAYS, test_zone, TEST_ZONE_SIZE, 0);
+    test_sim.pGet_time_ms = stse_platform_host_time_ms;
+    stse_simulator_set_cmd_latency(&test_sim, STSAFEA_CMD_READ, 0, TEST_FAST_LATENCY);
+
+    stse_set_default_handler_value(&test_handler);
+    test_handler.device_type = STSAFE_A120;
+    STSE_TEST_CHECK_RET(stse_simulator_attach(&test_sim, &test_handler), STSE_OK);
+    STSE_TEST_CHECK_RET(stse_init(&test_handler), STSE_OK);
+
+    static_time = stsafea_cmd_timings[STSAFE_A120][STSAFEA_CMD_READ];
+    STSE_TEST_CHECK(static_time > TEST_FAST_LATENCY);
+
+    /* - No execution recorded : static timing */
+    STSE_TEST_CHECK_RET(stsafea_exec_time_get_statistics(&test_handler, STSAFEA_CMD_READ, 0, &average, &deviation, &sample_count),
+                        STSE_OK);
+    STSE_TEST_CHECK(sample_count == 0);
+    STSE_TEST_CHECK(stsafea_exec_time_estimate(&test_handler, STSAFEA_CMD_READ, 0, static_time) == static_time);
+
+    /* - Convergence to the simulated latency */
+    first_duration = test_read();
+    STSE_TEST_CHECK(first_duration >= static_time);
+    for (i = 1; i < TEST_ITERATIONS; i++) {
+        duration = test_read();
+    }
+    STSE_TEST_CHECK_RET(stsafea_exec_time_get_statistics(&test_handler, STSAFEA_CMD_READ, 0, &average, &deviation, &sample_count),
+                        STSE_OK);
+    STSE_TEST_CHECK(sample_count == TEST_ITERATIONS);
+    STSE_TEST_CHECK((average >= TEST_FAST_LATENCY) && (average <= (TEST_FAST_LATENCY + 2U)));
+    STSE_TEST_CHECK(deviation <= 2U);
+    STSE_TEST_CHECK(stsafea_exec_time_estimate(&test_handler, STSAFEA_CMD_READ, 0, static_time) <= TEST_FAST_LATENCY);
+    STSE_TEST_CHECK(duration < first_duration);
+    STSE_TEST_CHECK(duration <= (TEST_FAST_LATENCY + 3U));
+
+    /* - Other commands keep their own statistics */
+    STSE_TEST_CHECK_RET(stsafea_exec_time_get_statistics(&test_handler, STSAFEA_CMD_GENERATE_RANDOM, 0, &average, &deviation, &sample_count),
+                        STSE_OK);
+    STSE_TEST_CHECK(sample_count == 0);
+
+    /* - Latency above the static timing : learned time grows , response delay capped at the static timing */
+    stse_simulator_set_cmd_latency(&test_sim, STSAFEA_CMD_READ, 0, static_time + TEST_SLOW_LATENCY_MARGIN);
+    for (i = 0; i < TEST_ITERATIONS; i++) {
+        duration = test_read();
+        STSE_TEST_CHECK(duration >= (PLAT_UI32)(static_time + TEST_SLOW_LATENCY_MARGIN));
+    }
+    STSE_TEST_CHECK_RET(stsafea_exec_time_get_statistics(&test_handler, STSAFEA_CMD_READ, 0, &average, &deviation, &sample_count),
+                        STSE_OK);
+    STSE_TEST_CHECK(average > static_time);
+    STSE_TEST_CHECK(stsafea_exec_time_estimate(&test_handler, STSAFEA_CMD_READ, 0, static_time) == static_time);
+
+    /* - Statistics reset : static timing until the next execution */
+    stsafea_exec_time_reset(&test_handler);
+    STSE_TEST_CHECK_RET(stsafea_exec_time_get_statistics(&test_handler, STSAFEA_CMD_READ, 0, &average, &deviation, &sample_count),
+                        STSE_OK);
+    STSE_TEST_CHECK((sample_count == 0) && (average == 0) && (deviation == 0));
+    STSE_TEST_CHECK(stsafea_exec_time_estimate(&test_handler, STSAFEA_CMD_READ, 0, static_time) == static_time);
+    STSE_TEST_CHECK(test_sim.statistics.error_count == 0);
+
+    /* - Invalid parameters */
+    STSE_TEST_CHECK_RET(stsafea_exec_time_get_statistics(&test_handler, STSAFEA_CMD_READ, 0, NULL, &deviation, &sample_count),
+                        STSE_SERVICE_INVALID_PARAMETER);
+    STSE_TEST_CHECK_RET(stsafea_exec_time_get_statistics(NULL, STSAFEA_CMD_READ, 0, &average, &deviation, &sample_count),
+                        STSE_SERVICE_HANDLER_NOT_INITIALISED);
+
+    stse_simulator_detach(&test_sim);
+
+    return stse_test_report("test_adaptive_rsp_polling");
+}
@@ -0,0 +1,308 @@
+/*!
+ * ******************************************************************************
+ * \file	test_async_transfer.c
+ * \brief   Asynchronous frame transfer test against the STSAFE-A device simulator
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details Plain and host session protected commands are submitted with stsafea_frame_transfer_submit and collected
+ *          with stsafea_frame_transfer_poll on a simulated device answering after the command processing latency
+ *          (virtual host time) :
+ *          - polls issued before the response is available report STSE_SERVICE_TRANSFER_PENDING without callback
+ *          - the completion callback is called once with the transfer status and user context
+ *          - response polling retries exhaustion completes the transfer with the bus NACK code
+ *          - submit failures (no host session , response staging buffer overflow , session protection and command
+ *            transmission errors) report the error without callback and leave no transfer pending
+ *          With STSE_CONF_USE_THREAD_SAFETY , the handler device lock must be held from submit to completion and
+ *          released on every submit failure. With STSE_USE_RETRY_POLICY , each submitted command must be closed in
+ *          the handler retry statistics.
+ */
+
+#include <string.h>
+
+#include "stselib.h"
+#include "tools/host/stse_platform_host.h"
+#include "tools/stse_simulator.h"
+#include "stse_test.h"
+
+#if !defined(STSE_CONF_USE_ASYNC_TRANSFER) || !defined(STSE_CONF_USE_HOST_SESSION)
+#error "test_async_transfer requires STSE_CONF_USE_ASYNC_TRANSFER and STSE_CONF_USE_HOST_SESSION"
+#endif
+
+#define TEST_DATA_ZONE 1U
+#define TEST_ZONE_SIZE 32U
+#define TEST_RANDOM_SIZE 32U
+#define TEST_STAGING_OVERFLOW_SIZE (STSE_CONF_ASYNC_TRANSFER_BUFFER_SIZE + 16U)
+#define TEST_UNANSWERED_LATENCY 60000U
+
+typedef struct {
+    PLAT_UI8 cmd_header;
+    PLAT_UI8 cmd_payload[6];
+    PLAT_UI8 rsp_header;
+    PLAT_UI8 data[TEST_ZONE_SIZE];
+    stse_frame_t cmd_frame;
+    stse_frame_t rsp_frame;
+    stse_frame_element_t cmd_element[2];
+    stse_frame_element_t rsp_element[2];
+} test_command_t;
+
+static stse_simulator_t test_sim;
+static stse_Handler_t test_handler;
+static stse_session_t test_session;
+static stsafea_transfer_t test_transfer;
+static test_command_t test_command;
+static PLAT_UI8 test_host_MAC_key[STSE_AES_128_KEY_SIZE];
+static PLAT_UI8 test_host_cipher_key[STSE_AES_128_KEY_SIZE];
+static PLAT_UI8 test_zone[TEST_ZONE_SIZE];
+static PLAT_UI8 test_user_context;
+static PLAT_UI32 test_callback_count;
+static stse_ReturnCode_t test_callback_status;
+static stsafea_transfer_t *test_callback_transfer;
+static PLAT_UI32 test_lock_depth;
+
+/* Completion callback , handler lock and failing bus send callbacks -----------*/
+
+static void test_callback(stsafea_transfer_t *pTransfer, stse_ReturnCode_t status) {
+    test_callback_count++;
+    test_callback_status = status;
+    test_callback_transfer = pTransfer;
+    STSE_TEST_CHECK(pTransfer->pUser_context == &test_user_context);
+    STSE_TEST_CHECK(pTransfer->state == STSAFEA_TRANSFER_IDLE);
+}
+
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+static stse_ReturnCode_t test_device_lock(PLAT_UI8 busID, PLAT_UI8 devAddr) {
+    (void)busID;
+    (void)devAddr;
+    test_lock_depth++;
+    return STSE_OK;
+}
+
+static stse_ReturnCode_t test_device_unlock(PLAT_UI8 busID, PLAT_UI8 devAddr) {
+    (void)busID;
+    (void)devAddr;
+    STSE_TEST_CHECK(test_lock_depth != 0);
+    test_lock_depth--;
+    return STSE_OK;
+}
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
+
+static stse_ReturnCode_t test_bus_send_error(PLAT_UI8 busID, PLAT_UI8 devAddr, PLAT_UI16 speed, PLAT_UI16 frameLength) {
+    (void)busID;
+    (void)devAddr;
+    (void)speed;
+    (void)frameLength;
+    return STSE_PLATFORM_BUS_ERR;
+}
+
+/* - Read (plain) or Generate Random (protected) command frames , data_length response data bytes */
+static void test_command_build(PLAT_UI8 cmd_header, PLAT_UI8 *pRsp_data, PLAT_UI16 data_length) {
+    memset(&test_command, 0, sizeof(test_command));
+    test_command.cmd_header = cmd_header;
+    test_command.cmd_element[0].length = STSAFEA_HEADER_SIZE;
+    test_command.cmd_element[0].pData = &test_command.cmd_header;
+    if (cmd_header == STSAFEA_CMD_READ) {
+        test_command.cmd_payload[1] = TEST_DATA_ZONE;
+        test_command.cmd_payload[5] = (PLAT_UI8)data_length;
+        test_command.cmd_element[1].length = 6;
+    } else {
+        test_command.cmd_payload[1] = (PLAT_UI8)data_length;
+        test_command.cmd_element[1].length = 2;
+    }
+    test_command.cmd_element[1].pData = test_command.cmd_payload;
+    stse_frame_push_element(&test_command.cmd_frame, &test_command.cmd_element[0]);
+    stse_frame_push_element(&test_command.cmd_frame, &test_command.cmd_element[1]);
+
+    test_command.rsp_element[0].length = STSAFEA_HEADER_SIZE;
+    test_command.rsp_element[0].pData = &test_command.rsp_header;
+    test_command.rsp_element[1].length = data_length;
+    test_command.rsp_element[1].pData = pRsp_data;
+    stse_frame_push_element(&test_command.rsp_frame, &test_command.rsp_element[0]);
+    stse_frame_push_element(&test_command.rsp_frame, &test_command.rsp_element[1]);
+}
+
+static stse_ReturnCode_t test_submit(void) {
+    return stsafea_frame_transfer_submit(&test_handler, &test_transfer, &test_command.cmd_frame, &test_command.rsp_frame,
+                                         test_callback, &test_user_context);
+}
+
+/* - Submit failure : error reported without callback , no transfer pending , handler lock released */
+static void test_submit_error(stse_ReturnCode_t expected) {
+    PLAT_UI32 callback_count = test_callback_count;
+#ifdef STSE_USE_RETRY_POLICY
+    PLAT_UI32 cmd_count = test_handler.retry_stats.cmd_count;
+#endif /* STSE_USE_RETRY_POLICY */
+
+    STSE_TEST_CHECK_RET(test_submit(), expected);
+    STSE_TEST_CHECK(test_callback_count == callback_count);
+    STSE_TEST_CHECK(test_transfer.state == STSAFEA_TRANSFER_IDLE);
+    STSE_TEST_CHECK_RET(stsafea_frame_transfer_poll(&test_transfer), STSE_SERVICE_INVALID_PARAMETER);
+    STSE_TEST_CHECK(test_lock_depth == 0);
+#ifdef STSE_USE_RETRY_POLICY
+    STSE_TEST_CHECK(test_handler.retry_stats.cmd_count == (cmd_count + 1U));
+#endif /* STSE_USE_RETRY_POLICY */
+}
+
+/* - Submitted command polled every poll interval until completion , returns the transfer status */
+static stse_ReturnCode_t test_transfer_run(PLAT_UI16 latency) {
+    stse_ReturnCode_t ret;
+    PLAT_UI32 callback_count = test_callback_count;
+    PLAT_UI32 start;
+    PLAT_UI16 pending_count = 0;
+#ifdef STSE_USE_RETRY_POLICY
+    PLAT_UI32 cmd_count = test_handler.retry_stats.cmd_count;
+#endif /* STSE_USE_RETRY_POLICY */
+
+    start = stse_platform_host_time_ms();
+    STSE_TEST_CHECK_RET(test_submit(), STSE_OK);
+    STSE_TEST_CHECK(test_transfer.state == STSAFEA_TRANSFER_PENDING);
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+    STSE_TEST_CHECK(test_lock_depth == 1);
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
+
+    /* - Device processing the command : pending polls without callback */
+    stse_platform_Delay_ms(test_transfer.processing_time);
+    while ((ret = stsafea_frame_transfer_poll(&test_transfer)) == STSE_SERVICE_TRANSFER_PENDING) {
+        pending_count++;
+        STSE_TEST_CHECK(test_transfer.poll_count == pending_count);
+        STSE_TEST_CHECK(test_transfer.state == STSAFEA_TRANSFER_PENDING);
+        STSE_TEST_CHECK(test_callback_count == callback_count);
+        stse_platform_Delay_ms(test_transfer.poll_interval);
+    }
+    STSE_TEST_CHECK(pending_count != 0);
+    STSE_TEST_CHECK((stse_platform_host_time_ms() - start) >= latency);
+
+    /* - Completion : callback called once with the transfer status */
+    STSE_TEST_CHECK(test_callback_count == (callback_count + 1U));
+    STSE_TEST_CHECK(test_callback_status == ret);
+    STSE_TEST_CHECK(test_callback_transfer == &test_transfer);
+    STSE_TEST_CHECK(test_transfer.state == STSAFEA_TRANSFER_IDLE);
+    STSE_TEST_CHECK(test_lock_depth == 0);
+#ifdef STSE_USE_RETRY_POLICY
+    STSE_TEST_CHECK(test_handler.retry_stats.cmd_count == (cmd_count + 1U));
+#endif /* STSE_USE_RETRY_POLICY */
+
+    /* - Completed transfer no longer polled */
+    STSE_TEST_CHECK_RET(stsafea_frame_transfer_poll(&test_transfer), STSE_SERVICE_INVALID_PARAMETER);
+    STSE_TEST_CHECK(test_callback_count == (callback_count + 1U));
+
+    return ret;
+}
+
+int main(void) {
+    PLAT_UI8 data[TEST_ZONE_SIZE];
+    PLAT_UI8 random[TEST_RANDOM_SIZE];
+    PLAT_UI32 callback_count;
+    PLAT_UI16 i;
+
+    for (i = 0; i < TEST_ZONE_SIZE; i++) {
+        test_zone[i] = (PLAT_UI8)(0x6B ^ (i * 7U));
+    }
+    for (i = 0; i < STSE_AES_128_KEY_SIZE; i++) {
+        test_host_MAC_key[i] = (PLAT_UI8)(0x40 + i);
+        test_host_cipher_key[i] = (PLAT_UI8)(0x50 + i);
+    }
+    STSE_TEST_CHECK_RET(stse_platform_crypto_init(), STSE_OK);
+
+    /* - Simulated device answering after the command processing latency (virtual host time) */
+    STSE_TEST_CHECK_RET(stse_simulator_init(&test_sim, STSAFE_A120), STSE_OK);
+    stse_simulator_set_host_keys(&test_sim, STSE_AES_128_KT, test_host_MAC_key, test_host_cipher_key, 0);
+    stse_simulator_set_zone(&test_sim, TEST_DATA_ZONE, 0, STSE_AC_ALWAYS, STSE_AC_ALWAYS, test_zone, TEST_ZONE_SIZE, 0);
+    stse_simulator_set_cmd_protection(&test_sim, STSAFEA_CMD_GENERATE_RANDOM, 0, STSE_CMD_AC_HOST, 0, 1);
+    test_sim.pGet_time_ms = stse_platform_host_time_ms;
+
+    stse_set_default_handler_value(&test_handler);
+    test_handler.device_type = STSAFE_A120;
+    STSE_TEST_CHECK_RET(stse_simulator_attach(&test_sim, &test_handler), STSE_OK);
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+    test_handler.io.DeviceLock = test_device_lock;
+    test_handler.io.DeviceUnlock = test_device_unlock;
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
+    STSE_TEST_CHECK_RET(stse_init(&test_handler), STSE_OK);
+    STSE_TEST_CHECK(test_lock_depth == 0);
+
+    /* - Plain command : pending polls , completion callback */
+    memset(data, 0, sizeof(data));
+    test_command_build(STSAFEA_CMD_READ, data, TEST_ZONE_SIZE);
+    STSE_TEST_CHECK_RET(test_transfer_run(stsafea_cmd_timings[STSAFE_A120][STSAFEA_CMD_READ]), STSE_OK);
+    STSE_TEST_CHECK(memcmp(data, test_zone, TEST_ZONE_SIZE) == 0);
+
+    /* - No response before response polling retries exhaustion : bus NACK code reported on completion */
+    stse_simulator_set_cmd_latency(&test_sim, STSAFEA_CMD_READ, 0, TEST_UNANSWERED_LATENCY);
+    callback_count = test_callback_count;
+    test_command_build(STSAFEA_CMD_READ, data, TEST_ZONE_SIZE);
+    STSE_TEST_CHECK_RET(test_submit(), STSE_OK);
+    for (i = 1; i < STSE_MAX_POLLING_RETRY; i++) {
+        STSE_TEST_CHECK_RET(stsafea_frame_transfer_poll(&test_transfer), STSE_SERVICE_TRANSFER_PENDING);
+    }
+    STSE_TEST_CHECK_RET(stsafea_frame_transfer_poll(&test_transfer), STSE_PLATFORM_BUS_ACK_ERROR);
+    STSE_TEST_CHECK(test_transfer.poll_count == STSE_MAX_POLLING_RETRY);
+    STSE_TEST_CHECK(test_callback_count == (callback_count + 1U));
+    STSE_TEST_CHECK(test_callback_status == STSE_PLATFORM_BUS_ACK_ERROR);
+    STSE_TEST_CHECK(test_lock_depth == 0);
+    stse_platform_Delay_ms(TEST_UNANSWERED_LATENCY);
+    stse_simulator_set_cmd_latency(&test_sim, STSAFEA_CMD_READ, 0, stsafea_cmd_timings[STSAFE_A120][STSAFEA_CMD_READ]);
+    memset(data, 0, sizeof(data));
+    test_command_build(STSAFEA_CMD_READ, data, TEST_ZONE_SIZE);
+    STSE_TEST_CHECK_RET(test_transfer_run(stsafea_cmd_timings[STSAFE_A120][STSAFEA_CMD_READ]), STSE_OK);
+    STSE_TEST_CHECK(memcmp(data, test_zone, TEST_ZONE_SIZE) == 0);
+
+    /* - Protected command without active host session */
+    test_command_build(STSAFEA_CMD_GENERATE_RANDOM, random, TEST_RANDOM_SIZE);
+    test_submit_error(STSE_SERVICE_SESSION_ERROR);
+
+    STSE_TEST_CHECK_RET(stsafea_open_host_session(&test_handler, &test_session, test_host_MAC_key, test_host_cipher_key),
+                        STSE_OK);
+    STSE_TEST_CHECK(test_lock_depth == 0);
+
+    /* - Encrypted response larger than the transfer staging buffer (response element without buffer) */
+    test_command_build(STSAFEA_CMD_GENERATE_RANDOM, NULL, TEST_STAGING_OVERFLOW_SIZE);
+    test_submit_error(STSE_SERVICE_FRAME_SIZE_ERROR);
+
+    /* - Session protection failure (response header element without buffer) */
+    test_command_build(STSAFEA_CMD_GENERATE_RANDOM, random, TEST_RANDOM_SIZE);
+    test_command.rsp_element[0].pData = NULL;
+    test_submit_error(STSE_SERVICE_SESSION_ERROR);
+
+    /* - Command transmission failure (host MAC counter left unchanged) */
+    test_command_build(STSAFEA_CMD_GENERATE_RANDOM, random, TEST_RANDOM_SIZE);
+    test_handler.io.BusSendStart = test_bus_send_error;
+    test_handler.io.BusSendV = NULL;
+    test_submit_error(STSE_PLATFORM_BUS_ERR);
+    STSE_TEST_CHECK_RET(stse_simulator_attach(&test_sim, &test_handler), STSE_OK);
+#ifdef STSE_CONF_USE_THREAD_SAFETY
+    test_handler.io.DeviceLock = test_device_lock;
+    test_handler.io.DeviceUnlock = test_device_unlock;
+#endif /* STSE_CONF_USE_THREAD_SAFETY */
+
+    /* - Protected command with encrypted response */
+    memset(random, 0, sizeof(random));
+    test_command_build(STSAFEA_CMD_GENERATE_RANDOM, random, TEST_RANDOM_SIZE);
+    STSE_TEST_CHECK_RET(test_transfer_run(stsafea_cmd_timings[STSAFE_A120][STSAFEA_CMD_GENERATE_RANDOM]), STSE_OK);
+    for (i = 0; (i < TEST_RANDOM_SIZE) && (random[i] == 0); i++) {
+    }
+    STSE_TEST_CHECK(i < TEST_RANDOM_SIZE);
+    STSE_TEST_CHECK(test_session.context.host.MAC_counter == test_sim.host_MAC_counter);
+    STSE_TEST_CHECK(test_sim.statistics.error_count == 0);
+
+    /* - Invalid parameters */
+    STSE_TEST_CHECK_RET(stsafea_frame_transfer_submit(&test_handler, NULL, &test_command.cmd_frame, &test_command.rsp_frame,
+                                                      NULL, NULL),
+                        STSE_SERVICE_INVALID_PARAMETER);
+    STSE_TEST_CHECK_RET(stsafea_frame_transfer_poll(NULL), STSE_SERVICE_INVALID_PARAMETER);
+    STSE_TEST_CHECK(test_lock_depth == 0);
+
+    stsafea_close_host_session(&test_session);
+    stse_simulator_detach(&test_sim);
+
+    return stse_test_report("test_async_transfer");
+}
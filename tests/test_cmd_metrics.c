@@ -0,0 +1,159 @@
+/*!
+ * ******************************************************************************
+ * \file	test_cmd_metrics.c
+ * \brief   Command metrics test against the STSAFE-A device simulator
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details Generate Random and Read commands are run on a simulated device with known processing latencies (virtual
+ *          host time). The command metrics snapshot must report for each command code its transfer count , error
+ *          count , bus retries , bytes sent and received , execution wait time and latency histogram bin , other
+ *          command codes being left untouched. A metrics reset must clear all command metrics.
+ */
+
+#include <string.h>
+
+#include "stselib.h"
+#include "tools/host/stse_platform_host.h"
+#include "tools/stse_simulator.h"
+#include "stse_test.h"
+
+#if !defined(STSE_CMD_METRICS) || (STSE_CMD_METRICS_HISTOGRAM_SHIFT != 10)
+#error "test_cmd_metrics requires STSE_CMD_METRICS with STSE_CMD_METRICS_HISTOGRAM_SHIFT set to 10"
+#endif
+
+#define TEST_DATA_ZONE 1U
+#define TEST_LOCKED_ZONE 2U
+#define TEST_ZONE_SIZE 32U
+#define TEST_RANDOM_SIZE 16U
+#define TEST_RANDOM_COUNT 3U
+#define TEST_READ_COUNT 2U
+#define TEST_READ_CMD_SIZE 7U /* - Header , read option , zone index , offset (2 bytes) , length (2 bytes) */
+/* - Latencies in ms , histogram bins of 1024 us units : [4 ; 8[ -> bin 3 , [16 ; 32[ -> bin 5 */
+#define TEST_RANDOM_LATENCY 5U
+#define TEST_RANDOM_BIN 3U
+#define TEST_READ_LATENCY 20U
+#define TEST_READ_BIN 5U
+
+static stse_simulator_t test_sim;
+static stse_Handler_t test_handler;
+static stse_cmd_metrics_snapshot_t test_snapshot;
+static PLAT_UI8 test_zone[TEST_ZONE_SIZE];
+
+/* - Metrics of count transfers with a single latency histogram bin */
+static void test_metrics_check(const stse_cmd_metrics_t *pMetrics,
+                               PLAT_UI32 count,
+                               PLAT_UI32 error_count,
+                               PLAT_UI32 tx_bytes,
+                               PLAT_UI16 latency,
+                               PLAT_UI8 bin) {
+    PLAT_UI8 i;
+
+    STSE_TEST_CHECK(pMetrics->count == count);
+    STSE_TEST_CHECK(pMetrics->error_count == error_count);
+    STSE_TEST_CHECK(pMetrics->tx_bytes == tx_bytes);
+    /* - Response polled every ms from the end of the first polling interval : (latency - 1) NACKed polls */
+    STSE_TEST_CHECK(pMetrics->retry_count == (count * (latency - 1U)));
+    STSE_TEST_CHECK(pMetrics->exec_time == (count * latency * 1000U));
+    STSE_TEST_CHECK((pMetrics->tx_time == 0) && (pMetrics->rx_time == 0) && (pMetrics->crypto_time == 0));
+    for (i = 0; i < STSE_CMD_METRICS_HISTOGRAM_SIZE; i++) {
+        STSE_TEST_CHECK(pMetrics->latency_histogram[i] == ((i == bin) ? count : 0));
+    }
+}
+
+/* - Number of command codes with recorded transfers */
+static PLAT_UI8 test_metrics_used(void) {
+    PLAT_UI8 used = 0;
+    PLAT_UI8 i;
+
+    for (i = 0; i < STSE_CMD_METRICS_TRACKED_CMD_COUNT; i++) {
+        used += (test_snapshot.cmd[i].count != 0) ? 1U : 0U;
+        used += (test_snapshot.ext_cmd[i].count != 0) ? 1U : 0U;
+    }
+
+    return used;
+}
+
+int main(void) {
+    static const stse_cmd_metrics_snapshot_t cleared_snapshot;
+    PLAT_UI8 random[TEST_RANDOM_SIZE];
+    PLAT_UI8 data[TEST_ZONE_SIZE];
+    PLAT_UI8 i;
+
+    for (i = 0; i < TEST_ZONE_SIZE; i++) {
+        test_zone[i] = (PLAT_UI8)(0x5A ^ (i * 7U));
+    }
+    STSE_TEST_CHECK_RET(stse_platform_crypto_init(), STSE_OK);
+
+    /* - Simulated device with known command processing latencies in virtual host time */
+    STSE_TEST_CHECK_RET(stse_simulator_init(&test_sim, STSAFE_A120), STSE_OK);
+    stse_simulator_set_zone(&test_sim, TEST_DATA_ZONE, 0, STSE_AC_ALWAYS, STSE_AC_ALWAYS, test_zone, TEST_ZONE_SIZE, 0);
+    stse_simulator_set_zone(&test_sim, TEST_LOCKED_ZONE, 0, STSE_AC_NEVER, STSE_AC_NEVER, test_zone, TEST_ZONE_SIZE, 0);
+    test_sim.pGet_time_ms = stse_platform_host_time_ms;
+    stse_simulator_set_cmd_latency(&test_sim, STSAFEA_CMD_GENERATE_RANDOM, 0, TEST_RANDOM_LATENCY);
+    stse_simulator_set_cmd_latency(&test_sim, STSAFEA_CMD_READ, 0, TEST_READ_LATENCY);
+
+    stse_set_default_handler_value(&test_handler);
+    test_handler.device_type = STSAFE_A120;
+    STSE_TEST_CHECK_RET(stse_simulator_attach(&test_sim, &test_handler), STSE_OK);
+    STSE_TEST_CHECK_RET(stse_init(&test_handler), STSE_OK);
+
+    /* - Initialization commands cleared */
+    STSE_TEST_CHECK_RET(stse_cmd_metrics_reset(&test_handler), STSE_OK);
+    STSE_TEST_CHECK_RET(stse_cmd_metrics_snapshot(&test_handler, &test_snapshot), STSE_OK);
+    STSE_TEST_CHECK(memcmp(&test_snapshot, &cleared_snapshot, sizeof(test_snapshot)) == 0);
+
+    /* - Successful commands */
+    for (i = 0; i < TEST_RANDOM_COUNT; i++) {
+        STSE_TEST_CHECK_RET(stse_generate_random(&test_handler, random, TEST_RANDOM_SIZE), STSE_OK);
+    }
+    for (i = 0; i < TEST_READ_COUNT; i++) {
+        STSE_TEST_CHECK_RET(stse_data_storage_read_data_zone(&test_handler, TEST_DATA_ZONE, 0, data, TEST_ZONE_SIZE, 0, STSE_NO_PROT),
+                            STSE_OK);
+    }
+    STSE_TEST_CHECK_RET(stse_cmd_metrics_snapshot(&test_handler, &test_snapshot), STSE_OK);
+    test_metrics_check(&test_snapshot.cmd[STSAFEA_CMD_GENERATE_RANDOM], TEST_RANDOM_COUNT, 0,
+                       TEST_RANDOM_COUNT * 3U, TEST_RANDOM_LATENCY, TEST_RANDOM_BIN);
+    STSE_TEST_CHECK(test_snapshot.cmd[STSAFEA_CMD_GENERATE_RANDOM].rx_bytes == (TEST_RANDOM_COUNT * (1U + TEST_RANDOM_SIZE)));
+    test_metrics_check(&test_snapshot.cmd[STSAFEA_CMD_READ], TEST_READ_COUNT, 0,
+                       TEST_READ_COUNT * TEST_READ_CMD_SIZE, TEST_READ_LATENCY, TEST_READ_BIN);
+    STSE_TEST_CHECK(test_snapshot.cmd[STSAFEA_CMD_READ].rx_bytes == (TEST_READ_COUNT * (1U + TEST_ZONE_SIZE)));
+    STSE_TEST_CHECK(test_metrics_used() == 2U);
+
+    /* - Command refused by the device : error counted on its command code */
+    STSE_TEST_CHECK_RET(stse_data_storage_read_data_zone(&test_handler, TEST_LOCKED_ZONE, 0, data, TEST_ZONE_SIZE, 0, STSE_NO_PROT),
+                        STSE_ACCESS_CONDITION_NOT_SATISFIED);
+    STSE_TEST_CHECK_RET(stse_cmd_metrics_snapshot(&test_handler, &test_snapshot), STSE_OK);
+    test_metrics_check(&test_snapshot.cmd[STSAFEA_CMD_READ], TEST_READ_COUNT + 1U, 1,
+                       (TEST_READ_COUNT + 1U) * TEST_READ_CMD_SIZE, TEST_READ_LATENCY, TEST_READ_BIN);
+    STSE_TEST_CHECK(test_snapshot.cmd[STSAFEA_CMD_GENERATE_RANDOM].error_count == 0);
+    STSE_TEST_CHECK(test_metrics_used() == 2U);
+
+    /* - Reset : all command metrics cleared , next transfers counted from zero */
+    STSE_TEST_CHECK_RET(stse_cmd_metrics_reset(&test_handler), STSE_OK);
+    STSE_TEST_CHECK_RET(stse_cmd_metrics_snapshot(&test_handler, &test_snapshot), STSE_OK);
+    STSE_TEST_CHECK(memcmp(&test_snapshot, &cleared_snapshot, sizeof(test_snapshot)) == 0);
+    STSE_TEST_CHECK_RET(stse_generate_random(&test_handler, random, TEST_RANDOM_SIZE), STSE_OK);
+    STSE_TEST_CHECK_RET(stse_cmd_metrics_snapshot(&test_handler, &test_snapshot), STSE_OK);
+    test_metrics_check(&test_snapshot.cmd[STSAFEA_CMD_GENERATE_RANDOM], 1, 0, 3U, TEST_RANDOM_LATENCY, TEST_RANDOM_BIN);
+    STSE_TEST_CHECK(test_metrics_used() == 1U);
+
+    /* - Invalid parameters */
+    STSE_TEST_CHECK_RET(stse_cmd_metrics_snapshot(&test_handler, NULL), STSE_CORE_INVALID_PARAMETER);
+    STSE_TEST_CHECK_RET(stse_cmd_metrics_snapshot(NULL, &test_snapshot), STSE_CORE_HANDLER_NOT_INITIALISED);
+    STSE_TEST_CHECK_RET(stse_cmd_metrics_reset(NULL), STSE_CORE_HANDLER_NOT_INITIALISED);
+    STSE_TEST_CHECK(test_sim.statistics.error_count == 1);
+
+    stse_simulator_detach(&test_sim);
+
+    return stse_test_report("test_cmd_metrics");
+}
@@ -0,0 +1,93 @@
+/*!
+ * ******************************************************************************
+ * \file	test_crc16.c
+ * \brief   Built-in CRC16 implementation test against a bitwise reference
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details The built-in CRC16 of the library variant under test (table-driven , slice-by-8 or carry-less multiply
+ *          folding) is checked against the CRC-16/X-25 check value and a bitwise reference for every buffer length
+ *          up to the STSAFE-A120 maximum frame length , every buffer alignment , non initial register values and
+ *          split computations (stse_crc16_accumulate).
+ */
+
+#include "core/stse_crc16.h"
+#include "stselib.h"
+#include "stse_test.h"
+
+#if !defined(STSE_CONF_USE_BUILTIN_CRC16)
+#error "test_crc16 requires STSE_CONF_USE_BUILTIN_CRC16"
+#endif
+
+#define TEST_MAX_LENGTH STSAFEA_MAX_FRAME_LENGTH_A120
+#define TEST_ALIGNMENT_COUNT 16U
+
+static PLAT_UI8 test_data[TEST_MAX_LENGTH + TEST_ALIGNMENT_COUNT];
+
+static PLAT_UI16 test_crc16_bitwise(PLAT_UI16 crc, const PLAT_UI8 *pData, PLAT_UI16 length) {
+    PLAT_UI8 bit;
+
+    while (length > 0U) {
+        crc ^= *pData++;
+        for (bit = 0; bit < 8U; bit++) {
+            crc = (crc & 1U) ? (PLAT_UI16)((crc >> 1) ^ 0x8408U) : (PLAT_UI16)(crc >> 1);
+        }
+        length--;
+    }
+
+    return crc;
+}
+
+int main(void) {
+    PLAT_UI8 check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    PLAT_UI32 seed = 0x1234567U;
+    PLAT_UI32 mismatches = 0;
+    PLAT_UI16 length;
+    PLAT_UI16 split;
+    PLAT_UI16 frame_crc;
+    PLAT_UI16 i;
+    PLAT_UI8 offset;
+
+    for (i = 0; i < sizeof(test_data); i++) {
+        seed = (seed * 1103515245U) + 12345U;
+        test_data[i] = (PLAT_UI8)(seed >> 16);
+    }
+
+    /* - CRC-16/X-25 check value (0x906E , transmitted least significant byte first) */
+    STSE_TEST_CHECK(stse_crc16_finalize(stse_crc16_update(STSE_CRC16_INIT_VALUE, check, sizeof(check))) == 0x6E90U);
+
+    /* - Every length and alignment , initial and arbitrary register values */
+    for (offset = 0; offset < TEST_ALIGNMENT_COUNT; offset++) {
+        for (length = 0; length <= TEST_MAX_LENGTH; length++) {
+            if ((stse_crc16_update(STSE_CRC16_INIT_VALUE, &test_data[offset], length) !=
+                 test_crc16_bitwise(STSE_CRC16_INIT_VALUE, &test_data[offset], length)) ||
+                (stse_crc16_update((PLAT_UI16)(length * 0x9E37U), &test_data[offset], length) !=
+                 test_crc16_bitwise((PLAT_UI16)(length * 0x9E37U), &test_data[offset], length))) {
+                mismatches++;
+            }
+        }
+    }
+    STSE_TEST_CHECK(mismatches == 0);
+
+    /* - Split computations match the single pass frame CRC */
+    mismatches = 0;
+    for (split = 0; split <= TEST_MAX_LENGTH; split++) {
+        frame_crc = stse_crc16_finalize(stse_crc16_update(STSE_CRC16_INIT_VALUE, test_data, split));
+        frame_crc = stse_crc16_accumulate(frame_crc, &test_data[split], (PLAT_UI16)(TEST_MAX_LENGTH - split));
+        if (frame_crc != stse_crc16_finalize(test_crc16_bitwise(STSE_CRC16_INIT_VALUE, test_data, TEST_MAX_LENGTH))) {
+            mismatches++;
+        }
+    }
+    STSE_TEST_CHECK(mismatches == 0);
+
+    return stse_test_report("test_crc16");
+}
@@ -0,0 +1,141 @@
+/*!
+ * ******************************************************************************
+ * \file	test_frame.c
+ * \brief   Frame element push , pop and strap test
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details Frames are built , shortened and rerouted using the core frame functions : element links , last element ,
+ *          element count and frame length must describe the frame content after each operation (parsed and back
+ *          linked frame element pop).
+ */
+
+#include "stselib.h"
+#include "stse_test.h"
+
+/* - Frame consistency : element order , count , length and last element */
+static PLAT_UI8 test_frame_check(stse_frame_t *pFrame, stse_frame_element_t **pElements, PLAT_UI8 element_count) {
+    stse_frame_element_t *pElement = pFrame->first_element;
+    PLAT_UI16 length = 0;
+    PLAT_UI8 i;
+
+    if ((pFrame->element_count != element_count) ||
+        (pFrame->last_element != ((element_count == 0) ? NULL : pElements[element_count - 1U]))) {
+        return 0;
+    }
+    for (i = 0; i < element_count; i++) {
+        if (pElement != pElements[i]) {
+            return 0;
+        }
+        length += pElement->length;
+        pElement = pElement->next;
+    }
+
+    return (pElement == NULL) && (pFrame->length == length);
+}
+
+int main(void) {
+    PLAT_UI8 header = 0x14;
+    PLAT_UI8 payload[8] = {0};
+    PLAT_UI8 crc[STSE_FRAME_CRC_SIZE] = {0};
+    PLAT_UI8 mac[4] = {0};
+    PLAT_UI8 strapped[5] = {0};
+
+    stse_frame_allocate(Frame);
+    stse_frame_element_allocate(eHeader, sizeof(header), &header);
+    stse_frame_element_allocate(ePayload, sizeof(payload), payload);
+    stse_frame_element_allocate(eCrc, sizeof(crc), crc);
+    stse_frame_element_allocate(eMac, sizeof(mac), mac);
+
+    stse_frame_allocate(StrappedFrame);
+    stse_frame_element_allocate(eStrapped, sizeof(strapped), strapped);
+    stse_frame_element_allocate(eStrapped_crc, sizeof(crc), crc);
+
+    stse_frame_element_t *elements[] = {&eHeader, &ePayload, &eMac, &eCrc};
+    stse_frame_element_t *strap_elements[] = {&eHeader, &ePayload, NULL, &eStrapped, &eStrapped_crc};
+    stse_frame_element_t *strapped_elements[] = {&eStrapped, &eStrapped_crc};
+
+    /* - Empty frame */
+    STSE_TEST_CHECK(test_frame_check(&Frame, elements, 0));
+    stse_frame_pop_element(&Frame);
+    STSE_TEST_CHECK(test_frame_check(&Frame, elements, 0));
+
+    /* - Push */
+    stse_frame_push_element(&Frame, &eHeader);
+    STSE_TEST_CHECK(test_frame_check(&Frame, elements, 1));
+    stse_frame_push_element(&Frame, &ePayload);
+    stse_frame_push_element(&Frame, &eMac);
+    stse_frame_push_element(&Frame, &eCrc);
+    STSE_TEST_CHECK(test_frame_check(&Frame, elements, 4));
+    STSE_TEST_CHECK(Frame.length == (sizeof(header) + sizeof(payload) + sizeof(mac) + sizeof(crc)));
+
+    /* - Pop down to the empty frame */
+    stse_frame_pop_element(&Frame);
+    STSE_TEST_CHECK(test_frame_check(&Frame, elements, 3));
+    stse_frame_pop_element(&Frame);
+    STSE_TEST_CHECK(test_frame_check(&Frame, elements, 2));
+    stse_frame_pop_element(&Frame);
+    STSE_TEST_CHECK(test_frame_check(&Frame, elements, 1));
+    stse_frame_pop_element(&Frame);
+    STSE_TEST_CHECK(test_frame_check(&Frame, elements, 0));
+    STSE_TEST_CHECK(Frame.first_element == NULL);
+
+    /* - Push after pop (CRC and MAC appended and removed on each transfer) */
+    stse_frame_push_element(&Frame, &eHeader);
+    stse_frame_push_element(&Frame, &ePayload);
+    stse_frame_push_element(&Frame, &eMac);
+    stse_frame_pop_element(&Frame);
+    stse_frame_push_element(&Frame, &eMac);
+    stse_frame_push_element(&Frame, &eCrc);
+    STSE_TEST_CHECK(test_frame_check(&Frame, elements, 4));
+    stse_frame_pop_element(&Frame);
+    stse_frame_pop_element(&Frame);
+    STSE_TEST_CHECK(test_frame_check(&Frame, elements, 2));
+
+    /* - Strap : frame rerouted after its payload element to another frame */
+    stse_frame_push_element(&Frame, &eMac);
+    stse_frame_push_element(&StrappedFrame, &eStrapped);
+    stse_frame_push_element(&StrappedFrame, &eStrapped_crc);
+    stse_frame_strap(&Frame, eStrap, &ePayload, &eStrapped);
+    strap_elements[2] = &eStrap;
+    STSE_TEST_CHECK(test_frame_check(&Frame, strap_elements, 5));
+    STSE_TEST_CHECK(Frame.length == (sizeof(header) + sizeof(payload) + sizeof(strapped) + sizeof(crc)));
+
+    /* - Pop on the strapped frame (strapped frame last element) , then un-strap : original frame restored */
+    stse_frame_pop_element(&Frame);
+    STSE_TEST_CHECK(test_frame_check(&Frame, strap_elements, 4));
+    stse_frame_unstrap(&Frame);
+    STSE_TEST_CHECK(test_frame_check(&Frame, elements, 3));
+
+    /* - Pop after un-strap */
+    stse_frame_pop_element(&Frame);
+    STSE_TEST_CHECK(test_frame_check(&Frame, elements, 2));
+
+    /* - Strapped frame elements left unchanged except the popped element link */
+    STSE_TEST_CHECK(StrappedFrame.first_element == &eStrapped);
+    STSE_TEST_CHECK(eStrapped.next == NULL);
+    stse_frame_update(&StrappedFrame);
+    STSE_TEST_CHECK(test_frame_check(&StrappedFrame, strapped_elements, 1));
+
+    /* - Element links rerouted outside the frame services then frame updated */
+    stse_frame_push_element(&Frame, &eCrc);
+    ePayload.next = &eMac;
+    eMac.next = &eCrc;
+    stse_frame_update(&Frame);
+    STSE_TEST_CHECK(test_frame_check(&Frame, elements, 4));
+    stse_frame_pop_element(&Frame);
+    STSE_TEST_CHECK(test_frame_check(&Frame, elements, 3));
+    stse_frame_pop_element(&Frame);
+    STSE_TEST_CHECK(test_frame_check(&Frame, elements, 2));
+
+    return stse_test_report("test_frame");
+}
@@ -0,0 +1,192 @@
+/*!
+ * ******************************************************************************
+ * \file	test_frame_batch.c
+ * \brief   Frame transfer batch test against the STSAFE-A device simulator
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details Batches of read commands are run with stsafea_frame_transfer_batch :
+ *          - all entries of a valid batch complete with their individual report
+ *          - an entry refused by the device (access condition not satisfied) stops the batch : earlier entries
+ *            complete , the failing entry reports the device status and later entries are left pending
+ *          - an invalid entry (missing frame , oversized command frame) is reported before any transfer , all other
+ *            entries being left pending
+ */
+
+#include <string.h>
+
+#include "stselib.h"
+#include "tools/stse_simulator.h"
+#include "stse_test.h"
+
+#define TEST_DATA_ZONE 1U
+#define TEST_LOCKED_ZONE 2U
+#define TEST_ZONE_SIZE 32U
+#define TEST_ENTRY_COUNT 4U
+#define TEST_FAILING_ENTRY 2U
+
+typedef struct {
+    PLAT_UI8 cmd_header;
+    PLAT_UI8 cmd_payload[6];
+    PLAT_UI8 rsp_header;
+    PLAT_UI8 data[TEST_ZONE_SIZE];
+    stse_frame_t cmd_frame;
+    stse_frame_t rsp_frame;
+    stse_frame_element_t cmd_element[2];
+    stse_frame_element_t rsp_element[2];
+} test_read_t;
+
+static stse_simulator_t test_sim;
+static stse_Handler_t test_handler;
+static test_read_t test_read[TEST_ENTRY_COUNT];
+static stsafea_frame_batch_entry_t test_entries[TEST_ENTRY_COUNT];
+static PLAT_UI8 test_zone[TEST_ZONE_SIZE];
+static PLAT_UI8 test_oversized_payload[STSAFEA_MAX_FRAME_LENGTH_A120];
+
+/* - Read command frames of a batch entry (zone , offset) */
+static void test_entry_build(PLAT_UI8 index, PLAT_UI8 zone, PLAT_UI8 offset) {
+    test_read_t *pRead = &test_read[index];
+
+    memset(pRead, 0, sizeof(*pRead));
+    pRead->cmd_header = STSAFEA_CMD_READ;
+    pRead->cmd_payload[1] = zone;
+    pRead->cmd_payload[3] = offset;
+    pRead->cmd_payload[5] = TEST_ZONE_SIZE - offset;
+    pRead->cmd_element[0].length = STSAFEA_HEADER_SIZE;
+    pRead->cmd_element[0].pData = &pRead->cmd_header;
+    pRead->cmd_element[1].length = sizeof(pRead->cmd_payload);
+    pRead->cmd_element[1].pData = pRead->cmd_payload;
+    stse_frame_push_element(&pRead->cmd_frame, &pRead->cmd_element[0]);
+    stse_frame_push_element(&pRead->cmd_frame, &pRead->cmd_element[1]);
+
+    pRead->rsp_element[0].length = STSAFEA_HEADER_SIZE;
+    pRead->rsp_element[0].pData = &pRead->rsp_header;
+    pRead->rsp_element[1].length = TEST_ZONE_SIZE - offset;
+    pRead->rsp_element[1].pData = pRead->data;
+    stse_frame_push_element(&pRead->rsp_frame, &pRead->rsp_element[0]);
+    stse_frame_push_element(&pRead->rsp_frame, &pRead->rsp_element[1]);
+
+    test_entries[index].pCmdFrame = &pRead->cmd_frame;
+    test_entries[index].pRspFrame = &pRead->rsp_frame;
+    test_entries[index].status = STSE_OK;
+    test_entries[index].processing_time = 0xFFFF;
+    test_entries[index].poll_count = 0xFFFF;
+}
+
+static void test_batch_build(void) {
+    PLAT_UI8 i;
+
+    for (i = 0; i < TEST_ENTRY_COUNT; i++) {
+        test_entry_build(i, TEST_DATA_ZONE, i);
+    }
+}
+
+/* - Completed entry : status , report and data read at the entry offset */
+static void test_entry_check_done(PLAT_UI8 index) {
+    STSE_TEST_CHECK(test_entries[index].status == STSE_OK);
+    STSE_TEST_CHECK(test_entries[index].processing_time != 0xFFFF);
+    STSE_TEST_CHECK(test_entries[index].poll_count != 0xFFFF);
+    STSE_TEST_CHECK(memcmp(test_read[index].data, &test_zone[index], TEST_ZONE_SIZE - index) == 0);
+}
+
+/* - Entry not performed : pending status , cleared report , response buffer untouched */
+static void test_entry_check_pending(PLAT_UI8 index) {
+    PLAT_UI8 i;
+
+    STSE_TEST_CHECK(test_entries[index].status == STSE_SERVICE_TRANSFER_PENDING);
+    STSE_TEST_CHECK((test_entries[index].processing_time == 0) && (test_entries[index].poll_count == 0));
+    for (i = 0; (i < TEST_ZONE_SIZE) && (test_read[index].data[i] == 0); i++) {
+    }
+    STSE_TEST_CHECK(i == TEST_ZONE_SIZE);
+}
+
+int main(void) {
+    PLAT_UI32 cmd_count;
+    PLAT_UI8 i;
+
+    for (i = 0; i < TEST_ZONE_SIZE; i++) {
+        test_zone[i] = (PLAT_UI8)(0xA5 ^ (i * 11U));
+    }
+    STSE_TEST_CHECK_RET(stse_platform_crypto_init(), STSE_OK);
+
+    STSE_TEST_CHECK_RET(stse_simulator_init(&test_sim, STSAFE_A120), STSE_OK);
+    stse_simulator_set_zone(&test_sim, TEST_DATA_ZONE, 0, STSE_AC_ALWAYS, STSE_AC_ALWAYS, test_zone, TEST_ZONE_SIZE, 0);
+    stse_simulator_set_zone(&test_sim, TEST_LOCKED_ZONE, 0, STSE_AC_NEVER, STSE_AC_NEVER, test_zone, TEST_ZONE_SIZE, 0);
+
+    stse_set_default_handler_value(&test_handler);
+    test_handler.device_type = STSAFE_A120;
+    STSE_TEST_CHECK_RET(stse_simulator_attach(&test_sim, &test_handler), STSE_OK);
+    STSE_TEST_CHECK_RET(stse_init(&test_handler), STSE_OK);
+
+    /* - Valid batch : all entries performed */
+    test_batch_build();
+    cmd_count = test_sim.statistics.cmd_count;
+    STSE_TEST_CHECK_RET(stsafea_frame_transfer_batch(&test_handler, test_entries, TEST_ENTRY_COUNT), STSE_OK);
+    STSE_TEST_CHECK(test_sim.statistics.cmd_count - cmd_count == TEST_ENTRY_COUNT);
+    for (i = 0; i < TEST_ENTRY_COUNT; i++) {
+        test_entry_check_done(i);
+    }
+
+    /* - Entry refused by the device : batch stopped on the failing entry */
+    test_batch_build();
+    test_entry_build(TEST_FAILING_ENTRY, TEST_LOCKED_ZONE, 0);
+    cmd_count = test_sim.statistics.cmd_count;
+    STSE_TEST_CHECK_RET(stsafea_frame_transfer_batch(&test_handler, test_entries, TEST_ENTRY_COUNT),
+                        STSE_ACCESS_CONDITION_NOT_SATISFIED);
+    STSE_TEST_CHECK(test_sim.statistics.cmd_count - cmd_count == (TEST_FAILING_ENTRY + 1U));
+    for (i = 0; i < TEST_FAILING_ENTRY; i++) {
+        test_entry_check_done(i);
+    }
+    STSE_TEST_CHECK(test_entries[TEST_FAILING_ENTRY].status == STSE_ACCESS_CONDITION_NOT_SATISFIED);
+    for (i = TEST_FAILING_ENTRY + 1U; i < TEST_ENTRY_COUNT; i++) {
+        test_entry_check_pending(i);
+    }
+
+    /* - Missing response frame : reported before any transfer */
+    test_batch_build();
+    test_entries[TEST_FAILING_ENTRY].pRspFrame = NULL;
+    cmd_count = test_sim.statistics.cmd_count;
+    STSE_TEST_CHECK_RET(stsafea_frame_transfer_batch(&test_handler, test_entries, TEST_ENTRY_COUNT),
+                        STSE_SERVICE_INVALID_PARAMETER);
+    STSE_TEST_CHECK(test_sim.statistics.cmd_count == cmd_count);
+    STSE_TEST_CHECK(test_entries[TEST_FAILING_ENTRY].status == STSE_SERVICE_INVALID_PARAMETER);
+    for (i = 0; i < TEST_ENTRY_COUNT; i++) {
+        if (i != TEST_FAILING_ENTRY) {
+            test_entry_check_pending(i);
+        }
+    }
+
+    /* - Oversized command frame : reported before any transfer */
+    test_batch_build();
+    test_read[TEST_FAILING_ENTRY].cmd_element[1].pData = test_oversized_payload;
+    test_read[TEST_FAILING_ENTRY].cmd_element[1].length = sizeof(test_oversized_payload);
+    stse_frame_update(&test_read[TEST_FAILING_ENTRY].cmd_frame);
+    cmd_count = test_sim.statistics.cmd_count;
+    STSE_TEST_CHECK_RET(stsafea_frame_transfer_batch(&test_handler, test_entries, TEST_ENTRY_COUNT),
+                        STSE_SERVICE_FRAME_SIZE_ERROR);
+    STSE_TEST_CHECK(test_sim.statistics.cmd_count == cmd_count);
+    STSE_TEST_CHECK(test_entries[TEST_FAILING_ENTRY].status == STSE_SERVICE_FRAME_SIZE_ERROR);
+    for (i = 0; i < TEST_ENTRY_COUNT; i++) {
+        if (i != TEST_FAILING_ENTRY) {
+            test_entry_check_pending(i);
+        }
+    }
+
+    /* - Invalid parameters */
+    STSE_TEST_CHECK_RET(stsafea_frame_transfer_batch(&test_handler, NULL, TEST_ENTRY_COUNT), STSE_SERVICE_INVALID_PARAMETER);
+    STSE_TEST_CHECK_RET(stsafea_frame_transfer_batch(&test_handler, test_entries, 0), STSE_SERVICE_INVALID_PARAMETER);
+    STSE_TEST_CHECK(test_sim.statistics.error_count == 1);
+
+    stse_simulator_detach(&test_sim);
+
+    return stse_test_report("test_frame_batch");
+}
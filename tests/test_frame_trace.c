@@ -0,0 +1,155 @@
+/*!
+ * ******************************************************************************
+ * \file	test_frame_trace.c
+ * \brief   Frame trace record and export test against the STSAFE-A device simulator
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details Generate Random commands are traced on a simulated device answering after the command processing latency
+ *          (NACKed response polls recorded as retries). The exported trace is parsed before and after the ring
+ *          buffer wrap-around : record count , first sequence number , oldest to newest record order , directions ,
+ *          headers , lengths , statuses , retry counts and captured bytes. An export buffer too small for all
+ *          records must keep the newest ones. The wrapped trace is written to test_frame_trace.bin for the
+ *          stse_frame_trace_decode host utility (test_frame_trace_decode).
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "stselib.h"
+#include "tools/host/stse_platform_host.h"
+#include "tools/stse_simulator.h"
+#include "stse_test.h"
+
+#if !defined(STSE_FRAME_TRACE) || (STSE_FRAME_TRACE_PAYLOAD_SIZE < 3)
+#error "test_frame_trace requires STSE_FRAME_TRACE with STSE_FRAME_TRACE_PAYLOAD_SIZE of at least 3"
+#endif
+
+#define TEST_RANDOM_SIZE 16U
+#define TEST_TRACE_FILE "test_frame_trace.bin"
+#define TEST_EXPORT_SIZE (STSE_FRAME_TRACE_EXPORT_HEADER_SIZE + (STSE_FRAME_TRACE_DEPTH * STSE_FRAME_TRACE_EXPORT_RECORD_SIZE))
+
+static stse_simulator_t test_sim;
+static stse_Handler_t test_handler;
+static PLAT_UI8 test_export[TEST_EXPORT_SIZE];
+
+static PLAT_UI16 test_get_u16(const PLAT_UI8 *p) {
+    return (PLAT_UI16)(p[0] | (p[1] << 8));
+}
+
+static PLAT_UI32 test_get_u32(const PLAT_UI8 *p) {
+    return (PLAT_UI32)p[0] | ((PLAT_UI32)p[1] << 8) | ((PLAT_UI32)p[2] << 16) | ((PLAT_UI32)p[3] << 24);
+}
+
+static void test_random(void) {
+    PLAT_UI8 random[TEST_RANDOM_SIZE];
+
+    STSE_TEST_CHECK_RET(stse_generate_random(&test_handler, random, TEST_RANDOM_SIZE), STSE_OK);
+}
+
+/* - Exported trace of record_count Generate Random command / response records starting at first_sequence */
+static void test_export_check(PLAT_UI16 buffer_size, PLAT_UI16 record_count, PLAT_UI32 first_sequence) {
+    const PLAT_UI8 *pRecord;
+    PLAT_UI32 previous_timestamp = 0;
+    PLAT_UI16 length = 0;
+    PLAT_UI16 i;
+
+    STSE_TEST_CHECK_RET(stse_frame_trace_export(&test_handler, test_export, buffer_size, &length), STSE_OK);
+    STSE_TEST_CHECK(length == (STSE_FRAME_TRACE_EXPORT_HEADER_SIZE + (record_count * STSE_FRAME_TRACE_EXPORT_RECORD_SIZE)));
+
+    /* - Header */
+    STSE_TEST_CHECK(memcmp(test_export, "STFT", 4) == 0);
+    STSE_TEST_CHECK(test_export[4] == STSE_FRAME_TRACE_EXPORT_VERSION);
+    STSE_TEST_CHECK(test_export[5] == STSE_FRAME_TRACE_PAYLOAD_SIZE);
+    STSE_TEST_CHECK(test_get_u16(&test_export[6]) == record_count);
+    STSE_TEST_CHECK(test_get_u32(&test_export[8]) == first_sequence);
+
+    /* - Records from the oldest to the newest one (even sequence numbers : command frames) */
+    for (i = 0; i < record_count; i++) {
+        pRecord = &test_export[STSE_FRAME_TRACE_EXPORT_HEADER_SIZE + (i * STSE_FRAME_TRACE_EXPORT_RECORD_SIZE)];
+        STSE_TEST_CHECK(test_get_u32(&pRecord[0]) >= previous_timestamp);
+        previous_timestamp = test_get_u32(&pRecord[0]);
+        STSE_TEST_CHECK(test_get_u16(&pRecord[6]) == STSE_OK);
+        if (((first_sequence + i) & 1U) == 0) {
+            STSE_TEST_CHECK(pRecord[8] == STSE_FRAME_TRACE_CMD);
+            STSE_TEST_CHECK(pRecord[9] == STSAFEA_CMD_GENERATE_RANDOM);
+            STSE_TEST_CHECK(test_get_u16(&pRecord[4]) == 3U);
+            STSE_TEST_CHECK(pRecord[10] == 0);
+            STSE_TEST_CHECK(pRecord[11] == 3U);
+            STSE_TEST_CHECK((pRecord[12] == STSAFEA_CMD_GENERATE_RANDOM) && (pRecord[13] == 0x00) &&
+                            (pRecord[14] == TEST_RANDOM_SIZE));
+        } else {
+            STSE_TEST_CHECK(pRecord[8] == STSE_FRAME_TRACE_RSP);
+            STSE_TEST_CHECK(pRecord[9] == STSE_OK);
+            STSE_TEST_CHECK(test_get_u16(&pRecord[4]) == (1U + TEST_RANDOM_SIZE));
+            STSE_TEST_CHECK(pRecord[10] != 0);
+            STSE_TEST_CHECK(pRecord[11] == STSE_FRAME_TRACE_PAYLOAD_SIZE);
+        }
+    }
+}
+
+int main(void) {
+    FILE *pFile;
+    PLAT_UI16 length = 0;
+    PLAT_UI16 i;
+
+    STSE_TEST_CHECK_RET(stse_platform_crypto_init(), STSE_OK);
+
+    /* - Simulated device answering after the command processing latency (NACKed response polls) */
+    STSE_TEST_CHECK_RET(stse_simulator_init(&test_sim, STSAFE_A120), STSE_OK);
+    test_sim.pGet_time_ms = stse_platform_host_time_ms;
+
+    stse_set_default_handler_value(&test_handler);
+    test_handler.device_type = STSAFE_A120;
+    STSE_TEST_CHECK_RET(stse_simulator_attach(&test_sim, &test_handler), STSE_OK);
+    STSE_TEST_CHECK_RET(stse_init(&test_handler), STSE_OK);
+
+    /* - Cleared trace : header only */
+    stse_frame_trace_clear(&test_handler);
+    test_export_check(sizeof(test_export), 0, 0);
+
+    /* - Trace before wrap-around */
+    for (i = 0; i < (STSE_FRAME_TRACE_DEPTH / 4U); i++) {
+        test_random();
+    }
+    test_export_check(sizeof(test_export), STSE_FRAME_TRACE_DEPTH / 2U, 0);
+
+    /* - Trace after wrap-around : last STSE_FRAME_TRACE_DEPTH records */
+    for (i = 0; i < STSE_FRAME_TRACE_DEPTH; i++) {
+        test_random();
+    }
+    test_export_check(sizeof(test_export), STSE_FRAME_TRACE_DEPTH, (STSE_FRAME_TRACE_DEPTH / 2U) * 3U);
+
+    /* - Export buffer too small for all records : newest records */
+    test_export_check(sizeof(test_export) - 1U, STSE_FRAME_TRACE_DEPTH - 1U, ((STSE_FRAME_TRACE_DEPTH / 2U) * 3U) + 1U);
+    test_export_check(STSE_FRAME_TRACE_EXPORT_HEADER_SIZE, 0, (STSE_FRAME_TRACE_DEPTH / 2U) * 5U);
+
+    /* - Invalid parameters */
+    STSE_TEST_CHECK_RET(stse_frame_trace_export(&test_handler, test_export, STSE_FRAME_TRACE_EXPORT_HEADER_SIZE - 1U, &length),
+                        STSE_CORE_INVALID_PARAMETER);
+    STSE_TEST_CHECK_RET(stse_frame_trace_export(NULL, test_export, sizeof(test_export), &length),
+                        STSE_CORE_HANDLER_NOT_INITIALISED);
+
+    /* - Wrapped trace for the host decoder */
+    STSE_TEST_CHECK_RET(stse_frame_trace_export(&test_handler, test_export, sizeof(test_export), &length), STSE_OK);
+    pFile = fopen(TEST_TRACE_FILE, "wb");
+    STSE_TEST_CHECK(pFile != NULL);
+    if (pFile != NULL) {
+        STSE_TEST_CHECK(fwrite(test_export, 1, length, pFile) == length);
+        fclose(pFile);
+    }
+
+    STSE_TEST_CHECK(test_sim.statistics.error_count == 0);
+    stse_simulator_detach(&test_sim);
+
+    return stse_test_report("test_frame_trace");
+}
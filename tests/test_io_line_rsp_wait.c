@@ -0,0 +1,153 @@
+/*!
+ * ******************************************************************************
+ * \file	test_io_line_rsp_wait.c
+ * \brief   Ready line driven response wait test against STSAFE-A device simulators sharing a bus
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details Two simulated devices share a bus and report their own ready line through the io.IOLineReady callback
+ *          (virtual host time). A blocking read on the first device must be received as soon as its ready line is
+ *          asserted , without NACKed response polls , including while a longer command submitted to the second
+ *          device is still executed. The asynchronous transfer of the second device must not issue bus
+ *          transactions while its ready line is not asserted.
+ */
+
+#include <string.h>
+
+#include "stselib.h"
+#include "tools/host/stse_platform_host.h"
+#include "tools/stse_simulator.h"
+#include "stse_test.h"
+
+#if !defined(STSE_USE_IO_LINE_RSP_WAIT) || !defined(STSE_CONF_USE_ASYNC_TRANSFER)
+#error "test_io_line_rsp_wait requires STSE_USE_IO_LINE_RSP_WAIT and STSE_CONF_USE_ASYNC_TRANSFER"
+#endif
+
+#define TEST_DATA_ZONE 1U
+#define TEST_ZONE_SIZE 32U
+#define TEST_DEVICE_COUNT 2U
+#define TEST_FAST_LATENCY 5U
+#define TEST_SLOW_LATENCY 40U
+
+typedef struct {
+    PLAT_UI8 cmd_header;
+    PLAT_UI8 cmd_payload[6];
+    PLAT_UI8 rsp_header;
+    PLAT_UI8 data[TEST_ZONE_SIZE];
+    stse_frame_t cmd_frame;
+    stse_frame_t rsp_frame;
+    stse_frame_element_t cmd_element[2];
+    stse_frame_element_t rsp_element[2];
+} test_command_t;
+
+static stse_simulator_t test_sim[TEST_DEVICE_COUNT];
+static stse_Handler_t test_handler[TEST_DEVICE_COUNT];
+static stsafea_transfer_t test_transfer;
+static test_command_t test_command;
+static PLAT_UI8 test_zone[TEST_ZONE_SIZE];
+
+/* - Blocking read on the first device , returns its duration in virtual host time */
+static PLAT_UI32 test_read(void) {
+    PLAT_UI8 data[TEST_ZONE_SIZE];
+    PLAT_UI32 start = stse_platform_host_time_ms();
+    PLAT_UI32 nack_count = test_sim[0].statistics.nack_count;
+
+    memset(data, 0, sizeof(data));
+    STSE_TEST_CHECK_RET(stse_data_storage_read_data_zone(&test_handler[0], TEST_DATA_ZONE, 0, data, TEST_ZONE_SIZE, 0, STSE_NO_PROT),
+                        STSE_OK);
+    STSE_TEST_CHECK(memcmp(data, test_zone, TEST_ZONE_SIZE) == 0);
+    STSE_TEST_CHECK(test_sim[0].statistics.nack_count == nack_count);
+
+    return stse_platform_host_time_ms() - start;
+}
+
+/* - Read command frames of the asynchronous transfer */
+static void test_command_build(void) {
+    memset(&test_command, 0, sizeof(test_command));
+    test_command.cmd_header = STSAFEA_CMD_READ;
+    test_command.cmd_payload[1] = TEST_DATA_ZONE;
+    test_command.cmd_payload[5] = TEST_ZONE_SIZE;
+    test_command.cmd_element[0].length = STSAFEA_HEADER_SIZE;
+    test_command.cmd_element[0].pData = &test_command.cmd_header;
+    test_command.cmd_element[1].length = sizeof(test_command.cmd_payload);
+    test_command.cmd_element[1].pData = test_command.cmd_payload;
+    stse_frame_push_element(&test_command.cmd_frame, &test_command.cmd_element[0]);
+    stse_frame_push_element(&test_command.cmd_frame, &test_command.cmd_element[1]);
+
+    test_command.rsp_element[0].length = STSAFEA_HEADER_SIZE;
+    test_command.rsp_element[0].pData = &test_command.rsp_header;
+    test_command.rsp_element[1].length = TEST_ZONE_SIZE;
+    test_command.rsp_element[1].pData = test_command.data;
+    stse_frame_push_element(&test_command.rsp_frame, &test_command.rsp_element[0]);
+    stse_frame_push_element(&test_command.rsp_frame, &test_command.rsp_element[1]);
+}
+
+int main(void) {
+    stse_ReturnCode_t ret;
+    PLAT_UI32 start;
+    PLAT_UI32 receive_count;
+    PLAT_UI16 pending_count = 0;
+    PLAT_UI8 i;
+
+    for (i = 0; i < TEST_ZONE_SIZE; i++) {
+        test_zone[i] = (PLAT_UI8)(0x96 ^ (i * 13U));
+    }
+    STSE_TEST_CHECK_RET(stse_platform_crypto_init(), STSE_OK);
+
+    /* - Simulated devices on the same bus : fast read on the first one , slow read on the second one */
+    for (i = 0; i < TEST_DEVICE_COUNT; i++) {
+        STSE_TEST_CHECK_RET(stse_simulator_init(&test_sim[i], STSAFE_A120), STSE_OK);
+        stse_simulator_set_zone(&test_sim[i], TEST_DATA_ZONE, 0, STSE_AC_ALWAYS, STSE_AC_ALWAYS, test_zone, TEST_ZONE_SIZE, 0);
+        stse_simulator_set_cmd_latency(&test_sim[i], STSAFEA_CMD_READ, 0, (i == 0) ? TEST_FAST_LATENCY : TEST_SLOW_LATENCY);
+        test_sim[i].pGet_time_ms = stse_platform_host_time_ms;
+
+        stse_set_default_handler_value(&test_handler[i]);
+        test_handler[i].device_type = STSAFE_A120;
+        test_handler[i].io.Devaddr += i;
+        STSE_TEST_CHECK_RET(stse_simulator_attach(&test_sim[i], &test_handler[i]), STSE_OK);
+        STSE_TEST_CHECK(test_handler[i].io.IOLineReady != NULL);
+        STSE_TEST_CHECK_RET(stse_init(&test_handler[i]), STSE_OK);
+    }
+    STSE_TEST_CHECK(test_handler[0].io.busID == test_handler[1].io.busID);
+    STSE_TEST_CHECK(stsafea_cmd_timings[STSAFE_A120][STSAFEA_CMD_READ] > TEST_FAST_LATENCY);
+
+    /* - Idle bus : response received on the ready line assertion */
+    STSE_TEST_CHECK(test_read() == TEST_FAST_LATENCY);
+
+    /* - Command executed by the other device of the bus : ready line of the addressed device only */
+    test_command_build();
+    STSE_TEST_CHECK_RET(stsafea_frame_transfer_submit(&test_handler[1], &test_transfer, &test_command.cmd_frame,
+                                                      &test_command.rsp_frame, NULL, NULL),
+                        STSE_OK);
+    start = stse_platform_host_time_ms();
+    STSE_TEST_CHECK(test_read() == TEST_FAST_LATENCY);
+
+    /* - Asynchronous transfer : no bus transaction until the ready line of its device is asserted */
+    receive_count = test_sim[1].statistics.receive_count;
+    while ((ret = stsafea_frame_transfer_poll(&test_transfer)) == STSE_SERVICE_TRANSFER_PENDING) {
+        pending_count++;
+        STSE_TEST_CHECK(test_sim[1].statistics.receive_count == receive_count);
+        stse_platform_Delay_ms(test_transfer.poll_interval);
+    }
+    STSE_TEST_CHECK_RET(ret, STSE_OK);
+    STSE_TEST_CHECK(pending_count != 0);
+    STSE_TEST_CHECK((stse_platform_host_time_ms() - start) >= (TEST_SLOW_LATENCY - TEST_FAST_LATENCY));
+    STSE_TEST_CHECK(test_sim[1].statistics.nack_count == 0);
+    STSE_TEST_CHECK(memcmp(test_command.data, test_zone, TEST_ZONE_SIZE) == 0);
+
+    for (i = 0; i < TEST_DEVICE_COUNT; i++) {
+        STSE_TEST_CHECK(test_sim[i].statistics.error_count == 0);
+        stse_simulator_detach(&test_sim[i]);
+    }
+
+    return stse_test_report("test_io_line_rsp_wait");
+}
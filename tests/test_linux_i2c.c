@@ -0,0 +1,284 @@
+/*!
+ * ******************************************************************************
+ * \file	test_linux_i2c.c
+ * \brief   Linux i2c-dev platform test against the STSAFE-A device simulator
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details The open , ioctl and close calls of platform/linux/stse_platform_linux_i2c.c are wrapped at link time
+ *          (-Wl,--wrap). The I2C_RDWR transactions issued on the test bus are checked (one transaction per frame ,
+ *          NOSTART chaining) and forwarded to the device simulator bus callbacks.
+ */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+#include "stselib.h"
+#include "platform/linux/stse_platform_linux_i2c.h"
+#include "tools/stse_simulator.h"
+#include "stse_test.h"
+
+#define TEST_BUS_ID 3U
+#define TEST_MISSING_BUS_ID 4U
+#define TEST_DEVICE_ADDRESS 0x20U
+#define TEST_FD 0x5A5
+#define TEST_ZONE_SIZE 300U
+
+int __real_open(const char *pPath, int flags, ...);
+int __real_ioctl(int fd, unsigned long request, ...);
+int __real_close(int fd);
+
+static stse_simulator_t test_sim;
+static stse_Handler_t test_sim_port; /* simulator bus callbacks */
+static unsigned long test_funcs;
+static int test_rdwr_count;
+static int test_write_max_msgs;
+static int test_read_nack_left;
+static int test_read_errno;
+
+static int test_rdwr(struct i2c_rdwr_ioctl_data *pXfer) {
+    stse_io_t *pIo = &test_sim_port.io;
+    PLAT_UI16 length = 0;
+    PLAT_UI32 i;
+    stse_ReturnCode_t ret;
+
+    test_rdwr_count++;
+
+    if ((pXfer->msgs[0].flags & I2C_M_RD) != 0U) {
+        if ((pXfer->nmsgs != 1U) || (pXfer->msgs[0].addr != TEST_DEVICE_ADDRESS)) {
+            errno = EINVAL;
+            return -1;
+        }
+        if (test_read_nack_left > 0) {
+            test_read_nack_left--;
+            errno = test_read_errno;
+            return -1;
+        }
+        ret = pIo->BusRecvStart(TEST_BUS_ID, (PLAT_UI8)pXfer->msgs[0].addr, 0, pXfer->msgs[0].len);
+        if (ret == STSE_OK) {
+            ret = pIo->BusRecvStop(TEST_BUS_ID, (PLAT_UI8)pXfer->msgs[0].addr, 0,
+                                   pXfer->msgs[0].buf, pXfer->msgs[0].len);
+        }
+    } else {
+        for (i = 0; i < pXfer->nmsgs; i++) {
+            /* - Only the first message of a write transaction carries the start condition */
+            if ((pXfer->msgs[i].addr != TEST_DEVICE_ADDRESS) ||
+                (((pXfer->msgs[i].flags & I2C_M_NOSTART) != 0U) != (i != 0U))) {
+                errno = EINVAL;
+                return -1;
+            }
+            length += pXfer->msgs[i].len;
+        }
+        if ((int)pXfer->nmsgs > test_write_max_msgs) {
+            test_write_max_msgs = (int)pXfer->nmsgs;
+        }
+        if (length == 0U) {
+            /* - Wake-up : address only write */
+            return (int)pXfer->nmsgs;
+        }
+        ret = pIo->BusSendStart(TEST_BUS_ID, TEST_DEVICE_ADDRESS, 0, length);
+        for (i = 0; (ret == STSE_OK) && (i < (pXfer->nmsgs - 1U)); i++) {
+            ret = pIo->BusSendContinue(TEST_BUS_ID, TEST_DEVICE_ADDRESS, 0, pXfer->msgs[i].buf, pXfer->msgs[i].len);
+        }
+        if (ret == STSE_OK) {
+            ret = pIo->BusSendStop(TEST_BUS_ID, TEST_DEVICE_ADDRESS, 0, pXfer->msgs[i].buf, pXfer->msgs[i].len);
+        }
+    }
+
+    if (ret == STSE_PLATFORM_BUS_ACK_ERROR) {
+        errno = ENXIO;
+        return -1;
+    }
+    if (ret != STSE_OK) {
+        errno = EIO;
+        return -1;
+    }
+
+    return (int)pXfer->nmsgs;
+}
+
+int __wrap_open(const char *pPath, int flags, ...) {
+    char path[32];
+    mode_t mode = 0;
+    va_list args;
+
+    if ((flags & O_CREAT) != 0) {
+        va_start(args, flags);
+        mode = va_arg(args, mode_t);
+        va_end(args);
+    }
+
+    snprintf(path, sizeof(path), "/dev/i2c-%u", TEST_BUS_ID);
+    if (strcmp(pPath, path) == 0) {
+        return TEST_FD;
+    }
+    snprintf(path, sizeof(path), "/dev/i2c-%u", TEST_MISSING_BUS_ID);
+    if (strcmp(pPath, path) == 0) {
+        errno = ENOENT;
+        return -1;
+    }
+
+    return __real_open(pPath, flags, mode);
+}
+
+int __wrap_ioctl(int fd, unsigned long request, ...) {
+    void *pArg;
+    va_list args;
+
+    va_start(args, request);
+    pArg = va_arg(args, void *);
+    va_end(args);
+
+    if (fd != TEST_FD) {
+        return __real_ioctl(fd, request, pArg);
+    }
+
+    switch (request) {
+    case I2C_FUNCS:
+        *(unsigned long *)pArg = test_funcs;
+        return 0;
+    case I2C_RDWR:
+        return test_rdwr((struct i2c_rdwr_ioctl_data *)pArg);
+    default:
+        errno = ENOTTY;
+        return -1;
+    }
+}
+
+int __wrap_close(int fd) {
+    if (fd == TEST_FD) {
+        return 0;
+    }
+
+    return __real_close(fd);
+}
+
+static void test_bus_open(unsigned long funcs) {
+    stse_platform_i2c_deinit(TEST_BUS_ID);
+    test_funcs = funcs;
+    STSE_TEST_CHECK_RET(stse_platform_i2c_init(TEST_BUS_ID), STSE_OK);
+}
+
+static void test_frames(stse_Handler_t *pSTSE, PLAT_UI8 *pZone) {
+    PLAT_UI8 message[500];
+    PLAT_UI8 echoed[500];
+    PLAT_UI8 data[TEST_ZONE_SIZE];
+    PLAT_UI16 length;
+    PLAT_UI16 i;
+    int rdwr_count;
+
+    for (i = 0; i < sizeof(message); i++) {
+        message[i] = (PLAT_UI8)(i * 7U + 3U);
+    }
+
+    /* - One write and one read transaction per command frame when the device answers immediately */
+    for (length = 1; length < sizeof(message); length += 61U) {
+        memset(echoed, 0, sizeof(echoed));
+        rdwr_count = test_rdwr_count;
+        STSE_TEST_CHECK_RET(stsafea_echo(pSTSE, message, echoed, length), STSE_OK);
+        STSE_TEST_CHECK(memcmp(message, echoed, length) == 0);
+        STSE_TEST_CHECK(test_rdwr_count - rdwr_count <= 3);
+    }
+
+    STSE_TEST_CHECK_RET(stse_generate_random(pSTSE, data, 32), STSE_OK);
+
+    memcpy(data, message, sizeof(data));
+    STSE_TEST_CHECK_RET(stse_data_storage_update_data_zone(pSTSE, 0, 10, data, 200, STSE_NON_ATOMIC_ACCESS, STSE_NO_PROT), STSE_OK);
+    STSE_TEST_CHECK(memcmp(pZone + 10, message, 200) == 0);
+    memset(data, 0, sizeof(data));
+    STSE_TEST_CHECK_RET(stse_data_storage_read_data_zone(pSTSE, 0, 0, data, TEST_ZONE_SIZE, 128, STSE_NO_PROT), STSE_OK);
+    STSE_TEST_CHECK(memcmp(data, pZone, TEST_ZONE_SIZE) == 0);
+}
+
+int main(void) {
+    static stse_Handler_t handler;
+    static PLAT_UI8 zone[TEST_ZONE_SIZE];
+    PLAT_UI8 message[16] = {0};
+    PLAT_UI8 echoed[16];
+    PLAT_UI16 i;
+    int rdwr_count;
+
+    for (i = 0; i < TEST_ZONE_SIZE; i++) {
+        zone[i] = (PLAT_UI8)i;
+    }
+
+    /* - Simulated device attached to the bus address reached through the wrapped I2C_RDWR ioctl */
+    STSE_TEST_CHECK_RET(stse_simulator_init(&test_sim, STSAFE_A120), STSE_OK);
+    STSE_TEST_CHECK_RET(stse_simulator_set_zone(&test_sim, 0, 0, STSE_AC_ALWAYS, STSE_AC_ALWAYS, zone, TEST_ZONE_SIZE, 0), STSE_OK);
+    stse_set_default_handler_value(&test_sim_port);
+    test_sim_port.io.busID = TEST_BUS_ID;
+    test_sim_port.io.Devaddr = TEST_DEVICE_ADDRESS;
+    STSE_TEST_CHECK_RET(stse_simulator_attach(&test_sim, &test_sim_port), STSE_OK);
+
+    /* - Bus opening errors */
+    test_funcs = I2C_FUNC_SMBUS_BYTE;
+    STSE_TEST_CHECK_RET(stse_platform_i2c_init(TEST_BUS_ID), STSE_PLATFORM_SERVICES_INIT_ERROR);
+    STSE_TEST_CHECK_RET(stse_platform_i2c_init(TEST_MISSING_BUS_ID), STSE_PLATFORM_SERVICES_INIT_ERROR);
+    STSE_TEST_CHECK_RET(stse_platform_i2c_init(0xFF), STSE_PLATFORM_INVALID_PARAMETER);
+
+    /* - Library initialization through the Linux platform (start / continue / stop callbacks) */
+    test_funcs = I2C_FUNC_I2C | I2C_FUNC_NOSTART;
+    stse_set_default_handler_value(&handler);
+    handler.device_type = STSAFE_A120;
+    handler.io.busID = TEST_BUS_ID;
+    handler.io.Devaddr = TEST_DEVICE_ADDRESS;
+    STSE_TEST_CHECK_RET(stse_init(&handler), STSE_OK);
+    test_frames(&handler, zone);
+    STSE_TEST_CHECK(test_write_max_msgs == 1);
+
+    /* - Vectored callbacks , adapter with NOSTART support : one message per frame element */
+    handler.io.BusSendV = stse_platform_i2c_send_vectored;
+    handler.io.BusRecvV = stse_platform_i2c_receive_vectored;
+    test_write_max_msgs = 0;
+    test_frames(&handler, zone);
+    STSE_TEST_CHECK(test_write_max_msgs > 1);
+
+    /* - Vectored callbacks , adapter without NOSTART support : frame gathered in one message */
+    test_bus_open(I2C_FUNC_I2C);
+    test_write_max_msgs = 0;
+    test_frames(&handler, zone);
+    STSE_TEST_CHECK(test_write_max_msgs == 1);
+
+    /* - Address NACK errno values are reported as bus ACK errors : the response is polled again */
+    test_bus_open(I2C_FUNC_I2C | I2C_FUNC_NOSTART);
+    test_read_errno = EREMOTEIO;
+    test_read_nack_left = 3;
+    rdwr_count = test_rdwr_count;
+    STSE_TEST_CHECK_RET(stsafea_echo(&handler, message, echoed, sizeof(message)), STSE_OK);
+    STSE_TEST_CHECK(test_read_nack_left == 0);
+    STSE_TEST_CHECK(test_rdwr_count - rdwr_count >= 5);
+    test_read_errno = ETIMEDOUT;
+    test_read_nack_left = 2;
+    STSE_TEST_CHECK_RET(stsafea_echo(&handler, message, echoed, sizeof(message)), STSE_OK);
+
+    /* - Other errno values are bus errors , not retried */
+    test_read_errno = EBADF;
+    test_read_nack_left = 1;
+    STSE_TEST_CHECK(stsafea_echo(&handler, message, echoed, sizeof(message)) != STSE_OK);
+    STSE_TEST_CHECK(test_read_nack_left == 0);
+
+    /* - The simulated device is left waiting for the response read : resynchronize */
+    test_read_nack_left = 0;
+    (void)stsafea_echo(&handler, message, echoed, sizeof(message));
+    STSE_TEST_CHECK_RET(stsafea_echo(&handler, message, echoed, sizeof(message)), STSE_OK);
+
+    stse_platform_i2c_deinit(TEST_BUS_ID);
+    STSE_TEST_CHECK(stsafea_echo(&handler, message, echoed, sizeof(message)) != STSE_OK);
+
+    return stse_test_report("test_linux_i2c");
+}
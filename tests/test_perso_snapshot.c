@@ -0,0 +1,165 @@
+/*!
+ * ******************************************************************************
+ * \file	test_perso_snapshot.c
+ * \brief   Personalization snapshot export / warm initialization test against the STSAFE-A device simulator
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details The personalization of a simulated device (protected and encrypted commands) is discovered by stse_init
+ *          and exported as a snapshot. A second handler is initialized from the snapshot : the personalization
+ *          information must match the discovered one with a single device command (mask identification query)
+ *          and protected commands must run on the restored configuration. Corrupted , outdated , foreign mask and
+ *          missing snapshots must fall back to the full discovery.
+ */
+
+#include <string.h>
+
+#include "stselib.h"
+#include "tools/stse_simulator.h"
+#include "stse_test.h"
+
+#if !defined(STSE_CONF_STSAFE_A_SUPPORT) || defined(STSE_CONF_USE_STATIC_PERSONALIZATION_INFORMATIONS)
+#error "test_perso_snapshot requires STSE_CONF_STSAFE_A_SUPPORT without STSE_CONF_USE_STATIC_PERSONALIZATION_INFORMATIONS"
+#endif
+
+#define TEST_DATA_ZONE 1U
+#define TEST_ZONE_SIZE 64U
+
+static const PLAT_UI8 test_protected_cmd[][2] = {
+    {STSAFEA_CMD_GENERATE_RANDOM, 0},
+    {STSAFEA_CMD_READ, 0},
+};
+
+static stse_simulator_t test_sim;
+static stse_Handler_t test_handler;
+static stse_Handler_t test_warm_handler;
+static stse_session_t test_session;
+static PLAT_UI8 test_host_MAC_key[STSE_AES_128_KEY_SIZE];
+static PLAT_UI8 test_host_cipher_key[STSE_AES_128_KEY_SIZE];
+static PLAT_UI8 test_zone[TEST_ZONE_SIZE];
+
+/* - Warm initialization of a fresh handler , returns the number of device commands it needed */
+static PLAT_UI32 test_warm_init(const PLAT_UI8 *pSnapshot, PLAT_UI16 snapshot_length, PLAT_UI8 expected_restored) {
+    PLAT_UI32 cmd_count;
+    PLAT_UI8 restored = 0xFF;
+
+    stse_set_default_handler_value(&test_warm_handler);
+    test_warm_handler.device_type = STSAFE_A120;
+    STSE_TEST_CHECK_RET(stse_simulator_attach(&test_sim, &test_warm_handler), STSE_OK);
+#ifdef STSE_USE_INCREMENTAL_CRC
+    /* - Element by element bus transfers (frame CRCs computed during the element transfers) */
+    test_warm_handler.io.BusSendV = NULL;
+    test_warm_handler.io.BusRecvV = NULL;
+#endif /* STSE_USE_INCREMENTAL_CRC */
+
+    cmd_count = test_sim.statistics.cmd_count;
+    STSE_TEST_CHECK_RET(stse_init_from_perso_snapshot(&test_warm_handler, pSnapshot, snapshot_length, &restored), STSE_OK);
+    STSE_TEST_CHECK(restored == expected_restored);
+    STSE_TEST_CHECK(memcmp(&test_warm_handler.perso_info, &test_handler.perso_info, sizeof(stse_perso_info_t)) == 0);
+
+    return test_sim.statistics.cmd_count - cmd_count;
+}
+
+int main(void) {
+    PLAT_UI8 snapshot[STSE_PERSO_SNAPSHOT_SIZE + 4U];
+    PLAT_UI8 altered[STSE_PERSO_SNAPSHOT_SIZE];
+    PLAT_UI8 data[TEST_ZONE_SIZE];
+    PLAT_UI8 random[32];
+    PLAT_UI16 snapshot_length;
+    PLAT_UI32 cold_cmd_count;
+    PLAT_UI32 error_count;
+    PLAT_UI8 i;
+
+    for (i = 0; i < TEST_ZONE_SIZE; i++) {
+        test_zone[i] = (PLAT_UI8)(0x3C ^ (i * 5U));
+    }
+    for (i = 0; i < STSE_AES_128_KEY_SIZE; i++) {
+        test_host_MAC_key[i] = (PLAT_UI8)(0x10 + i);
+        test_host_cipher_key[i] = (PLAT_UI8)(0x20 + i);
+    }
+    STSE_TEST_CHECK_RET(stse_platform_crypto_init(), STSE_OK);
+
+    /* - Simulated device with protected and encrypted commands */
+    STSE_TEST_CHECK_RET(stse_simulator_init(&test_sim, STSAFE_A120), STSE_OK);
+    stse_simulator_set_host_keys(&test_sim, STSE_AES_128_KT, test_host_MAC_key, test_host_cipher_key, 0);
+    stse_simulator_set_zone(&test_sim, TEST_DATA_ZONE, 0, STSE_AC_ALWAYS, STSE_AC_ALWAYS, test_zone, TEST_ZONE_SIZE, 0);
+    for (i = 0; i < (sizeof(test_protected_cmd) / sizeof(test_protected_cmd[0])); i++) {
+        stse_simulator_set_cmd_protection(&test_sim, test_protected_cmd[i][0], test_protected_cmd[i][1],
+                                          STSE_CMD_AC_HOST, 1, 1);
+    }
+
+    /* - Cold initialization (full personalization discovery) and snapshot export */
+    stse_set_default_handler_value(&test_handler);
+    test_handler.device_type = STSAFE_A120;
+    STSE_TEST_CHECK_RET(stse_simulator_attach(&test_sim, &test_handler), STSE_OK);
+#ifdef STSE_USE_INCREMENTAL_CRC
+    /* - Element by element bus transfers (frame CRCs computed during the element transfers) */
+    test_handler.io.BusSendV = NULL;
+    test_handler.io.BusRecvV = NULL;
+#endif /* STSE_USE_INCREMENTAL_CRC */
+    cold_cmd_count = test_sim.statistics.cmd_count;
+    STSE_TEST_CHECK_RET(stse_init(&test_handler), STSE_OK);
+    cold_cmd_count = test_sim.statistics.cmd_count - cold_cmd_count;
+    STSE_TEST_CHECK(test_handler.perso_info.cmd_encryption_status != 0);
+
+    snapshot_length = STSE_PERSO_SNAPSHOT_SIZE - 1U;
+    STSE_TEST_CHECK_RET(stse_perso_snapshot_export(&test_handler, snapshot, &snapshot_length), STSE_API_INVALID_PARAMETER);
+    snapshot_length = sizeof(snapshot);
+    STSE_TEST_CHECK_RET(stse_perso_snapshot_export(&test_handler, snapshot, &snapshot_length), STSE_OK);
+    STSE_TEST_CHECK(snapshot_length == STSE_PERSO_SNAPSHOT_SIZE);
+
+    /* - Warm initialization : personalization restored with the mask identification query only */
+    STSE_TEST_CHECK(test_warm_init(snapshot, snapshot_length, 1) == 1U);
+    STSE_TEST_CHECK(cold_cmd_count > 1U);
+
+    /* - Protected commands on the restored personalization */
+    error_count = test_sim.statistics.error_count;
+    STSE_TEST_CHECK_RET(stsafea_open_host_session(&test_warm_handler, &test_session,
+                                                  test_host_MAC_key, test_host_cipher_key),
+                        STSE_OK);
+    memset(data, 0, sizeof(data));
+    STSE_TEST_CHECK_RET(stse_data_storage_read_data_zone(&test_warm_handler, TEST_DATA_ZONE, 0, data,
+                                                         TEST_ZONE_SIZE, 0, STSE_NO_PROT),
+                        STSE_OK);
+    STSE_TEST_CHECK(memcmp(data, test_zone, TEST_ZONE_SIZE) == 0);
+    STSE_TEST_CHECK_RET(stse_generate_random(&test_warm_handler, random, sizeof(random)), STSE_OK);
+    STSE_TEST_CHECK(test_sim.statistics.error_count == error_count);
+    STSE_TEST_CHECK(test_session.context.host.MAC_counter == test_sim.host_MAC_counter);
+    stsafea_close_host_session(&test_session);
+
+    /* - Corrupted snapshot (each byte in turn) : full discovery */
+    for (i = 0; i < STSE_PERSO_SNAPSHOT_SIZE; i++) {
+        memcpy(altered, snapshot, STSE_PERSO_SNAPSHOT_SIZE);
+        altered[i] ^= 0x01U;
+        STSE_TEST_CHECK(test_warm_init(altered, STSE_PERSO_SNAPSHOT_SIZE, 0) == cold_cmd_count);
+    }
+
+    /* - Truncated and missing snapshots : full discovery */
+    STSE_TEST_CHECK(test_warm_init(snapshot, STSE_PERSO_SNAPSHOT_SIZE - 1U, 0) == cold_cmd_count);
+    STSE_TEST_CHECK(test_warm_init(NULL, 0, 0) == cold_cmd_count);
+
+    /* - Snapshot taken on another device mask : full discovery */
+    test_sim.mask_id[STSAFEA_MASK_ID_SIZE - 1U] ^= 0x01U;
+    STSE_TEST_CHECK(test_warm_init(snapshot, snapshot_length, 0) == cold_cmd_count);
+    test_sim.mask_id[STSAFEA_MASK_ID_SIZE - 1U] ^= 0x01U;
+
+    /* - Device personalization changed : a new export reflects the rediscovered configuration */
+    stse_simulator_set_cmd_protection(&test_sim, STSAFEA_CMD_GENERATE_RANDOM, 0, STSE_CMD_AC_FREE, 0, 0);
+    STSE_TEST_CHECK_RET(stse_init(&test_handler), STSE_OK);
+    STSE_TEST_CHECK_RET(stse_perso_snapshot_export(&test_handler, altered, &snapshot_length), STSE_OK);
+    STSE_TEST_CHECK(memcmp(altered, snapshot, STSE_PERSO_SNAPSHOT_SIZE) != 0);
+    STSE_TEST_CHECK(test_warm_init(altered, snapshot_length, 1) == 1U);
+
+    stse_simulator_detach(&test_sim);
+
+    return stse_test_report("test_perso_snapshot");
+}
@@ -0,0 +1,149 @@
+/*!
+ * ******************************************************************************
+ * \file	test_retry_policy.c
+ * \brief   Bus retry policy test
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details Retry delays returned by stse_retry_next are checked against the handler retry policy : exponential
+ *          backoff up to the delay cap , random jitter bounds , platform delay range clamp , attempt count and
+ *          cumulated delay deadline. Invalid policies must be refused and leave the handler policy unchanged.
+ */
+
+#include "stselib.h"
+#include "tools/host/stse_platform_host.h"
+#include "stse_test.h"
+
+#if !defined(STSE_USE_RETRY_POLICY)
+#error "test_retry_policy requires STSE_USE_RETRY_POLICY"
+#endif
+
+#define TEST_MAX_ATTEMPT 10U
+#define TEST_JITTER_SAMPLES 500U
+
+static stse_Handler_t test_handler;
+
+static void test_policy_set(PLAT_UI16 initial_delay, PLAT_UI8 backoff_factor, PLAT_UI16 max_delay,
+                            PLAT_UI8 jitter, PLAT_UI16 deadline) {
+    stse_retry_policy_t policy;
+
+    policy.initial_delay = initial_delay;
+    policy.backoff_factor = backoff_factor;
+    policy.max_delay = max_delay;
+    policy.jitter = jitter;
+    policy.deadline = deadline;
+    STSE_TEST_CHECK_RET(stse_retry_set_policy(&test_handler, &policy), STSE_OK);
+}
+
+/* - Number of retries allowed on a bus operation (delays checked against pExpected when not NULL) */
+static PLAT_UI16 test_retry_run(PLAT_UI16 max_attempt, const PLAT_UI16 *pExpected) {
+    stse_retry_t retry;
+    PLAT_UI16 delay;
+    PLAT_UI16 retry_count = 0;
+
+    stse_retry_init(&test_handler, &retry, max_attempt);
+    while (stse_retry_next(&test_handler, &retry, &delay) != 0) {
+        if (pExpected != NULL) {
+            STSE_TEST_CHECK(delay == pExpected[retry_count]);
+        }
+        retry_count++;
+    }
+
+    return retry_count;
+}
+
+int main(void) {
+    static const PLAT_UI16 backoff_delays[TEST_MAX_ATTEMPT - 1U] = {2, 6, 18, 50, 50, 50, 50, 50, 50};
+    static const PLAT_UI16 default_delays[TEST_MAX_ATTEMPT - 1U] = {
+        STSE_POLLING_RETRY_INTERVAL, STSE_POLLING_RETRY_INTERVAL, STSE_POLLING_RETRY_INTERVAL,
+        STSE_POLLING_RETRY_INTERVAL, STSE_POLLING_RETRY_INTERVAL, STSE_POLLING_RETRY_INTERVAL,
+        STSE_POLLING_RETRY_INTERVAL, STSE_POLLING_RETRY_INTERVAL, STSE_POLLING_RETRY_INTERVAL};
+    stse_retry_policy_t policy;
+    stse_retry_t retry;
+    PLAT_UI32 delay_total;
+    PLAT_UI16 delay;
+    PLAT_UI16 min_delay = 0xFFFF;
+    PLAT_UI16 max_delay = 0;
+    PLAT_UI16 i;
+
+    STSE_TEST_CHECK_RET(stse_platform_generate_random_init(), STSE_OK);
+    stse_set_default_handler_value(&test_handler);
+
+    /* - Default policy : fixed STSE_POLLING_RETRY_INTERVAL , STSE_MAX_POLLING_RETRY like attempt count */
+    STSE_TEST_CHECK(test_retry_run(TEST_MAX_ATTEMPT, default_delays) == (TEST_MAX_ATTEMPT - 1U));
+
+    /* - Exponential backoff up to the delay cap */
+    test_policy_set(2, 3, 50, 0, 0);
+    STSE_TEST_CHECK(test_retry_run(TEST_MAX_ATTEMPT, backoff_delays) == (TEST_MAX_ATTEMPT - 1U));
+    STSE_TEST_CHECK(test_retry_run(1, NULL) == 0);
+
+    /* - Jitter : delay in [base delay ; base delay + jitter] */
+    test_policy_set(10, 1, 10, 5, 0);
+    stse_retry_init(&test_handler, &retry, TEST_JITTER_SAMPLES + 1U);
+    for (i = 0; i < TEST_JITTER_SAMPLES; i++) {
+        STSE_TEST_CHECK(stse_retry_next(&test_handler, &retry, &delay) == 1);
+        if (delay < min_delay) {
+            min_delay = delay;
+        }
+        if (delay > max_delay) {
+            max_delay = delay;
+        }
+    }
+    STSE_TEST_CHECK((min_delay >= 10U) && (max_delay <= 15U));
+    STSE_TEST_CHECK(min_delay != max_delay);
+
+    /* - Jittered delay clamped to the platform delay range */
+    test_policy_set(0xFFFF, 2, 0xFFFF, 0xFF, 0);
+    stse_retry_init(&test_handler, &retry, TEST_MAX_ATTEMPT);
+    STSE_TEST_CHECK(stse_retry_next(&test_handler, &retry, &delay) == 1);
+    STSE_TEST_CHECK(delay == 0xFFFF);
+
+    /* - Deadline : retries stop before the cumulated delay exceeds the deadline (10 + 20 + 40 = 70 ms) */
+    test_policy_set(10, 2, 100, 0, 75);
+    STSE_TEST_CHECK(test_retry_run(TEST_MAX_ATTEMPT, NULL) == 3U);
+    test_policy_set(10, 2, 100, 0, 70);
+    STSE_TEST_CHECK(test_retry_run(TEST_MAX_ATTEMPT, NULL) == 3U);
+    test_policy_set(10, 2, 100, 0, 9);
+    STSE_TEST_CHECK(test_retry_run(TEST_MAX_ATTEMPT, NULL) == 0U);
+
+    /* - Retry statistics and platform delay */
+    stse_retry_reset_statistics(&test_handler);
+    test_policy_set(3, 2, 12, 0, 0);
+    stse_retry_command_start(&test_handler);
+    delay_total = stse_platform_host_delay_total();
+    stse_retry_init(&test_handler, &retry, 4);
+    while (stse_retry_wait(&test_handler, &retry) != 0) {
+    }
+    stse_retry_command_end(&test_handler);
+    STSE_TEST_CHECK((stse_platform_host_delay_total() - delay_total) == (3U + 6U + 12U));
+    STSE_TEST_CHECK(test_handler.retry_stats.cmd_retry_count == 3U);
+    STSE_TEST_CHECK(test_handler.retry_stats.max_cmd_retry_count == 3U);
+    STSE_TEST_CHECK(test_handler.retry_stats.total_retry_count == 3U);
+    STSE_TEST_CHECK(test_handler.retry_stats.cmd_count == 1U);
+
+    /* - Invalid policies refused , handler policy unchanged */
+    policy = test_handler.retry_policy;
+    policy.initial_delay = 0;
+    STSE_TEST_CHECK_RET(stse_retry_set_policy(&test_handler, &policy), STSE_CORE_INVALID_PARAMETER);
+    policy = test_handler.retry_policy;
+    policy.backoff_factor = 0;
+    STSE_TEST_CHECK_RET(stse_retry_set_policy(&test_handler, &policy), STSE_CORE_INVALID_PARAMETER);
+    policy = test_handler.retry_policy;
+    policy.max_delay = policy.initial_delay - 1U;
+    STSE_TEST_CHECK_RET(stse_retry_set_policy(&test_handler, &policy), STSE_CORE_INVALID_PARAMETER);
+    STSE_TEST_CHECK_RET(stse_retry_set_policy(&test_handler, NULL), STSE_CORE_INVALID_PARAMETER);
+    STSE_TEST_CHECK_RET(stse_retry_set_policy(NULL, &policy), STSE_CORE_HANDLER_NOT_INITIALISED);
+    STSE_TEST_CHECK((test_handler.retry_policy.initial_delay == 3U) && (test_handler.retry_policy.backoff_factor == 2U) &&
+                    (test_handler.retry_policy.max_delay == 12U));
+
+    return stse_test_report("test_retry_policy");
+}
@@ -0,0 +1,122 @@
+/*!
+ * ******************************************************************************
+ * \file	test_rsp_crc_error.c
+ * \brief   Frame CRC error detection test against the STSAFE-A device simulator
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details Frames are transferred element by element (vectored bus callbacks removed) so that frame CRCs are computed
+ *          while the frame elements are transferred when STSE_USE_INCREMENTAL_CRC is defined. Response CRC bytes
+ *          and response payload bytes are corrupted on the bus : the transfer must report
+ *          STSE_SERVICE_FRAME_CRC_ERROR and the next uncorrupted transfer must succeed.
+ */
+
+#include <string.h>
+
+#include "stselib.h"
+#include "tools/stse_simulator.h"
+#include "stse_test.h"
+
+#define TEST_DATA_ZONE 1U
+#define TEST_ZONE_SIZE 48U
+
+typedef enum {
+    TEST_NO_CORRUPTION = 0,
+    TEST_CORRUPT_CRC,
+    TEST_CORRUPT_PAYLOAD
+} test_corruption_t;
+
+static stse_simulator_t test_sim;
+static stse_Handler_t test_handler;
+static PLAT_UI8 test_zone[TEST_ZONE_SIZE];
+static test_corruption_t test_corruption;
+static stse_ReturnCode_t (*test_sim_recv_continue)(PLAT_UI8, PLAT_UI8, PLAT_UI16, PLAT_UI8 *, PLAT_UI16);
+static stse_ReturnCode_t (*test_sim_recv_stop)(PLAT_UI8, PLAT_UI8, PLAT_UI16, PLAT_UI8 *, PLAT_UI16);
+
+/* Corrupting bus receive callbacks --------------------------------------------*/
+
+static stse_ReturnCode_t test_recv_continue(PLAT_UI8 busID, PLAT_UI8 devAddr, PLAT_UI16 speed,
+                                            PLAT_UI8 *pData, PLAT_UI16 data_size) {
+    stse_ReturnCode_t ret = test_sim_recv_continue(busID, devAddr, speed, pData, data_size);
+
+    /* - Response payload element (response header and length excluded) */
+    if ((ret == STSE_OK) && (test_corruption == TEST_CORRUPT_PAYLOAD) && (pData != NULL) && (data_size == TEST_ZONE_SIZE)) {
+        pData[data_size / 2U] ^= 0x10U;
+    }
+
+    return ret;
+}
+
+static stse_ReturnCode_t test_recv_stop(PLAT_UI8 busID, PLAT_UI8 devAddr, PLAT_UI16 speed,
+                                        PLAT_UI8 *pData, PLAT_UI16 data_size) {
+    stse_ReturnCode_t ret = test_sim_recv_stop(busID, devAddr, speed, pData, data_size);
+
+    /* - Response CRC element (last element of each response read) */
+    if ((ret == STSE_OK) && (test_corruption == TEST_CORRUPT_CRC) && (pData != NULL) && (data_size == STSE_FRAME_CRC_SIZE)) {
+        pData[1] ^= 0x01U;
+    }
+
+    return ret;
+}
+
+static stse_ReturnCode_t test_read(test_corruption_t corruption) {
+    PLAT_UI8 data[TEST_ZONE_SIZE];
+    stse_ReturnCode_t ret;
+
+    test_corruption = corruption;
+    memset(data, 0, sizeof(data));
+    ret = stse_data_storage_read_data_zone(&test_handler, TEST_DATA_ZONE, 0, data, TEST_ZONE_SIZE, 0, STSE_NO_PROT);
+    test_corruption = TEST_NO_CORRUPTION;
+    if (ret == STSE_OK) {
+        STSE_TEST_CHECK(memcmp(data, test_zone, TEST_ZONE_SIZE) == 0);
+    }
+
+    return ret;
+}
+
+int main(void) {
+    PLAT_UI8 i;
+
+    for (i = 0; i < TEST_ZONE_SIZE; i++) {
+        test_zone[i] = (PLAT_UI8)(0xC3 ^ (i * 9U));
+    }
+    STSE_TEST_CHECK_RET(stse_platform_crypto_init(), STSE_OK);
+
+    STSE_TEST_CHECK_RET(stse_simulator_init(&test_sim, STSAFE_A120), STSE_OK);
+    stse_simulator_set_zone(&test_sim, TEST_DATA_ZONE, 0, STSE_AC_ALWAYS, STSE_AC_ALWAYS, test_zone, TEST_ZONE_SIZE, 0);
+
+    stse_set_default_handler_value(&test_handler);
+    test_handler.device_type = STSAFE_A120;
+    STSE_TEST_CHECK_RET(stse_simulator_attach(&test_sim, &test_handler), STSE_OK);
+
+    /* - Element by element bus transfers through corrupting receive callbacks */
+    test_handler.io.BusSendV = NULL;
+    test_handler.io.BusRecvV = NULL;
+    test_sim_recv_continue = test_handler.io.BusRecvContinue;
+    test_sim_recv_stop = test_handler.io.BusRecvStop;
+    test_handler.io.BusRecvContinue = test_recv_continue;
+    test_handler.io.BusRecvStop = test_recv_stop;
+    STSE_TEST_CHECK_RET(stse_init(&test_handler), STSE_OK);
+
+    STSE_TEST_CHECK_RET(test_read(TEST_NO_CORRUPTION), STSE_OK);
+    STSE_TEST_CHECK_RET(test_read(TEST_CORRUPT_CRC), STSE_SERVICE_FRAME_CRC_ERROR);
+    STSE_TEST_CHECK_RET(test_read(TEST_NO_CORRUPTION), STSE_OK);
+    STSE_TEST_CHECK_RET(test_read(TEST_CORRUPT_PAYLOAD), STSE_SERVICE_FRAME_CRC_ERROR);
+    STSE_TEST_CHECK_RET(test_read(TEST_NO_CORRUPTION), STSE_OK);
+
+    /* - Command frames (CRC computed while sending) are accepted by the simulated device */
+    STSE_TEST_CHECK(test_sim.statistics.error_count == 0);
+
+    stse_simulator_detach(&test_sim);
+
+    return stse_test_report("test_rsp_crc_error");
+}
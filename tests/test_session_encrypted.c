@@ -0,0 +1,181 @@
+/*!
+ * ******************************************************************************
+ * \file	test_session_encrypted.c
+ * \brief   Host session encrypted transfer test against the STSAFE-A device simulator
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details Commands are exchanged in plaintext , then with C-MAC/R-MAC and encrypted command and response payloads.
+ *          Generate signature response elements share a length buffer (response staged before decryption) while
+ *          the other responses are decrypted in place. Command and response payloads of every padding length go
+ *          through the single-pass encrypt-and-MAC / MAC-and-decrypt pipeline. Each encrypted result is checked
+ *          against the plaintext one and the host session must stay synchronized with the device from one command
+ *          to the next.
+ */
+
+#include <string.h>
+
+#include "stselib.h"
+#include "tools/stse_simulator.h"
+#include "stse_test.h"
+
+#define TEST_PRIVATE_KEY_SLOT 0U
+#define TEST_SYMMETRIC_KEY_SLOT 0U
+#define TEST_DATA_ZONE 1U
+#define TEST_ZONE_SIZE 200U
+#define TEST_DIGEST_SIZE 32U
+#define TEST_GCM_IV_SIZE 12U
+#define TEST_GCM_AAD_SIZE 16U
+#define TEST_GCM_TAG_SIZE 16U
+#define TEST_GCM_MAX_MESSAGE_SIZE 100U
+#define TEST_PADDING_LENGTH_COUNT 33U
+
+static const PLAT_UI8 test_protected_cmd[][2] = {
+    {STSAFEA_CMD_GENERATE_RANDOM, 0},
+    {STSAFEA_CMD_READ, 0},
+    {STSAFEA_CMD_GENERATE_SIGNATURE, 0},
+    {STSAFEA_CMD_ENCRYPT, 0},
+};
+
+static stse_simulator_t test_sim;
+static stse_Handler_t test_handler;
+static stse_session_t test_session;
+static PLAT_UI8 test_host_MAC_key[STSE_AES_128_KEY_SIZE];
+static PLAT_UI8 test_host_cipher_key[STSE_AES_128_KEY_SIZE];
+static PLAT_UI8 test_symmetric_key[STSE_AES_128_KEY_SIZE];
+static PLAT_UI8 test_private_key[TEST_DIGEST_SIZE];
+static PLAT_UI8 test_public_key[2U * TEST_DIGEST_SIZE];
+static PLAT_UI8 test_zone[TEST_ZONE_SIZE];
+static PLAT_UI8 test_message[TEST_ZONE_SIZE];
+static PLAT_UI8 test_padding_reference[TEST_PADDING_LENGTH_COUNT][TEST_PADDING_LENGTH_COUNT];
+static PLAT_UI8 test_padding_reference_tag[TEST_PADDING_LENGTH_COUNT][TEST_GCM_TAG_SIZE];
+
+static void test_protection_set(PLAT_UI8 protected_mode) {
+    PLAT_UI8 i;
+
+    for (i = 0; i < (sizeof(test_protected_cmd) / sizeof(test_protected_cmd[0])); i++) {
+        stse_simulator_set_cmd_protection(&test_sim, test_protected_cmd[i][0], test_protected_cmd[i][1],
+                                          (protected_mode != 0) ? STSE_CMD_AC_HOST : STSE_CMD_AC_FREE,
+                                          protected_mode, protected_mode);
+    }
+
+    /* - Reload the command authorization configuration from the simulated device */
+    STSE_TEST_CHECK_RET(stse_init(&test_handler), STSE_OK);
+    if (protected_mode != 0) {
+        STSE_TEST_CHECK_RET(stsafea_open_host_session(&test_handler, &test_session,
+                                                      test_host_MAC_key, test_host_cipher_key),
+                            STSE_OK);
+    }
+}
+
+static void test_gcm(PLAT_UI16 message_length, PLAT_UI8 *pEncrypted, PLAT_UI8 *pTag) {
+    STSE_TEST_CHECK_RET(stse_aes_gcm_encrypt(&test_handler, TEST_SYMMETRIC_KEY_SLOT, TEST_GCM_TAG_SIZE,
+                                             TEST_GCM_IV_SIZE, test_message,
+                                             TEST_GCM_AAD_SIZE, &test_message[TEST_GCM_IV_SIZE],
+                                             message_length, &test_message[TEST_DIGEST_SIZE],
+                                             pEncrypted, pTag),
+                        STSE_OK);
+}
+
+int main(void) {
+    PLAT_UI8 signature[2U * TEST_DIGEST_SIZE];
+    PLAT_UI8 data[TEST_ZONE_SIZE];
+    PLAT_UI8 random[TEST_DIGEST_SIZE];
+    PLAT_UI8 reference[TEST_GCM_MAX_MESSAGE_SIZE];
+    PLAT_UI8 reference_tag[TEST_GCM_TAG_SIZE];
+    PLAT_UI8 encrypted[TEST_GCM_MAX_MESSAGE_SIZE];
+    PLAT_UI8 tag[TEST_GCM_TAG_SIZE];
+    PLAT_UI16 message_length;
+    PLAT_UI16 i;
+    PLAT_UI32 error_count;
+
+    for (i = 0; i < TEST_ZONE_SIZE; i++) {
+        test_zone[i] = (PLAT_UI8)(0xA5 ^ i);
+        test_message[i] = (PLAT_UI8)(i * 3U);
+    }
+    for (i = 0; i < STSE_AES_128_KEY_SIZE; i++) {
+        test_host_MAC_key[i] = (PLAT_UI8)(0x10 + i);
+        test_host_cipher_key[i] = (PLAT_UI8)(0x20 + i);
+        test_symmetric_key[i] = (PLAT_UI8)(0x30 + i);
+    }
+    STSE_TEST_CHECK_RET(stse_platform_crypto_init(), STSE_OK);
+    STSE_TEST_CHECK_RET(stse_platform_ecc_generate_key_pair(STSE_ECC_KT_NIST_P_256, test_private_key, test_public_key), STSE_OK);
+
+    /* - Simulated device provisioning */
+    STSE_TEST_CHECK_RET(stse_simulator_init(&test_sim, STSAFE_A120), STSE_OK);
+    stse_simulator_set_host_keys(&test_sim, STSE_AES_128_KT, test_host_MAC_key, test_host_cipher_key, 0);
+    stse_simulator_set_private_key(&test_sim, TEST_PRIVATE_KEY_SLOT, STSE_ECC_KT_NIST_P_256, test_private_key);
+    stse_simulator_set_symmetric_key(&test_sim, TEST_SYMMETRIC_KEY_SLOT, STSE_AES_128_KT, test_symmetric_key, TEST_GCM_TAG_SIZE);
+    stse_simulator_set_zone(&test_sim, TEST_DATA_ZONE, 0, STSE_AC_ALWAYS, STSE_AC_ALWAYS, test_zone, TEST_ZONE_SIZE, 0);
+
+    stse_set_default_handler_value(&test_handler);
+    test_handler.device_type = STSAFE_A120;
+    STSE_TEST_CHECK_RET(stse_simulator_attach(&test_sim, &test_handler), STSE_OK);
+#ifdef STSE_USE_INCREMENTAL_CRC
+    /* - Element by element bus transfers (frame CRCs computed during the element transfers) */
+    test_handler.io.BusSendV = NULL;
+    test_handler.io.BusRecvV = NULL;
+#endif /* STSE_USE_INCREMENTAL_CRC */
+
+    /* - Plaintext references */
+    test_protection_set(0);
+    test_gcm(TEST_GCM_MAX_MESSAGE_SIZE, reference, reference_tag);
+    for (message_length = 1; message_length <= TEST_PADDING_LENGTH_COUNT; message_length++) {
+        test_gcm(message_length, test_padding_reference[message_length - 1U], test_padding_reference_tag[message_length - 1U]);
+    }
+
+    /* - Encrypted responses : signature (staged) followed by commands decrypted in place */
+    test_protection_set(1);
+    error_count = test_sim.statistics.error_count;
+    for (i = 0; i < 4U; i++) {
+        memset(signature, 0, sizeof(signature));
+        STSE_TEST_CHECK_RET(stse_ecc_generate_signature(&test_handler, TEST_PRIVATE_KEY_SLOT, STSE_ECC_KT_NIST_P_256,
+                                                        test_message, TEST_DIGEST_SIZE, signature),
+                            STSE_OK);
+        STSE_TEST_CHECK_RET(stse_platform_ecc_verify(STSE_ECC_KT_NIST_P_256, test_public_key,
+                                                     test_message, TEST_DIGEST_SIZE, signature),
+                            STSE_OK);
+
+        memset(encrypted, 0, sizeof(encrypted));
+        memset(tag, 0, sizeof(tag));
+        test_gcm(TEST_GCM_MAX_MESSAGE_SIZE, encrypted, tag);
+        STSE_TEST_CHECK(memcmp(encrypted, reference, TEST_GCM_MAX_MESSAGE_SIZE) == 0);
+        STSE_TEST_CHECK(memcmp(tag, reference_tag, TEST_GCM_TAG_SIZE) == 0);
+
+        STSE_TEST_CHECK_RET(stse_generate_random(&test_handler, random, sizeof(random)), STSE_OK);
+    }
+
+    /* - Encrypted commands of all padding lengths */
+    for (message_length = 1; message_length <= TEST_PADDING_LENGTH_COUNT; message_length++) {
+        memset(encrypted, 0, sizeof(encrypted));
+        memset(tag, 0, sizeof(tag));
+        test_gcm(message_length, encrypted, tag);
+        STSE_TEST_CHECK(memcmp(encrypted, test_padding_reference[message_length - 1U], message_length) == 0);
+        STSE_TEST_CHECK(memcmp(tag, test_padding_reference_tag[message_length - 1U], TEST_GCM_TAG_SIZE) == 0);
+    }
+
+    /* - Encrypted responses of all padding lengths */
+    for (message_length = 1; message_length <= TEST_PADDING_LENGTH_COUNT; message_length++) {
+        memset(data, 0, sizeof(data));
+        STSE_TEST_CHECK_RET(stse_data_storage_read_data_zone(&test_handler, TEST_DATA_ZONE, message_length, data,
+                                                             message_length, 0, STSE_NO_PROT),
+                            STSE_OK);
+        STSE_TEST_CHECK(memcmp(data, &test_zone[message_length], message_length) == 0);
+    }
+    STSE_TEST_CHECK(test_sim.statistics.error_count == error_count);
+    STSE_TEST_CHECK(test_session.context.host.MAC_counter == test_sim.host_MAC_counter);
+
+    stsafea_close_host_session(&test_session);
+    stse_simulator_detach(&test_sim);
+
+    return stse_test_report("test_session_encrypted");
+}
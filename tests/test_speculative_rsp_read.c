@@ -0,0 +1,130 @@
+/*!
+ * ******************************************************************************
+ * \file	test_speculative_rsp_read.c
+ * \brief   Speculative response read test against the STSAFE-A device simulator
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details Responses are read over vectored and element by element bus receive callbacks :
+ *          - a response of the expected length must be received in a single bus transaction
+ *          - a response longer than the expected one must fall back to a response length probe followed by the
+ *            frame read , the expected bytes being received unaltered
+ *          - a response frame whose elements share a buffer (generate signature) must not be read speculatively
+ *          The number of response bus transactions is counted by the simulated device.
+ */
+
+#include <string.h>
+
+#include "stselib.h"
+#include "tools/stse_simulator.h"
+#include "stse_test.h"
+
+#if !defined(STSE_USE_SPECULATIVE_RSP_READ)
+#error "test_speculative_rsp_read requires STSE_USE_SPECULATIVE_RSP_READ"
+#endif
+
+#define TEST_PRIVATE_KEY_SLOT 0U
+#define TEST_DATA_ZONE 1U
+#define TEST_ZONE_SIZE 64U
+#define TEST_READ_LENGTH 32U
+#define TEST_SHORT_READ_LENGTH 16U
+#define TEST_DIGEST_SIZE 32U
+
+static stse_simulator_t test_sim;
+static stse_Handler_t test_handler;
+static PLAT_UI8 test_zone[TEST_ZONE_SIZE];
+static PLAT_UI8 test_private_key[TEST_DIGEST_SIZE];
+static PLAT_UI8 test_public_key[2U * TEST_DIGEST_SIZE];
+static PLAT_UI8 test_digest[TEST_DIGEST_SIZE];
+
+/* - Read command of TEST_READ_LENGTH bytes received in a response frame of expected_length data bytes */
+static stse_ReturnCode_t test_read(PLAT_UI8 *pData, PLAT_UI16 expected_length) {
+    PLAT_UI8 cmd_header = STSAFEA_CMD_READ;
+    PLAT_UI8 cmd_payload[] = {0x00, TEST_DATA_ZONE, 0x00, 0x00, 0x00, TEST_READ_LENGTH};
+    PLAT_UI8 rsp_header;
+
+    stse_frame_allocate(CmdFrame);
+    stse_frame_element_allocate_push(&CmdFrame, eCmdHeader, STSAFEA_HEADER_SIZE, &cmd_header);
+    stse_frame_element_allocate_push(&CmdFrame, eCmdPayload, sizeof(cmd_payload), cmd_payload);
+
+    stse_frame_allocate(RspFrame);
+    stse_frame_element_allocate_push(&RspFrame, eRsp_header, STSAFEA_HEADER_SIZE, &rsp_header);
+    stse_frame_element_allocate_push(&RspFrame, eData, expected_length, pData);
+
+    return stsafea_frame_transfer(&test_handler, &CmdFrame, &RspFrame);
+}
+
+static void test_run(void) {
+    PLAT_UI8 data[TEST_READ_LENGTH];
+    PLAT_UI8 signature[2U * TEST_DIGEST_SIZE];
+    PLAT_UI32 receive_count;
+
+    /* - Response of the expected length : single bus transaction */
+    memset(data, 0, sizeof(data));
+    receive_count = test_sim.statistics.receive_count;
+    STSE_TEST_CHECK_RET(test_read(data, TEST_READ_LENGTH), STSE_OK);
+    STSE_TEST_CHECK(test_sim.statistics.receive_count - receive_count == 1U);
+    STSE_TEST_CHECK(memcmp(data, test_zone, TEST_READ_LENGTH) == 0);
+
+    /* - Response longer than expected : length probe then frame read */
+    memset(data, 0, sizeof(data));
+    receive_count = test_sim.statistics.receive_count;
+    STSE_TEST_CHECK_RET(test_read(data, TEST_SHORT_READ_LENGTH), STSE_OK);
+    STSE_TEST_CHECK(test_sim.statistics.receive_count - receive_count == 3U);
+    STSE_TEST_CHECK(memcmp(data, test_zone, TEST_SHORT_READ_LENGTH) == 0);
+    STSE_TEST_CHECK(data[TEST_SHORT_READ_LENGTH] == 0);
+
+    /* - Response elements sharing a buffer : no speculative read */
+    memset(signature, 0, sizeof(signature));
+    receive_count = test_sim.statistics.receive_count;
+    STSE_TEST_CHECK_RET(stse_ecc_generate_signature(&test_handler, TEST_PRIVATE_KEY_SLOT, STSE_ECC_KT_NIST_P_256,
+                                                    test_digest, TEST_DIGEST_SIZE, signature),
+                        STSE_OK);
+    STSE_TEST_CHECK(test_sim.statistics.receive_count - receive_count == 2U);
+    STSE_TEST_CHECK_RET(stse_platform_ecc_verify(STSE_ECC_KT_NIST_P_256, test_public_key,
+                                                 test_digest, TEST_DIGEST_SIZE, signature),
+                        STSE_OK);
+}
+
+int main(void) {
+    PLAT_UI8 i;
+
+    for (i = 0; i < TEST_ZONE_SIZE; i++) {
+        test_zone[i] = (PLAT_UI8)(0x5A ^ (i * 3U));
+    }
+    for (i = 0; i < TEST_DIGEST_SIZE; i++) {
+        test_digest[i] = (PLAT_UI8)(i + 1U);
+    }
+    STSE_TEST_CHECK_RET(stse_platform_crypto_init(), STSE_OK);
+    STSE_TEST_CHECK_RET(stse_platform_ecc_generate_key_pair(STSE_ECC_KT_NIST_P_256, test_private_key, test_public_key), STSE_OK);
+
+    STSE_TEST_CHECK_RET(stse_simulator_init(&test_sim, STSAFE_A120), STSE_OK);
+    stse_simulator_set_private_key(&test_sim, TEST_PRIVATE_KEY_SLOT, STSE_ECC_KT_NIST_P_256, test_private_key);
+    stse_simulator_set_zone(&test_sim, TEST_DATA_ZONE, 0, STSE_AC_ALWAYS, STSE_AC_ALWAYS, test_zone, TEST_ZONE_SIZE, 0);
+
+    stse_set_default_handler_value(&test_handler);
+    test_handler.device_type = STSAFE_A120;
+    STSE_TEST_CHECK_RET(stse_simulator_attach(&test_sim, &test_handler), STSE_OK);
+    STSE_TEST_CHECK_RET(stse_init(&test_handler), STSE_OK);
+
+    /* - Vectored bus receive */
+    test_run();
+
+    /* - Element by element bus receive */
+    test_handler.io.BusRecvV = NULL;
+    test_run();
+
+    STSE_TEST_CHECK(test_sim.statistics.error_count == 0);
+    stse_simulator_detach(&test_sim);
+
+    return stse_test_report("test_speculative_rsp_read");
+}
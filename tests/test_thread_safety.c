@@ -0,0 +1,214 @@
+/*!
+ * ******************************************************************************
+ * \file	test_thread_safety.c
+ * \brief   Multi-thread host session stress test against the STSAFE-A device simulator
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details Several simulated devices (one bus each) are driven concurrently with protected and encrypted commands ,
+ *          two of them being shared by a second thread. Handler device and bus locks are POSIX mutexes. Frame CRC ,
+ *          C-MAC / R-MAC contexts and session MAC counters must stay consistent : every command result is checked
+ *          and each host session must be synchronized with its device at the end of the run.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <pthread.h>
+#include <string.h>
+
+#include "stselib.h"
+#include "tools/stse_simulator.h"
+#include "stse_test.h"
+
+#if !defined(STSE_CONF_USE_THREAD_SAFETY) || !defined(STSE_CONF_USE_HOST_SESSION)
+#error "test_thread_safety requires STSE_CONF_USE_THREAD_SAFETY and STSE_CONF_USE_HOST_SESSION"
+#endif
+
+#define TEST_DEVICE_COUNT 4U
+#define TEST_SHARED_DEVICE_COUNT 2U
+#define TEST_THREAD_COUNT (TEST_DEVICE_COUNT + TEST_SHARED_DEVICE_COUNT)
+#define TEST_ITERATIONS 150U
+#define TEST_SYMMETRIC_KEY_SLOT 0U
+#define TEST_DATA_ZONE 1U
+#define TEST_ZONE_SIZE 128U
+#define TEST_READ_MAX_LENGTH 48U
+#define TEST_RANDOM_SIZE 32U
+#define TEST_GCM_IV_SIZE 12U
+#define TEST_GCM_AAD_SIZE 16U
+#define TEST_GCM_TAG_SIZE 16U
+#define TEST_GCM_MESSAGE_SIZE 64U
+
+static const PLAT_UI8 test_protected_cmd[][2] = {
+    {STSAFEA_CMD_GENERATE_RANDOM, 0},
+    {STSAFEA_CMD_READ, 0},
+    {STSAFEA_CMD_ENCRYPT, 0},
+};
+
+typedef struct {
+    stse_Handler_t *pHandler;
+    PLAT_UI32 failures;
+} test_thread_t;
+
+static stse_simulator_t test_sim[TEST_DEVICE_COUNT];
+static stse_Handler_t test_handler[TEST_DEVICE_COUNT];
+static stse_session_t test_session[TEST_DEVICE_COUNT];
+static pthread_mutex_t test_device_mutex[TEST_DEVICE_COUNT];
+static pthread_mutex_t test_bus_mutex[TEST_DEVICE_COUNT];
+static PLAT_UI8 test_host_MAC_key[STSE_AES_128_KEY_SIZE];
+static PLAT_UI8 test_host_cipher_key[STSE_AES_128_KEY_SIZE];
+static PLAT_UI8 test_symmetric_key[STSE_AES_128_KEY_SIZE];
+static PLAT_UI8 test_zone[TEST_ZONE_SIZE];
+static PLAT_UI8 test_message[TEST_GCM_IV_SIZE + TEST_GCM_AAD_SIZE + TEST_GCM_MESSAGE_SIZE];
+static PLAT_UI8 test_reference[TEST_GCM_MESSAGE_SIZE];
+static PLAT_UI8 test_reference_tag[TEST_GCM_TAG_SIZE];
+
+/* Handler lock callbacks (bus index = device index) --------------------------*/
+
+static stse_ReturnCode_t test_device_lock(PLAT_UI8 busID, PLAT_UI8 devAddr) {
+    (void)devAddr;
+    return (pthread_mutex_lock(&test_device_mutex[busID]) == 0) ? STSE_OK : STSE_PLATFORM_BUS_ERR;
+}
+
+static stse_ReturnCode_t test_device_unlock(PLAT_UI8 busID, PLAT_UI8 devAddr) {
+    (void)devAddr;
+    return (pthread_mutex_unlock(&test_device_mutex[busID]) == 0) ? STSE_OK : STSE_PLATFORM_BUS_ERR;
+}
+
+static stse_ReturnCode_t test_bus_lock(PLAT_UI8 busID) {
+    return (pthread_mutex_lock(&test_bus_mutex[busID]) == 0) ? STSE_OK : STSE_PLATFORM_BUS_ERR;
+}
+
+static stse_ReturnCode_t test_bus_unlock(PLAT_UI8 busID) {
+    return (pthread_mutex_unlock(&test_bus_mutex[busID]) == 0) ? STSE_OK : STSE_PLATFORM_BUS_ERR;
+}
+
+static stse_ReturnCode_t test_gcm(stse_Handler_t *pHandler, PLAT_UI8 *pEncrypted, PLAT_UI8 *pTag) {
+    return stse_aes_gcm_encrypt(pHandler, TEST_SYMMETRIC_KEY_SLOT, TEST_GCM_TAG_SIZE,
+                                TEST_GCM_IV_SIZE, test_message,
+                                TEST_GCM_AAD_SIZE, &test_message[TEST_GCM_IV_SIZE],
+                                TEST_GCM_MESSAGE_SIZE, &test_message[TEST_GCM_IV_SIZE + TEST_GCM_AAD_SIZE],
+                                pEncrypted, pTag);
+}
+
+static void *test_thread_run(void *pArg) {
+    test_thread_t *pThread = (test_thread_t *)pArg;
+    PLAT_UI8 data[TEST_READ_MAX_LENGTH];
+    PLAT_UI8 random[TEST_RANDOM_SIZE];
+    PLAT_UI8 encrypted[TEST_GCM_MESSAGE_SIZE];
+    PLAT_UI8 tag[TEST_GCM_TAG_SIZE];
+    PLAT_UI16 offset;
+    PLAT_UI16 length;
+    PLAT_UI16 i;
+
+    for (i = 0; i < TEST_ITERATIONS; i++) {
+        /* - Encrypted response , in place decryption of every padding length */
+        offset = (PLAT_UI16)(i % (TEST_ZONE_SIZE - TEST_READ_MAX_LENGTH));
+        length = (PLAT_UI16)(1U + (i % TEST_READ_MAX_LENGTH));
+        memset(data, 0, sizeof(data));
+        if ((stse_data_storage_read_data_zone(pThread->pHandler, TEST_DATA_ZONE, offset, data, length, 0, STSE_NO_PROT) != STSE_OK) ||
+            (memcmp(data, &test_zone[offset], length) != 0)) {
+            pThread->failures++;
+        }
+
+        /* - Encrypted command and response */
+        memset(encrypted, 0, sizeof(encrypted));
+        memset(tag, 0, sizeof(tag));
+        if ((test_gcm(pThread->pHandler, encrypted, tag) != STSE_OK) ||
+            (memcmp(encrypted, test_reference, TEST_GCM_MESSAGE_SIZE) != 0) ||
+            (memcmp(tag, test_reference_tag, TEST_GCM_TAG_SIZE) != 0)) {
+            pThread->failures++;
+        }
+
+        if (stse_generate_random(pThread->pHandler, random, sizeof(random)) != STSE_OK) {
+            pThread->failures++;
+        }
+    }
+
+    return NULL;
+}
+
+int main(void) {
+    pthread_t thread_id[TEST_THREAD_COUNT];
+    test_thread_t thread[TEST_THREAD_COUNT];
+    PLAT_UI32 error_count[TEST_DEVICE_COUNT];
+    PLAT_UI8 i;
+    PLAT_UI8 j;
+
+    for (i = 0; i < TEST_ZONE_SIZE; i++) {
+        test_zone[i] = (PLAT_UI8)(0x5A ^ (i * 7U));
+    }
+    for (i = 0; i < sizeof(test_message); i++) {
+        test_message[i] = (PLAT_UI8)(i * 3U);
+    }
+    for (i = 0; i < STSE_AES_128_KEY_SIZE; i++) {
+        test_host_MAC_key[i] = (PLAT_UI8)(0x10 + i);
+        test_host_cipher_key[i] = (PLAT_UI8)(0x20 + i);
+        test_symmetric_key[i] = (PLAT_UI8)(0x30 + i);
+    }
+    STSE_TEST_CHECK_RET(stse_platform_crypto_init(), STSE_OK);
+
+    /* - Simulated devices (one bus each) with host session opened on all protected commands */
+    for (i = 0; i < TEST_DEVICE_COUNT; i++) {
+        STSE_TEST_CHECK(pthread_mutex_init(&test_device_mutex[i], NULL) == 0);
+        STSE_TEST_CHECK(pthread_mutex_init(&test_bus_mutex[i], NULL) == 0);
+
+        STSE_TEST_CHECK_RET(stse_simulator_init(&test_sim[i], STSAFE_A120), STSE_OK);
+        stse_simulator_set_host_keys(&test_sim[i], STSE_AES_128_KT, test_host_MAC_key, test_host_cipher_key, 0);
+        stse_simulator_set_symmetric_key(&test_sim[i], TEST_SYMMETRIC_KEY_SLOT, STSE_AES_128_KT, test_symmetric_key, TEST_GCM_TAG_SIZE);
+        stse_simulator_set_zone(&test_sim[i], TEST_DATA_ZONE, 0, STSE_AC_ALWAYS, STSE_AC_ALWAYS, test_zone, TEST_ZONE_SIZE, 0);
+        for (j = 0; j < (sizeof(test_protected_cmd) / sizeof(test_protected_cmd[0])); j++) {
+            stse_simulator_set_cmd_protection(&test_sim[i], test_protected_cmd[j][0], test_protected_cmd[j][1],
+                                              STSE_CMD_AC_HOST, 1, 1);
+        }
+
+        stse_set_default_handler_value(&test_handler[i]);
+        test_handler[i].device_type = STSAFE_A120;
+        test_handler[i].io.busID = i;
+        test_handler[i].io.DeviceLock = test_device_lock;
+        test_handler[i].io.DeviceUnlock = test_device_unlock;
+        test_handler[i].io.BusLock = test_bus_lock;
+        test_handler[i].io.BusUnlock = test_bus_unlock;
+        STSE_TEST_CHECK_RET(stse_simulator_attach(&test_sim[i], &test_handler[i]), STSE_OK);
+        STSE_TEST_CHECK_RET(stse_init(&test_handler[i]), STSE_OK);
+        STSE_TEST_CHECK_RET(stsafea_open_host_session(&test_handler[i], &test_session[i],
+                                                      test_host_MAC_key, test_host_cipher_key),
+                            STSE_OK);
+    }
+
+    /* - GCM reference (same symmetric key on all devices) */
+    STSE_TEST_CHECK_RET(test_gcm(&test_handler[0], test_reference, test_reference_tag), STSE_OK);
+    for (i = 0; i < TEST_DEVICE_COUNT; i++) {
+        error_count[i] = test_sim[i].statistics.error_count;
+    }
+
+    /* - One thread per device , first devices shared with a second thread */
+    for (i = 0; i < TEST_THREAD_COUNT; i++) {
+        thread[i].pHandler = &test_handler[i % TEST_DEVICE_COUNT];
+        thread[i].failures = 0;
+        STSE_TEST_CHECK(pthread_create(&thread_id[i], NULL, test_thread_run, &thread[i]) == 0);
+    }
+    for (i = 0; i < TEST_THREAD_COUNT; i++) {
+        STSE_TEST_CHECK(pthread_join(thread_id[i], NULL) == 0);
+        STSE_TEST_CHECK(thread[i].failures == 0);
+    }
+
+    for (i = 0; i < TEST_DEVICE_COUNT; i++) {
+        STSE_TEST_CHECK(test_sim[i].statistics.error_count == error_count[i]);
+        STSE_TEST_CHECK(test_session[i].context.host.MAC_counter == test_sim[i].host_MAC_counter);
+        stsafea_close_host_session(&test_session[i]);
+        stse_simulator_detach(&test_sim[i]);
+        pthread_mutex_destroy(&test_device_mutex[i]);
+        pthread_mutex_destroy(&test_bus_mutex[i]);
+    }
+
+    return stse_test_report("test_thread_safety");
+}
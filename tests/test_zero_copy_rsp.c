@@ -0,0 +1,138 @@
+/*!
+ * ******************************************************************************
+ * \file	test_zero_copy_rsp.c
+ * \brief   Zero-copy response view test against the STSAFE-A device simulator
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details Read data zone and generate signature views are requested on a simulated device lending its response
+ *          buffer through the io.BusRecvFrame callback : returned views must point into the simulator response
+ *          frame and hold the zone data and a valid signature. Views must be refused without any transfer when the
+ *          platform has no io.BusRecvFrame callback or when the command response is encrypted.
+ */
+
+#include <string.h>
+
+#include "stselib.h"
+#include "tools/stse_simulator.h"
+#include "stse_test.h"
+
+#if !defined(STSE_USE_ZERO_COPY_RSP)
+#error "test_zero_copy_rsp requires STSE_USE_ZERO_COPY_RSP"
+#endif
+
+#define TEST_PRIVATE_KEY_SLOT 0U
+#define TEST_DATA_ZONE 1U
+#define TEST_ZONE_SIZE 64U
+#define TEST_READ_OFFSET 5U
+#define TEST_READ_LENGTH 40U
+#define TEST_DIGEST_SIZE 32U
+#define TEST_RSP_PAYLOAD_OFFSET (STSE_RSP_FRAME_HEADER_SIZE + STSE_FRAME_LENGTH_SIZE)
+
+static stse_simulator_t test_sim;
+static stse_Handler_t test_handler;
+static PLAT_UI8 test_private_key[TEST_DIGEST_SIZE];
+static PLAT_UI8 test_public_key[2U * TEST_DIGEST_SIZE];
+static PLAT_UI8 test_zone[TEST_ZONE_SIZE];
+static PLAT_UI8 test_digest[TEST_DIGEST_SIZE];
+
+static stse_ReturnCode_t test_read_view(PLAT_UI8 **ppData) {
+    stsafea_read_option_t option;
+
+    memset(&option, 0, sizeof(option));
+    return stsafea_read_data_zone_view(&test_handler, TEST_DATA_ZONE, option, TEST_READ_OFFSET, ppData, TEST_READ_LENGTH,
+                                       STSE_NO_PROT);
+}
+
+static stse_ReturnCode_t test_signature_view(PLAT_UI8 **ppSignature_R, PLAT_UI8 **ppSignature_S) {
+    return stsafea_ecc_generate_signature_view(&test_handler, TEST_PRIVATE_KEY_SLOT, STSE_ECC_KT_NIST_P_256,
+                                               test_digest, TEST_DIGEST_SIZE, ppSignature_R, ppSignature_S);
+}
+
+/* - Views refused before any transfer */
+static void test_view_refused(void) {
+    PLAT_UI8 *pData = NULL;
+    PLAT_UI8 *pSignature_R = NULL;
+    PLAT_UI8 *pSignature_S = NULL;
+    PLAT_UI32 cmd_count = test_sim.statistics.cmd_count;
+
+    STSE_TEST_CHECK_RET(test_read_view(&pData), STSE_SERVICE_INVALID_PARAMETER);
+    STSE_TEST_CHECK_RET(test_signature_view(&pSignature_R, &pSignature_S), STSE_SERVICE_INVALID_PARAMETER);
+    STSE_TEST_CHECK((pData == NULL) && (pSignature_R == NULL) && (pSignature_S == NULL));
+    STSE_TEST_CHECK(test_sim.statistics.cmd_count == cmd_count);
+}
+
+int main(void) {
+    PLAT_UI8 *pData = NULL;
+    PLAT_UI8 *pSignature_R = NULL;
+    PLAT_UI8 *pSignature_S = NULL;
+    PLAT_UI8 signature[2U * TEST_DIGEST_SIZE];
+    stse_ReturnCode_t (*pBusRecvFrame)(PLAT_UI8, PLAT_UI8, PLAT_UI16, PLAT_UI16, PLAT_UI8 **);
+    PLAT_UI8 i;
+
+    for (i = 0; i < TEST_ZONE_SIZE; i++) {
+        test_zone[i] = (PLAT_UI8)(0x3C ^ (i * 5U));
+    }
+    for (i = 0; i < TEST_DIGEST_SIZE; i++) {
+        test_digest[i] = (PLAT_UI8)(0xF0 - i);
+    }
+    STSE_TEST_CHECK_RET(stse_platform_crypto_init(), STSE_OK);
+    STSE_TEST_CHECK_RET(stse_platform_ecc_generate_key_pair(STSE_ECC_KT_NIST_P_256, test_private_key, test_public_key), STSE_OK);
+
+    STSE_TEST_CHECK_RET(stse_simulator_init(&test_sim, STSAFE_A120), STSE_OK);
+    stse_simulator_set_private_key(&test_sim, TEST_PRIVATE_KEY_SLOT, STSE_ECC_KT_NIST_P_256, test_private_key);
+    stse_simulator_set_zone(&test_sim, TEST_DATA_ZONE, 0, STSE_AC_ALWAYS, STSE_AC_ALWAYS, test_zone, TEST_ZONE_SIZE, 0);
+
+    stse_set_default_handler_value(&test_handler);
+    test_handler.device_type = STSAFE_A120;
+    STSE_TEST_CHECK_RET(stse_simulator_attach(&test_sim, &test_handler), STSE_OK);
+    STSE_TEST_CHECK_RET(stse_init(&test_handler), STSE_OK);
+    pBusRecvFrame = test_handler.io.BusRecvFrame;
+    STSE_TEST_CHECK(pBusRecvFrame != NULL);
+
+    /* - Read data zone view : zone data in the simulator response frame */
+    STSE_TEST_CHECK_RET(test_read_view(&pData), STSE_OK);
+    STSE_TEST_CHECK(pData == &test_sim.rsp_buffer[TEST_RSP_PAYLOAD_OFFSET]);
+    STSE_TEST_CHECK((pData != NULL) && (memcmp(pData, &test_zone[TEST_READ_OFFSET], TEST_READ_LENGTH) == 0));
+
+    /* - Generate signature view : R and S components (each preceded by its length) in the simulator response frame */
+    STSE_TEST_CHECK_RET(test_signature_view(&pSignature_R, &pSignature_S), STSE_OK);
+    STSE_TEST_CHECK(pSignature_R == &test_sim.rsp_buffer[TEST_RSP_PAYLOAD_OFFSET + STSE_ECC_GENERIC_LENGTH_SIZE]);
+    STSE_TEST_CHECK(pSignature_S == (pSignature_R + TEST_DIGEST_SIZE + STSE_ECC_GENERIC_LENGTH_SIZE));
+    if ((pSignature_R != NULL) && (pSignature_S != NULL)) {
+        memcpy(signature, pSignature_R, TEST_DIGEST_SIZE);
+        memcpy(&signature[TEST_DIGEST_SIZE], pSignature_S, TEST_DIGEST_SIZE);
+        STSE_TEST_CHECK_RET(stse_platform_ecc_verify(STSE_ECC_KT_NIST_P_256, test_public_key,
+                                                     test_digest, TEST_DIGEST_SIZE, signature),
+                            STSE_OK);
+    }
+
+    /* - Platform without zero-copy receive */
+    test_handler.io.BusRecvFrame = NULL;
+    test_view_refused();
+    test_handler.io.BusRecvFrame = pBusRecvFrame;
+
+    /* - Encrypted responses : decrypted in caller buffers only */
+    stse_simulator_set_cmd_protection(&test_sim, STSAFEA_CMD_READ, 0, STSE_CMD_AC_FREE, 0, 1);
+    stse_simulator_set_cmd_protection(&test_sim, STSAFEA_CMD_GENERATE_SIGNATURE, 0, STSE_CMD_AC_FREE, 0, 1);
+    STSE_TEST_CHECK_RET(stse_init(&test_handler), STSE_OK);
+    test_view_refused();
+
+    /* - Invalid parameters */
+    STSE_TEST_CHECK_RET(test_read_view(NULL), STSE_SERVICE_INVALID_PARAMETER);
+    STSE_TEST_CHECK_RET(test_signature_view(NULL, &pSignature_S), STSE_SERVICE_INVALID_PARAMETER);
+    STSE_TEST_CHECK(test_sim.statistics.error_count == 0);
+
+    stse_simulator_detach(&test_sim);
+
+    return stse_test_report("test_zero_copy_rsp");
+}
@@ -0,0 +1,144 @@
+/*!
+ * ******************************************************************************
+ * \file	stse_platform_host.c
+ * \brief   STSecureElement delay and bus platform file for simulator builds (sources)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details Delay and I2C platform functions of the host tools and tests driven against the STSAFE-A device
+ *          simulator (tools/stse_simulator.c). The simulator installs its own bus callbacks on the attached
+ *          handlers : the I2C functions below only report a bus error for handlers without simulated device.
+ *          Builds targeting a real bus use platform/linux/stse_platform_linux_i2c.c instead of this file.
+ */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <time.h>
+
+#include "tools/host/stse_platform_host.h"
+
+static PLAT_UI8 host_real_time;
+static PLAT_UI32 host_virtual_time_ms;
+static PLAT_UI32 host_delay_total_ms;
+
+static PLAT_UI64 stse_platform_host_monotonic_us(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((PLAT_UI64)now.tv_sec * 1000000U) + ((PLAT_UI64)now.tv_nsec / 1000U);
+}
+
+void stse_platform_host_set_real_time(PLAT_UI8 real_time) {
+    host_real_time = real_time;
+}
+
+PLAT_UI32 stse_platform_host_time_ms(void) {
+    if (host_real_time != 0U) {
+        return (PLAT_UI32)(stse_platform_host_monotonic_us() / 1000U);
+    }
+
+    return __atomic_load_n(&host_virtual_time_ms, __ATOMIC_RELAXED);
+}
+
+PLAT_UI32 stse_platform_host_delay_total(void) {
+    return __atomic_load_n(&host_delay_total_ms, __ATOMIC_RELAXED);
+}
+
+stse_ReturnCode_t stse_platform_delay_init(void) {
+    return STSE_OK;
+}
+
+void stse_platform_Delay_ms(PLAT_UI16 delay_val) {
+    struct timespec deadline;
+
+    (void)__atomic_add_fetch(&host_delay_total_ms, delay_val, __ATOMIC_RELAXED);
+
+    if (host_real_time == 0U) {
+        (void)__atomic_add_fetch(&host_virtual_time_ms, delay_val, __ATOMIC_RELAXED);
+        return;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += delay_val / 1000U;
+    deadline.tv_nsec += (long)(delay_val % 1000U) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR) {
+    }
+}
+
+#if defined(STSE_FRAME_TRACE) || defined(STSE_CMD_METRICS)
+PLAT_UI32 stse_platform_get_timestamp(void) {
+    if (host_real_time != 0U) {
+        return (PLAT_UI32)stse_platform_host_monotonic_us();
+    }
+
+    /* - Microsecond unit in both time bases */
+    return stse_platform_host_time_ms() * 1000U;
+}
+#endif /* STSE_FRAME_TRACE || STSE_CMD_METRICS */
+
+stse_ReturnCode_t stse_platform_i2c_init(PLAT_UI8 busID) {
+    (void)busID;
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_i2c_wake(PLAT_UI8 busID, PLAT_UI8 devAddr, PLAT_UI16 speed) {
+    (void)busID;
+    (void)devAddr;
+    (void)speed;
+
+    return STSE_PLATFORM_BUS_ERR;
+}
+
+stse_ReturnCode_t stse_platform_i2c_send_start(PLAT_UI8 busID, PLAT_UI8 devAddr, PLAT_UI16 speed, PLAT_UI16 FrameLength) {
+    (void)busID;
+    (void)devAddr;
+    (void)speed;
+    (void)FrameLength;
+
+    return STSE_PLATFORM_BUS_ERR;
+}
+
+stse_ReturnCode_t stse_platform_i2c_send_continue(PLAT_UI8 busID, PLAT_UI8 devAddr, PLAT_UI16 speed,
+                                                  PLAT_UI8 *pData, PLAT_UI16 data_size) {
+    (void)busID;
+    (void)devAddr;
+    (void)speed;
+    (void)pData;
+    (void)data_size;
+
+    return STSE_PLATFORM_BUS_ERR;
+}
+
+stse_ReturnCode_t stse_platform_i2c_send_stop(PLAT_UI8 busID, PLAT_UI8 devAddr, PLAT_UI16 speed,
+                                              PLAT_UI8 *pData, PLAT_UI16 data_size) {
+    return stse_platform_i2c_send_continue(busID, devAddr, speed, pData, data_size);
+}
+
+stse_ReturnCode_t stse_platform_i2c_receive_start(PLAT_UI8 busID, PLAT_UI8 devAddr, PLAT_UI16 speed, PLAT_UI16 frameLength) {
+    return stse_platform_i2c_send_start(busID, devAddr, speed, frameLength);
+}
+
+stse_ReturnCode_t stse_platform_i2c_receive_continue(PLAT_UI8 busID, PLAT_UI8 devAddr, PLAT_UI16 speed,
+                                                     PLAT_UI8 *pData, PLAT_UI16 data_size) {
+    return stse_platform_i2c_send_continue(busID, devAddr, speed, pData, data_size);
+}
+
+stse_ReturnCode_t stse_platform_i2c_receive_stop(PLAT_UI8 busID, PLAT_UI8 devAddr, PLAT_UI16 speed,
+                                                 PLAT_UI8 *pData, PLAT_UI16 data_size) {
+    return stse_platform_i2c_send_continue(busID, devAddr, speed, pData, data_size);
+}
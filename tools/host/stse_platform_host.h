@@ -0,0 +1,56 @@
+/*!
+ * ******************************************************************************
+ * \file	stse_platform_host.h
+ * \brief   STSecureElement host platform file for simulator builds (header)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef STSE_PLATFORM_HOST_H
+#define STSE_PLATFORM_HOST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "core/stse_platform.h"
+
+/* Exported functions --------------------------------------------------------*/
+
+/*!
+ * \brief      Select the host delay time base
+ * \details    In virtual time (default) \ref stse_platform_Delay_ms returns immediately and only advances the host
+ *             millisecond clock , so that simulated device latencies do not slow down the tests. In real time
+ *             the delays sleep on the host monotonic clock.
+ * \param[in]  real_time 0 : virtual time ; 1 : real time
+ */
+void stse_platform_host_set_real_time(PLAT_UI8 real_time);
+
+/*!
+ * \brief      Get the host millisecond clock (simulator pGet_time_ms time source)
+ * \return     Virtual or monotonic time in ms , according to \ref stse_platform_host_set_real_time
+ */
+PLAT_UI32 stse_platform_host_time_ms(void);
+
+/*!
+ * \brief      Get the cumulated delay requested through \ref stse_platform_Delay_ms
+ * \return     Cumulated delay in ms
+ */
+PLAT_UI32 stse_platform_host_delay_total(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STSE_PLATFORM_HOST_H */
@@ -0,0 +1,830 @@
+/*!
+ * ******************************************************************************
+ * \file	stse_platform_openssl.c
+ * \brief   STSecureElement cryptographic and random platform file for host builds using OpenSSL 3
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details Host implementation of the crypto , random and AES key handle platform functions on top of the
+ *          OpenSSL 3 EVP interface. Public keys are raw X||Y coordinates (raw key for X25519 / Ed25519) and
+ *          signatures are raw R||S values , as expected by the library.
+ */
+
+#include <string.h>
+
+#include <openssl/core_names.h>
+#include <openssl/ecdsa.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/kdf.h>
+#include <openssl/params.h>
+#include <openssl/rand.h>
+
+#include "core/stse_platform.h"
+
+#define STSE_OPENSSL_MAX_COORDINATE_SIZE 66U
+#define STSE_OPENSSL_MAX_DER_SIGNATURE_SIZE 160U
+#define STSE_OPENSSL_AES_BLOCK_SIZE 16U
+
+/* Private functions ---------------------------------------------------------*/
+
+static const char *stse_openssl_ecc_group_name(stse_ecc_key_type_t key_type) {
+    switch (key_type) {
+#ifdef STSE_CONF_ECC_NIST_P_256
+    case STSE_ECC_KT_NIST_P_256:
+        return "P-256";
+#endif
+#ifdef STSE_CONF_ECC_NIST_P_384
+    case STSE_ECC_KT_NIST_P_384:
+        return "P-384";
+#endif
+#ifdef STSE_CONF_ECC_NIST_P_521
+    case STSE_ECC_KT_NIST_P_521:
+        return "P-521";
+#endif
+#ifdef STSE_CONF_ECC_BRAINPOOL_P_256
+    case STSE_ECC_KT_BP_P_256:
+        return "brainpoolP256r1";
+#endif
+#ifdef STSE_CONF_ECC_BRAINPOOL_P_384
+    case STSE_ECC_KT_BP_P_384:
+        return "brainpoolP384r1";
+#endif
+#ifdef STSE_CONF_ECC_BRAINPOOL_P_512
+    case STSE_ECC_KT_BP_P_512:
+        return "brainpoolP512r1";
+#endif
+    default:
+        return NULL;
+    }
+}
+
+static int stse_openssl_ecc_raw_type(stse_ecc_key_type_t key_type) {
+    switch (key_type) {
+#ifdef STSE_CONF_ECC_CURVE_25519
+    case STSE_ECC_KT_CURVE25519:
+        return EVP_PKEY_X25519;
+#endif
+#ifdef STSE_CONF_ECC_EDWARD_25519
+    case STSE_ECC_KT_ED25519:
+        return EVP_PKEY_ED25519;
+#endif
+    default:
+        return EVP_PKEY_NONE;
+    }
+}
+
+static EVP_PKEY *stse_openssl_ecc_load_key(stse_ecc_key_type_t key_type,
+                                           const PLAT_UI8 *pPubKey,
+                                           const PLAT_UI8 *pPrivKey) {
+    const char *pGroup = stse_openssl_ecc_group_name(key_type);
+    int raw_type = stse_openssl_ecc_raw_type(key_type);
+    PLAT_UI16 key_size;
+    PLAT_UI8 point[1U + (2U * STSE_OPENSSL_MAX_COORDINATE_SIZE)];
+    OSSL_PARAM params[4];
+    OSSL_PARAM *pParam = params;
+    BIGNUM *pPriv = NULL;
+    PLAT_UI8 priv[STSE_OPENSSL_MAX_COORDINATE_SIZE];
+    EVP_PKEY_CTX *pCtx;
+    EVP_PKEY *pKey = NULL;
+
+    if (raw_type != EVP_PKEY_NONE) {
+        if (pPrivKey != NULL) {
+            return EVP_PKEY_new_raw_private_key(raw_type, NULL, pPrivKey, 32U);
+        }
+        return EVP_PKEY_new_raw_public_key(raw_type, NULL, pPubKey, 32U);
+    }
+    if (pGroup == NULL) {
+        return NULL;
+    }
+
+    key_size = stse_ecc_info_table[key_type].coordinate_or_key_size;
+    *pParam++ = OSSL_PARAM_construct_utf8_string(OSSL_PKEY_PARAM_GROUP_NAME, (char *)pGroup, 0);
+    if (pPubKey != NULL) {
+        point[0] = 0x04;
+        memcpy(&point[1], pPubKey, 2U * key_size);
+        *pParam++ = OSSL_PARAM_construct_octet_string(OSSL_PKEY_PARAM_PUB_KEY, point, 1U + (2U * key_size));
+    }
+    if (pPrivKey != NULL) {
+        /* - OSSL_PARAM integers are native endian */
+        pPriv = BN_bin2bn(pPrivKey, key_size, NULL);
+        if ((pPriv == NULL) || (BN_bn2nativepad(pPriv, priv, key_size) < 0)) {
+            BN_free(pPriv);
+            return NULL;
+        }
+        *pParam++ = OSSL_PARAM_construct_BN(OSSL_PKEY_PARAM_PRIV_KEY, priv, key_size);
+    }
+    *pParam = OSSL_PARAM_construct_end();
+
+    pCtx = EVP_PKEY_CTX_new_from_name(NULL, "EC", NULL);
+    if ((pCtx == NULL) ||
+        (EVP_PKEY_fromdata_init(pCtx) <= 0) ||
+        (EVP_PKEY_fromdata(pCtx, &pKey, (pPrivKey != NULL) ? EVP_PKEY_KEYPAIR : EVP_PKEY_PUBLIC_KEY, params) <= 0)) {
+        pKey = NULL;
+    }
+    EVP_PKEY_CTX_free(pCtx);
+    BN_clear_free(pPriv);
+    OPENSSL_cleanse(priv, sizeof(priv));
+
+    return pKey;
+}
+
+static const EVP_MD *stse_openssl_md(stse_hash_algorithm_t hash_algo) {
+    switch (hash_algo) {
+#ifdef STSE_CONF_HASH_SHA_1
+    case STSE_SHA_1:
+        return EVP_sha1();
+#endif
+#ifdef STSE_CONF_HASH_SHA_224
+    case STSE_SHA_224:
+        return EVP_sha224();
+#endif
+#ifdef STSE_CONF_HASH_SHA_256
+    case STSE_SHA_256:
+        return EVP_sha256();
+#endif
+#ifdef STSE_CONF_HASH_SHA_384
+    case STSE_SHA_384:
+        return EVP_sha384();
+#endif
+#ifdef STSE_CONF_HASH_SHA_512
+    case STSE_SHA_512:
+        return EVP_sha512();
+#endif
+#ifdef STSE_CONF_HASH_SHA_3_256
+    case STSE_SHA3_256:
+        return EVP_sha3_256();
+#endif
+#ifdef STSE_CONF_HASH_SHA_3_384
+    case STSE_SHA3_384:
+        return EVP_sha3_384();
+#endif
+#ifdef STSE_CONF_HASH_SHA_3_512
+    case STSE_SHA3_512:
+        return EVP_sha3_512();
+#endif
+    default:
+        return NULL;
+    }
+}
+
+static stse_ReturnCode_t stse_openssl_aes(const EVP_CIPHER *pCipher_128,
+                                          const EVP_CIPHER *pCipher_256,
+                                          int encrypt,
+                                          const PLAT_UI8 *pKey, PLAT_UI16 key_length,
+                                          const PLAT_UI8 *pInitial_value,
+                                          const PLAT_UI8 *pInput, PLAT_UI16 length,
+                                          PLAT_UI8 *pOutput, PLAT_UI16 *pOutput_length,
+                                          stse_ReturnCode_t error) {
+    EVP_CIPHER_CTX *pCtx;
+    int update_length = 0;
+    int final_length = 0;
+    int ok;
+
+    if ((key_length != STSE_AES_128_KEY_SIZE) && (key_length != STSE_AES_256_KEY_SIZE)) {
+        return STSE_PLATFORM_INVALID_PARAMETER;
+    }
+
+    pCtx = EVP_CIPHER_CTX_new();
+    if (pCtx == NULL) {
+        return error;
+    }
+    ok = (EVP_CipherInit_ex(pCtx, (key_length == STSE_AES_128_KEY_SIZE) ? pCipher_128 : pCipher_256,
+                            NULL, pKey, pInitial_value, encrypt) > 0) &&
+         (EVP_CIPHER_CTX_set_padding(pCtx, 0) > 0) &&
+         (EVP_CipherUpdate(pCtx, pOutput, &update_length, pInput, length) > 0) &&
+         (EVP_CipherFinal_ex(pCtx, pOutput + update_length, &final_length) > 0);
+    EVP_CIPHER_CTX_free(pCtx);
+
+    if (!ok) {
+        return error;
+    }
+    if (pOutput_length != NULL) {
+        *pOutput_length = (PLAT_UI16)(update_length + final_length);
+    }
+
+    return STSE_OK;
+}
+
+/* Public functions ----------------------------------------------------------*/
+
+stse_ReturnCode_t stse_platform_crypto_init(void) {
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_generate_random_init(void) {
+    return (RAND_status() == 1) ? STSE_OK : STSE_PLATFORM_SERVICES_INIT_ERROR;
+}
+
+PLAT_UI32 stse_platform_generate_random(void) {
+    PLAT_UI32 random = 0;
+
+    (void)RAND_bytes((unsigned char *)&random, sizeof(random));
+
+    return random;
+}
+
+stse_ReturnCode_t stse_platform_hash_compute(stse_hash_algorithm_t hash_algo,
+                                             PLAT_UI8 *pPayload, PLAT_UI16 payload_length,
+                                             PLAT_UI8 *pHash, PLAT_UI16 *hash_length) {
+    const EVP_MD *pMd = stse_openssl_md(hash_algo);
+    unsigned int length = 0;
+
+    if (pMd == NULL) {
+        return STSE_PLATFORM_INVALID_PARAMETER;
+    }
+    if (EVP_Digest(pPayload, payload_length, pHash, &length, pMd, NULL) <= 0) {
+        return STSE_PLATFORM_HASH_ERROR;
+    }
+    *hash_length = (PLAT_UI16)length;
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_aes_ecb_enc(const PLAT_UI8 *pPlaintext, PLAT_UI16 plaintext_length,
+                                            const PLAT_UI8 *pKey, PLAT_UI16 key_length,
+                                            PLAT_UI8 *pEncryptedtext, PLAT_UI16 *pEncryptedtext_length) {
+    return stse_openssl_aes(EVP_aes_128_ecb(), EVP_aes_256_ecb(), 1, pKey, key_length, NULL,
+                            pPlaintext, plaintext_length, pEncryptedtext, pEncryptedtext_length,
+                            STSE_PLATFORM_AES_ECB_ENCRYPT_ERROR);
+}
+
+stse_ReturnCode_t stse_platform_aes_cbc_enc(const PLAT_UI8 *pPlaintext, PLAT_UI16 plaintext_length,
+                                            PLAT_UI8 *pInitial_value, const PLAT_UI8 *pKey,
+                                            PLAT_UI16 key_length, PLAT_UI8 *pEncryptedtext,
+                                            PLAT_UI16 *pEncryptedtext_length) {
+    return stse_openssl_aes(EVP_aes_128_cbc(), EVP_aes_256_cbc(), 1, pKey, key_length, pInitial_value,
+                            pPlaintext, plaintext_length, pEncryptedtext, pEncryptedtext_length,
+                            STSE_PLATFORM_AES_CBC_ENCRYPT_ERROR);
+}
+
+stse_ReturnCode_t stse_platform_aes_cbc_dec(const PLAT_UI8 *pEncryptedtext, PLAT_UI16 encryptedtext_length,
+                                            PLAT_UI8 *pInitial_value, const PLAT_UI8 *pKey,
+                                            PLAT_UI16 key_length, PLAT_UI8 *pPlaintext,
+                                            PLAT_UI16 *pPlaintext_length) {
+    return stse_openssl_aes(EVP_aes_128_cbc(), EVP_aes_256_cbc(), 0, pKey, key_length, pInitial_value,
+                            pEncryptedtext, encryptedtext_length, pPlaintext, pPlaintext_length,
+                            STSE_PLATFORM_AES_CBC_DECRYPT_ERROR);
+}
+
+#if defined(STSE_CONF_USE_HOST_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_HOST_SESSION)
+
+/* - Layout of the caller owned stse_platform_aes_cmac_ctx_t storage */
+typedef struct {
+    EVP_MAC_CTX *pMac_ctx;
+    PLAT_UI16 tag_size;
+} stse_openssl_cmac_ctx_t;
+
+static EVP_MAC_CTX *stse_openssl_cmac_new(const PLAT_UI8 *pKey, PLAT_UI16 key_length) {
+    EVP_MAC *pMac;
+    EVP_MAC_CTX *pMac_ctx;
+    OSSL_PARAM params[2];
+
+    if ((key_length != STSE_AES_128_KEY_SIZE) && (key_length != STSE_AES_256_KEY_SIZE)) {
+        return NULL;
+    }
+
+    pMac = EVP_MAC_fetch(NULL, "CMAC", NULL);
+    if (pMac == NULL) {
+        return NULL;
+    }
+    pMac_ctx = EVP_MAC_CTX_new(pMac);
+    EVP_MAC_free(pMac);
+    if (pMac_ctx == NULL) {
+        return NULL;
+    }
+
+    params[0] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_CIPHER,
+                                                 (key_length == STSE_AES_128_KEY_SIZE) ? "AES-128-CBC" : "AES-256-CBC", 0);
+    params[1] = OSSL_PARAM_construct_end();
+    if (EVP_MAC_init(pMac_ctx, pKey, key_length, params) <= 0) {
+        EVP_MAC_CTX_free(pMac_ctx);
+        return NULL;
+    }
+
+    return pMac_ctx;
+}
+
+static stse_ReturnCode_t stse_openssl_cmac_final(stse_platform_aes_cmac_ctx_t *pCtx, PLAT_UI8 *pTag) {
+    stse_openssl_cmac_ctx_t *pCmac = (stse_openssl_cmac_ctx_t *)pCtx;
+    size_t length = 0;
+    int ok;
+
+    ok = EVP_MAC_final(pCmac->pMac_ctx, pTag, &length, STSE_OPENSSL_AES_BLOCK_SIZE) > 0;
+    EVP_MAC_CTX_free(pCmac->pMac_ctx);
+    pCmac->pMac_ctx = NULL;
+
+    return ok ? STSE_OK : STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
+}
+
+static stse_ReturnCode_t stse_openssl_cmac_init(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                const PLAT_UI8 *pKey,
+                                                PLAT_UI16 key_length,
+                                                PLAT_UI16 exp_tag_size) {
+    stse_openssl_cmac_ctx_t *pCmac = (stse_openssl_cmac_ctx_t *)pCtx;
+
+    pCmac->pMac_ctx = stse_openssl_cmac_new(pKey, key_length);
+    pCmac->tag_size = exp_tag_size;
+
+    return (pCmac->pMac_ctx != NULL) ? STSE_OK : STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
+}
+
+static stse_ReturnCode_t stse_openssl_cmac_append(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                  PLAT_UI8 *pInput,
+                                                  PLAT_UI16 length) {
+    stse_openssl_cmac_ctx_t *pCmac = (stse_openssl_cmac_ctx_t *)pCtx;
+
+    if (EVP_MAC_update(pCmac->pMac_ctx, pInput, length) <= 0) {
+        return STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
+    }
+
+    return STSE_OK;
+}
+
+static stse_ReturnCode_t stse_openssl_cmac_compute_finish(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                          PLAT_UI8 *pTag,
+                                                          PLAT_UI8 *pTagLen) {
+    stse_openssl_cmac_ctx_t *pCmac = (stse_openssl_cmac_ctx_t *)pCtx;
+    PLAT_UI8 tag[STSE_OPENSSL_AES_BLOCK_SIZE];
+    stse_ReturnCode_t ret;
+
+    ret = stse_openssl_cmac_final(pCtx, tag);
+    if (ret == STSE_OK) {
+        memcpy(pTag, tag, pCmac->tag_size);
+        if (pTagLen != NULL) {
+            *pTagLen = (PLAT_UI8)pCmac->tag_size;
+        }
+    }
+
+    return ret;
+}
+
+static stse_ReturnCode_t stse_openssl_cmac_verify_finish(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                         PLAT_UI8 *pTag) {
+    stse_openssl_cmac_ctx_t *pCmac = (stse_openssl_cmac_ctx_t *)pCtx;
+    PLAT_UI8 tag[STSE_OPENSSL_AES_BLOCK_SIZE];
+
+    if (stse_openssl_cmac_final(pCtx, tag) != STSE_OK) {
+        return STSE_PLATFORM_AES_CMAC_VERIFY_ERROR;
+    }
+
+    return (CRYPTO_memcmp(tag, pTag, pCmac->tag_size) == 0) ? STSE_OK : STSE_PLATFORM_AES_CMAC_VERIFY_ERROR;
+}
+
+static void stse_openssl_cmac_abort(stse_platform_aes_cmac_ctx_t *pCtx) {
+    stse_openssl_cmac_ctx_t *pCmac = (stse_openssl_cmac_ctx_t *)pCtx;
+
+    EVP_MAC_CTX_free(pCmac->pMac_ctx);
+    pCmac->pMac_ctx = NULL;
+}
+
+#ifdef STSE_CONF_USE_PLATFORM_AES_CMAC_CTX
+
+stse_ReturnCode_t stse_platform_aes_cmac_ctx_init(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                  const PLAT_UI8 *pKey,
+                                                  PLAT_UI16 key_length,
+                                                  PLAT_UI16 exp_tag_size) {
+    return stse_openssl_cmac_init(pCtx, pKey, key_length, exp_tag_size);
+}
+
+stse_ReturnCode_t stse_platform_aes_cmac_ctx_append(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                    PLAT_UI8 *pInput,
+                                                    PLAT_UI16 length) {
+    return stse_openssl_cmac_append(pCtx, pInput, length);
+}
+
+stse_ReturnCode_t stse_platform_aes_cmac_ctx_compute_finish(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                            PLAT_UI8 *pTag,
+                                                            PLAT_UI8 *pTagLen) {
+    return stse_openssl_cmac_compute_finish(pCtx, pTag, pTagLen);
+}
+
+stse_ReturnCode_t stse_platform_aes_cmac_ctx_verify_finish(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                           PLAT_UI8 *pTag) {
+    return stse_openssl_cmac_verify_finish(pCtx, pTag);
+}
+
+void stse_platform_aes_cmac_ctx_abort(stse_platform_aes_cmac_ctx_t *pCtx) {
+    stse_openssl_cmac_abort(pCtx);
+}
+
+#else
+
+/* - Legacy sequence API : single computation (library context API provided by the weak core definitions) */
+static stse_platform_aes_cmac_ctx_t stse_openssl_cmac_legacy_ctx;
+
+stse_ReturnCode_t stse_platform_aes_cmac_init(const PLAT_UI8 *pKey,
+                                              PLAT_UI16 key_length,
+                                              PLAT_UI16 exp_tag_size) {
+    return stse_openssl_cmac_init(&stse_openssl_cmac_legacy_ctx, pKey, key_length, exp_tag_size);
+}
+
+stse_ReturnCode_t stse_platform_aes_cmac_append(PLAT_UI8 *pInput, PLAT_UI16 length) {
+    return stse_openssl_cmac_append(&stse_openssl_cmac_legacy_ctx, pInput, length);
+}
+
+stse_ReturnCode_t stse_platform_aes_cmac_compute_finish(PLAT_UI8 *pTag, PLAT_UI8 *pTagLen) {
+    return stse_openssl_cmac_compute_finish(&stse_openssl_cmac_legacy_ctx, pTag, pTagLen);
+}
+
+stse_ReturnCode_t stse_platform_aes_cmac_verify_finish(PLAT_UI8 *pTag) {
+    return stse_openssl_cmac_verify_finish(&stse_openssl_cmac_legacy_ctx, pTag);
+}
+
+#endif /* STSE_CONF_USE_PLATFORM_AES_CMAC_CTX */
+
+stse_ReturnCode_t stse_platform_aes_cmac_compute(const PLAT_UI8 *pPayload, PLAT_UI16 payload_length,
+                                                 const PLAT_UI8 *pKey, PLAT_UI16 key_length,
+                                                 PLAT_UI16 exp_tag_size,
+                                                 PLAT_UI8 *pTag, PLAT_UI16 *pTag_length) {
+    stse_platform_aes_cmac_ctx_t ctx;
+    stse_ReturnCode_t ret;
+
+    ret = stse_openssl_cmac_init(&ctx, pKey, key_length, exp_tag_size);
+    if (ret == STSE_OK) {
+        ret = stse_openssl_cmac_append(&ctx, (PLAT_UI8 *)pPayload, payload_length);
+        if (ret != STSE_OK) {
+            stse_openssl_cmac_abort(&ctx);
+            return ret;
+        }
+        ret = stse_openssl_cmac_compute_finish(&ctx, pTag, NULL);
+    }
+    if (ret == STSE_OK) {
+        *pTag_length = exp_tag_size;
+    }
+
+    return ret;
+}
+
+stse_ReturnCode_t stse_platform_aes_cmac_verify(const PLAT_UI8 *pPayload, PLAT_UI16 payload_length,
+                                                const PLAT_UI8 *pKey, PLAT_UI16 key_length,
+                                                const PLAT_UI8 *pTag, PLAT_UI16 tag_length) {
+    PLAT_UI8 tag[STSE_OPENSSL_AES_BLOCK_SIZE];
+    PLAT_UI16 length;
+
+    if ((tag_length > sizeof(tag)) ||
+        (stse_platform_aes_cmac_compute(pPayload, payload_length, pKey, key_length, tag_length, tag, &length) != STSE_OK) ||
+        (CRYPTO_memcmp(tag, pTag, tag_length) != 0)) {
+        return STSE_PLATFORM_AES_CMAC_VERIFY_ERROR;
+    }
+
+    return STSE_OK;
+}
+
+#if defined(STSE_CONF_USE_HOST_SESSION) && defined(STSE_CONF_USE_HOST_SESSION_KEY_HANDLES)
+
+typedef struct {
+    EVP_CIPHER_CTX *pEcb_enc;
+    EVP_CIPHER_CTX *pCbc_enc;
+    EVP_CIPHER_CTX *pCbc_dec;
+    EVP_MAC_CTX *pCmac;
+} stse_openssl_key_handle_t;
+
+static EVP_CIPHER_CTX *stse_openssl_key_schedule(const EVP_CIPHER *pCipher, const PLAT_UI8 *pKey, int encrypt) {
+    EVP_CIPHER_CTX *pCtx = EVP_CIPHER_CTX_new();
+
+    if ((pCtx != NULL) &&
+        ((EVP_CipherInit_ex(pCtx, pCipher, NULL, pKey, NULL, encrypt) <= 0) ||
+         (EVP_CIPHER_CTX_set_padding(pCtx, 0) <= 0))) {
+        EVP_CIPHER_CTX_free(pCtx);
+        pCtx = NULL;
+    }
+
+    return pCtx;
+}
+
+static stse_ReturnCode_t stse_openssl_key_handle_cipher(EVP_CIPHER_CTX *pCtx, const PLAT_UI8 *pInitial_value,
+                                                        const PLAT_UI8 *pInput, PLAT_UI16 length,
+                                                        PLAT_UI8 *pOutput, PLAT_UI16 *pOutput_length,
+                                                        stse_ReturnCode_t error) {
+    int update_length = 0;
+
+    /* - Keep the key schedule , only reload the IV */
+    if ((EVP_CipherInit_ex(pCtx, NULL, NULL, NULL, pInitial_value, -1) <= 0) ||
+        (EVP_CipherUpdate(pCtx, pOutput, &update_length, pInput, length) <= 0)) {
+        return error;
+    }
+    *pOutput_length = (PLAT_UI16)update_length;
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_aes_key_handle_create(const PLAT_UI8 *pKey, PLAT_UI16 key_length,
+                                                      stse_platform_aes_key_handle_t *pKey_handle) {
+    stse_openssl_key_handle_t *pHandle;
+    PLAT_UI8 aes_128 = (key_length == STSE_AES_128_KEY_SIZE);
+
+    if ((key_length != STSE_AES_128_KEY_SIZE) && (key_length != STSE_AES_256_KEY_SIZE)) {
+        return STSE_PLATFORM_INVALID_PARAMETER;
+    }
+
+    pHandle = OPENSSL_zalloc(sizeof(*pHandle));
+    if (pHandle == NULL) {
+        return STSE_PLATFORM_CRYPTO_INIT_ERROR;
+    }
+    pHandle->pEcb_enc = stse_openssl_key_schedule(aes_128 ? EVP_aes_128_ecb() : EVP_aes_256_ecb(), pKey, 1);
+    pHandle->pCbc_enc = stse_openssl_key_schedule(aes_128 ? EVP_aes_128_cbc() : EVP_aes_256_cbc(), pKey, 1);
+    pHandle->pCbc_dec = stse_openssl_key_schedule(aes_128 ? EVP_aes_128_cbc() : EVP_aes_256_cbc(), pKey, 0);
+    pHandle->pCmac = stse_openssl_cmac_new(pKey, key_length);
+    if ((pHandle->pEcb_enc == NULL) || (pHandle->pCbc_enc == NULL) ||
+        (pHandle->pCbc_dec == NULL) || (pHandle->pCmac == NULL)) {
+        stse_platform_aes_key_handle_destroy(pHandle);
+        return STSE_PLATFORM_CRYPTO_INIT_ERROR;
+    }
+    *pKey_handle = pHandle;
+
+    return STSE_OK;
+}
+
+void stse_platform_aes_key_handle_destroy(stse_platform_aes_key_handle_t key_handle) {
+    stse_openssl_key_handle_t *pHandle = (stse_openssl_key_handle_t *)key_handle;
+
+    if (pHandle == NULL) {
+        return;
+    }
+    EVP_CIPHER_CTX_free(pHandle->pEcb_enc);
+    EVP_CIPHER_CTX_free(pHandle->pCbc_enc);
+    EVP_CIPHER_CTX_free(pHandle->pCbc_dec);
+    EVP_MAC_CTX_free(pHandle->pCmac);
+    OPENSSL_clear_free(pHandle, sizeof(*pHandle));
+}
+
+stse_ReturnCode_t stse_platform_aes_key_handle_ecb_enc(stse_platform_aes_key_handle_t key_handle,
+                                                       const PLAT_UI8 *pPlaintext, PLAT_UI16 plaintext_length,
+                                                       PLAT_UI8 *pEncryptedtext, PLAT_UI16 *pEncryptedtext_length) {
+    stse_openssl_key_handle_t *pHandle = (stse_openssl_key_handle_t *)key_handle;
+
+    return stse_openssl_key_handle_cipher(pHandle->pEcb_enc, NULL, pPlaintext, plaintext_length,
+                                          pEncryptedtext, pEncryptedtext_length, STSE_PLATFORM_AES_ECB_ENCRYPT_ERROR);
+}
+
+stse_ReturnCode_t stse_platform_aes_key_handle_cbc_enc(stse_platform_aes_key_handle_t key_handle,
+                                                       const PLAT_UI8 *pPlaintext, PLAT_UI16 plaintext_length,
+                                                       PLAT_UI8 *pInitial_value,
+                                                       PLAT_UI8 *pEncryptedtext, PLAT_UI16 *pEncryptedtext_length) {
+    stse_openssl_key_handle_t *pHandle = (stse_openssl_key_handle_t *)key_handle;
+
+    return stse_openssl_key_handle_cipher(pHandle->pCbc_enc, pInitial_value, pPlaintext, plaintext_length,
+                                          pEncryptedtext, pEncryptedtext_length, STSE_PLATFORM_AES_CBC_ENCRYPT_ERROR);
+}
+
+stse_ReturnCode_t stse_platform_aes_key_handle_cbc_dec(stse_platform_aes_key_handle_t key_handle,
+                                                       const PLAT_UI8 *pEncryptedtext, PLAT_UI16 encryptedtext_length,
+                                                       PLAT_UI8 *pInitial_value,
+                                                       PLAT_UI8 *pPlaintext, PLAT_UI16 *pPlaintext_length) {
+    stse_openssl_key_handle_t *pHandle = (stse_openssl_key_handle_t *)key_handle;
+
+    return stse_openssl_key_handle_cipher(pHandle->pCbc_dec, pInitial_value, pEncryptedtext, encryptedtext_length,
+                                          pPlaintext, pPlaintext_length, STSE_PLATFORM_AES_CBC_DECRYPT_ERROR);
+}
+
+stse_ReturnCode_t stse_platform_aes_key_handle_cmac_init(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                         stse_platform_aes_key_handle_t key_handle,
+                                                         PLAT_UI16 exp_tag_size) {
+    stse_openssl_key_handle_t *pHandle = (stse_openssl_key_handle_t *)key_handle;
+    stse_openssl_cmac_ctx_t *pCmac = (stse_openssl_cmac_ctx_t *)pCtx;
+
+    /* - Duplicate the initialized CMAC context : no key schedule nor subkey derivation */
+    pCmac->pMac_ctx = EVP_MAC_CTX_dup(pHandle->pCmac);
+    pCmac->tag_size = exp_tag_size;
+
+    return (pCmac->pMac_ctx != NULL) ? STSE_OK : STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
+}
+
+#endif /* STSE_CONF_USE_HOST_SESSION && STSE_CONF_USE_HOST_SESSION_KEY_HANDLES */
+
+#endif /* STSE_CONF_USE_HOST_KEY_ESTABLISHMENT || STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT || STSE_CONF_USE_HOST_SESSION */
+
+stse_ReturnCode_t stse_platform_hmac_sha256_extract(PLAT_UI8 *pSalt, PLAT_UI16 salt_length,
+                                                    PLAT_UI8 *pInput_keying_material, PLAT_UI16 input_keying_material_length,
+                                                    PLAT_UI8 *pPseudorandom_key, PLAT_UI16 pseudorandom_key_expected_length) {
+    unsigned int length = 0;
+
+    if (HMAC(EVP_sha256(), pSalt, salt_length, pInput_keying_material, input_keying_material_length,
+             pPseudorandom_key, &length) == NULL) {
+        return STSE_PLATFORM_HKDF_ERROR;
+    }
+
+    return (length == pseudorandom_key_expected_length) ? STSE_OK : STSE_PLATFORM_HKDF_ERROR;
+}
+
+stse_ReturnCode_t stse_platform_hmac_sha256_expand(PLAT_UI8 *pPseudorandom_key, PLAT_UI16 pseudorandom_key_length,
+                                                   PLAT_UI8 *pInfo, PLAT_UI16 info_length,
+                                                   PLAT_UI8 *pOutput_keying_material, PLAT_UI16 output_keying_material_length) {
+    EVP_KDF *pKdf;
+    EVP_KDF_CTX *pKdf_ctx;
+    OSSL_PARAM params[5];
+    int mode = EVP_KDF_HKDF_MODE_EXPAND_ONLY;
+    int ok;
+
+    pKdf = EVP_KDF_fetch(NULL, "HKDF", NULL);
+    pKdf_ctx = EVP_KDF_CTX_new(pKdf);
+    EVP_KDF_free(pKdf);
+    if (pKdf_ctx == NULL) {
+        return STSE_PLATFORM_HKDF_ERROR;
+    }
+
+    params[0] = OSSL_PARAM_construct_utf8_string(OSSL_KDF_PARAM_DIGEST, "SHA256", 0);
+    params[1] = OSSL_PARAM_construct_int(OSSL_KDF_PARAM_MODE, &mode);
+    params[2] = OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_KEY, pPseudorandom_key, pseudorandom_key_length);
+    params[3] = OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_INFO, pInfo, info_length);
+    params[4] = OSSL_PARAM_construct_end();
+    ok = EVP_KDF_derive(pKdf_ctx, pOutput_keying_material, output_keying_material_length, params) > 0;
+    EVP_KDF_CTX_free(pKdf_ctx);
+
+    return ok ? STSE_OK : STSE_PLATFORM_HKDF_ERROR;
+}
+
+stse_ReturnCode_t stse_platform_nist_kw_encrypt(PLAT_UI8 *pPayload, PLAT_UI32 payload_length,
+                                                PLAT_UI8 *pKey, PLAT_UI8 key_length,
+                                                PLAT_UI8 *pOutput, PLAT_UI32 *pOutput_length) {
+    EVP_CIPHER_CTX *pCtx;
+    int update_length = 0;
+    int final_length = 0;
+    int ok;
+
+    if ((key_length != STSE_AES_128_KEY_SIZE) && (key_length != STSE_AES_256_KEY_SIZE)) {
+        return STSE_PLATFORM_INVALID_PARAMETER;
+    }
+
+    pCtx = EVP_CIPHER_CTX_new();
+    if (pCtx == NULL) {
+        return STSE_PLATFORM_KEYWRAP_ERROR;
+    }
+    EVP_CIPHER_CTX_set_flags(pCtx, EVP_CIPHER_CTX_FLAG_WRAP_ALLOW);
+    ok = (EVP_EncryptInit_ex(pCtx, (key_length == STSE_AES_128_KEY_SIZE) ? EVP_aes_128_wrap() : EVP_aes_256_wrap(),
+                             NULL, pKey, NULL) > 0) &&
+         (EVP_EncryptUpdate(pCtx, pOutput, &update_length, pPayload, (int)payload_length) > 0) &&
+         (EVP_EncryptFinal_ex(pCtx, pOutput + update_length, &final_length) > 0);
+    EVP_CIPHER_CTX_free(pCtx);
+
+    if (!ok) {
+        return STSE_PLATFORM_KEYWRAP_ERROR;
+    }
+    *pOutput_length = (PLAT_UI32)(update_length + final_length);
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_ecc_verify(stse_ecc_key_type_t key_type,
+                                           const PLAT_UI8 *pPubKey,
+                                           PLAT_UI8 *pDigest,
+                                           PLAT_UI16 digestLen,
+                                           PLAT_UI8 *pSignature) {
+    EVP_PKEY *pKey = stse_openssl_ecc_load_key(key_type, pPubKey, NULL);
+    EVP_PKEY_CTX *pCtx = NULL;
+    EVP_MD_CTX *pMd_ctx = NULL;
+    ECDSA_SIG *pSig = NULL;
+    PLAT_UI8 der[STSE_OPENSSL_MAX_DER_SIGNATURE_SIZE];
+    PLAT_UI8 *pDer = der;
+    PLAT_UI16 key_size;
+    int der_length;
+    int ok = 0;
+
+    if (pKey == NULL) {
+        return STSE_PLATFORM_ECC_VERIFY_ERROR;
+    }
+
+    if (stse_openssl_ecc_raw_type(key_type) == EVP_PKEY_ED25519) {
+        /* - EdDSA : pDigest is the message */
+        pMd_ctx = EVP_MD_CTX_new();
+        ok = (pMd_ctx != NULL) &&
+             (EVP_DigestVerifyInit(pMd_ctx, NULL, NULL, NULL, pKey) > 0) &&
+             (EVP_DigestVerify(pMd_ctx, pSignature, 64U, pDigest, digestLen) == 1);
+        EVP_MD_CTX_free(pMd_ctx);
+    } else if (stse_openssl_ecc_raw_type(key_type) == EVP_PKEY_NONE) {
+        key_size = stse_ecc_info_table[key_type].coordinate_or_key_size;
+        pSig = ECDSA_SIG_new();
+        if ((pSig != NULL) &&
+            (ECDSA_SIG_set0(pSig, BN_bin2bn(pSignature, key_size, NULL),
+                            BN_bin2bn(pSignature + key_size, key_size, NULL)) == 1)) {
+            der_length = i2d_ECDSA_SIG(pSig, &pDer);
+            pCtx = EVP_PKEY_CTX_new(pKey, NULL);
+            ok = (der_length > 0) && (pCtx != NULL) &&
+                 (EVP_PKEY_verify_init(pCtx) > 0) &&
+                 (EVP_PKEY_verify(pCtx, der, der_length, pDigest, digestLen) == 1);
+            EVP_PKEY_CTX_free(pCtx);
+        }
+        ECDSA_SIG_free(pSig);
+    }
+    EVP_PKEY_free(pKey);
+
+    return ok ? STSE_OK : STSE_PLATFORM_ECC_VERIFY_ERROR;
+}
+
+stse_ReturnCode_t stse_platform_ecc_sign(stse_ecc_key_type_t key_type,
+                                         PLAT_UI8 *pPrivKey,
+                                         PLAT_UI8 *pDigest,
+                                         PLAT_UI16 digestLen,
+                                         PLAT_UI8 *pSignature) {
+    EVP_PKEY *pKey = stse_openssl_ecc_load_key(key_type, NULL, pPrivKey);
+    EVP_PKEY_CTX *pCtx = NULL;
+    EVP_MD_CTX *pMd_ctx = NULL;
+    ECDSA_SIG *pSig = NULL;
+    const BIGNUM *pR;
+    const BIGNUM *pS;
+    PLAT_UI8 der[STSE_OPENSSL_MAX_DER_SIGNATURE_SIZE];
+    const PLAT_UI8 *pDer = der;
+    size_t der_length = sizeof(der);
+    size_t signature_length = 64U;
+    PLAT_UI16 key_size;
+    int ok = 0;
+
+    if (pKey == NULL) {
+        return STSE_PLATFORM_ECC_SIGN_ERROR;
+    }
+
+    if (stse_openssl_ecc_raw_type(key_type) == EVP_PKEY_ED25519) {
+        pMd_ctx = EVP_MD_CTX_new();
+        ok = (pMd_ctx != NULL) &&
+             (EVP_DigestSignInit(pMd_ctx, NULL, NULL, NULL, pKey) > 0) &&
+             (EVP_DigestSign(pMd_ctx, pSignature, &signature_length, pDigest, digestLen) > 0);
+        EVP_MD_CTX_free(pMd_ctx);
+    } else if (stse_openssl_ecc_raw_type(key_type) == EVP_PKEY_NONE) {
+        key_size = stse_ecc_info_table[key_type].coordinate_or_key_size;
+        pCtx = EVP_PKEY_CTX_new(pKey, NULL);
+        if ((pCtx != NULL) &&
+            (EVP_PKEY_sign_init(pCtx) > 0) &&
+            (EVP_PKEY_sign(pCtx, der, &der_length, pDigest, digestLen) > 0)) {
+            pSig = d2i_ECDSA_SIG(NULL, &pDer, (long)der_length);
+        }
+        if (pSig != NULL) {
+            ECDSA_SIG_get0(pSig, &pR, &pS);
+            ok = (BN_bn2binpad(pR, pSignature, key_size) > 0) &&
+                 (BN_bn2binpad(pS, pSignature + key_size, key_size) > 0);
+        }
+        ECDSA_SIG_free(pSig);
+        EVP_PKEY_CTX_free(pCtx);
+    }
+    EVP_PKEY_free(pKey);
+
+    return ok ? STSE_OK : STSE_PLATFORM_ECC_SIGN_ERROR;
+}
+
+stse_ReturnCode_t stse_platform_ecc_generate_key_pair(stse_ecc_key_type_t key_type,
+                                                      PLAT_UI8 *pPrivKey,
+                                                      PLAT_UI8 *pPubKey) {
+    const char *pGroup = stse_openssl_ecc_group_name(key_type);
+    int raw_type = stse_openssl_ecc_raw_type(key_type);
+    PLAT_UI8 point[1U + (2U * STSE_OPENSSL_MAX_COORDINATE_SIZE)];
+    size_t length;
+    BIGNUM *pPriv = NULL;
+    EVP_PKEY *pKey = NULL;
+    PLAT_UI16 key_size;
+    int ok = 0;
+
+    if (raw_type != EVP_PKEY_NONE) {
+        pKey = EVP_PKEY_Q_keygen(NULL, NULL, (raw_type == EVP_PKEY_X25519) ? "X25519" : "ED25519");
+        length = 32U;
+        ok = (pKey != NULL) &&
+             (EVP_PKEY_get_raw_private_key(pKey, pPrivKey, &length) > 0);
+        length = 32U;
+        ok = ok && (EVP_PKEY_get_raw_public_key(pKey, pPubKey, &length) > 0);
+    } else if (pGroup != NULL) {
+        key_size = stse_ecc_info_table[key_type].coordinate_or_key_size;
+        pKey = EVP_PKEY_Q_keygen(NULL, NULL, "EC", pGroup);
+        ok = (pKey != NULL) &&
+             (EVP_PKEY_get_bn_param(pKey, OSSL_PKEY_PARAM_PRIV_KEY, &pPriv) > 0) &&
+             (BN_bn2binpad(pPriv, pPrivKey, key_size) > 0) &&
+             (EVP_PKEY_get_octet_string_param(pKey, OSSL_PKEY_PARAM_PUB_KEY, point, sizeof(point), &length) > 0) &&
+             (length == (1U + (2U * key_size)));
+        if (ok) {
+            memcpy(pPubKey, &point[1], 2U * key_size);
+        }
+        BN_clear_free(pPriv);
+    }
+    EVP_PKEY_free(pKey);
+
+    return ok ? STSE_OK : STSE_PLATFORM_ECC_GENERATE_KEY_PAIR_ERROR;
+}
+
+stse_ReturnCode_t stse_platform_ecc_ecdh(stse_ecc_key_type_t key_type,
+                                         const PLAT_UI8 *pPubKey,
+                                         const PLAT_UI8 *pPrivKey,
+                                         PLAT_UI8 *pSharedSecret) {
+    EVP_PKEY *pPeer = stse_openssl_ecc_load_key(key_type, pPubKey, NULL);
+    EVP_PKEY *pKey = stse_openssl_ecc_load_key(key_type, NULL, pPrivKey);
+    EVP_PKEY_CTX *pCtx = NULL;
+    size_t length = stse_ecc_info_table[key_type].shared_secret_size;
+    int ok;
+
+    ok = (pPeer != NULL) && (pKey != NULL) &&
+         ((pCtx = EVP_PKEY_CTX_new(pKey, NULL)) != NULL) &&
+         (EVP_PKEY_derive_init(pCtx) > 0) &&
+         (EVP_PKEY_derive_set_peer(pCtx, pPeer) > 0) &&
+         (EVP_PKEY_derive(pCtx, pSharedSecret, &length) > 0);
+    EVP_PKEY_CTX_free(pCtx);
+    EVP_PKEY_free(pKey);
+    EVP_PKEY_free(pPeer);
+
+    return ok ? STSE_OK : STSE_PLATFORM_ECC_ECDH_ERROR;
+}
@@ -0,0 +1,42 @@
+/*!
+ * ******************************************************************************
+ * \file	stse_platform_power.c
+ * \brief   STSecureElement power platform file for host builds
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details The host has no control on the target device supply : power line operations always succeed.
+ */
+
+#include "core/stse_platform.h"
+
+stse_ReturnCode_t stse_platform_power_init(void) {
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_power_ctrl_init(void) {
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_power_on(PLAT_UI8 busID, PLAT_UI8 devAddr) {
+    (void)busID;
+    (void)devAddr;
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_power_off(PLAT_UI8 busID, PLAT_UI8 devAddr) {
+    (void)busID;
+    (void)devAddr;
+
+    return STSE_OK;
+}
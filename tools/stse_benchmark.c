@@ -0,0 +1,759 @@
+/*!
+ * ******************************************************************************
+ * \file	stse_benchmark.c
+ * \brief   STSELib end-to-end API benchmark
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details Host benchmark of the STSELib public API functions driven against the STSAFE-A device simulator
+ *          (tools/stse_simulator.c) or a recorded bus trace , in plaintext , authenticated (C-MAC/R-MAC) and
+ *          encrypted host session modes.
+ *          Build   : stse_benchmark target of the repository root CMake project (tools/CMakeLists.txt)
+ *          Usage   : stse_benchmark [-n iterations] [-d 100|110|120] [-l] [-w trace.bin | -t trace.bin]
+ *                                   [-r root_ca.der -c certificate.der -k private_key.bin]
+ *                    -n  number of measured calls per API function and mode (default 1000)
+ *                    -d  simulated STSAFE-A device (default 120)
+ *                    -l  enable the simulated device processing latency (the platform delay actually waits)
+ *                    -w  record the bus transactions exchanged with the simulated device in a trace file
+ *                    -t  replay a trace file recorded with -w instead of driving the simulated device
+ *                        (iterations and device are taken from the trace)
+ *                    -r , -c , -k  root CA certificate , device leaf certificate and raw leaf private key used by
+ *                        stse_device_authenticate (skipped when not provided)
+ *          Output  : one JSON object per line (JSON Lines) and per API function and mode , e.g.
+ *                    {"api":"stse_generate_random","mode":"encrypted","device":"STSAFE-A120","backend":"simulator",
+ *                     "status":"0x0000","payload_bytes":32,"ops":1000,"ops_per_s":51234.1,"p50_us":18.9,
+ *                     "p99_us":25.3,"bus_bytes_per_op":84.0,"bus_transactions_per_op":3.0,"cpu_us_per_op":19.2}
+ *          The command access conditions and encryption flags of the benchmarked commands are set on the simulated
+ *          device and reloaded by stse_init() for each mode. Start hash extended command code cannot be described
+ *          in the command authorization configuration and is always exchanged in plaintext.
+ *          Trace   : the recorded and replayed runs use the start/continue/stop bus callbacks. Trace file format
+ *                    (little endian) : header "STBT" magic , version (1 byte) , device type (1 byte) , iterations
+ *                    (4 bytes) , then one record per bus transaction : direction (1 byte , 0 = write , 1 = read) ,
+ *                    status (2 bytes) , length (2 bytes) , transferred bytes. On replay , the written frames are
+ *                    compared with the recorded ones ("trace_mismatch" output field) : commands carrying host random
+ *                    values (stse_device_authenticate challenge) do not replay.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "stselib.h"
+#include "tools/stse_simulator.h"
+#include "stse_platform_host.h"
+
+#if !defined(STSE_CONF_STSAFE_A_SUPPORT) || !defined(STSE_CONF_USE_HOST_SESSION)
+#error "stse_benchmark requires STSE_CONF_STSAFE_A_SUPPORT and STSE_CONF_USE_HOST_SESSION"
+#endif
+
+#define STSE_BENCHMARK_DEFAULT_ITERATIONS 1000U
+#define STSE_BENCHMARK_MAX_ITERATIONS 100000U
+#define STSE_BENCHMARK_MAX_CERTIFICATE_SIZE 2048U
+#define STSE_BENCHMARK_RANDOM_SIZE 32U
+#define STSE_BENCHMARK_ZONE_SIZE 256U
+#define STSE_BENCHMARK_READ_SIZE 64U
+#define STSE_BENCHMARK_HASH_MESSAGE_SIZE 256U
+#define STSE_BENCHMARK_DIGEST_SIZE 32U
+#define STSE_BENCHMARK_GCM_IV_SIZE 12U
+#define STSE_BENCHMARK_GCM_AAD_SIZE 16U
+#define STSE_BENCHMARK_GCM_MESSAGE_SIZE 64U
+#define STSE_BENCHMARK_GCM_TAG_SIZE 16U
+#define STSE_BENCHMARK_CERTIFICATE_ZONE 0U
+#define STSE_BENCHMARK_DATA_ZONE 1U
+#define STSE_BENCHMARK_PRIVATE_KEY_SLOT 0U
+#define STSE_BENCHMARK_SYMMETRIC_KEY_SLOT 0U
+#define STSE_BENCHMARK_TRACE_VERSION 0x01U
+#define STSE_BENCHMARK_TRACE_HEADER_SIZE 10U
+#define STSE_BENCHMARK_TRACE_RECORD_HEADER_SIZE 5U
+#define STSE_BENCHMARK_TRACE_FRAME_SIZE 1024U
+
+typedef enum stse_benchmark_mode_t {
+    STSE_BENCHMARK_PLAINTEXT = 0,
+    STSE_BENCHMARK_AUTHENTICATED,
+    STSE_BENCHMARK_ENCRYPTED,
+    STSE_BENCHMARK_MODE_COUNT
+} stse_benchmark_mode_t;
+
+typedef enum stse_benchmark_trace_direction_t {
+    STSE_BENCHMARK_TRACE_WRITE = 0,
+    STSE_BENCHMARK_TRACE_READ
+} stse_benchmark_trace_direction_t;
+
+typedef struct stse_benchmark_trace_t {
+    FILE *pFile;                                       /*!< Recorded trace file (-w) */
+    stse_io_t device_io;                               /*!< Simulated device bus callbacks (-w) */
+    PLAT_UI8 *pData;                                   /*!< Replayed trace content (-t) */
+    size_t size;                                       /*!< Replayed trace size */
+    size_t offset;                                     /*!< Next replayed record offset */
+    stse_benchmark_trace_direction_t direction;        /*!< Current transaction direction */
+    PLAT_UI8 frame[STSE_BENCHMARK_TRACE_FRAME_SIZE];   /*!< Current recorded transaction bytes */
+    PLAT_UI16 frame_length;                            /*!< Current transaction length */
+    const PLAT_UI8 *pRecord;                           /*!< Current replayed transaction bytes */
+    PLAT_UI16 record_length;                           /*!< Current replayed transaction length */
+    stse_ReturnCode_t record_status;                   /*!< Current replayed transaction status */
+    PLAT_UI32 mismatch_count;                          /*!< Replayed write transactions differing from the trace */
+    PLAT_UI32 bus_bytes;                               /*!< Replayed transaction bytes */
+    PLAT_UI32 bus_transactions;                        /*!< Replayed transactions */
+} stse_benchmark_trace_t;
+
+typedef struct stse_benchmark_scenario_t {
+    const char *pName;
+    PLAT_UI16 payload_bytes;
+    stse_ReturnCode_t (*pRun)(stse_Handler_t *pSTSE);
+} stse_benchmark_scenario_t;
+
+static const char *stse_benchmark_mode_name[STSE_BENCHMARK_MODE_COUNT] = {
+    "plaintext",
+    "authenticated",
+    "encrypted",
+};
+
+/* - Commands protected in authenticated and encrypted modes : {command code , extended} */
+static const PLAT_UI8 stse_benchmark_protected_cmd[][2] = {
+    {STSAFEA_CMD_GENERATE_RANDOM, 0},
+    {STSAFEA_CMD_READ, 0},
+    {STSAFEA_CMD_GENERATE_SIGNATURE, 0},
+    {STSAFEA_CMD_ENCRYPT, 0},
+    {STSAFEA_EXTENDED_CMD_PROCESS_HASH, 1},
+    {STSAFEA_EXTENDED_CMD_FINISH_HASH, 1},
+};
+
+static stse_simulator_t benchmark_simulator;
+static stse_Handler_t benchmark_handler;
+static stse_session_t benchmark_session;
+static PLAT_UI8 benchmark_host_MAC_key[STSE_AES_128_KEY_SIZE];
+static PLAT_UI8 benchmark_host_cipher_key[STSE_AES_128_KEY_SIZE];
+static PLAT_UI8 benchmark_symmetric_key[STSE_AES_128_KEY_SIZE];
+static PLAT_UI8 benchmark_private_key[STSE_BENCHMARK_DIGEST_SIZE];
+static PLAT_UI8 benchmark_certificate_zone[STSE_BENCHMARK_MAX_CERTIFICATE_SIZE];
+static PLAT_UI8 benchmark_data_zone[STSE_BENCHMARK_ZONE_SIZE];
+static PLAT_UI8 benchmark_root_ca[STSE_BENCHMARK_MAX_CERTIFICATE_SIZE];
+static PLAT_UI8 benchmark_root_ca_present;
+static PLAT_UI8 benchmark_message[STSE_BENCHMARK_HASH_MESSAGE_SIZE];
+static PLAT_UI8 benchmark_output[STSE_BENCHMARK_HASH_MESSAGE_SIZE];
+static PLAT_UI8 benchmark_tag[STSE_BENCHMARK_GCM_TAG_SIZE];
+static double benchmark_sample_us[STSE_BENCHMARK_MAX_ITERATIONS];
+static stse_benchmark_trace_t benchmark_trace;
+
+static double stse_benchmark_time_us(clockid_t clock_id) {
+    struct timespec ts;
+
+    clock_gettime(clock_id, &ts);
+
+    return ((double)ts.tv_sec * 1000000.0) + ((double)ts.tv_nsec / 1000.0);
+}
+
+static PLAT_UI32 stse_benchmark_time_ms(void) {
+    return (PLAT_UI32)(stse_benchmark_time_us(CLOCK_MONOTONIC) / 1000.0);
+}
+
+static int stse_benchmark_compare(const void *pA, const void *pB) {
+    double a = *(const double *)pA;
+    double b = *(const double *)pB;
+
+    return (a > b) - (a < b);
+}
+
+static size_t stse_benchmark_file_load(const char *pPath, PLAT_UI8 *pBuffer, size_t size) {
+    FILE *f = fopen(pPath, "rb");
+    size_t length;
+
+    if (f == NULL) {
+        return 0;
+    }
+    length = fread(pBuffer, 1, size, f);
+    fclose(f);
+
+    return length;
+}
+
+/* Recorded trace backend ----------------------------------------------------*/
+
+static void stse_benchmark_trace_put_u16(PLAT_UI8 *pBuffer, PLAT_UI16 value) {
+    pBuffer[0] = (PLAT_UI8)value;
+    pBuffer[1] = (PLAT_UI8)(value >> 8);
+}
+
+static PLAT_UI16 stse_benchmark_trace_get_u16(const PLAT_UI8 *pBuffer) {
+    return (PLAT_UI16)(pBuffer[0] | (pBuffer[1] << 8));
+}
+
+static void stse_benchmark_trace_write(stse_benchmark_trace_direction_t direction, stse_ReturnCode_t status) {
+    PLAT_UI8 header[STSE_BENCHMARK_TRACE_RECORD_HEADER_SIZE];
+    PLAT_UI16 length = (status == STSE_OK) ? benchmark_trace.frame_length : 0U;
+
+    header[0] = (PLAT_UI8)direction;
+    stse_benchmark_trace_put_u16(&header[1], (PLAT_UI16)status);
+    stse_benchmark_trace_put_u16(&header[3], length);
+    fwrite(header, 1, sizeof(header), benchmark_trace.pFile);
+    fwrite(benchmark_trace.frame, 1, length, benchmark_trace.pFile);
+}
+
+static void stse_benchmark_trace_append(PLAT_UI8 *pData, PLAT_UI16 length) {
+    if ((benchmark_trace.frame_length + length) > STSE_BENCHMARK_TRACE_FRAME_SIZE) {
+        length = STSE_BENCHMARK_TRACE_FRAME_SIZE - benchmark_trace.frame_length;
+    }
+    if (pData != NULL) {
+        memcpy(&benchmark_trace.frame[benchmark_trace.frame_length], pData, length);
+    } else {
+        memset(&benchmark_trace.frame[benchmark_trace.frame_length], 0x00, length);
+    }
+    benchmark_trace.frame_length += length;
+}
+
+/* - Recording : simulated device bus callbacks , transactions written to the trace file */
+
+static stse_ReturnCode_t stse_benchmark_record_send_start(PLAT_UI8 busID,
+                                                          PLAT_UI8 devAddr,
+                                                          PLAT_UI16 speed,
+                                                          PLAT_UI16 frame_length) {
+    stse_ReturnCode_t ret = benchmark_trace.device_io.BusSendStart(busID, devAddr, speed, frame_length);
+
+    benchmark_trace.frame_length = 0;
+    if (ret != STSE_OK) {
+        stse_benchmark_trace_write(STSE_BENCHMARK_TRACE_WRITE, ret);
+    }
+
+    return ret;
+}
+
+static stse_ReturnCode_t stse_benchmark_record_send_continue(PLAT_UI8 busID,
+                                                             PLAT_UI8 devAddr,
+                                                             PLAT_UI16 speed,
+                                                             PLAT_UI8 *pData,
+                                                             PLAT_UI16 data_size) {
+    stse_benchmark_trace_append(pData, data_size);
+
+    return benchmark_trace.device_io.BusSendContinue(busID, devAddr, speed, pData, data_size);
+}
+
+static stse_ReturnCode_t stse_benchmark_record_send_stop(PLAT_UI8 busID,
+                                                         PLAT_UI8 devAddr,
+                                                         PLAT_UI16 speed,
+                                                         PLAT_UI8 *pData,
+                                                         PLAT_UI16 data_size) {
+    stse_ReturnCode_t ret;
+
+    stse_benchmark_trace_append(pData, data_size);
+    ret = benchmark_trace.device_io.BusSendStop(busID, devAddr, speed, pData, data_size);
+    stse_benchmark_trace_write(STSE_BENCHMARK_TRACE_WRITE, ret);
+
+    return ret;
+}
+
+static stse_ReturnCode_t stse_benchmark_record_receive_start(PLAT_UI8 busID,
+                                                             PLAT_UI8 devAddr,
+                                                             PLAT_UI16 speed,
+                                                             PLAT_UI16 frame_length) {
+    stse_ReturnCode_t ret = benchmark_trace.device_io.BusRecvStart(busID, devAddr, speed, frame_length);
+
+    benchmark_trace.frame_length = 0;
+    if (ret != STSE_OK) {
+        stse_benchmark_trace_write(STSE_BENCHMARK_TRACE_READ, ret);
+    }
+
+    return ret;
+}
+
+static stse_ReturnCode_t stse_benchmark_record_receive_continue(PLAT_UI8 busID,
+                                                                PLAT_UI8 devAddr,
+                                                                PLAT_UI16 speed,
+                                                                PLAT_UI8 *pData,
+                                                                PLAT_UI16 data_size) {
+    stse_ReturnCode_t ret = benchmark_trace.device_io.BusRecvContinue(busID, devAddr, speed, pData, data_size);
+
+    stse_benchmark_trace_append(pData, data_size);
+
+    return ret;
+}
+
+static stse_ReturnCode_t stse_benchmark_record_receive_stop(PLAT_UI8 busID,
+                                                            PLAT_UI8 devAddr,
+                                                            PLAT_UI16 speed,
+                                                            PLAT_UI8 *pData,
+                                                            PLAT_UI16 data_size) {
+    stse_ReturnCode_t ret = benchmark_trace.device_io.BusRecvStop(busID, devAddr, speed, pData, data_size);
+
+    stse_benchmark_trace_append(pData, data_size);
+    stse_benchmark_trace_write(STSE_BENCHMARK_TRACE_READ, ret);
+
+    return ret;
+}
+
+/* - Replay : transactions served from the trace file content */
+
+static stse_ReturnCode_t stse_benchmark_replay_next(stse_benchmark_trace_direction_t direction) {
+    const PLAT_UI8 *pHeader = &benchmark_trace.pData[benchmark_trace.offset];
+
+    benchmark_trace.pRecord = NULL;
+    benchmark_trace.record_length = 0;
+    benchmark_trace.frame_length = 0;
+    if (((benchmark_trace.offset + STSE_BENCHMARK_TRACE_RECORD_HEADER_SIZE) > benchmark_trace.size) ||
+        (pHeader[0] != (PLAT_UI8)direction)) {
+        return STSE_PLATFORM_BUS_ERR;
+    }
+    benchmark_trace.record_status = (stse_ReturnCode_t)stse_benchmark_trace_get_u16(&pHeader[1]);
+    benchmark_trace.record_length = stse_benchmark_trace_get_u16(&pHeader[3]);
+    if ((benchmark_trace.offset + STSE_BENCHMARK_TRACE_RECORD_HEADER_SIZE + benchmark_trace.record_length) >
+        benchmark_trace.size) {
+        return STSE_PLATFORM_BUS_ERR;
+    }
+    benchmark_trace.pRecord = pHeader + STSE_BENCHMARK_TRACE_RECORD_HEADER_SIZE;
+    benchmark_trace.offset += STSE_BENCHMARK_TRACE_RECORD_HEADER_SIZE + benchmark_trace.record_length;
+    benchmark_trace.bus_transactions++;
+    benchmark_trace.bus_bytes += benchmark_trace.record_length;
+
+    return benchmark_trace.record_status;
+}
+
+static stse_ReturnCode_t stse_benchmark_replay_send_start(PLAT_UI8 busID,
+                                                          PLAT_UI8 devAddr,
+                                                          PLAT_UI16 speed,
+                                                          PLAT_UI16 frame_length) {
+    (void)busID;
+    (void)devAddr;
+    (void)speed;
+    (void)frame_length;
+
+    return stse_benchmark_replay_next(STSE_BENCHMARK_TRACE_WRITE);
+}
+
+static stse_ReturnCode_t stse_benchmark_replay_send_continue(PLAT_UI8 busID,
+                                                             PLAT_UI8 devAddr,
+                                                             PLAT_UI16 speed,
+                                                             PLAT_UI8 *pData,
+                                                             PLAT_UI16 data_size) {
+    (void)busID;
+    (void)devAddr;
+    (void)speed;
+
+    stse_benchmark_trace_append(pData, data_size);
+
+    return STSE_OK;
+}
+
+static stse_ReturnCode_t stse_benchmark_replay_send_stop(PLAT_UI8 busID,
+                                                         PLAT_UI8 devAddr,
+                                                         PLAT_UI16 speed,
+                                                         PLAT_UI8 *pData,
+                                                         PLAT_UI16 data_size) {
+    (void)busID;
+    (void)devAddr;
+    (void)speed;
+
+    stse_benchmark_trace_append(pData, data_size);
+    if ((benchmark_trace.frame_length != benchmark_trace.record_length) ||
+        (memcmp(benchmark_trace.frame, benchmark_trace.pRecord, benchmark_trace.record_length) != 0)) {
+        benchmark_trace.mismatch_count++;
+    }
+
+    return benchmark_trace.record_status;
+}
+
+static stse_ReturnCode_t stse_benchmark_replay_receive_start(PLAT_UI8 busID,
+                                                             PLAT_UI8 devAddr,
+                                                             PLAT_UI16 speed,
+                                                             PLAT_UI16 frame_length) {
+    (void)busID;
+    (void)devAddr;
+    (void)speed;
+    (void)frame_length;
+
+    return stse_benchmark_replay_next(STSE_BENCHMARK_TRACE_READ);
+}
+
+static stse_ReturnCode_t stse_benchmark_replay_receive_continue(PLAT_UI8 busID,
+                                                                PLAT_UI8 devAddr,
+                                                                PLAT_UI16 speed,
+                                                                PLAT_UI8 *pData,
+                                                                PLAT_UI16 data_size) {
+    PLAT_UI16 i;
+
+    (void)busID;
+    (void)devAddr;
+    (void)speed;
+
+    /* - Bytes read beyond the recorded transaction are returned as 0xFF (released bus) */
+    for (i = 0; i < data_size; i++) {
+        if (pData != NULL) {
+            pData[i] = (benchmark_trace.frame_length < benchmark_trace.record_length)
+                           ? benchmark_trace.pRecord[benchmark_trace.frame_length]
+                           : 0xFF;
+        }
+        benchmark_trace.frame_length++;
+    }
+
+    return STSE_OK;
+}
+
+static stse_ReturnCode_t stse_benchmark_replay_wake(PLAT_UI8 busID, PLAT_UI8 devAddr, PLAT_UI16 speed) {
+    (void)busID;
+    (void)devAddr;
+    (void)speed;
+
+    return STSE_OK;
+}
+
+static void stse_benchmark_trace_attach(stse_Handler_t *pSTSE, PLAT_UI8 replay) {
+    if (replay != 0) {
+        pSTSE->io.BusSendStart = stse_benchmark_replay_send_start;
+        pSTSE->io.BusSendContinue = stse_benchmark_replay_send_continue;
+        pSTSE->io.BusSendStop = stse_benchmark_replay_send_stop;
+        pSTSE->io.BusRecvStart = stse_benchmark_replay_receive_start;
+        pSTSE->io.BusRecvContinue = stse_benchmark_replay_receive_continue;
+        pSTSE->io.BusRecvStop = stse_benchmark_replay_receive_continue;
+        pSTSE->io.BusWake = stse_benchmark_replay_wake;
+    } else {
+        benchmark_trace.device_io = pSTSE->io;
+        pSTSE->io.BusSendStart = stse_benchmark_record_send_start;
+        pSTSE->io.BusSendContinue = stse_benchmark_record_send_continue;
+        pSTSE->io.BusSendStop = stse_benchmark_record_send_stop;
+        pSTSE->io.BusRecvStart = stse_benchmark_record_receive_start;
+        pSTSE->io.BusRecvContinue = stse_benchmark_record_receive_continue;
+        pSTSE->io.BusRecvStop = stse_benchmark_record_receive_stop;
+    }
+
+    /* - Transactions are recorded and replayed through the start/continue/stop callbacks */
+    pSTSE->io.BusSendV = NULL;
+    pSTSE->io.BusRecvV = NULL;
+#ifdef STSE_USE_ZERO_COPY_RSP
+    pSTSE->io.BusRecvFrame = NULL;
+#endif /* STSE_USE_ZERO_COPY_RSP */
+#ifdef STSE_USE_IO_LINE_RSP_WAIT
+    pSTSE->io.IOLineReady = NULL;
+    pSTSE->io.IOLineWait = NULL;
+#endif /* STSE_USE_IO_LINE_RSP_WAIT */
+}
+
+static int stse_benchmark_trace_load(const char *pPath, stse_device_t *pDevice_type, PLAT_UI32 *pIterations) {
+    FILE *f = fopen(pPath, "rb");
+    long size;
+
+    if (f == NULL) {
+        return 0;
+    }
+    if ((fseek(f, 0, SEEK_END) != 0) || ((size = ftell(f)) < (long)STSE_BENCHMARK_TRACE_HEADER_SIZE) ||
+        (fseek(f, 0, SEEK_SET) != 0) || ((benchmark_trace.pData = malloc((size_t)size)) == NULL)) {
+        fclose(f);
+        return 0;
+    }
+    benchmark_trace.size = fread(benchmark_trace.pData, 1, (size_t)size, f);
+    fclose(f);
+
+    if ((benchmark_trace.size != (size_t)size) || (memcmp(benchmark_trace.pData, "STBT", 4) != 0) ||
+        (benchmark_trace.pData[4] != STSE_BENCHMARK_TRACE_VERSION)) {
+        return 0;
+    }
+    *pDevice_type = (stse_device_t)benchmark_trace.pData[5];
+    *pIterations = (PLAT_UI32)benchmark_trace.pData[6] | ((PLAT_UI32)benchmark_trace.pData[7] << 8) |
+                   ((PLAT_UI32)benchmark_trace.pData[8] << 16) | ((PLAT_UI32)benchmark_trace.pData[9] << 24);
+    benchmark_trace.offset = STSE_BENCHMARK_TRACE_HEADER_SIZE;
+
+    return 1;
+}
+
+static int stse_benchmark_trace_create(const char *pPath, stse_device_t device_type, PLAT_UI32 iterations) {
+    PLAT_UI8 header[STSE_BENCHMARK_TRACE_HEADER_SIZE] = {'S', 'T', 'B', 'T', STSE_BENCHMARK_TRACE_VERSION};
+
+    benchmark_trace.pFile = fopen(pPath, "wb");
+    if (benchmark_trace.pFile == NULL) {
+        return 0;
+    }
+    header[5] = (PLAT_UI8)device_type;
+    header[6] = (PLAT_UI8)iterations;
+    header[7] = (PLAT_UI8)(iterations >> 8);
+    header[8] = (PLAT_UI8)(iterations >> 16);
+    header[9] = (PLAT_UI8)(iterations >> 24);
+
+    return (fwrite(header, 1, sizeof(header), benchmark_trace.pFile) == sizeof(header));
+}
+
+/* Benchmarked API calls -----------------------------------------------------*/
+
+static stse_ReturnCode_t stse_benchmark_random(stse_Handler_t *pSTSE) {
+    return stse_generate_random(pSTSE, benchmark_output, STSE_BENCHMARK_RANDOM_SIZE);
+}
+
+static stse_ReturnCode_t stse_benchmark_read_data_zone(stse_Handler_t *pSTSE) {
+    return stse_data_storage_read_data_zone(pSTSE, STSE_BENCHMARK_DATA_ZONE, 0, benchmark_output,
+                                            STSE_BENCHMARK_READ_SIZE, 0, STSE_NO_PROT);
+}
+
+static stse_ReturnCode_t stse_benchmark_hash(stse_Handler_t *pSTSE) {
+    PLAT_UI16 digest_size = STSE_BENCHMARK_DIGEST_SIZE;
+
+    return stse_compute_hash(pSTSE, STSE_SHA_256, benchmark_message, STSE_BENCHMARK_HASH_MESSAGE_SIZE,
+                             benchmark_output, &digest_size);
+}
+
+static stse_ReturnCode_t stse_benchmark_signature(stse_Handler_t *pSTSE) {
+    return stse_ecc_generate_signature(pSTSE, STSE_BENCHMARK_PRIVATE_KEY_SLOT, STSE_ECC_KT_NIST_P_256,
+                                       benchmark_message, STSE_BENCHMARK_DIGEST_SIZE, benchmark_output);
+}
+
+static stse_ReturnCode_t stse_benchmark_gcm_encrypt(stse_Handler_t *pSTSE) {
+    return stse_aes_gcm_encrypt(pSTSE, STSE_BENCHMARK_SYMMETRIC_KEY_SLOT, STSE_BENCHMARK_GCM_TAG_SIZE,
+                                STSE_BENCHMARK_GCM_IV_SIZE, benchmark_message,
+                                STSE_BENCHMARK_GCM_AAD_SIZE, &benchmark_message[STSE_BENCHMARK_GCM_IV_SIZE],
+                                STSE_BENCHMARK_GCM_MESSAGE_SIZE, &benchmark_message[STSE_BENCHMARK_DIGEST_SIZE],
+                                benchmark_output, benchmark_tag);
+}
+
+static stse_ReturnCode_t stse_benchmark_device_authenticate(stse_Handler_t *pSTSE) {
+    if (benchmark_root_ca_present == 0) {
+        return STSE_API_INVALID_PARAMETER;
+    }
+
+    return stse_device_authenticate(pSTSE, benchmark_root_ca, STSE_BENCHMARK_CERTIFICATE_ZONE,
+                                    STSE_BENCHMARK_PRIVATE_KEY_SLOT);
+}
+
+static const stse_benchmark_scenario_t stse_benchmark_scenario[] = {
+    {"stse_generate_random", STSE_BENCHMARK_RANDOM_SIZE, stse_benchmark_random},
+    {"stse_data_storage_read_data_zone", STSE_BENCHMARK_READ_SIZE, stse_benchmark_read_data_zone},
+    {"stse_compute_hash", STSE_BENCHMARK_HASH_MESSAGE_SIZE, stse_benchmark_hash},
+    {"stse_ecc_generate_signature", STSE_BENCHMARK_DIGEST_SIZE, stse_benchmark_signature},
+    {"stse_aes_gcm_encrypt", STSE_BENCHMARK_GCM_MESSAGE_SIZE, stse_benchmark_gcm_encrypt},
+    {"stse_device_authenticate", 0, stse_benchmark_device_authenticate},
+};
+
+/* Benchmark execution -------------------------------------------------------*/
+
+static stse_ReturnCode_t stse_benchmark_mode_set(stse_benchmark_mode_t mode) {
+    stse_ReturnCode_t ret;
+    stse_cmd_access_conditions_t cmd_AC = (mode == STSE_BENCHMARK_PLAINTEXT) ? STSE_CMD_AC_FREE : STSE_CMD_AC_HOST;
+    PLAT_UI8 encryption = (mode == STSE_BENCHMARK_ENCRYPTED) ? 1 : 0;
+    PLAT_UI8 i;
+
+    for (i = 0; i < (sizeof(stse_benchmark_protected_cmd) / sizeof(stse_benchmark_protected_cmd[0])); i++) {
+        stse_simulator_set_cmd_protection(&benchmark_simulator,
+                                          stse_benchmark_protected_cmd[i][0],
+                                          stse_benchmark_protected_cmd[i][1],
+                                          cmd_AC, encryption, encryption);
+    }
+
+    if (benchmark_handler.pActive_host_session != NULL) {
+        stsafea_close_host_session(&benchmark_session);
+    }
+
+    /* - Reload the command authorization configuration from the simulated device */
+    ret = stse_init(&benchmark_handler);
+    if ((ret != STSE_OK) || (mode == STSE_BENCHMARK_PLAINTEXT)) {
+        return ret;
+    }
+
+    return stsafea_open_host_session(&benchmark_handler, &benchmark_session,
+                                     benchmark_host_MAC_key, benchmark_host_cipher_key);
+}
+
+static void stse_benchmark_run(const stse_benchmark_scenario_t *pScenario,
+                               stse_benchmark_mode_t mode,
+                               PLAT_UI32 iterations) {
+    stse_ReturnCode_t ret;
+    stse_simulator_statistics_t *pStatistics = &benchmark_simulator.statistics;
+    double wall_start;
+    double cpu_start;
+    double wall_total;
+    double cpu_total;
+    double call_start;
+    PLAT_UI32 bus_bytes;
+    PLAT_UI32 bus_transactions;
+    PLAT_UI32 i;
+
+    /* - Warm-up call (also reports unsupported configurations) */
+    ret = pScenario->pRun(&benchmark_handler);
+    if (ret != STSE_OK) {
+        iterations = 0;
+    }
+
+    stse_simulator_reset_statistics(&benchmark_simulator);
+    benchmark_trace.bus_bytes = 0;
+    benchmark_trace.bus_transactions = 0;
+    benchmark_trace.mismatch_count = 0;
+    wall_start = stse_benchmark_time_us(CLOCK_MONOTONIC);
+    cpu_start = stse_benchmark_time_us(CLOCK_PROCESS_CPUTIME_ID);
+    for (i = 0; i < iterations; i++) {
+        call_start = stse_benchmark_time_us(CLOCK_MONOTONIC);
+        ret = pScenario->pRun(&benchmark_handler);
+        benchmark_sample_us[i] = stse_benchmark_time_us(CLOCK_MONOTONIC) - call_start;
+        if (ret != STSE_OK) {
+            iterations = i;
+            break;
+        }
+    }
+    cpu_total = stse_benchmark_time_us(CLOCK_PROCESS_CPUTIME_ID) - cpu_start;
+    wall_total = stse_benchmark_time_us(CLOCK_MONOTONIC) - wall_start;
+
+    if (benchmark_trace.pData != NULL) {
+        bus_bytes = benchmark_trace.bus_bytes;
+        bus_transactions = benchmark_trace.bus_transactions;
+    } else {
+        bus_bytes = pStatistics->cmd_bytes + pStatistics->rsp_bytes;
+        bus_transactions = pStatistics->send_count + pStatistics->receive_count + pStatistics->nack_count;
+    }
+
+    printf("{\"api\":\"%s\",\"mode\":\"%s\",\"device\":\"STSAFE-A1%d0\",\"backend\":\"%s\",\"status\":\"0x%04X\",\"payload_bytes\":%u,\"ops\":%u",
+           pScenario->pName,
+           stse_benchmark_mode_name[mode],
+           (int)(benchmark_handler.device_type - STSE_DEVICE_STSAFEA_FAMILY_INDEX),
+           (benchmark_trace.pData != NULL) ? "trace" : "simulator",
+           (unsigned int)ret,
+           pScenario->payload_bytes,
+           (unsigned int)iterations);
+    if (iterations > 0) {
+        qsort(benchmark_sample_us, iterations, sizeof(benchmark_sample_us[0]), stse_benchmark_compare);
+        printf(",\"ops_per_s\":%.1f,\"p50_us\":%.1f,\"p99_us\":%.1f,\"bus_bytes_per_op\":%.1f,\"bus_transactions_per_op\":%.1f,\"cpu_us_per_op\":%.1f",
+               (iterations * 1000000.0) / wall_total,
+               benchmark_sample_us[((iterations - 1) * 50U) / 100U],
+               benchmark_sample_us[((iterations - 1) * 99U) / 100U],
+               (double)bus_bytes / iterations,
+               (double)bus_transactions / iterations,
+               cpu_total / iterations);
+    }
+    if (benchmark_trace.pData != NULL) {
+        printf(",\"trace_mismatch\":%u", (unsigned int)benchmark_trace.mismatch_count);
+    }
+    printf("}\n");
+}
+
+int main(int argc, char **argv) {
+    stse_ReturnCode_t ret;
+    stse_device_t device_type = STSAFE_A120;
+    PLAT_UI32 iterations = STSE_BENCHMARK_DEFAULT_ITERATIONS;
+    PLAT_UI8 latency = 0;
+    const char *pRoot_ca_path = NULL;
+    const char *pCertificate_path = NULL;
+    const char *pPrivate_key_path = NULL;
+    const char *pRecord_path = NULL;
+    const char *pReplay_path = NULL;
+    size_t certificate_size = 0;
+    PLAT_UI16 i;
+    int arg;
+
+    for (arg = 1; arg < argc; arg++) {
+        if ((strcmp(argv[arg], "-n") == 0) && (arg + 1 < argc)) {
+            iterations = (PLAT_UI32)strtoul(argv[++arg], NULL, 0);
+        } else if ((strcmp(argv[arg], "-d") == 0) && (arg + 1 < argc)) {
+            arg++;
+            device_type = (strcmp(argv[arg], "100") == 0)   ? STSAFE_A100
+                          : (strcmp(argv[arg], "110") == 0) ? STSAFE_A110
+                                                            : STSAFE_A120;
+        } else if (strcmp(argv[arg], "-l") == 0) {
+            latency = 1;
+        } else if ((strcmp(argv[arg], "-w") == 0) && (arg + 1 < argc)) {
+            pRecord_path = argv[++arg];
+        } else if ((strcmp(argv[arg], "-t") == 0) && (arg + 1 < argc)) {
+            pReplay_path = argv[++arg];
+        } else if ((strcmp(argv[arg], "-r") == 0) && (arg + 1 < argc)) {
+            pRoot_ca_path = argv[++arg];
+        } else if ((strcmp(argv[arg], "-c") == 0) && (arg + 1 < argc)) {
+            pCertificate_path = argv[++arg];
+        } else if ((strcmp(argv[arg], "-k") == 0) && (arg + 1 < argc)) {
+            pPrivate_key_path = argv[++arg];
+        } else {
+            fprintf(stderr, "usage: %s [-n iterations] [-d 100|110|120] [-l] [-w trace.bin | -t trace.bin] [-r root_ca.der -c certificate.der -k private_key.bin]\n", argv[0]);
+            return 1;
+        }
+    }
+    if ((pReplay_path != NULL) && ((pRecord_path != NULL) ||
+                                   (stse_benchmark_trace_load(pReplay_path, &device_type, &iterations) == 0))) {
+        fprintf(stderr, "%s : invalid trace file\n", pReplay_path);
+        return 1;
+    }
+    if ((iterations == 0) || (iterations > STSE_BENCHMARK_MAX_ITERATIONS)) {
+        fprintf(stderr, "iterations must be in 1..%u\n", STSE_BENCHMARK_MAX_ITERATIONS);
+        return 1;
+    }
+
+    /* - Test material */
+    for (i = 0; i < sizeof(benchmark_message); i++) {
+        benchmark_message[i] = (PLAT_UI8)i;
+    }
+    for (i = 0; i < sizeof(benchmark_data_zone); i++) {
+        benchmark_data_zone[i] = (PLAT_UI8)(0xFF - i);
+    }
+    for (i = 0; i < STSE_AES_128_KEY_SIZE; i++) {
+        benchmark_host_MAC_key[i] = (PLAT_UI8)(0x10 + i);
+        benchmark_host_cipher_key[i] = (PLAT_UI8)(0x20 + i);
+        benchmark_symmetric_key[i] = (PLAT_UI8)(0x30 + i);
+    }
+    for (i = 0; i < sizeof(benchmark_private_key); i++) {
+        benchmark_private_key[i] = (PLAT_UI8)(i + 1);
+    }
+    if ((pRoot_ca_path != NULL) && (pCertificate_path != NULL)) {
+        benchmark_root_ca_present = (stse_benchmark_file_load(pRoot_ca_path, benchmark_root_ca, sizeof(benchmark_root_ca)) != 0);
+        certificate_size = stse_benchmark_file_load(pCertificate_path, benchmark_certificate_zone, sizeof(benchmark_certificate_zone));
+    }
+    if ((pPrivate_key_path != NULL) &&
+        (stse_benchmark_file_load(pPrivate_key_path, benchmark_private_key, sizeof(benchmark_private_key)) != sizeof(benchmark_private_key))) {
+        fprintf(stderr, "%s : %u-byte raw NIST P-256 private key expected\n", pPrivate_key_path, STSE_BENCHMARK_DIGEST_SIZE);
+        return 1;
+    }
+
+    /* - Simulated device provisioning */
+    stse_simulator_init(&benchmark_simulator, device_type);
+    if (latency != 0) {
+        stse_platform_host_set_real_time(1);
+        benchmark_simulator.pGet_time_ms = stse_benchmark_time_ms;
+    }
+    stse_simulator_set_host_keys(&benchmark_simulator, STSE_AES_128_KT,
+                                 benchmark_host_MAC_key, benchmark_host_cipher_key, 0);
+    stse_simulator_set_private_key(&benchmark_simulator, STSE_BENCHMARK_PRIVATE_KEY_SLOT,
+                                   STSE_ECC_KT_NIST_P_256, benchmark_private_key);
+    stse_simulator_set_symmetric_key(&benchmark_simulator, STSE_BENCHMARK_SYMMETRIC_KEY_SLOT,
+                                     STSE_AES_128_KT, benchmark_symmetric_key, STSE_BENCHMARK_GCM_TAG_SIZE);
+    stse_simulator_set_zone(&benchmark_simulator, STSE_BENCHMARK_CERTIFICATE_ZONE, 0, STSE_AC_ALWAYS, STSE_AC_NEVER,
+                            benchmark_certificate_zone, (PLAT_UI16)((certificate_size != 0) ? certificate_size : 4U), 0);
+    stse_simulator_set_zone(&benchmark_simulator, STSE_BENCHMARK_DATA_ZONE, 0, STSE_AC_ALWAYS, STSE_AC_ALWAYS,
+                            benchmark_data_zone, sizeof(benchmark_data_zone), 0);
+
+    stse_set_default_handler_value(&benchmark_handler);
+    benchmark_handler.device_type = device_type;
+    if (pReplay_path != NULL) {
+        stse_benchmark_trace_attach(&benchmark_handler, 1);
+    } else {
+        ret = stse_simulator_attach(&benchmark_simulator, &benchmark_handler);
+        if (ret != STSE_OK) {
+            fprintf(stderr, "simulator attach error 0x%04X\n", ret);
+            return 1;
+        }
+        if (pRecord_path != NULL) {
+            if (stse_benchmark_trace_create(pRecord_path, device_type, iterations) == 0) {
+                fprintf(stderr, "%s : trace file creation error\n", pRecord_path);
+                return 1;
+            }
+            stse_benchmark_trace_attach(&benchmark_handler, 0);
+        }
+    }
+
+    for (arg = STSE_BENCHMARK_PLAINTEXT; arg < STSE_BENCHMARK_MODE_COUNT; arg++) {
+        ret = stse_benchmark_mode_set((stse_benchmark_mode_t)arg);
+        if (ret != STSE_OK) {
+            fprintf(stderr, "%s mode setup error 0x%04X\n", stse_benchmark_mode_name[arg], ret);
+            return 1;
+        }
+        for (i = 0; i < (sizeof(stse_benchmark_scenario) / sizeof(stse_benchmark_scenario[0])); i++) {
+            stse_benchmark_run(&stse_benchmark_scenario[i], (stse_benchmark_mode_t)arg, iterations);
+        }
+    }
+
+    stse_simulator_detach(&benchmark_simulator);
+    if (benchmark_trace.pFile != NULL) {
+        fclose(benchmark_trace.pFile);
+    }
+    free(benchmark_trace.pData);
+
+    return 0;
+}
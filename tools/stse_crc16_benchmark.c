@@ -0,0 +1,169 @@
+/*!
+ * ******************************************************************************
+ * \file	stse_crc16_benchmark.c
+ * \brief   STSELib built-in CRC16 microbenchmark
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details Host CPU time spent computing a frame CRC16 for frame sizes from 8 bytes to the STSAFE-A120 maximum frame
+ *          length (STSAFEA_MAX_FRAME_LENGTH_A120). Each size is measured twice :
+ *          - bitwise  : reference CRC-16/X-25 computation shifting one bit at a time
+ *          - builtin  : library built-in CRC16 (stse_crc16_update / stse_crc16_finalize) as configured for the
+ *                       build : table-driven , slice-by-8 (STSE_CONF_BUILTIN_CRC16_SLICE_BY_8) and/or carry-less
+ *                       multiply folding (STSE_CONF_BUILTIN_CRC16_CLMUL on x86 targets built with -mpclmul)
+ *          Both CRC values are compared before measurement.
+ *          Build   : stse_crc16_benchmark (slice-by-8) and stse_crc16_benchmark_clmul (slice-by-8 and carry-less
+ *                    multiply , x86 compilers supporting -mpclmul) targets of the repository root CMake project
+ *                    (tools/CMakeLists.txt , STSE_CONF_USE_BUILTIN_CRC16 required)
+ *          Usage   : stse_crc16_benchmark [-n computations] [-r rounds]
+ *                    -n  number of CRC computations per round and frame size (default 100000)
+ *                    -r  number of measurement rounds , the fastest round is reported (default 5)
+ *          Output  : one JSON object , e.g.
+ *                    {"benchmark":"crc16","implementation":"slice_by_8","computations":100000,"results":[
+ *                     {"frame_bytes":8,"bitwise_ns":40.1,"builtin_ns":6.2,"speedup":6.47}, ...]}
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "core/stse_crc16.h"
+#include "stselib.h"
+
+#if !defined(STSE_CONF_USE_BUILTIN_CRC16)
+#error "stse_crc16_benchmark requires STSE_CONF_USE_BUILTIN_CRC16"
+#endif
+
+#define STSE_CRC16_BENCHMARK_DEFAULT_COMPUTATIONS 100000U
+#define STSE_CRC16_BENCHMARK_DEFAULT_ROUNDS 5U
+
+#if defined(STSE_CONF_BUILTIN_CRC16_CLMUL) && defined(__PCLMUL__) && defined(__SSE2__)
+#define STSE_CRC16_BENCHMARK_IMPLEMENTATION "clmul"
+#elif defined(STSE_CONF_BUILTIN_CRC16_SLICE_BY_8)
+#define STSE_CRC16_BENCHMARK_IMPLEMENTATION "slice_by_8"
+#else
+#define STSE_CRC16_BENCHMARK_IMPLEMENTATION "table"
+#endif
+
+static const PLAT_UI16 benchmark_frame_lengths[] = {8, 16, 32, 64, 128, 256, 512, STSAFEA_MAX_FRAME_LENGTH_A120};
+
+static PLAT_UI8 benchmark_frame[STSAFEA_MAX_FRAME_LENGTH_A120];
+static volatile PLAT_UI16 benchmark_sink;
+
+static double stse_crc16_benchmark_time_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+
+    return ((double)ts.tv_sec * 1000000000.0) + (double)ts.tv_nsec;
+}
+
+/* Bitwise reference ---------------------------------------------------------*/
+
+static PLAT_UI16 stse_crc16_benchmark_bitwise(PLAT_UI8 *pData, PLAT_UI16 length) {
+    PLAT_UI16 crc = STSE_CRC16_INIT_VALUE;
+    PLAT_UI8 bit;
+
+    while (length > 0U) {
+        crc ^= *pData++;
+        for (bit = 0; bit < 8U; bit++) {
+            crc = (crc & 1U) ? (PLAT_UI16)((crc >> 1) ^ 0x8408U) : (PLAT_UI16)(crc >> 1);
+        }
+        length--;
+    }
+
+    return stse_crc16_finalize(crc);
+}
+
+/* Library built-in CRC16 ----------------------------------------------------*/
+
+static PLAT_UI16 stse_crc16_benchmark_builtin(PLAT_UI8 *pData, PLAT_UI16 length) {
+    return stse_crc16_finalize(stse_crc16_update(STSE_CRC16_INIT_VALUE, pData, length));
+}
+
+static double stse_crc16_benchmark_measure(PLAT_UI16 (*pCompute)(PLAT_UI8 *, PLAT_UI16),
+                                           PLAT_UI16 length,
+                                           PLAT_UI32 computations,
+                                           PLAT_UI32 rounds) {
+    double round_start;
+    double round_ns;
+    double best_ns = 0;
+    PLAT_UI32 round;
+    PLAT_UI32 i;
+
+    for (round = 0; round < rounds; round++) {
+        round_start = stse_crc16_benchmark_time_ns();
+        for (i = 0; i < computations; i++) {
+            /* - Vary the first byte so that computations cannot be hoisted out of the loop */
+            benchmark_frame[0] = (PLAT_UI8)i;
+            benchmark_sink ^= pCompute(benchmark_frame, length);
+        }
+        round_ns = stse_crc16_benchmark_time_ns() - round_start;
+        if ((round == 0) || (round_ns < best_ns)) {
+            best_ns = round_ns;
+        }
+    }
+
+    return best_ns / computations;
+}
+
+int main(int argc, char **argv) {
+    PLAT_UI32 computations = STSE_CRC16_BENCHMARK_DEFAULT_COMPUTATIONS;
+    PLAT_UI32 rounds = STSE_CRC16_BENCHMARK_DEFAULT_ROUNDS;
+    double bitwise_ns;
+    double builtin_ns;
+    PLAT_UI16 length;
+    PLAT_UI8 size_idx;
+    PLAT_UI16 i;
+    int arg;
+
+    for (arg = 1; arg < argc; arg++) {
+        if ((strcmp(argv[arg], "-n") == 0) && (arg + 1 < argc)) {
+            computations = (PLAT_UI32)strtoul(argv[++arg], NULL, 0);
+        } else if ((strcmp(argv[arg], "-r") == 0) && (arg + 1 < argc)) {
+            rounds = (PLAT_UI32)strtoul(argv[++arg], NULL, 0);
+        } else {
+            fprintf(stderr, "usage: %s [-n computations] [-r rounds]\n", argv[0]);
+            return 1;
+        }
+    }
+    if ((computations == 0) || (rounds == 0)) {
+        fprintf(stderr, "computations and rounds must be non zero\n");
+        return 1;
+    }
+
+    for (i = 0; i < sizeof(benchmark_frame); i++) {
+        benchmark_frame[i] = (PLAT_UI8)((i * 31U) ^ 0x5A);
+    }
+
+    printf("{\"benchmark\":\"crc16\",\"implementation\":\"%s\",\"computations\":%u,\"results\":[",
+           STSE_CRC16_BENCHMARK_IMPLEMENTATION, (unsigned int)computations);
+    for (size_idx = 0; size_idx < (sizeof(benchmark_frame_lengths) / sizeof(benchmark_frame_lengths[0])); size_idx++) {
+        length = benchmark_frame_lengths[size_idx];
+
+        if (stse_crc16_benchmark_bitwise(benchmark_frame, length) != stse_crc16_benchmark_builtin(benchmark_frame, length)) {
+            fprintf(stderr, "\nCRC mismatch on %u bytes frame\n", (unsigned int)length);
+            return 1;
+        }
+
+        bitwise_ns = stse_crc16_benchmark_measure(stse_crc16_benchmark_bitwise, length, computations, rounds);
+        builtin_ns = stse_crc16_benchmark_measure(stse_crc16_benchmark_builtin, length, computations, rounds);
+        printf("%s{\"frame_bytes\":%u,\"bitwise_ns\":%.1f,\"builtin_ns\":%.1f,\"speedup\":%.2f}",
+               (size_idx == 0) ? "" : ",", (unsigned int)length, bitwise_ns, builtin_ns, bitwise_ns / builtin_ns);
+    }
+    printf("]}\n");
+
+    return 0;
+}
@@ -0,0 +1,173 @@
+/*!
+ * ******************************************************************************
+ * \file	stse_frame_trace_decode.c
+ * \brief   STSELib frame trace host decoder
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details Host side decoder of the frame trace exported by stse_frame_trace_export().
+ *          Build   : stse_frame_trace_decode target of the repository root CMake project (tools/CMakeLists.txt)
+ *          Usage   : stse_frame_trace_decode [-x] <file>   ("-" reads standard input)
+ *          The trace file contains the raw exported blob , or its hexadecimal dump when -x is set
+ *          (any non-hexadecimal character is ignored).
+ */
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "core/stse_return_codes.h"
+
+#define TRACE_HEADER_SIZE 12U
+#define TRACE_RECORD_BASE_SIZE 12U
+#define TRACE_MAX_SIZE 0x10000U
+
+static uint16_t get_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+#define STATUS_CASE(code) \
+    case code:             \
+        return #code
+
+static const char *status_name(uint16_t status) {
+    switch ((stse_ReturnCode_t)status) {
+        STATUS_CASE(STSE_OK);
+        STATUS_CASE(STSE_COMMUNICATION_ERROR);
+        STATUS_CASE(STSE_INCONSISTENT_COMMAND_DATA);
+        STATUS_CASE(STSE_COMMAND_CODE_NOT_SUPPORTED);
+        STATUS_CASE(STSE_SESSION_ERROR);
+        STATUS_CASE(STSE_ACCESS_CONDITION_NOT_SATISFIED);
+        STATUS_CASE(STSE_INVALID_C_MAC);
+        STATUS_CASE(STSE_PLATFORM_BUS_ERR);
+        STATUS_CASE(STSE_PLATFORM_BUS_ARBITRATION_LOST);
+        STATUS_CASE(STSE_PLATFORM_BUS_RECEIVE_TIMEOUT);
+        STATUS_CASE(STSE_PLATFORM_BUS_ACK_ERROR);
+        STATUS_CASE(STSE_CORE_FRAME_RMAC_ERROR);
+        STATUS_CASE(STSE_SERVICE_INVALID_PARAMETER);
+        STATUS_CASE(STSE_SERVICE_FRAME_CRC_ERROR);
+        STATUS_CASE(STSE_SERVICE_FRAME_SIZE_ERROR);
+        STATUS_CASE(STSE_SERVICE_INVALID_FRAME);
+    default:
+        return (status <= 0xFF) ? "(target device status)" : "(library error)";
+    }
+}
+
+static size_t read_trace(FILE *pFile, int hex_input, uint8_t *pBuffer, size_t buffer_size) {
+    size_t length = 0;
+    int c;
+    int nibble = -1;
+
+    if (!hex_input) {
+        return fread(pBuffer, 1, buffer_size, pFile);
+    }
+    while (((c = fgetc(pFile)) != EOF) && (length < buffer_size)) {
+        if (!isxdigit(c)) {
+            continue;
+        }
+        c = isdigit(c) ? (c - '0') : (tolower(c) - 'a' + 10);
+        if (nibble < 0) {
+            nibble = c;
+        } else {
+            pBuffer[length++] = (uint8_t)((nibble << 4) | c);
+            nibble = -1;
+        }
+    }
+    return length;
+}
+
+int main(int argc, char **argv) {
+    static uint8_t trace[TRACE_MAX_SIZE];
+    const uint8_t *pRecord;
+    const char *pPath = NULL;
+    FILE *pFile;
+    size_t length;
+    size_t record_size;
+    uint32_t sequence;
+    uint32_t previous_timestamp = 0;
+    uint16_t record_count;
+    uint16_t i;
+    uint8_t payload_size;
+    uint8_t j;
+    int hex_input = 0;
+    int arg;
+
+    for (arg = 1; arg < argc; arg++) {
+        if (strcmp(argv[arg], "-x") == 0) {
+            hex_input = 1;
+        } else {
+            pPath = argv[arg];
+        }
+    }
+    if (pPath == NULL) {
+        fprintf(stderr, "usage: %s [-x] <trace file | ->\n", argv[0]);
+        return 2;
+    }
+
+    pFile = (strcmp(pPath, "-") == 0) ? stdin : fopen(pPath, hex_input ? "r" : "rb");
+    if (pFile == NULL) {
+        perror(pPath);
+        return 1;
+    }
+    length = read_trace(pFile, hex_input, trace, sizeof(trace));
+    if (pFile != stdin) {
+        fclose(pFile);
+    }
+
+    /* - Verify export header */
+    if ((length < TRACE_HEADER_SIZE) || (memcmp(trace, "STFT", 4) != 0)) {
+        fprintf(stderr, "invalid frame trace (bad magic)\n");
+        return 1;
+    }
+    if (trace[4] != 0x01) {
+        fprintf(stderr, "unsupported frame trace version %u\n", trace[4]);
+        return 1;
+    }
+    payload_size = trace[5];
+    record_count = get_u16(&trace[6]);
+    sequence = get_u32(&trace[8]);
+    record_size = TRACE_RECORD_BASE_SIZE + payload_size;
+    if (length < (TRACE_HEADER_SIZE + (record_count * record_size))) {
+        fprintf(stderr, "truncated frame trace (%u records announced)\n", record_count);
+        return 1;
+    }
+
+    printf("%-8s %-10s %-10s %-3s %-6s %-6s %-5s %s\n", "seq", "timestamp", "delta", "dir", "header", "length", "retry", "status");
+    for (i = 0; i < record_count; i++) {
+        pRecord = &trace[TRACE_HEADER_SIZE + (i * record_size)];
+        uint32_t timestamp = get_u32(&pRecord[0]);
+        uint16_t status = get_u16(&pRecord[6]);
+
+        printf("%-8u %-10u %-10u %-3s 0x%02X   %-6u %-5u 0x%04X %s",
+               sequence + i,
+               timestamp,
+               (i == 0) ? 0U : (uint32_t)(timestamp - previous_timestamp),
+               (pRecord[8] == 0) ? ">" : "<",
+               pRecord[9],
+               get_u16(&pRecord[4]),
+               pRecord[10],
+               status,
+               status_name(status));
+        for (j = 0; (j < pRecord[11]) && (j < payload_size); j++) {
+            printf("%s%02X", (j == 0) ? "\t: " : " ", pRecord[TRACE_RECORD_BASE_SIZE + j]);
+        }
+        printf("\n");
+        previous_timestamp = timestamp;
+    }
+
+    return 0;
+}
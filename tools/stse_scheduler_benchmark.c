@@ -0,0 +1,247 @@
+/*!
+ * ******************************************************************************
+ * \file	stse_scheduler_benchmark.c
+ * \brief   STSELib multi-device frame scheduler scaling benchmark
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details Generate Signature throughput of 1 to N simulated STSAFE-A120 devices sharing one bus (same busID ,
+ *          one device address each). The simulated devices answer after the command processing latency of the
+ *          library timing table (stsafea_cmd_timings) and reject response polls until then. For each device count
+ *          the same commands are run twice :
+ *          - sequential : one blocking transfer after the other (stsafea_frame_transfer)
+ *          - scheduled  : all transfers handed to stsafea_frame_scheduler_run , which sends a command to every
+ *                         idle device and only uses the bus again to collect responses
+ *          Throughput is computed on the host platform clock : virtual time by default (delays only advance the
+ *          clock , the run is not slowed down by the device latency) or real time with -l.
+ *          Build   : stse_scheduler_benchmark target of the repository root CMake project (tools/CMakeLists.txt)
+ *                    (STSE_CONF_STSAFE_A_SUPPORT and STSE_CONF_USE_ASYNC_TRANSFER required)
+ *          Usage   : stse_scheduler_benchmark [-m max_devices] [-n commands] [-l]
+ *                    -m  maximum number of simulated devices on the bus (default 4 , up to 8)
+ *                    -n  number of Generate Signature commands per device (default 8)
+ *                    -l  real time host clock (the platform delay actually waits)
+ *          Output  : one JSON object , e.g.
+ *                    {"benchmark":"scheduler","command":"generate_signature","latency_ms":64,"commands_per_device":8,
+ *                     "results":[{"devices":1,"sequential_ops_per_s":15.4,"scheduled_ops_per_s":15.4,
+ *                     "speedup":1.00,"scaling":1.00}, ...]}
+ *                    speedup : scheduled over sequential throughput ; scaling : scheduled throughput over the
+ *                    single device scheduled throughput (close to the device count when the bus is not saturated)
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "stselib.h"
+#include "tools/stse_simulator.h"
+#include "stse_platform_host.h"
+
+#if !defined(STSE_CONF_STSAFE_A_SUPPORT) || !defined(STSE_CONF_USE_ASYNC_TRANSFER)
+#error "stse_scheduler_benchmark requires STSE_CONF_STSAFE_A_SUPPORT and STSE_CONF_USE_ASYNC_TRANSFER"
+#endif
+
+#define STSE_SCHEDULER_BENCHMARK_MAX_DEVICES 8U
+#define STSE_SCHEDULER_BENCHMARK_DEFAULT_DEVICES 4U
+#define STSE_SCHEDULER_BENCHMARK_MAX_COMMANDS 31U /* scheduler transfer list is limited to 255 entries */
+#define STSE_SCHEDULER_BENCHMARK_DEFAULT_COMMANDS 8U
+#define STSE_SCHEDULER_BENCHMARK_MAX_TRANSFERS (STSE_SCHEDULER_BENCHMARK_MAX_DEVICES * STSE_SCHEDULER_BENCHMARK_MAX_COMMANDS)
+#define STSE_SCHEDULER_BENCHMARK_BUS_ID 0U
+#define STSE_SCHEDULER_BENCHMARK_FIRST_ADDRESS 0x20U
+#define STSE_SCHEDULER_BENCHMARK_PRIVATE_KEY_SLOT 0U
+#define STSE_SCHEDULER_BENCHMARK_DIGEST_SIZE 32U
+#define STSE_SCHEDULER_BENCHMARK_SIGNATURE_SIZE 64U
+
+typedef struct stse_scheduler_benchmark_command_t {
+    PLAT_UI8 cmd_header;
+    PLAT_UI8 slot_number;
+    PLAT_UI8 digest_length[STSAFEA_GENERIC_LENGTH_SIZE];
+    PLAT_UI8 rsp_header;
+    PLAT_UI8 signature_length[STSE_ECC_GENERIC_LENGTH_SIZE];
+    PLAT_UI8 signature[STSE_SCHEDULER_BENCHMARK_SIGNATURE_SIZE];
+    stse_frame_t cmd_frame;
+    stse_frame_t rsp_frame;
+    stse_frame_element_t cmd_element[4];
+    stse_frame_element_t rsp_element[5];
+} stse_scheduler_benchmark_command_t;
+
+static stse_simulator_t benchmark_simulator[STSE_SCHEDULER_BENCHMARK_MAX_DEVICES];
+static stse_Handler_t benchmark_handler[STSE_SCHEDULER_BENCHMARK_MAX_DEVICES];
+static stse_scheduler_benchmark_command_t benchmark_command[STSE_SCHEDULER_BENCHMARK_MAX_TRANSFERS];
+static stsafea_scheduled_transfer_t benchmark_transfer[STSE_SCHEDULER_BENCHMARK_MAX_TRANSFERS];
+static PLAT_UI8 benchmark_private_key[STSE_SCHEDULER_BENCHMARK_DIGEST_SIZE];
+static PLAT_UI8 benchmark_digest[STSE_SCHEDULER_BENCHMARK_DIGEST_SIZE];
+
+/* - Generate Signature frames (same layout as stsafea_ecc_generate_signature for a NIST P-256 key) */
+static void stse_scheduler_benchmark_frames_build(stse_scheduler_benchmark_command_t *pCommand) {
+    PLAT_UI8 i;
+
+    memset(pCommand, 0, sizeof(*pCommand));
+    pCommand->cmd_header = STSAFEA_CMD_GENERATE_SIGNATURE;
+    pCommand->slot_number = STSE_SCHEDULER_BENCHMARK_PRIVATE_KEY_SLOT;
+    pCommand->digest_length[0] = UI16_B1(STSE_SCHEDULER_BENCHMARK_DIGEST_SIZE);
+    pCommand->digest_length[1] = UI16_B0(STSE_SCHEDULER_BENCHMARK_DIGEST_SIZE);
+    pCommand->signature_length[0] = UI16_B1(STSE_SCHEDULER_BENCHMARK_SIGNATURE_SIZE >> 1);
+    pCommand->signature_length[1] = UI16_B0(STSE_SCHEDULER_BENCHMARK_SIGNATURE_SIZE >> 1);
+
+    pCommand->cmd_element[0].length = STSAFEA_HEADER_SIZE;
+    pCommand->cmd_element[0].pData = &pCommand->cmd_header;
+    pCommand->cmd_element[1].length = STSAFEA_SLOT_NUMBER_ID_SIZE;
+    pCommand->cmd_element[1].pData = &pCommand->slot_number;
+    pCommand->cmd_element[2].length = STSAFEA_GENERIC_LENGTH_SIZE;
+    pCommand->cmd_element[2].pData = pCommand->digest_length;
+    pCommand->cmd_element[3].length = STSE_SCHEDULER_BENCHMARK_DIGEST_SIZE;
+    pCommand->cmd_element[3].pData = benchmark_digest;
+    for (i = 0; i < 4U; i++) {
+        stse_frame_push_element(&pCommand->cmd_frame, &pCommand->cmd_element[i]);
+    }
+
+    pCommand->rsp_element[0].length = STSAFEA_HEADER_SIZE;
+    pCommand->rsp_element[0].pData = &pCommand->rsp_header;
+    pCommand->rsp_element[1].length = STSE_ECC_GENERIC_LENGTH_SIZE;
+    pCommand->rsp_element[1].pData = pCommand->signature_length;
+    pCommand->rsp_element[2].length = STSE_SCHEDULER_BENCHMARK_SIGNATURE_SIZE >> 1;
+    pCommand->rsp_element[2].pData = pCommand->signature;
+    pCommand->rsp_element[3].length = STSE_ECC_GENERIC_LENGTH_SIZE;
+    pCommand->rsp_element[3].pData = pCommand->signature_length;
+    pCommand->rsp_element[4].length = STSE_SCHEDULER_BENCHMARK_SIGNATURE_SIZE >> 1;
+    pCommand->rsp_element[4].pData = &pCommand->signature[STSE_SCHEDULER_BENCHMARK_SIGNATURE_SIZE >> 1];
+    for (i = 0; i < 5U; i++) {
+        stse_frame_push_element(&pCommand->rsp_frame, &pCommand->rsp_element[i]);
+    }
+}
+
+/* - Run device_count x commands Generate Signature transfers , return elapsed host clock time in ms */
+static stse_ReturnCode_t stse_scheduler_benchmark_run(PLAT_UI8 scheduled,
+                                                      PLAT_UI8 device_count,
+                                                      PLAT_UI8 commands,
+                                                      PLAT_UI32 *pElapsed_ms) {
+    stse_ReturnCode_t ret = STSE_OK;
+    PLAT_UI16 transfer_count = (PLAT_UI16)(device_count * commands);
+    PLAT_UI32 start_ms;
+    PLAT_UI16 i;
+
+    /* - Transfers interleaved by device : t = device + (device_count x command index) */
+    for (i = 0; i < transfer_count; i++) {
+        stse_scheduler_benchmark_frames_build(&benchmark_command[i]);
+        memset(&benchmark_transfer[i], 0, sizeof(benchmark_transfer[i]));
+        benchmark_transfer[i].pSTSE = &benchmark_handler[i % device_count];
+        benchmark_transfer[i].pCmdFrame = &benchmark_command[i].cmd_frame;
+        benchmark_transfer[i].pRspFrame = &benchmark_command[i].rsp_frame;
+    }
+
+    start_ms = stse_platform_host_time_ms();
+    if (scheduled != 0) {
+        ret = stsafea_frame_scheduler_run(benchmark_transfer, (PLAT_UI8)transfer_count);
+    } else {
+        for (i = 0; (i < transfer_count) && (ret == STSE_OK); i++) {
+            ret = stsafea_frame_transfer(benchmark_transfer[i].pSTSE,
+                                         benchmark_transfer[i].pCmdFrame,
+                                         benchmark_transfer[i].pRspFrame);
+        }
+    }
+    *pElapsed_ms = stse_platform_host_time_ms() - start_ms;
+
+    return ret;
+}
+
+int main(int argc, char **argv) {
+    stse_ReturnCode_t ret;
+    PLAT_UI32 max_devices = STSE_SCHEDULER_BENCHMARK_DEFAULT_DEVICES;
+    PLAT_UI32 commands = STSE_SCHEDULER_BENCHMARK_DEFAULT_COMMANDS;
+    PLAT_UI8 real_time = 0;
+    PLAT_UI32 sequential_ms;
+    PLAT_UI32 scheduled_ms;
+    double sequential_ops;
+    double scheduled_ops;
+    double single_device_ops = 0;
+    PLAT_UI8 device_count;
+    PLAT_UI8 i;
+    int arg;
+
+    for (arg = 1; arg < argc; arg++) {
+        if ((strcmp(argv[arg], "-m") == 0) && (arg + 1 < argc)) {
+            max_devices = (PLAT_UI32)strtoul(argv[++arg], NULL, 0);
+        } else if ((strcmp(argv[arg], "-n") == 0) && (arg + 1 < argc)) {
+            commands = (PLAT_UI32)strtoul(argv[++arg], NULL, 0);
+        } else if (strcmp(argv[arg], "-l") == 0) {
+            real_time = 1;
+        } else {
+            fprintf(stderr, "usage: %s [-m max_devices] [-n commands] [-l]\n", argv[0]);
+            return 1;
+        }
+    }
+    if ((max_devices == 0) || (max_devices > STSE_SCHEDULER_BENCHMARK_MAX_DEVICES) ||
+        (commands == 0) || (commands > STSE_SCHEDULER_BENCHMARK_MAX_COMMANDS)) {
+        fprintf(stderr, "max_devices must be in 1..%u and commands in 1..%u\n",
+                STSE_SCHEDULER_BENCHMARK_MAX_DEVICES, STSE_SCHEDULER_BENCHMARK_MAX_COMMANDS);
+        return 1;
+    }
+
+    for (i = 0; i < STSE_SCHEDULER_BENCHMARK_DIGEST_SIZE; i++) {
+        benchmark_private_key[i] = (PLAT_UI8)(i + 1);
+        benchmark_digest[i] = (PLAT_UI8)(0xA0 ^ i);
+    }
+    stse_platform_host_set_real_time(real_time);
+    stse_platform_crypto_init();
+
+    /* - Simulated devices sharing one bus , with processing latency on the host clock */
+    for (i = 0; i < max_devices; i++) {
+        stse_simulator_init(&benchmark_simulator[i], STSAFE_A120);
+        benchmark_simulator[i].pGet_time_ms = stse_platform_host_time_ms;
+        stse_simulator_set_private_key(&benchmark_simulator[i], STSE_SCHEDULER_BENCHMARK_PRIVATE_KEY_SLOT,
+                                       STSE_ECC_KT_NIST_P_256, benchmark_private_key);
+
+        stse_set_default_handler_value(&benchmark_handler[i]);
+        benchmark_handler[i].device_type = STSAFE_A120;
+        benchmark_handler[i].io.busID = STSE_SCHEDULER_BENCHMARK_BUS_ID;
+        benchmark_handler[i].io.Devaddr = (PLAT_UI8)(STSE_SCHEDULER_BENCHMARK_FIRST_ADDRESS + i);
+        ret = stse_simulator_attach(&benchmark_simulator[i], &benchmark_handler[i]);
+        if (ret == STSE_OK) {
+            ret = stse_init(&benchmark_handler[i]);
+        }
+        if (ret != STSE_OK) {
+            fprintf(stderr, "device %u setup error 0x%04X\n", (unsigned int)i, ret);
+            return 1;
+        }
+    }
+
+    printf("{\"benchmark\":\"scheduler\",\"command\":\"generate_signature\",\"latency_ms\":%u,\"commands_per_device\":%u,\"results\":[",
+           (unsigned int)benchmark_simulator[0].cmd_latency[STSAFEA_CMD_GENERATE_SIGNATURE], (unsigned int)commands);
+    for (device_count = 1; device_count <= max_devices; device_count++) {
+        ret = stse_scheduler_benchmark_run(0, device_count, (PLAT_UI8)commands, &sequential_ms);
+        if (ret == STSE_OK) {
+            ret = stse_scheduler_benchmark_run(1, device_count, (PLAT_UI8)commands, &scheduled_ms);
+        }
+        if ((ret != STSE_OK) || (sequential_ms == 0) || (scheduled_ms == 0)) {
+            fprintf(stderr, "\n%u devices run error 0x%04X\n", (unsigned int)device_count, ret);
+            return 1;
+        }
+
+        sequential_ops = (1000.0 * device_count * commands) / sequential_ms;
+        scheduled_ops = (1000.0 * device_count * commands) / scheduled_ms;
+        if (device_count == 1) {
+            single_device_ops = scheduled_ops;
+        }
+        printf("%s{\"devices\":%u,\"sequential_ops_per_s\":%.1f,\"scheduled_ops_per_s\":%.1f,\"speedup\":%.2f,\"scaling\":%.2f}",
+               (device_count == 1) ? "" : ",", (unsigned int)device_count, sequential_ops, scheduled_ops,
+               scheduled_ops / sequential_ops, scheduled_ops / single_device_ops);
+    }
+    printf("]}\n");
+
+    for (i = 0; i < max_devices; i++) {
+        stse_simulator_detach(&benchmark_simulator[i]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,300 @@
+/*!
+ * ******************************************************************************
+ * \file	stse_session_mac_benchmark.c
+ * \brief   STSELib host session C-MAC computation microbenchmark
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details Host CPU time spent computing the C-MAC of a host session command frame , for frame payloads from
+ *          32 to 752 bytes (update data zone like frame : header , option , zone index , offset and data elements).
+ *          Each size is measured twice :
+ *          - bytewise  : reference feeder copying every frame byte in a 16 bytes block and appending each
+ *                        complete block to the platform AES CMAC context (library behavior before block-wise
+ *                        feeding)
+ *          - blockwise : library C-MAC computation (stsafea_session_transfer_prepare) passing whole AES blocks
+ *                        straight from the frame element buffers
+ *          Both tags are compared before measurement. The speedup depends on the platform AES CMAC append cost.
+ *          When built with STSE_CONF_USE_HOST_SESSION_KEY_HANDLES , the library C-MAC uses the pre-expanded session
+ *          MAC key while the bytewise reference still initializes the CMAC from the raw key.
+ *          Build   : stse_session_mac_benchmark and stse_session_mac_benchmark_key_handles targets of the repository
+ *                    root CMake project (tools/CMakeLists.txt)
+ *                    (STSE_CONF_STSAFE_A_SUPPORT and STSE_CONF_USE_HOST_SESSION required)
+ *          Usage   : stse_session_mac_benchmark [-n computations] [-r rounds]
+ *                    -n  number of C-MAC computations per round and frame size (default 20000)
+ *                    -r  number of measurement rounds , the fastest round is reported (default 5)
+ *          Output  : one JSON object , e.g.
+ *                    {"benchmark":"session_cmac","key_handles":false,"computations":20000,"results":[
+ *                     {"payload_bytes":32,"bytewise_ns":1530.2,"blockwise_ns":1012.8,"speedup":1.51}, ...]}
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "stselib.h"
+
+#if !defined(STSE_CONF_STSAFE_A_SUPPORT) || !defined(STSE_CONF_USE_HOST_SESSION)
+#error "stse_session_mac_benchmark requires STSE_CONF_STSAFE_A_SUPPORT and STSE_CONF_USE_HOST_SESSION"
+#endif
+
+#define STSE_SESSION_MAC_BENCHMARK_DEFAULT_COMPUTATIONS 20000U
+#define STSE_SESSION_MAC_BENCHMARK_DEFAULT_ROUNDS 5U
+#define STSE_SESSION_MAC_BENCHMARK_MAX_PAYLOAD 752U
+#define STSE_SESSION_MAC_BENCHMARK_FIELDS_LENGTH 5U /* option (1) , zone index (2) , offset (2) */
+#define STSE_SESSION_MAC_BENCHMARK_CMD_HEADER 0xE5U /* protected update data zone */
+#define STSE_SESSION_MAC_BENCHMARK_AES_BLOCK_SIZE 16U
+
+static const PLAT_UI16 benchmark_payload_lengths[] = {32, 64, 128, 256, 512, 752};
+
+static stse_Handler_t benchmark_handler;
+static stse_session_t benchmark_session;
+static PLAT_UI8 benchmark_mac_key[STSE_AES_128_KEY_SIZE] = {
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF};
+static PLAT_UI8 benchmark_fields[STSE_SESSION_MAC_BENCHMARK_FIELDS_LENGTH] = {0x00, 0x00, 0x01, 0x00, 0x00};
+static PLAT_UI8 benchmark_data[STSE_SESSION_MAC_BENCHMARK_MAX_PAYLOAD];
+
+static double stse_session_mac_benchmark_time_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+
+    return ((double)ts.tv_sec * 1000000000.0) + (double)ts.tv_nsec;
+}
+
+/* Bytewise reference --------------------------------------------------------*/
+
+static stse_ReturnCode_t stse_session_mac_benchmark_bytewise(stse_frame_t *pCmdFrame, PLAT_UI8 *pMAC) {
+    stse_ReturnCode_t ret;
+    stse_platform_aes_cmac_ctx_t cmac_ctx;
+    PLAT_UI8 aes_cmac_block[STSE_SESSION_MAC_BENCHMARK_AES_BLOCK_SIZE];
+    PLAT_UI8 aes_block_idx = 0;
+    PLAT_UI8 mac_type = 0x00;
+    PLAT_UI8 mac_length;
+    PLAT_UI16 cmd_payload_length = pCmdFrame->length - pCmdFrame->first_element->length;
+    stse_frame_element_t *pElement;
+    PLAT_UI16 i;
+
+    stse_frame_allocate(c_mac_frame);
+    stse_frame_element_allocate_push(&c_mac_frame, eMACType, 1, &mac_type);
+    stse_frame_element_allocate_push(&c_mac_frame, eCMD_HEADER, pCmdFrame->first_element->length, pCmdFrame->first_element->pData);
+    stse_frame_element_allocate_push(&c_mac_frame, eCmdPayloadLength, STSAFEA_CMD_RSP_LEN_SIZE, (PLAT_UI8 *)&cmd_payload_length);
+    stse_frame_element_swap_byte_order(&eCmdPayloadLength);
+    eCmdPayloadLength.next = pCmdFrame->first_element->next;
+
+    ret = stse_platform_aes_cmac_ctx_init(&cmac_ctx, benchmark_mac_key, STSE_AES_128_KEY_SIZE, STSAFEA_MAC_SIZE);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+
+    /* - First block : MAC counter , C-MAC subject and padding */
+    memset(aes_cmac_block, 0x00, sizeof(aes_cmac_block));
+    aes_cmac_block[0] = UI32_B3(benchmark_session.context.host.MAC_counter);
+    aes_cmac_block[1] = UI32_B2(benchmark_session.context.host.MAC_counter);
+    aes_cmac_block[2] = UI32_B1(benchmark_session.context.host.MAC_counter);
+    aes_cmac_block[3] = UI32_B0(benchmark_session.context.host.MAC_counter);
+    aes_cmac_block[5] = 0x80;
+    ret = stse_platform_aes_cmac_ctx_append(&cmac_ctx, aes_cmac_block, STSE_SESSION_MAC_BENCHMARK_AES_BLOCK_SIZE);
+    if (ret != STSE_OK) {
+        stse_platform_aes_cmac_ctx_abort(&cmac_ctx);
+        return ret;
+    }
+
+    pElement = c_mac_frame.first_element;
+    while (pElement != NULL) {
+        for (i = 0; i < pElement->length; i++) {
+            if (aes_block_idx == STSE_SESSION_MAC_BENCHMARK_AES_BLOCK_SIZE) {
+                stse_platform_aes_cmac_ctx_append(&cmac_ctx, aes_cmac_block, STSE_SESSION_MAC_BENCHMARK_AES_BLOCK_SIZE);
+                aes_block_idx = 0;
+            }
+            aes_cmac_block[aes_block_idx] = *(pElement->pData + i);
+            aes_block_idx++;
+        }
+        pElement = pElement->next;
+    }
+    if (aes_block_idx != 0) {
+        ret = stse_platform_aes_cmac_ctx_append(&cmac_ctx, aes_cmac_block, aes_block_idx);
+        if (ret != STSE_OK) {
+            stse_platform_aes_cmac_ctx_abort(&cmac_ctx);
+            return ret;
+        }
+    }
+
+    ret = stse_platform_aes_cmac_ctx_compute_finish(&cmac_ctx, aes_cmac_block, &mac_length);
+    memcpy(pMAC, aes_cmac_block, STSAFEA_MAC_SIZE);
+
+    return ret;
+}
+
+/* Library block-wise C-MAC --------------------------------------------------*/
+
+static stse_ReturnCode_t stse_session_mac_benchmark_blockwise(stse_frame_t *pCmdFrame, stse_frame_t *pRspFrame, PLAT_UI8 *pMAC) {
+    stse_ReturnCode_t ret;
+    stsafea_session_transfer_ctx_t transfer_ctx;
+
+    ret = stsafea_session_transfer_prepare(&transfer_ctx, &benchmark_session, pCmdFrame, pRspFrame, 0, 0, NULL, NULL);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+
+    /* - Detach C-MAC and R-MAC elements for next computation */
+    stse_frame_pop_element(pCmdFrame);
+    stse_frame_pop_element(pRspFrame);
+    memcpy(pMAC, transfer_ctx.Cmd_MAC, STSAFEA_MAC_SIZE);
+
+    return ret;
+}
+
+static double stse_session_mac_benchmark_measure(PLAT_UI8 blockwise,
+                                                 stse_frame_t *pCmdFrame,
+                                                 stse_frame_t *pRspFrame,
+                                                 PLAT_UI32 computations,
+                                                 PLAT_UI32 rounds,
+                                                 stse_ReturnCode_t *pRet) {
+    PLAT_UI8 mac[STSAFEA_MAC_SIZE];
+    double round_start;
+    double round_ns;
+    double best_ns = 0;
+    PLAT_UI32 round;
+    PLAT_UI32 i;
+
+    *pRet = STSE_OK;
+    for (round = 0; (round < rounds) && (*pRet == STSE_OK); round++) {
+        round_start = stse_session_mac_benchmark_time_ns();
+        for (i = 0; (i < computations) && (*pRet == STSE_OK); i++) {
+            if (blockwise != 0) {
+                *pRet = stse_session_mac_benchmark_blockwise(pCmdFrame, pRspFrame, mac);
+            } else {
+                *pRet = stse_session_mac_benchmark_bytewise(pCmdFrame, mac);
+            }
+        }
+        round_ns = stse_session_mac_benchmark_time_ns() - round_start;
+        if ((round == 0) || (round_ns < best_ns)) {
+            best_ns = round_ns;
+        }
+    }
+
+    return best_ns / computations;
+}
+
+int main(int argc, char **argv) {
+    stse_ReturnCode_t ret = STSE_OK;
+    PLAT_UI32 computations = STSE_SESSION_MAC_BENCHMARK_DEFAULT_COMPUTATIONS;
+    PLAT_UI32 rounds = STSE_SESSION_MAC_BENCHMARK_DEFAULT_ROUNDS;
+    PLAT_UI8 cmd_header = STSE_SESSION_MAC_BENCHMARK_CMD_HEADER;
+    PLAT_UI8 rsp_header;
+    PLAT_UI8 bytewise_mac[STSAFEA_MAC_SIZE];
+    PLAT_UI8 blockwise_mac[STSAFEA_MAC_SIZE];
+    double bytewise_ns;
+    double blockwise_ns;
+    PLAT_UI16 data_length;
+    PLAT_UI8 size_idx;
+    PLAT_UI16 i;
+    int arg;
+#ifdef STSE_CONF_USE_HOST_SESSION_KEY_HANDLES
+    stse_platform_aes_key_handle_t key_handle;
+#endif /* STSE_CONF_USE_HOST_SESSION_KEY_HANDLES */
+
+    for (arg = 1; arg < argc; arg++) {
+        if ((strcmp(argv[arg], "-n") == 0) && (arg + 1 < argc)) {
+            computations = (PLAT_UI32)strtoul(argv[++arg], NULL, 0);
+        } else if ((strcmp(argv[arg], "-r") == 0) && (arg + 1 < argc)) {
+            rounds = (PLAT_UI32)strtoul(argv[++arg], NULL, 0);
+        } else {
+            fprintf(stderr, "usage: %s [-n computations] [-r rounds]\n", argv[0]);
+            return 1;
+        }
+    }
+    if ((computations == 0) || (rounds == 0)) {
+        fprintf(stderr, "computations and rounds must be non zero\n");
+        return 1;
+    }
+
+    for (i = 0; i < sizeof(benchmark_data); i++) {
+        benchmark_data[i] = (PLAT_UI8)i;
+    }
+    stse_platform_crypto_init();
+
+    /* - A120 host session with AES-128 keys */
+    stse_set_default_handler_value(&benchmark_handler);
+    benchmark_handler.device_type = STSAFE_A120;
+    benchmark_session.type = STSE_HOST_SESSION;
+    benchmark_session.context.host.pSTSE = &benchmark_handler;
+    benchmark_session.context.host.pHost_MAC_key = benchmark_mac_key;
+    benchmark_session.context.host.pHost_cypher_key = benchmark_mac_key;
+    benchmark_session.context.host.key_type = STSE_AES_128_KT;
+    benchmark_session.context.host.MAC_counter = 0x12345678;
+#ifdef STSE_CONF_USE_HOST_SESSION_KEY_HANDLES
+    ret = stse_platform_aes_key_handle_create(benchmark_mac_key, STSE_AES_128_KEY_SIZE, &key_handle);
+    if (ret != STSE_OK) {
+        fprintf(stderr, "key handle creation error 0x%04X\n", ret);
+        return 1;
+    }
+    benchmark_session.context.host.pHost_MAC_key_handle = key_handle;
+    benchmark_session.context.host.pHost_cypher_key_handle = key_handle;
+#endif /* STSE_CONF_USE_HOST_SESSION_KEY_HANDLES */
+
+    printf("{\"benchmark\":\"session_cmac\",\"key_handles\":%s,\"computations\":%u,\"results\":[",
+#ifdef STSE_CONF_USE_HOST_SESSION_KEY_HANDLES
+           "true",
+#else
+           "false",
+#endif /* STSE_CONF_USE_HOST_SESSION_KEY_HANDLES */
+           (unsigned int)computations);
+    for (size_idx = 0; (size_idx < (sizeof(benchmark_payload_lengths) / sizeof(benchmark_payload_lengths[0]))) && (ret == STSE_OK); size_idx++) {
+        data_length = benchmark_payload_lengths[size_idx] - STSE_SESSION_MAC_BENCHMARK_FIELDS_LENGTH;
+
+        stse_frame_allocate(CmdFrame);
+        stse_frame_element_allocate_push(&CmdFrame, eCmd_header, STSAFEA_HEADER_SIZE, &cmd_header);
+        stse_frame_element_allocate_push(&CmdFrame, eOption, 1, &benchmark_fields[0]);
+        stse_frame_element_allocate_push(&CmdFrame, eZone_index, 2, &benchmark_fields[1]);
+        stse_frame_element_allocate_push(&CmdFrame, eOffset, 2, &benchmark_fields[3]);
+        stse_frame_element_allocate_push(&CmdFrame, eData, data_length, benchmark_data);
+
+        stse_frame_allocate(RspFrame);
+        stse_frame_element_allocate_push(&RspFrame, eRsp_header, STSAFEA_HEADER_SIZE, &rsp_header);
+
+        /* - Check both feeders produce the same C-MAC */
+        ret = stse_session_mac_benchmark_bytewise(&CmdFrame, bytewise_mac);
+        if (ret == STSE_OK) {
+            ret = stse_session_mac_benchmark_blockwise(&CmdFrame, &RspFrame, blockwise_mac);
+        }
+        if ((ret == STSE_OK) && (memcmp(bytewise_mac, blockwise_mac, STSAFEA_MAC_SIZE) != 0)) {
+            fprintf(stderr, "C-MAC mismatch for %u bytes payload\n", benchmark_payload_lengths[size_idx]);
+            return 1;
+        }
+
+        if (ret == STSE_OK) {
+            bytewise_ns = stse_session_mac_benchmark_measure(0, &CmdFrame, &RspFrame, computations, rounds, &ret);
+        }
+        if (ret == STSE_OK) {
+            blockwise_ns = stse_session_mac_benchmark_measure(1, &CmdFrame, &RspFrame, computations, rounds, &ret);
+        }
+        if (ret == STSE_OK) {
+            printf("%s{\"payload_bytes\":%u,\"bytewise_ns\":%.1f,\"blockwise_ns\":%.1f,\"speedup\":%.2f}",
+                   (size_idx == 0) ? "" : ",",
+                   benchmark_payload_lengths[size_idx],
+                   bytewise_ns,
+                   blockwise_ns,
+                   bytewise_ns / blockwise_ns);
+        }
+    }
+    if (ret != STSE_OK) {
+        fprintf(stderr, "C-MAC computation error 0x%04X\n", ret);
+        return 1;
+    }
+    printf("]}\n");
+
+    return 0;
+}
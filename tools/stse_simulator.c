@@ -0,0 +1,1515 @@
+/*!
+ * ******************************************************************************
+ * \file	stse_simulator.c
+ * \brief   STSAFE-A software device simulator (sources)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details Build : add this file to the host test application built with the library sources and a host platform
+ *          abstraction layer , e.g. cc -I.. -I<conf> app.c stse_simulator.c <library sources> <platform sources>
+ *
+ *          Usage :
+ *          \code
+ *          stse_simulator_t sim;
+ *          stse_set_default_handler_value(&stse_handler);
+ *          stse_handler.device_type = STSAFE_A120;
+ *          stse_simulator_init(&sim, STSAFE_A120);
+ *          sim.pGet_time_ms = host_time_ms;              // optional processing latency model
+ *          stse_simulator_attach(&sim, &stse_handler);
+ *          stse_init(&stse_handler);
+ *          \endcode
+ */
+
+#include <string.h>
+
+#include "tools/stse_simulator.h"
+#include "core/stse_crc16.h"
+#include "services/stsafea/stsafea_data_partition.h"
+#include "services/stsafea/stsafea_hash.h"
+
+#ifdef STSE_CONF_STSAFE_A_SUPPORT
+
+#ifndef STSE_CONF_USE_BUILTIN_CRC16
+#error "stse_simulator requires STSE_CONF_USE_BUILTIN_CRC16"
+#endif /* STSE_CONF_USE_BUILTIN_CRC16 */
+
+#define STSE_SIMULATOR_SUB_TAG_MASK_ID 0x01U
+#define STSE_SIMULATOR_AES_BLOCK_SIZE 16U
+#define STSE_SIMULATOR_SUBJECT_HOST_CMAC 0x00U
+#define STSE_SIMULATOR_SUBJECT_HOST_RMAC 0x40U
+#define STSE_SIMULATOR_SUBJECT_CMD_ENCRYPT 0x80U
+#define STSE_SIMULATOR_SUBJECT_RSP_ENCRYPT 0xC0U
+#define STSE_SIMULATOR_SUB_COMMAND_DISTINGUISHER 0x02U
+#define STSE_SIMULATOR_RSP_PAYLOAD_OFFSET (STSE_RSP_FRAME_HEADER_SIZE + STSE_FRAME_LENGTH_SIZE)
+
+static stse_simulator_t *stse_simulator_registry[STSE_SIMULATOR_MAX_DEVICES];
+
+static const PLAT_UI8 stse_simulator_mask_id[STSAFEA_PRODUCT_COUNT][STSAFEA_MASK_ID_SIZE] = {
+    {0x00, 0x40, 0x00}, /* STSAFE-A100 */
+    {0x00, 0x46, 0x00}, /* STSAFE-A110 */
+    {0x00, 0x60, 0x00}, /* STSAFE-A120 */
+};
+
+static const PLAT_UI16 stse_simulator_max_frame_length[STSAFEA_PRODUCT_COUNT] = {
+    STSAFEA_MAX_FRAME_LENGTH_A100,
+    STSAFEA_MAX_FRAME_LENGTH_A110,
+    STSAFEA_MAX_FRAME_LENGTH_A120,
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+static stse_simulator_t *stse_simulator_get(PLAT_UI8 busID, PLAT_UI8 devAddr) {
+    PLAT_UI8 i;
+
+    for (i = 0; i < STSE_SIMULATOR_MAX_DEVICES; i++) {
+        if ((stse_simulator_registry[i] != NULL) &&
+            (stse_simulator_registry[i]->busID == busID) &&
+            (stse_simulator_registry[i]->devAddr == devAddr)) {
+            return stse_simulator_registry[i];
+        }
+    }
+
+    return NULL;
+}
+
+static PLAT_UI8 stse_simulator_product_index(stse_simulator_t *pSim) {
+    return (PLAT_UI8)(pSim->device_type - STSE_DEVICE_STSAFEA_FAMILY_INDEX);
+}
+
+static PLAT_UI8 stse_simulator_is_busy(stse_simulator_t *pSim) {
+    if (pSim->pGet_time_ms == NULL) {
+        return 0;
+    }
+
+    return ((PLAT_I32)(pSim->pGet_time_ms() - pSim->rsp_ready_time) < 0) ? 1 : 0;
+}
+
+static PLAT_UI16 stse_simulator_zone_access_check(stse_zone_ac_t zone_ac, PLAT_UI8 authenticated) {
+    switch (zone_ac) {
+    case STSE_AC_ALWAYS:
+        return STSE_OK;
+    case STSE_AC_HOST:
+        return (authenticated != 0) ? STSE_OK : STSE_ACCESS_CONDITION_NOT_SATISFIED;
+    default:
+        return STSE_ACCESS_CONDITION_NOT_SATISFIED;
+    }
+}
+
+#ifdef STSE_CONF_USE_HOST_SESSION
+
+static PLAT_UI8 stse_simulator_host_key_length(stse_simulator_t *pSim) {
+    return (pSim->host_key_type == STSE_AES_128_KT) ? STSE_AES_128_KEY_SIZE : STSE_AES_256_KEY_SIZE;
+}
+
+static void stse_simulator_session_block(stse_simulator_t *pSim,
+                                         PLAT_UI32 counter,
+                                         PLAT_UI8 subject,
+                                         PLAT_UI8 *pBlock) {
+    PLAT_UI8 i = 0;
+
+    memset(pBlock, 0x00, STSE_SIMULATOR_AES_BLOCK_SIZE);
+    if (pSim->device_type == STSAFE_A120) {
+        pBlock[i++] = UI32_B3(counter);
+    }
+    pBlock[i++] = UI32_B2(counter);
+    pBlock[i++] = UI32_B1(counter);
+    pBlock[i++] = UI32_B0(counter);
+    pBlock[i++] = subject;
+    pBlock[i] = 0x80;
+}
+
+static stse_ReturnCode_t stse_simulator_mac_compute(stse_simulator_t *pSim,
+                                                    PLAT_UI8 subject,
+                                                    PLAT_UI16 length,
+                                                    PLAT_UI8 *pMAC) {
+    stse_ReturnCode_t ret;
+    PLAT_UI16 mac_length;
+    PLAT_UI8 mac[STSE_SIMULATOR_AES_BLOCK_SIZE];
+
+    /* - MAC input is prepared in work buffer after the session block */
+    stse_simulator_session_block(pSim, pSim->host_MAC_counter, subject, pSim->work_buffer);
+
+    /* - One-shot computation : does not use the platform CMAC sequence of the library under test */
+    ret = stse_platform_aes_cmac_compute(pSim->work_buffer, STSE_SIMULATOR_AES_BLOCK_SIZE + length,
+                                         pSim->host_MAC_key, stse_simulator_host_key_length(pSim),
+                                         STSAFEA_MAC_SIZE, mac, &mac_length);
+
+    memcpy(pMAC, mac, STSAFEA_MAC_SIZE);
+
+    return ret;
+}
+
+static PLAT_UI16 stse_simulator_mac_input_push(PLAT_UI8 *pBuffer,
+                                               const PLAT_UI8 *pHeader,
+                                               PLAT_UI8 header_length,
+                                               const PLAT_UI8 *pPayload,
+                                               PLAT_UI16 payload_length) {
+    PLAT_UI16 i = 0;
+
+    memcpy(&pBuffer[i], pHeader, header_length);
+    i += header_length;
+    pBuffer[i++] = UI16_B1(payload_length);
+    pBuffer[i++] = UI16_B0(payload_length);
+    memcpy(&pBuffer[i], pPayload, payload_length);
+
+    return i + payload_length;
+}
+
+static stse_ReturnCode_t stse_simulator_cipher_iv(stse_simulator_t *pSim,
+                                                  PLAT_UI32 counter,
+                                                  PLAT_UI8 subject,
+                                                  PLAT_UI8 *pIV) {
+    PLAT_UI8 block[STSE_SIMULATOR_AES_BLOCK_SIZE];
+    PLAT_UI16 iv_length;
+
+    stse_simulator_session_block(pSim, counter, subject, block);
+
+    return stse_platform_aes_ecb_enc(block, STSE_SIMULATOR_AES_BLOCK_SIZE,
+                                     pSim->host_cipher_key, stse_simulator_host_key_length(pSim),
+                                     pIV, &iv_length);
+}
+
+static stse_ReturnCode_t stse_simulator_cmd_decrypt(stse_simulator_t *pSim,
+                                                    PLAT_UI8 **ppPayload,
+                                                    PLAT_UI16 *pPayload_length) {
+    stse_ReturnCode_t ret;
+    PLAT_UI8 iv[STSE_SIMULATOR_AES_BLOCK_SIZE];
+    PLAT_UI16 plaintext_length;
+
+    if ((*pPayload_length == 0) || ((*pPayload_length % STSE_SIMULATOR_AES_BLOCK_SIZE) != 0)) {
+        return STSE_COMMAND_DECRYPTION_ERROR;
+    }
+
+    /* - Command is encrypted with the incremented C-MAC sequence counter */
+    ret = stse_simulator_cipher_iv(pSim, pSim->host_MAC_counter + 1, STSE_SIMULATOR_SUBJECT_CMD_ENCRYPT, iv);
+    if (ret == STSE_OK) {
+        ret = stse_platform_aes_cbc_dec(*ppPayload, *pPayload_length, iv,
+                                        pSim->host_cipher_key, stse_simulator_host_key_length(pSim),
+                                        pSim->payload_buffer, &plaintext_length);
+    }
+    if (ret != STSE_OK) {
+        return STSE_COMMAND_DECRYPTION_ERROR;
+    }
+
+    /* - Remove 0x80 0x00 .. 0x00 padding (received frame is kept for R-MAC computation) */
+    while ((plaintext_length > 0) && (pSim->payload_buffer[plaintext_length - 1] == 0x00)) {
+        plaintext_length--;
+    }
+    if ((plaintext_length == 0) || (pSim->payload_buffer[plaintext_length - 1] != 0x80)) {
+        return STSE_COMMAND_DECRYPTION_ERROR;
+    }
+
+    *ppPayload = pSim->payload_buffer;
+    *pPayload_length = plaintext_length - 1;
+
+    return STSE_OK;
+}
+
+static stse_ReturnCode_t stse_simulator_rsp_encrypt(stse_simulator_t *pSim,
+                                                    PLAT_UI8 *pPayload,
+                                                    PLAT_UI16 *pPayload_length) {
+    stse_ReturnCode_t ret;
+    PLAT_UI8 iv[STSE_SIMULATOR_AES_BLOCK_SIZE];
+    PLAT_UI16 padded_length = *pPayload_length;
+    PLAT_UI16 encrypted_length;
+
+    pPayload[padded_length++] = 0x80;
+    while ((padded_length % STSE_SIMULATOR_AES_BLOCK_SIZE) != 0) {
+        pPayload[padded_length++] = 0x00;
+    }
+
+    ret = stse_simulator_cipher_iv(pSim, pSim->host_MAC_counter, STSE_SIMULATOR_SUBJECT_RSP_ENCRYPT, iv);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+
+    memcpy(pSim->work_buffer, pPayload, padded_length);
+    ret = stse_platform_aes_cbc_enc(pSim->work_buffer, padded_length, iv,
+                                    pSim->host_cipher_key, stse_simulator_host_key_length(pSim),
+                                    pPayload, &encrypted_length);
+    *pPayload_length = encrypted_length;
+
+    return ret;
+}
+
+#endif /* STSE_CONF_USE_HOST_SESSION */
+
+/* Command handlers ----------------------------------------------------------*/
+
+static PLAT_UI16 stse_simulator_query(stse_simulator_t *pSim,
+                                      PLAT_UI8 *pCmd, PLAT_UI16 cmd_length,
+                                      PLAT_UI8 *pRsp, PLAT_UI16 *pRsp_length) {
+    PLAT_UI16 i = 0;
+    PLAT_UI8 code;
+    PLAT_UI8 count = 0;
+    PLAT_UI8 count_index;
+    stse_cmd_access_conditions_t cmd_AC;
+    PLAT_UI8 cmd_enc;
+    PLAT_UI8 rsp_enc;
+    stse_simulator_zone_t *pZone;
+
+    if (cmd_length < 1) {
+        return STSE_INCONSISTENT_COMMAND_DATA;
+    }
+
+    switch (pCmd[0]) {
+    case STSAFEA_SUBJECT_TAG_PRODUCT_DATA:
+        pRsp[i++] = STSE_SIMULATOR_SUB_TAG_MASK_ID;
+        pRsp[i++] = STSAFEA_MASK_ID_SIZE;
+        memcpy(&pRsp[i], pSim->mask_id, STSAFEA_MASK_ID_SIZE);
+        i += STSAFEA_MASK_ID_SIZE;
+        break;
+
+    case STSAFEA_SUBJECT_TAG_COMMAND_AUTHORIZATION_CONFIG:
+        pRsp[i++] = 0x00; /* Change rights */
+        count_index = (PLAT_UI8)i++;
+        for (code = 0; code < STSAFEA_MAX_CMD_COUNT; code++) {
+            stsafea_perso_info_get_cmd_AC(&pSim->perso_info, code, &cmd_AC);
+            stsafea_perso_info_get_cmd_encrypt_flag(&pSim->perso_info, code, &cmd_enc);
+            stsafea_perso_info_get_rsp_encrypt_flag(&pSim->perso_info, code, &rsp_enc);
+            pRsp[i++] = code;
+            pRsp[i++] = (PLAT_UI8)cmd_AC;
+            pRsp[i++] = (PLAT_UI8)((cmd_enc << 1) | rsp_enc);
+            count++;
+        }
+        /* - Extended command code 0x00 can't be distinguished from a standard record by the host : not reported */
+        for (code = 1; code < STSAFEA_MAX_EXT_CMD_COUNT; code++) {
+            stsafea_perso_info_get_ext_cmd_AC(&pSim->perso_info, code, &cmd_AC);
+            stsafea_perso_info_get_ext_cmd_encrypt_flag(&pSim->perso_info, code, &cmd_enc);
+            stsafea_perso_info_get_ext_rsp_encrypt_flag(&pSim->perso_info, code, &rsp_enc);
+            pRsp[i++] = STSAFEA_EXTENDED_COMMAND_PREFIX;
+            pRsp[i++] = code;
+            pRsp[i++] = (PLAT_UI8)cmd_AC;
+            pRsp[i++] = (PLAT_UI8)((cmd_enc << 1) | rsp_enc);
+            count++;
+        }
+        pRsp[count_index] = count;
+        break;
+
+    case STSAFEA_SUBJECT_TAG_HOST_KEY_SLOT_V1:
+        pRsp[i++] = pSim->host_key_presence;
+        pRsp[i++] = UI32_B2(pSim->host_MAC_counter);
+        pRsp[i++] = UI32_B1(pSim->host_MAC_counter);
+        pRsp[i++] = UI32_B0(pSim->host_MAC_counter);
+        break;
+
+    case STSAFEA_SUBJECT_TAG_HOST_KEY_SLOT_V2:
+        pRsp[i++] = pSim->host_key_presence;
+        pRsp[i++] = (PLAT_UI8)pSim->host_key_type;
+        pRsp[i++] = UI32_B3(pSim->host_MAC_counter);
+        pRsp[i++] = UI32_B2(pSim->host_MAC_counter);
+        pRsp[i++] = UI32_B1(pSim->host_MAC_counter);
+        pRsp[i++] = UI32_B0(pSim->host_MAC_counter);
+        break;
+
+    case STSAFEA_SUBJECT_TAG_DATA_PARTITION_CONFIGURATION:
+        count_index = (PLAT_UI8)i++;
+        for (code = 0; code < STSE_SIMULATOR_MAX_ZONES; code++) {
+            pZone = &pSim->zone[code];
+            if (pZone->pData == NULL) {
+                continue;
+            }
+            pRsp[i++] = code;
+            pRsp[i++] = pZone->zone_type;
+            pRsp[i++] = (PLAT_UI8)(((pZone->read_ac << STSAFEA_ZIR_AC_READ_Pos) & STSAFEA_ZIR_AC_READ_Msk) |
+                                   ((pZone->update_ac << STSAFEA_ZIR_AC_UPDATE_Pos) & STSAFEA_ZIR_AC_UPDATE_Msk));
+            pRsp[i++] = UI16_B1(pZone->size);
+            pRsp[i++] = UI16_B0(pZone->size);
+            if (pZone->zone_type == 1) {
+                pRsp[i++] = UI32_B3(pZone->counter);
+                pRsp[i++] = UI32_B2(pZone->counter);
+                pRsp[i++] = UI32_B1(pZone->counter);
+                pRsp[i++] = UI32_B0(pZone->counter);
+            }
+            count++;
+        }
+        pRsp[count_index] = count;
+        break;
+
+    default:
+        return STSE_ENTRY_NOT_FOUND;
+    }
+
+    *pRsp_length = i;
+
+    return STSE_OK;
+}
+
+static PLAT_UI16 stse_simulator_zone_get(stse_simulator_t *pSim,
+                                         PLAT_UI8 *pCmd, PLAT_UI16 cmd_length,
+                                         PLAT_UI16 header_length,
+                                         stse_simulator_zone_t **ppZone,
+                                         PLAT_UI16 *pOffset) {
+    /* - [option][zone index][offset] */
+    if ((cmd_length < header_length) || (pCmd[1] >= STSE_SIMULATOR_MAX_ZONES) || (pSim->zone[pCmd[1]].pData == NULL)) {
+        return (cmd_length < header_length) ? STSE_INCONSISTENT_COMMAND_DATA : STSE_ENTRY_NOT_FOUND;
+    }
+
+    *ppZone = &pSim->zone[pCmd[1]];
+    *pOffset = (PLAT_UI16)((pCmd[2] << 8) + pCmd[3]);
+
+    return STSE_OK;
+}
+
+static PLAT_UI16 stse_simulator_read(stse_simulator_t *pSim,
+                                     PLAT_UI8 *pCmd, PLAT_UI16 cmd_length,
+                                     PLAT_UI8 *pRsp, PLAT_UI16 *pRsp_length,
+                                     PLAT_UI16 rsp_max_length,
+                                     PLAT_UI8 authenticated) {
+    stse_simulator_zone_t *pZone;
+    PLAT_UI16 offset;
+    PLAT_UI16 length;
+    PLAT_UI16 i = 0;
+    PLAT_UI16 status;
+
+    status = stse_simulator_zone_get(pSim, pCmd, cmd_length, 6, &pZone, &offset);
+    if (status != STSE_OK) {
+        return status;
+    }
+    status = stse_simulator_zone_access_check(pZone->read_ac, authenticated);
+    if (status != STSE_OK) {
+        return status;
+    }
+
+    length = (PLAT_UI16)((pCmd[4] << 8) + pCmd[5]);
+    if (((PLAT_UI32)offset + length) > pZone->size) {
+        return STSE_BOUNDARY_EXCEEDED;
+    }
+    if ((length + STSAFEA_COUNTER_VALUE_SIZE) > rsp_max_length) {
+        return STSE_BUFFER_LENGTH_EXCEEDED;
+    }
+
+    if (pZone->zone_type == 1) {
+        pRsp[i++] = UI32_B3(pZone->counter);
+        pRsp[i++] = UI32_B2(pZone->counter);
+        pRsp[i++] = UI32_B1(pZone->counter);
+        pRsp[i++] = UI32_B0(pZone->counter);
+    }
+    memcpy(&pRsp[i], &pZone->pData[offset], length);
+    *pRsp_length = i + length;
+
+    return STSE_OK;
+}
+
+static PLAT_UI16 stse_simulator_update(stse_simulator_t *pSim,
+                                       PLAT_UI8 *pCmd, PLAT_UI16 cmd_length,
+                                       PLAT_UI8 authenticated) {
+    stse_simulator_zone_t *pZone;
+    PLAT_UI16 offset;
+    PLAT_UI16 length;
+    PLAT_UI16 status;
+
+    status = stse_simulator_zone_get(pSim, pCmd, cmd_length, 4, &pZone, &offset);
+    if (status != STSE_OK) {
+        return status;
+    }
+    if (pZone->zone_type != 0) {
+        return STSE_WRONG_ZONE_TYPE;
+    }
+    status = stse_simulator_zone_access_check(pZone->update_ac, authenticated);
+    if (status != STSE_OK) {
+        return status;
+    }
+
+    length = cmd_length - 4;
+    if (((PLAT_UI32)offset + length) > pZone->size) {
+        return STSE_BOUNDARY_EXCEEDED;
+    }
+    memcpy(&pZone->pData[offset], &pCmd[4], length);
+
+    return STSE_OK;
+}
+
+static PLAT_UI16 stse_simulator_decrement(stse_simulator_t *pSim,
+                                          PLAT_UI8 *pCmd, PLAT_UI16 cmd_length,
+                                          PLAT_UI8 *pRsp, PLAT_UI16 *pRsp_length,
+                                          PLAT_UI8 authenticated) {
+    stse_simulator_zone_t *pZone;
+    PLAT_UI16 offset;
+    PLAT_UI16 length;
+    PLAT_UI32 amount;
+    PLAT_UI16 status;
+
+    status = stse_simulator_zone_get(pSim, pCmd, cmd_length, 8, &pZone, &offset);
+    if (status != STSE_OK) {
+        return status;
+    }
+    if (pZone->zone_type != 1) {
+        return STSE_WRONG_ZONE_TYPE;
+    }
+    status = stse_simulator_zone_access_check(pZone->update_ac, authenticated);
+    if (status != STSE_OK) {
+        return status;
+    }
+
+    amount = ((PLAT_UI32)pCmd[4] << 24) + ((PLAT_UI32)pCmd[5] << 16) + ((PLAT_UI32)pCmd[6] << 8) + pCmd[7];
+    length = cmd_length - 8;
+    if (((PLAT_UI32)offset + length) > pZone->size) {
+        return STSE_BOUNDARY_EXCEEDED;
+    }
+    if ((amount == 0) || (amount > pZone->counter)) {
+        return STSE_COUNTER_LIMIT_EXCEEDED;
+    }
+
+    pZone->counter -= amount;
+    memcpy(&pZone->pData[offset], &pCmd[8], length);
+
+    pRsp[0] = UI32_B3(pZone->counter);
+    pRsp[1] = UI32_B2(pZone->counter);
+    pRsp[2] = UI32_B1(pZone->counter);
+    pRsp[3] = UI32_B0(pZone->counter);
+    *pRsp_length = STSAFEA_COUNTER_VALUE_SIZE;
+
+    return STSE_OK;
+}
+
+static PLAT_UI16 stse_simulator_hash(stse_simulator_t *pSim,
+                                     PLAT_UI8 ext_cmd_code,
+                                     PLAT_UI8 *pCmd, PLAT_UI16 cmd_length,
+                                     PLAT_UI8 *pRsp, PLAT_UI16 *pRsp_length) {
+    PLAT_UI16 digest_length;
+    PLAT_UI8 algorithm;
+
+    if (ext_cmd_code == STSAFEA_EXTENDED_CMD_START_HASH) {
+        if (cmd_length < STSAFEA_HASH_ALGO_ID_SIZE) {
+            return STSE_INCONSISTENT_COMMAND_DATA;
+        }
+        for (algorithm = 0; algorithm < (PLAT_UI8)STSE_SHA_INVALID; algorithm++) {
+            if (memcmp(&stsafea_hash_info_table[algorithm].id, pCmd, STSAFEA_HASH_ALGO_ID_SIZE) == 0) {
+                break;
+            }
+        }
+        if (algorithm == (PLAT_UI8)STSE_SHA_INVALID) {
+            return STSE_INCONSISTENT_COMMAND_DATA;
+        }
+        pSim->hash_algorithm = algorithm;
+        pSim->hash_active = 1;
+        pSim->hash_length = 0;
+        pCmd += STSAFEA_HASH_ALGO_ID_SIZE;
+        cmd_length -= STSAFEA_HASH_ALGO_ID_SIZE;
+    } else if (pSim->hash_active == 0) {
+        return STSE_INCONSISTENT_COMMAND_DATA;
+    }
+
+    if ((pSim->hash_length + cmd_length) > STSE_SIMULATOR_HASH_BUFFER_SIZE) {
+        pSim->hash_active = 0;
+        return STSE_BUFFER_LENGTH_EXCEEDED;
+    }
+    memcpy(&pSim->hash_buffer[pSim->hash_length], pCmd, cmd_length);
+    pSim->hash_length += cmd_length;
+
+    if (ext_cmd_code == STSAFEA_EXTENDED_CMD_FINISH_HASH) {
+        pSim->hash_active = 0;
+        if (stse_platform_hash_compute((stse_hash_algorithm_t)pSim->hash_algorithm,
+                                       pSim->hash_buffer, pSim->hash_length,
+                                       &pRsp[STSAFEA_GENERIC_LENGTH_SIZE], &digest_length) != STSE_OK) {
+            return STSE_UNEXPECTED_ERROR;
+        }
+        pRsp[0] = UI16_B1(digest_length);
+        pRsp[1] = UI16_B0(digest_length);
+        *pRsp_length = STSAFEA_GENERIC_LENGTH_SIZE + digest_length;
+    }
+
+    return STSE_OK;
+}
+
+#if defined(STSE_CONF_ECC_NIST_P_256) || defined(STSE_CONF_ECC_NIST_P_384) || defined(STSE_CONF_ECC_NIST_P_521) ||                \
+    defined(STSE_CONF_ECC_BRAINPOOL_P_256) || defined(STSE_CONF_ECC_BRAINPOOL_P_384) || defined(STSE_CONF_ECC_BRAINPOOL_P_512) || \
+    defined(STSE_CONF_ECC_CURVE_25519) || defined(STSE_CONF_ECC_EDWARD_25519)
+
+static PLAT_UI16 stse_simulator_generate_signature(stse_simulator_t *pSim,
+                                                   PLAT_UI8 *pCmd, PLAT_UI16 cmd_length,
+                                                   PLAT_UI8 *pRsp, PLAT_UI16 *pRsp_length) {
+    stse_simulator_private_key_t *pKey;
+    PLAT_UI16 message_length;
+    PLAT_UI16 half_signature_size;
+    PLAT_UI8 signature[2U * STSE_ECC_GENERIC_LENGTH_SIZE + 2U * 66U];
+
+    /* - [slot][message length][message] */
+    if (cmd_length < 3) {
+        return STSE_INCONSISTENT_COMMAND_DATA;
+    }
+    message_length = (PLAT_UI16)((pCmd[1] << 8) + pCmd[2]);
+    if ((message_length + 3U) != cmd_length) {
+        return STSE_INCONSISTENT_COMMAND_DATA;
+    }
+    if ((pCmd[0] >= STSE_SIMULATOR_MAX_PRIVATE_KEY_SLOTS) || (pSim->private_key[pCmd[0]].pPrivate_key == NULL)) {
+        return STSE_KEY_NOT_FOUND;
+    }
+    if (pSim->pEcc_sign == NULL) {
+        return STSE_COMMAND_CODE_NOT_SUPPORTED;
+    }
+
+    pKey = &pSim->private_key[pCmd[0]];
+    if (pSim->pEcc_sign(pKey->key_type, pKey->pPrivate_key, &pCmd[3], message_length, signature) != STSE_OK) {
+        return STSE_UNEXPECTED_ERROR;
+    }
+
+    /* - [R length][R][S length][S] */
+    half_signature_size = stse_ecc_info_table[pKey->key_type].signature_size >> 1;
+    pRsp[0] = UI16_B1(half_signature_size);
+    pRsp[1] = UI16_B0(half_signature_size);
+    memcpy(&pRsp[2], signature, half_signature_size);
+    pRsp[2 + half_signature_size] = UI16_B1(half_signature_size);
+    pRsp[3 + half_signature_size] = UI16_B0(half_signature_size);
+    memcpy(&pRsp[4 + half_signature_size], &signature[half_signature_size], half_signature_size);
+    *pRsp_length = 4U + 2U * half_signature_size;
+
+    return STSE_OK;
+}
+
+static PLAT_UI16 stse_simulator_verify_signature(PLAT_UI8 *pCmd, PLAT_UI16 cmd_length,
+                                                 PLAT_UI8 *pRsp, PLAT_UI16 *pRsp_length) {
+    stse_ecc_key_type_t key_type;
+    PLAT_UI8 public_key[2U * 66U];
+    PLAT_UI8 signature[2U * 66U];
+    PLAT_UI16 coordinate_size;
+    PLAT_UI16 half_signature_size;
+    PLAT_UI16 curve_id_length;
+    PLAT_UI16 message_length;
+    PLAT_UI16 i = 1; /* Skip subject */
+    PLAT_UI16 expected_length;
+
+    if (cmd_length < 3) {
+        return STSE_INCONSISTENT_COMMAND_DATA;
+    }
+
+    /* - [subject][curve id][public key][signature R][signature S]([EdDSA variant])[message length][message] */
+    curve_id_length = (PLAT_UI16)((pCmd[i] << 8) + pCmd[i + 1]);
+    i += STSE_ECC_CURVE_ID_LENGTH_SIZE;
+    if (((i + curve_id_length) > cmd_length) ||
+        (stse_get_ecc_key_type_from_curve_id((PLAT_UI8)curve_id_length, &pCmd[i], &key_type) != STSE_OK)) {
+        return STSE_INCONSISTENT_COMMAND_DATA;
+    }
+    i += curve_id_length;
+
+    coordinate_size = stse_ecc_info_table[key_type].coordinate_or_key_size;
+    half_signature_size = stse_ecc_info_table[key_type].signature_size >> 1;
+#ifdef STSE_CONF_ECC_EDWARD_25519
+    if (key_type == STSE_ECC_KT_ED25519) {
+        expected_length = i + STSE_ECC_GENERIC_LENGTH_SIZE + coordinate_size +
+                          2U * (STSE_ECC_GENERIC_LENGTH_SIZE + half_signature_size) + 1U + STSAFEA_GENERIC_LENGTH_SIZE;
+    } else
+#endif /* STSE_CONF_ECC_EDWARD_25519 */
+    {
+        expected_length = i + 1U + 2U * (STSE_ECC_GENERIC_LENGTH_SIZE + coordinate_size) +
+                          2U * (STSE_ECC_GENERIC_LENGTH_SIZE + half_signature_size) + STSAFEA_GENERIC_LENGTH_SIZE;
+    }
+    if (expected_length > cmd_length) {
+        return STSE_INCONSISTENT_COMMAND_DATA;
+    }
+
+#ifdef STSE_CONF_ECC_EDWARD_25519
+    if (key_type == STSE_ECC_KT_ED25519) {
+        i += STSE_ECC_GENERIC_LENGTH_SIZE;
+        memcpy(public_key, &pCmd[i], coordinate_size);
+        i += coordinate_size;
+    } else
+#endif /* STSE_CONF_ECC_EDWARD_25519 */
+    {
+        i += 1U + STSE_ECC_GENERIC_LENGTH_SIZE; /* Point representation + X length */
+        memcpy(public_key, &pCmd[i], coordinate_size);
+        i += coordinate_size + STSE_ECC_GENERIC_LENGTH_SIZE;
+        memcpy(&public_key[coordinate_size], &pCmd[i], coordinate_size);
+        i += coordinate_size;
+    }
+    i += STSE_ECC_GENERIC_LENGTH_SIZE;
+    memcpy(signature, &pCmd[i], half_signature_size);
+    i += half_signature_size + STSE_ECC_GENERIC_LENGTH_SIZE;
+    memcpy(&signature[half_signature_size], &pCmd[i], half_signature_size);
+    i += half_signature_size;
+#ifdef STSE_CONF_ECC_EDWARD_25519
+    if (key_type == STSE_ECC_KT_ED25519) {
+        i++; /* EdDSA variant */
+    }
+#endif /* STSE_CONF_ECC_EDWARD_25519 */
+
+    message_length = (PLAT_UI16)((pCmd[i] << 8) + pCmd[i + 1]);
+    i += STSAFEA_GENERIC_LENGTH_SIZE;
+    if ((i + message_length) != cmd_length) {
+        return STSE_INCONSISTENT_COMMAND_DATA;
+    }
+
+    pRsp[0] = (stse_platform_ecc_verify(key_type, public_key, &pCmd[i], message_length, signature) == STSE_OK)
+                  ? STSAFEA_TRUE
+                  : STSAFEA_FALSE;
+    *pRsp_length = 1;
+
+    return STSE_OK;
+}
+
+#endif /* STSE_CONF_ECC_* */
+
+#if defined(STSE_CONF_USE_HOST_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT) || \
+    defined(STSE_CONF_USE_HOST_SESSION)
+
+static void stse_simulator_gf128_multiply(PLAT_UI8 *pX, const PLAT_UI8 *pH) {
+    PLAT_UI8 z[STSE_SIMULATOR_AES_BLOCK_SIZE] = {0};
+    PLAT_UI8 v[STSE_SIMULATOR_AES_BLOCK_SIZE];
+    PLAT_UI8 lsb;
+    PLAT_UI8 i;
+    PLAT_UI8 j;
+
+    /* - Right shift multiplication in GF(2^128) (NIST SP 800-38D algorithm 1) */
+    memcpy(v, pH, STSE_SIMULATOR_AES_BLOCK_SIZE);
+    for (i = 0; i < 128; i++) {
+        if ((pX[i >> 3] & (0x80 >> (i & 0x07))) != 0) {
+            for (j = 0; j < STSE_SIMULATOR_AES_BLOCK_SIZE; j++) {
+                z[j] ^= v[j];
+            }
+        }
+        lsb = v[STSE_SIMULATOR_AES_BLOCK_SIZE - 1] & 0x01;
+        for (j = STSE_SIMULATOR_AES_BLOCK_SIZE - 1; j > 0; j--) {
+            v[j] = (PLAT_UI8)((v[j] >> 1) | (v[j - 1] << 7));
+        }
+        v[0] >>= 1;
+        if (lsb != 0) {
+            v[0] ^= 0xE1;
+        }
+    }
+    memcpy(pX, z, STSE_SIMULATOR_AES_BLOCK_SIZE);
+}
+
+static void stse_simulator_ghash_update(PLAT_UI8 *pY, const PLAT_UI8 *pH, const PLAT_UI8 *pData, PLAT_UI16 length) {
+    PLAT_UI16 block_length;
+    PLAT_UI16 i;
+
+    /* - Last partial block is implicitly zero padded */
+    while (length > 0) {
+        block_length = (length > STSE_SIMULATOR_AES_BLOCK_SIZE) ? STSE_SIMULATOR_AES_BLOCK_SIZE : length;
+        for (i = 0; i < block_length; i++) {
+            pY[i] ^= pData[i];
+        }
+        stse_simulator_gf128_multiply(pY, pH);
+        pData += block_length;
+        length -= block_length;
+    }
+}
+
+static void stse_simulator_ghash_lengths(PLAT_UI8 *pY, const PLAT_UI8 *pH, PLAT_UI16 length_a, PLAT_UI16 length_b) {
+    PLAT_UI8 block[STSE_SIMULATOR_AES_BLOCK_SIZE] = {0};
+    PLAT_UI32 bit_length_a = (PLAT_UI32)length_a << 3;
+    PLAT_UI32 bit_length_b = (PLAT_UI32)length_b << 3;
+
+    /* - [len(A) 64-bit][len(C) 64-bit] in bits */
+    block[4] = UI32_B3(bit_length_a);
+    block[5] = UI32_B2(bit_length_a);
+    block[6] = UI32_B1(bit_length_a);
+    block[7] = UI32_B0(bit_length_a);
+    block[12] = UI32_B3(bit_length_b);
+    block[13] = UI32_B2(bit_length_b);
+    block[14] = UI32_B1(bit_length_b);
+    block[15] = UI32_B0(bit_length_b);
+    stse_simulator_ghash_update(pY, pH, block, STSE_SIMULATOR_AES_BLOCK_SIZE);
+}
+
+static PLAT_UI16 stse_simulator_encrypt(stse_simulator_t *pSim,
+                                        PLAT_UI8 *pCmd, PLAT_UI16 cmd_length,
+                                        PLAT_UI8 *pRsp, PLAT_UI16 *pRsp_length,
+                                        PLAT_UI16 rsp_max_length) {
+    stse_simulator_symmetric_key_t *pKey;
+    PLAT_UI8 *pIV;
+    PLAT_UI8 *pAssociated_data;
+    PLAT_UI8 *pMessage;
+    PLAT_UI8 *pCounter_blocks = pSim->work_buffer;
+    PLAT_UI8 *pKey_stream = &pSim->work_buffer[STSE_SIMULATOR_FRAME_BUFFER_SIZE];
+    PLAT_UI8 hash_key[STSE_SIMULATOR_AES_BLOCK_SIZE] = {0};
+    PLAT_UI8 j0[STSE_SIMULATOR_AES_BLOCK_SIZE] = {0};
+    PLAT_UI8 tag[STSE_SIMULATOR_AES_BLOCK_SIZE] = {0};
+    PLAT_UI8 key_length;
+    PLAT_UI16 IV_length;
+    PLAT_UI16 associated_data_length;
+    PLAT_UI16 message_length;
+    PLAT_UI16 block_count;
+    PLAT_UI16 output_length;
+    PLAT_UI32 counter;
+    PLAT_UI16 i = 2; /* Skip distinguisher and slot */
+
+    /* - [distinguisher][slot][IV length][IV][associated data length][associated data][message length][message] */
+    if (cmd_length < (i + STSAFEA_GENERIC_LENGTH_SIZE)) {
+        return STSE_INCONSISTENT_COMMAND_DATA;
+    }
+    if (pCmd[0] != STSE_SIMULATOR_SUB_COMMAND_DISTINGUISHER) {
+        return STSE_COMMAND_CODE_NOT_SUPPORTED;
+    }
+    IV_length = (PLAT_UI16)((pCmd[i] << 8) + pCmd[i + 1]);
+    i += STSAFEA_GENERIC_LENGTH_SIZE;
+    pIV = &pCmd[i];
+    i += IV_length;
+    if ((IV_length == 0) || (cmd_length < (i + STSAFEA_GENERIC_LENGTH_SIZE))) {
+        return STSE_INCONSISTENT_COMMAND_DATA;
+    }
+    associated_data_length = (PLAT_UI16)((pCmd[i] << 8) + pCmd[i + 1]);
+    i += STSAFEA_GENERIC_LENGTH_SIZE;
+    pAssociated_data = &pCmd[i];
+    i += associated_data_length;
+    if (cmd_length < (i + STSAFEA_GENERIC_LENGTH_SIZE)) {
+        return STSE_INCONSISTENT_COMMAND_DATA;
+    }
+    message_length = (PLAT_UI16)((pCmd[i] << 8) + pCmd[i + 1]);
+    i += STSAFEA_GENERIC_LENGTH_SIZE;
+    pMessage = &pCmd[i];
+    if ((i + message_length) != cmd_length) {
+        return STSE_INCONSISTENT_COMMAND_DATA;
+    }
+
+    if ((pCmd[1] >= STSE_SIMULATOR_MAX_SYMMETRIC_KEY_SLOTS) || (pSim->symmetric_key[pCmd[1]].pKey == NULL)) {
+        return STSE_KEY_NOT_FOUND;
+    }
+    pKey = &pSim->symmetric_key[pCmd[1]];
+    key_length = (pKey->key_type == STSE_AES_128_KT) ? STSE_AES_128_KEY_SIZE : STSE_AES_256_KEY_SIZE;
+    if ((message_length + pKey->tag_length) > rsp_max_length) {
+        return STSE_BUFFER_LENGTH_EXCEEDED;
+    }
+
+    /* - Hash subkey H = E(K , 0^128) */
+    if (stse_platform_aes_ecb_enc(j0, STSE_SIMULATOR_AES_BLOCK_SIZE, pKey->pKey, key_length,
+                                  hash_key, &output_length) != STSE_OK) {
+        return STSE_UNEXPECTED_ERROR;
+    }
+
+    /* - Pre-counter block J0 */
+    if (IV_length == 12) {
+        memcpy(j0, pIV, IV_length);
+        j0[STSE_SIMULATOR_AES_BLOCK_SIZE - 1] = 0x01;
+    } else {
+        stse_simulator_ghash_update(j0, hash_key, pIV, IV_length);
+        stse_simulator_ghash_lengths(j0, hash_key, 0, IV_length);
+    }
+
+    /* - Key stream from inc32(J0) counter blocks */
+    block_count = (message_length + STSE_SIMULATOR_AES_BLOCK_SIZE - 1) / STSE_SIMULATOR_AES_BLOCK_SIZE;
+    counter = ((PLAT_UI32)j0[12] << 24) | ((PLAT_UI32)j0[13] << 16) | ((PLAT_UI32)j0[14] << 8) | j0[15];
+    for (i = 0; i < block_count; i++) {
+        PLAT_UI8 *pBlock = &pCounter_blocks[i * STSE_SIMULATOR_AES_BLOCK_SIZE];
+        memcpy(pBlock, j0, 12);
+        pBlock[12] = UI32_B3(counter + i + 1);
+        pBlock[13] = UI32_B2(counter + i + 1);
+        pBlock[14] = UI32_B1(counter + i + 1);
+        pBlock[15] = UI32_B0(counter + i + 1);
+    }
+    if ((block_count > 0) &&
+        (stse_platform_aes_ecb_enc(pCounter_blocks, block_count * STSE_SIMULATOR_AES_BLOCK_SIZE, pKey->pKey, key_length,
+                                   pKey_stream, &output_length) != STSE_OK)) {
+        return STSE_UNEXPECTED_ERROR;
+    }
+    for (i = 0; i < message_length; i++) {
+        pRsp[i] = pMessage[i] ^ pKey_stream[i];
+    }
+
+    /* - Tag = E(K , J0) xor GHASH(A , C) */
+    stse_simulator_ghash_update(tag, hash_key, pAssociated_data, associated_data_length);
+    stse_simulator_ghash_update(tag, hash_key, pRsp, message_length);
+    stse_simulator_ghash_lengths(tag, hash_key, associated_data_length, message_length);
+    if (stse_platform_aes_ecb_enc(j0, STSE_SIMULATOR_AES_BLOCK_SIZE, pKey->pKey, key_length,
+                                  pKey_stream, &output_length) != STSE_OK) {
+        return STSE_UNEXPECTED_ERROR;
+    }
+    for (i = 0; i < pKey->tag_length; i++) {
+        pRsp[message_length + i] = tag[i] ^ pKey_stream[i];
+    }
+    *pRsp_length = message_length + pKey->tag_length;
+
+    return STSE_OK;
+}
+
+#endif /* STSE_CONF_USE_HOST_KEY_ESTABLISHMENT || STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT || STSE_CONF_USE_HOST_SESSION */
+
+/* Frame processing ----------------------------------------------------------*/
+
+static PLAT_UI16 stse_simulator_execute(stse_simulator_t *pSim,
+                                        PLAT_UI8 cmd_code,
+                                        PLAT_UI8 ext_cmd_code,
+                                        PLAT_UI8 *pCmd, PLAT_UI16 cmd_length,
+                                        PLAT_UI8 *pRsp, PLAT_UI16 *pRsp_length,
+                                        PLAT_UI16 rsp_max_length,
+                                        PLAT_UI8 authenticated) {
+    PLAT_UI16 i;
+    PLAT_UI32 random = 0;
+
+    switch (cmd_code) {
+    case STSAFEA_CMD_ECHO:
+        if (cmd_length > rsp_max_length) {
+            return STSE_BUFFER_LENGTH_EXCEEDED;
+        }
+        memcpy(pRsp, pCmd, cmd_length);
+        *pRsp_length = cmd_length;
+        return STSE_OK;
+
+    case STSAFEA_CMD_GENERATE_RANDOM:
+        /* - [subject][size] */
+        if (cmd_length != 2) {
+            return STSE_INCONSISTENT_COMMAND_DATA;
+        }
+        if (pCmd[1] > rsp_max_length) {
+            return STSE_BUFFER_LENGTH_EXCEEDED;
+        }
+        for (i = 0; i < pCmd[1]; i++) {
+            if ((i & 0x03) == 0) {
+                random = stse_platform_generate_random();
+            }
+            pRsp[i] = (PLAT_UI8)(random >> ((i & 0x03) << 3));
+        }
+        *pRsp_length = pCmd[1];
+        return STSE_OK;
+
+    case STSAFEA_CMD_QUERY:
+        return stse_simulator_query(pSim, pCmd, cmd_length, pRsp, pRsp_length);
+
+    case STSAFEA_CMD_READ:
+        return stse_simulator_read(pSim, pCmd, cmd_length, pRsp, pRsp_length, rsp_max_length, authenticated);
+
+    case STSAFEA_CMD_UPDATE:
+        return stse_simulator_update(pSim, pCmd, cmd_length, authenticated);
+
+    case STSAFEA_CMD_DECREMENT:
+        return stse_simulator_decrement(pSim, pCmd, cmd_length, pRsp, pRsp_length, authenticated);
+
+#if defined(STSE_CONF_ECC_NIST_P_256) || defined(STSE_CONF_ECC_NIST_P_384) || defined(STSE_CONF_ECC_NIST_P_521) ||                \
+    defined(STSE_CONF_ECC_BRAINPOOL_P_256) || defined(STSE_CONF_ECC_BRAINPOOL_P_384) || defined(STSE_CONF_ECC_BRAINPOOL_P_512) || \
+    defined(STSE_CONF_ECC_CURVE_25519) || defined(STSE_CONF_ECC_EDWARD_25519)
+    case STSAFEA_CMD_GENERATE_SIGNATURE:
+        return stse_simulator_generate_signature(pSim, pCmd, cmd_length, pRsp, pRsp_length);
+
+    case STSAFEA_CMD_VERIFY_SIGNATURE:
+        return stse_simulator_verify_signature(pCmd, cmd_length, pRsp, pRsp_length);
+#endif /* STSE_CONF_ECC_* */
+
+#if defined(STSE_CONF_USE_HOST_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT) || \
+    defined(STSE_CONF_USE_HOST_SESSION)
+    case STSAFEA_CMD_ENCRYPT:
+        return stse_simulator_encrypt(pSim, pCmd, cmd_length, pRsp, pRsp_length, rsp_max_length);
+#endif /* STSE_CONF_USE_HOST_KEY_ESTABLISHMENT || STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT || STSE_CONF_USE_HOST_SESSION */
+
+    case STSAFEA_EXTENDED_COMMAND_PREFIX:
+        switch (ext_cmd_code) {
+        case STSAFEA_EXTENDED_CMD_START_HASH:
+        case STSAFEA_EXTENDED_CMD_PROCESS_HASH:
+        case STSAFEA_EXTENDED_CMD_FINISH_HASH:
+            return stse_simulator_hash(pSim, ext_cmd_code, pCmd, cmd_length, pRsp, pRsp_length);
+        default:
+            return STSE_COMMAND_CODE_NOT_SUPPORTED;
+        }
+
+    default:
+        return STSE_COMMAND_CODE_NOT_SUPPORTED;
+    }
+}
+
+static PLAT_UI16 stse_simulator_latency_get(stse_simulator_t *pSim, PLAT_UI8 cmd_code, PLAT_UI8 ext_cmd_code) {
+    if (cmd_code == STSAFEA_EXTENDED_COMMAND_PREFIX) {
+        return (ext_cmd_code < STSAFEA_MAX_EXT_CMD_COUNT) ? pSim->ext_cmd_latency[ext_cmd_code] : 0;
+    }
+
+    return (cmd_code < STSAFEA_MAX_CMD_COUNT) ? pSim->cmd_latency[cmd_code] : 0;
+}
+
+static void stse_simulator_response_set(stse_simulator_t *pSim, PLAT_UI16 status, PLAT_UI16 payload_length) {
+    PLAT_UI16 crc;
+    PLAT_UI8 header = (PLAT_UI8)status;
+
+    /* - [status][length = payload + CRC][payload][CRC over status and payload] */
+    if (status != STSE_OK) {
+        payload_length = 0;
+        pSim->statistics.error_count++;
+    }
+    pSim->rsp_buffer[0] = header;
+    pSim->rsp_buffer[1] = UI16_B1(payload_length + STSE_FRAME_CRC_SIZE);
+    pSim->rsp_buffer[2] = UI16_B0(payload_length + STSE_FRAME_CRC_SIZE);
+    crc = stse_crc16_finalize(stse_crc16_update(STSE_CRC16_INIT_VALUE, &header, STSE_RSP_FRAME_HEADER_SIZE));
+    if (payload_length != 0) {
+        crc = stse_crc16_accumulate(crc, &pSim->rsp_buffer[STSE_SIMULATOR_RSP_PAYLOAD_OFFSET], payload_length);
+    }
+    pSim->rsp_buffer[STSE_SIMULATOR_RSP_PAYLOAD_OFFSET + payload_length] = UI16_B1(crc);
+    pSim->rsp_buffer[STSE_SIMULATOR_RSP_PAYLOAD_OFFSET + payload_length + 1] = UI16_B0(crc);
+    pSim->rsp_length = STSE_SIMULATOR_RSP_PAYLOAD_OFFSET + payload_length + STSE_FRAME_CRC_SIZE;
+    pSim->rsp_offset = 0;
+}
+
+static void stse_simulator_process(stse_simulator_t *pSim) {
+    PLAT_UI8 *pFrame = pSim->cmd_buffer;
+    PLAT_UI8 *pRsp = &pSim->rsp_buffer[STSE_SIMULATOR_RSP_PAYLOAD_OFFSET];
+    PLAT_UI16 rsp_max_length = stse_simulator_max_frame_length[stse_simulator_product_index(pSim)] - STSE_RSP_FRAME_HEADER_SIZE;
+    PLAT_UI16 rsp_length = 0;
+    PLAT_UI16 frame_length = pSim->cmd_length;
+    PLAT_UI16 header_length = STSAFEA_HEADER_SIZE;
+    PLAT_UI8 cmd_code;
+    PLAT_UI8 ext_cmd_code = 0;
+    PLAT_UI8 authenticated = 0;
+    PLAT_UI8 cmd_encryption = 0;
+    stse_cmd_access_conditions_t cmd_AC;
+    PLAT_UI16 crc;
+    PLAT_UI16 status;
+    PLAT_UI8 *pPayload;
+    PLAT_UI16 payload_length;
+#ifdef STSE_CONF_USE_HOST_SESSION
+    PLAT_UI8 rsp_encryption = 0;
+    PLAT_UI8 mac[STSAFEA_MAC_SIZE];
+    PLAT_UI16 mac_input_length;
+#endif /* STSE_CONF_USE_HOST_SESSION */
+
+    pSim->statistics.cmd_count++;
+    pSim->statistics.cmd_bytes += frame_length;
+
+    /* - Verify frame integrity */
+    if ((frame_length != pSim->cmd_expected_length) ||
+        (frame_length < (STSAFEA_HEADER_SIZE + STSE_FRAME_CRC_SIZE))) {
+        stse_simulator_response_set(pSim, STSE_COMMUNICATION_ERROR, 0);
+        return;
+    }
+    frame_length -= STSE_FRAME_CRC_SIZE;
+    crc = stse_crc16_finalize(stse_crc16_update(STSE_CRC16_INIT_VALUE, pFrame, frame_length));
+    if ((pFrame[frame_length] != UI16_B1(crc)) || (pFrame[frame_length + 1] != UI16_B0(crc))) {
+        stse_simulator_response_set(pSim, STSE_COMMUNICATION_ERROR, 0);
+        return;
+    }
+
+    /* - Decode command header(s) */
+    cmd_code = pFrame[0] & 0x1F;
+    if (cmd_code == STSAFEA_EXTENDED_COMMAND_PREFIX) {
+        if (frame_length < STSAFEA_EXT_HEADER_SIZE) {
+            stse_simulator_response_set(pSim, STSE_INCONSISTENT_COMMAND_DATA, 0);
+            return;
+        }
+        header_length = STSAFEA_EXT_HEADER_SIZE;
+        ext_cmd_code = pFrame[1];
+    }
+    pPayload = &pFrame[header_length];
+    payload_length = frame_length - header_length;
+
+    if (pSim->pGet_time_ms != NULL) {
+        pSim->rsp_ready_time = pSim->pGet_time_ms() + stse_simulator_latency_get(pSim, cmd_code, ext_cmd_code);
+    }
+
+    /* - Verify command authentication */
+    if (pFrame[0] & STSAFEA_PROT_CMD_Msk) {
+#ifdef STSE_CONF_USE_HOST_SESSION
+        if (pSim->host_key_presence == 0) {
+            stse_simulator_response_set(pSim, STSE_KEY_NOT_FOUND, 0);
+            return;
+        }
+        if (payload_length < STSAFEA_MAC_SIZE) {
+            stse_simulator_response_set(pSim, STSE_INVALID_C_MAC, 0);
+            return;
+        }
+        payload_length -= STSAFEA_MAC_SIZE;
+
+        /* - C-MAC input : [0x00][CMD HEADER][CMD PAYLOAD LENGTH][CMD PAYLOAD] */
+        pSim->work_buffer[STSE_SIMULATOR_AES_BLOCK_SIZE] = 0x00;
+        mac_input_length = 1 + stse_simulator_mac_input_push(&pSim->work_buffer[STSE_SIMULATOR_AES_BLOCK_SIZE + 1],
+                                                             pFrame, (PLAT_UI8)header_length,
+                                                             pPayload, payload_length);
+        if ((stse_simulator_mac_compute(pSim, STSE_SIMULATOR_SUBJECT_HOST_CMAC, mac_input_length, mac) != STSE_OK) ||
+            (memcmp(mac, &pPayload[payload_length], STSAFEA_MAC_SIZE) != 0)) {
+            stse_simulator_response_set(pSim, STSE_INVALID_C_MAC, 0);
+            return;
+        }
+        authenticated = 1;
+#else
+        stse_simulator_response_set(pSim, STSE_COMMAND_CODE_NOT_SUPPORTED, 0);
+        return;
+#endif /* STSE_CONF_USE_HOST_SESSION */
+    }
+
+    /* - Verify command access condition */
+    if (cmd_code == STSAFEA_EXTENDED_COMMAND_PREFIX) {
+        stsafea_perso_info_get_ext_cmd_AC(&pSim->perso_info, ext_cmd_code, &cmd_AC);
+        stsafea_perso_info_get_ext_cmd_encrypt_flag(&pSim->perso_info, ext_cmd_code, &cmd_encryption);
+#ifdef STSE_CONF_USE_HOST_SESSION
+        stsafea_perso_info_get_ext_rsp_encrypt_flag(&pSim->perso_info, ext_cmd_code, &rsp_encryption);
+#endif /* STSE_CONF_USE_HOST_SESSION */
+    } else {
+        stsafea_perso_info_get_cmd_AC(&pSim->perso_info, cmd_code, &cmd_AC);
+        stsafea_perso_info_get_cmd_encrypt_flag(&pSim->perso_info, cmd_code, &cmd_encryption);
+#ifdef STSE_CONF_USE_HOST_SESSION
+        stsafea_perso_info_get_rsp_encrypt_flag(&pSim->perso_info, cmd_code, &rsp_encryption);
+#endif /* STSE_CONF_USE_HOST_SESSION */
+    }
+
+    if ((cmd_AC == STSE_CMD_AC_FREE) || ((cmd_AC == STSE_CMD_AC_HOST) && (authenticated != 0))) {
+        status = STSE_OK;
+    } else {
+        status = STSE_ACCESS_CONDITION_NOT_SATISFIED;
+    }
+    if ((status == STSE_OK) && (cmd_encryption != 0) && (authenticated == 0)) {
+        status = STSE_ACCESS_CONDITION_NOT_SATISFIED;
+    }
+
+#ifdef STSE_CONF_USE_HOST_SESSION
+    /* - Decrypt command payload */
+    if ((status == STSE_OK) && (cmd_encryption != 0)) {
+        status = stse_simulator_cmd_decrypt(pSim, &pPayload, &payload_length);
+    }
+
+    /* - C-MAC sequence counter is consumed by any authenticated command */
+    if (authenticated != 0) {
+        pSim->host_MAC_counter++;
+    }
+#endif /* STSE_CONF_USE_HOST_SESSION */
+
+    /* - Execute command */
+    if (status == STSE_OK) {
+        status = stse_simulator_execute(pSim, cmd_code, ext_cmd_code,
+                                        pPayload, payload_length,
+                                        pRsp, &rsp_length,
+                                        rsp_max_length - STSAFEA_MAC_SIZE - STSE_SIMULATOR_AES_BLOCK_SIZE,
+                                        authenticated);
+    }
+
+#ifdef STSE_CONF_USE_HOST_SESSION
+    if ((status == STSE_OK) && (authenticated != 0)) {
+        /* - Encrypt response payload */
+        if ((rsp_encryption != 0) && (rsp_length != 0)) {
+            if (stse_simulator_rsp_encrypt(pSim, pRsp, &rsp_length) != STSE_OK) {
+                status = STSE_UNEXPECTED_ERROR;
+            }
+        }
+
+        /* - R-MAC input : [0x80][CMD HEADER][CMD PAYLOAD LENGTH][CMD PAYLOAD][RSP HEADER][RSP PAYLOAD LENGTH][RSP PAYLOAD] */
+        if ((status == STSE_OK) && (pFrame[0] & STSAFEA_PROT_RSP_Msk)) {
+            PLAT_UI8 rsp_header = STSE_OK;
+
+            /* - Command payload as received (encrypted if command encryption is set) */
+            pPayload = &pFrame[header_length];
+            payload_length = frame_length - header_length - STSAFEA_MAC_SIZE;
+            pSim->work_buffer[STSE_SIMULATOR_AES_BLOCK_SIZE] = 0x80;
+            mac_input_length = 1;
+            mac_input_length += stse_simulator_mac_input_push(&pSim->work_buffer[STSE_SIMULATOR_AES_BLOCK_SIZE + mac_input_length],
+                                                              pFrame, (PLAT_UI8)header_length,
+                                                              pPayload, payload_length);
+            mac_input_length += stse_simulator_mac_input_push(&pSim->work_buffer[STSE_SIMULATOR_AES_BLOCK_SIZE + mac_input_length],
+                                                              &rsp_header, STSE_RSP_FRAME_HEADER_SIZE,
+                                                              pRsp, rsp_length);
+            if (stse_simulator_mac_compute(pSim, STSE_SIMULATOR_SUBJECT_HOST_RMAC, mac_input_length, &pRsp[rsp_length]) != STSE_OK) {
+                status = STSE_UNEXPECTED_ERROR;
+            }
+            rsp_length += STSAFEA_MAC_SIZE;
+        }
+    }
+#endif /* STSE_CONF_USE_HOST_SESSION */
+
+    stse_simulator_response_set(pSim, status, rsp_length);
+}
+
+/* Bus callbacks -------------------------------------------------------------*/
+
+static stse_ReturnCode_t stse_simulator_bus_send_start(PLAT_UI8 busID,
+                                                       PLAT_UI8 devAddr,
+                                                       PLAT_UI16 speed,
+                                                       PLAT_UI16 frame_length) {
+    stse_simulator_t *pSim = stse_simulator_get(busID, devAddr);
+
+    (void)speed;
+
+    if (pSim == NULL) {
+        return STSE_PLATFORM_BUS_ACK_ERROR;
+    }
+    if (stse_simulator_is_busy(pSim) != 0) {
+        pSim->statistics.nack_count++;
+        return STSE_PLATFORM_BUS_ACK_ERROR;
+    }
+
+    pSim->statistics.send_count++;
+    pSim->cmd_length = 0;
+    pSim->cmd_expected_length = frame_length;
+
+    return STSE_OK;
+}
+
+static stse_ReturnCode_t stse_simulator_bus_send_continue(PLAT_UI8 busID,
+                                                          PLAT_UI8 devAddr,
+                                                          PLAT_UI16 speed,
+                                                          PLAT_UI8 *pData,
+                                                          PLAT_UI16 data_size) {
+    stse_simulator_t *pSim = stse_simulator_get(busID, devAddr);
+    PLAT_UI16 copy_size = data_size;
+
+    (void)speed;
+
+    if (pSim == NULL) {
+        return STSE_PLATFORM_BUS_ACK_ERROR;
+    }
+
+    /* - Bytes beyond the device buffer are dropped (reported as a communication error) */
+    if ((pSim->cmd_length + copy_size) > STSE_SIMULATOR_FRAME_BUFFER_SIZE) {
+        copy_size = STSE_SIMULATOR_FRAME_BUFFER_SIZE - pSim->cmd_length;
+        pSim->cmd_expected_length = 0;
+    }
+    if (pData != NULL) {
+        memcpy(&pSim->cmd_buffer[pSim->cmd_length], pData, copy_size);
+    } else {
+        memset(&pSim->cmd_buffer[pSim->cmd_length], 0x00, copy_size);
+    }
+    pSim->cmd_length += copy_size;
+
+    return STSE_OK;
+}
+
+static stse_ReturnCode_t stse_simulator_bus_send_stop(PLAT_UI8 busID,
+                                                      PLAT_UI8 devAddr,
+                                                      PLAT_UI16 speed,
+                                                      PLAT_UI8 *pData,
+                                                      PLAT_UI16 data_size) {
+    stse_ReturnCode_t ret;
+
+    ret = stse_simulator_bus_send_continue(busID, devAddr, speed, pData, data_size);
+    if (ret == STSE_OK) {
+        stse_simulator_process(stse_simulator_get(busID, devAddr));
+    }
+
+    return ret;
+}
+
+static stse_ReturnCode_t stse_simulator_bus_send_vectored(PLAT_UI8 busID,
+                                                          PLAT_UI8 devAddr,
+                                                          PLAT_UI16 speed,
+                                                          stse_io_vector_t *pVector,
+                                                          PLAT_UI8 vector_count) {
+    stse_ReturnCode_t ret;
+    PLAT_UI16 frame_length = 0;
+    PLAT_UI8 i;
+
+    for (i = 0; i < vector_count; i++) {
+        frame_length += pVector[i].length;
+    }
+
+    ret = stse_simulator_bus_send_start(busID, devAddr, speed, frame_length);
+    for (i = 0; (ret == STSE_OK) && (i < vector_count); i++) {
+        ret = stse_simulator_bus_send_continue(busID, devAddr, speed, pVector[i].pData, pVector[i].length);
+    }
+    if (ret == STSE_OK) {
+        stse_simulator_process(stse_simulator_get(busID, devAddr));
+    }
+
+    return ret;
+}
+
+static stse_ReturnCode_t stse_simulator_bus_receive_start(PLAT_UI8 busID,
+                                                          PLAT_UI8 devAddr,
+                                                          PLAT_UI16 speed,
+                                                          PLAT_UI16 frame_length) {
+    stse_simulator_t *pSim = stse_simulator_get(busID, devAddr);
+
+    (void)speed;
+    (void)frame_length;
+
+    if (pSim == NULL) {
+        return STSE_PLATFORM_BUS_ACK_ERROR;
+    }
+    if (stse_simulator_is_busy(pSim) != 0) {
+        pSim->statistics.nack_count++;
+        return STSE_PLATFORM_BUS_ACK_ERROR;
+    }
+
+    /* - Each read transaction restarts from the response frame first byte */
+    pSim->statistics.receive_count++;
+    pSim->rsp_offset = 0;
+
+    return STSE_OK;
+}
+
+static stse_ReturnCode_t stse_simulator_bus_receive_continue(PLAT_UI8 busID,
+                                                             PLAT_UI8 devAddr,
+                                                             PLAT_UI16 speed,
+                                                             PLAT_UI8 *pData,
+                                                             PLAT_UI16 data_size) {
+    stse_simulator_t *pSim = stse_simulator_get(busID, devAddr);
+    PLAT_UI16 i;
+    PLAT_UI8 value;
+
+    (void)speed;
+
+    if (pSim == NULL) {
+        return STSE_PLATFORM_BUS_ACK_ERROR;
+    }
+
+    /* - Bytes read beyond the response frame are returned as 0xFF (released bus) */
+    for (i = 0; i < data_size; i++) {
+        value = (pSim->rsp_offset < pSim->rsp_length) ? pSim->rsp_buffer[pSim->rsp_offset] : 0xFF;
+        if (pData != NULL) {
+            pData[i] = value;
+        }
+        pSim->rsp_offset++;
+    }
+    pSim->statistics.rsp_bytes += data_size;
+
+    return STSE_OK;
+}
+
+static stse_ReturnCode_t stse_simulator_bus_receive_vectored(PLAT_UI8 busID,
+                                                             PLAT_UI8 devAddr,
+                                                             PLAT_UI16 speed,
+                                                             stse_io_vector_t *pVector,
+                                                             PLAT_UI8 vector_count) {
+    stse_ReturnCode_t ret;
+    PLAT_UI8 i;
+
+    ret = stse_simulator_bus_receive_start(busID, devAddr, speed, 0);
+    for (i = 0; (ret == STSE_OK) && (i < vector_count); i++) {
+        ret = stse_simulator_bus_receive_continue(busID, devAddr, speed, pVector[i].pData, pVector[i].length);
+    }
+
+    return ret;
+}
+
+#ifdef STSE_USE_ZERO_COPY_RSP
+static stse_ReturnCode_t stse_simulator_bus_receive_frame(PLAT_UI8 busID,
+                                                          PLAT_UI8 devAddr,
+                                                          PLAT_UI16 speed,
+                                                          PLAT_UI16 length,
+                                                          PLAT_UI8 **ppFrame) {
+    stse_simulator_t *pSim = stse_simulator_get(busID, devAddr);
+    stse_ReturnCode_t ret;
+
+    if (pSim == NULL) {
+        return STSE_PLATFORM_BUS_ACK_ERROR;
+    }
+    if ((ppFrame == NULL) || (length > STSE_SIMULATOR_FRAME_BUFFER_SIZE)) {
+        return STSE_PLATFORM_BUS_ERR;
+    }
+
+    ret = stse_simulator_bus_receive_start(busID, devAddr, speed, length);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+
+    /* - The response buffer is lent to the caller, bytes beyond the response frame read as 0xFF */
+    if (length > pSim->rsp_length) {
+        memset(&pSim->rsp_buffer[pSim->rsp_length], 0xFF, length - pSim->rsp_length);
+    }
+    pSim->rsp_offset = length;
+    pSim->statistics.rsp_bytes += length;
+    *ppFrame = pSim->rsp_buffer;
+
+    return STSE_OK;
+}
+#endif /* STSE_USE_ZERO_COPY_RSP */
+
+#ifdef STSE_USE_IO_LINE_RSP_WAIT
+static stse_ReturnCode_t stse_simulator_io_line_ready(PLAT_UI8 busID, PLAT_UI8 devAddr) {
+    stse_simulator_t *pSim = stse_simulator_get(busID, devAddr);
+
+    /* - Ready line is asserted when the addressed simulated device is not executing a command */
+    if ((pSim == NULL) || (stse_simulator_is_busy(pSim) != 0)) {
+        return STSE_PLATFORM_BUS_ACK_ERROR;
+    }
+
+    return STSE_OK;
+}
+#endif /* STSE_USE_IO_LINE_RSP_WAIT */
+
+static stse_ReturnCode_t stse_simulator_bus_wake(PLAT_UI8 busID,
+                                                 PLAT_UI8 devAddr,
+                                                 PLAT_UI16 speed) {
+    (void)speed;
+
+    return (stse_simulator_get(busID, devAddr) != NULL) ? STSE_OK : STSE_PLATFORM_BUS_ACK_ERROR;
+}
+
+/* Public functions ----------------------------------------------------------*/
+
+stse_ReturnCode_t stse_simulator_init(stse_simulator_t *pSim, stse_device_t device_type) {
+    PLAT_UI8 product;
+
+    if ((pSim == NULL) ||
+        (device_type < STSE_DEVICE_STSAFEA_FAMILY_INDEX) ||
+        (device_type >= (STSE_DEVICE_STSAFEA_FAMILY_INDEX + STSAFEA_PRODUCT_COUNT))) {
+        return STSE_CORE_INVALID_PARAMETER;
+    }
+
+    memset(pSim, 0, sizeof(stse_simulator_t));
+    pSim->device_type = device_type;
+    product = stse_simulator_product_index(pSim);
+
+    memcpy(pSim->mask_id, stse_simulator_mask_id[product], STSAFEA_MASK_ID_SIZE);
+    memcpy(pSim->cmd_latency, stsafea_cmd_timings[product], sizeof(pSim->cmd_latency));
+    memcpy(pSim->ext_cmd_latency, stsafea_extended_cmd_timings[product], sizeof(pSim->ext_cmd_latency));
+
+    /* - All commands in free access without encryption */
+    pSim->perso_info.cmd_AC_status = 0x5555555555555555;
+    pSim->perso_info.ext_cmd_AC_status = 0x5555555555555555;
+
+#if defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED) || \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT_AUTHENTICATED) ||   \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED)
+    pSim->pEcc_sign = stse_platform_ecc_sign;
+#endif
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_simulator_attach(stse_simulator_t *pSim, stse_Handler_t *pSTSE) {
+    PLAT_UI8 i;
+    PLAT_UI8 free_slot = STSE_SIMULATOR_MAX_DEVICES;
+
+    if ((pSim == NULL) || (pSTSE == NULL)) {
+        return STSE_CORE_INVALID_PARAMETER;
+    }
+
+    for (i = 0; i < STSE_SIMULATOR_MAX_DEVICES; i++) {
+        if (stse_simulator_registry[i] == pSim) {
+            stse_simulator_registry[i] = NULL;
+        }
+        if ((stse_simulator_registry[i] != NULL) &&
+            (stse_simulator_registry[i]->busID == pSTSE->io.busID) &&
+            (stse_simulator_registry[i]->devAddr == pSTSE->io.Devaddr)) {
+            return STSE_CORE_INVALID_PARAMETER;
+        }
+        if ((stse_simulator_registry[i] == NULL) && (free_slot == STSE_SIMULATOR_MAX_DEVICES)) {
+            free_slot = i;
+        }
+    }
+    if (free_slot == STSE_SIMULATOR_MAX_DEVICES) {
+        return STSE_CORE_INVALID_PARAMETER;
+    }
+
+    pSim->busID = pSTSE->io.busID;
+    pSim->devAddr = pSTSE->io.Devaddr;
+    stse_simulator_registry[free_slot] = pSim;
+
+    pSTSE->io.BusSendStart = stse_simulator_bus_send_start;
+    pSTSE->io.BusSendContinue = stse_simulator_bus_send_continue;
+    pSTSE->io.BusSendStop = stse_simulator_bus_send_stop;
+    pSTSE->io.BusRecvStart = stse_simulator_bus_receive_start;
+    pSTSE->io.BusRecvContinue = stse_simulator_bus_receive_continue;
+    pSTSE->io.BusRecvStop = stse_simulator_bus_receive_continue;
+    pSTSE->io.BusSendV = stse_simulator_bus_send_vectored;
+    pSTSE->io.BusRecvV = stse_simulator_bus_receive_vectored;
+#ifdef STSE_USE_ZERO_COPY_RSP
+    pSTSE->io.BusRecvFrame = stse_simulator_bus_receive_frame;
+#endif /* STSE_USE_ZERO_COPY_RSP */
+    pSTSE->io.BusWake = stse_simulator_bus_wake;
+#ifdef STSE_USE_IO_LINE_RSP_WAIT
+    pSTSE->io.IOLineReady = stse_simulator_io_line_ready;
+#endif /* STSE_USE_IO_LINE_RSP_WAIT */
+
+    return STSE_OK;
+}
+
+void stse_simulator_detach(stse_simulator_t *pSim) {
+    PLAT_UI8 i;
+
+    for (i = 0; i < STSE_SIMULATOR_MAX_DEVICES; i++) {
+        if (stse_simulator_registry[i] == pSim) {
+            stse_simulator_registry[i] = NULL;
+        }
+    }
+}
+
+stse_ReturnCode_t stse_simulator_set_host_keys(stse_simulator_t *pSim,
+                                               stse_aes_key_type_t key_type,
+                                               const PLAT_UI8 *pHost_MAC_key,
+                                               const PLAT_UI8 *pHost_cipher_key,
+                                               PLAT_UI32 MAC_counter) {
+    PLAT_UI8 key_length = (key_type == STSE_AES_128_KT) ? STSE_AES_128_KEY_SIZE : STSE_AES_256_KEY_SIZE;
+
+    if ((pSim == NULL) || (pHost_MAC_key == NULL) || (pHost_cipher_key == NULL) ||
+        ((key_type == STSE_AES_256_KT) && (pSim->device_type != STSAFE_A120))) {
+        return STSE_CORE_INVALID_PARAMETER;
+    }
+
+    pSim->host_key_type = key_type;
+    memcpy(pSim->host_MAC_key, pHost_MAC_key, key_length);
+    memcpy(pSim->host_cipher_key, pHost_cipher_key, key_length);
+    pSim->host_MAC_counter = MAC_counter;
+    pSim->host_key_presence = 1;
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_simulator_set_zone(stse_simulator_t *pSim,
+                                          PLAT_UI8 zone_index,
+                                          PLAT_UI8 zone_type,
+                                          stse_zone_ac_t read_ac,
+                                          stse_zone_ac_t update_ac,
+                                          PLAT_UI8 *pData,
+                                          PLAT_UI16 size,
+                                          PLAT_UI32 counter) {
+    if ((pSim == NULL) || (zone_index >= STSE_SIMULATOR_MAX_ZONES) || (pData == NULL) || (zone_type > 1)) {
+        return STSE_CORE_INVALID_PARAMETER;
+    }
+
+    pSim->zone[zone_index].pData = pData;
+    pSim->zone[zone_index].size = size;
+    pSim->zone[zone_index].zone_type = zone_type;
+    pSim->zone[zone_index].read_ac = read_ac;
+    pSim->zone[zone_index].update_ac = update_ac;
+    pSim->zone[zone_index].counter = (zone_type == 1) ? counter : 0;
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_simulator_set_private_key(stse_simulator_t *pSim,
+                                                 PLAT_UI8 slot_number,
+                                                 stse_ecc_key_type_t key_type,
+                                                 PLAT_UI8 *pPrivate_key) {
+    if ((pSim == NULL) || (slot_number >= STSE_SIMULATOR_MAX_PRIVATE_KEY_SLOTS) ||
+        (pPrivate_key == NULL) || (key_type >= STSE_ECC_KT_INVALID)) {
+        return STSE_CORE_INVALID_PARAMETER;
+    }
+
+    pSim->private_key[slot_number].key_type = key_type;
+    pSim->private_key[slot_number].pPrivate_key = pPrivate_key;
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_simulator_set_symmetric_key(stse_simulator_t *pSim,
+                                                   PLAT_UI8 slot_number,
+                                                   stse_aes_key_type_t key_type,
+                                                   PLAT_UI8 *pKey,
+                                                   PLAT_UI8 tag_length) {
+    if ((pSim == NULL) || (slot_number >= STSE_SIMULATOR_MAX_SYMMETRIC_KEY_SLOTS) || (pKey == NULL) ||
+        (tag_length < 4) || (tag_length > STSE_SIMULATOR_AES_BLOCK_SIZE)) {
+        return STSE_CORE_INVALID_PARAMETER;
+    }
+
+    pSim->symmetric_key[slot_number].key_type = key_type;
+    pSim->symmetric_key[slot_number].pKey = pKey;
+    pSim->symmetric_key[slot_number].tag_length = tag_length;
+
+    return STSE_OK;
+}
+
+void stse_simulator_set_cmd_protection(stse_simulator_t *pSim,
+                                       PLAT_UI8 cmd_header,
+                                       PLAT_UI8 extended,
+                                       stse_cmd_access_conditions_t cmd_AC,
+                                       PLAT_UI8 cmd_encryption,
+                                       PLAT_UI8 rsp_encryption) {
+    if (extended != 0) {
+        stsafea_perso_info_set_ext_cmd_AC(&pSim->perso_info, cmd_header, cmd_AC);
+        stsafea_perso_info_set_ext_cmd_encrypt_flag(&pSim->perso_info, cmd_header, cmd_encryption);
+        stsafea_perso_info_set_ext_rsp_encrypt_flag(&pSim->perso_info, cmd_header, rsp_encryption);
+    } else {
+        stsafea_perso_info_set_cmd_AC(&pSim->perso_info, cmd_header, cmd_AC);
+        stsafea_perso_info_set_cmd_encrypt_flag(&pSim->perso_info, cmd_header, cmd_encryption);
+        stsafea_perso_info_set_rsp_encrypt_flag(&pSim->perso_info, cmd_header, rsp_encryption);
+    }
+}
+
+void stse_simulator_set_cmd_latency(stse_simulator_t *pSim,
+                                    PLAT_UI8 cmd_header,
+                                    PLAT_UI8 extended,
+                                    PLAT_UI16 latency) {
+    if ((extended != 0) && (cmd_header < STSAFEA_MAX_EXT_CMD_COUNT)) {
+        pSim->ext_cmd_latency[cmd_header] = latency;
+    } else if ((extended == 0) && (cmd_header < STSAFEA_MAX_CMD_COUNT)) {
+        pSim->cmd_latency[cmd_header] = latency;
+    }
+}
+
+void stse_simulator_reset_statistics(stse_simulator_t *pSim) {
+    memset(&pSim->statistics, 0, sizeof(pSim->statistics));
+}
+
+#endif /* STSE_CONF_STSAFE_A_SUPPORT */
@@ -0,0 +1,310 @@
+/*!
+ * ******************************************************************************
+ * \file	stse_simulator.h
+ * \brief   STSAFE-A software device simulator (header)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details Host side model of an STSAFE-A target device plugged in the STSE handler I/O callbacks (stse_io_t).
+ *          It is built together with the library sources and the host platform abstraction layer
+ *          (cc -I.. -I<stse_conf.h directory> ... stse_simulator.c from tools directory) and replaces the I2C
+ *          platform bus functions of the attached handlers. Device side cryptography relies on the host platform
+ *          functions (stse_platform_aes_* , stse_platform_hash_compute , stse_platform_ecc_*).
+ */
+
+#ifndef STSE_SIMULATOR_H
+#define STSE_SIMULATOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "core/stse_device.h"
+#include "core/stse_frame.h"
+#include "core/stse_platform.h"
+#include "services/stsafea/stsafea_commands.h"
+#include "services/stsafea/stsafea_put_query.h"
+#include "services/stsafea/stsafea_timings.h"
+
+/*! \defgroup stse_simulator STSAFE-A device simulator
+ *  \brief      Software STSAFE-A target device for host functional and performance testing
+ *  \details    The simulator implements the STSAFE-A I2C frame protocol (command CRC check , response length
+ *              header , response status code) and the following commands :
+ *              - Echo , Generate random
+ *              - Query (product data , command authorization configuration , host key slot V1/V2 ,
+ *                data partition configuration)
+ *              - Read , Update and Decrement data partition zones
+ *              - Start/Process/Finish hash
+ *              - Generate signature , Verify signature
+ *              - Encrypt (AES-GCM key slots)
+ *              - Host session C-MAC/R-MAC authentication and command/response encryption
+ *
+ *              Each command response is made available after a configurable latency initialized from the
+ *              \ref stsafea_cmd_timings table. Until the latency has elapsed , the simulated device does not
+ *              acknowledge the bus transactions (\ref STSE_PLATFORM_BUS_ACK_ERROR) , as a real device does.
+ *  @{
+ */
+
+#ifdef STSE_CONF_STSAFE_A_SUPPORT
+
+#ifndef STSE_SIMULATOR_MAX_DEVICES
+#define STSE_SIMULATOR_MAX_DEVICES 4U /*!< Maximum number of simultaneously attached simulated devices */
+#endif
+
+#ifndef STSE_SIMULATOR_MAX_ZONES
+#define STSE_SIMULATOR_MAX_ZONES 8U /*!< Number of data partition zones per simulated device */
+#endif
+
+#ifndef STSE_SIMULATOR_MAX_PRIVATE_KEY_SLOTS
+#define STSE_SIMULATOR_MAX_PRIVATE_KEY_SLOTS 2U /*!< Number of private key slots per simulated device */
+#endif
+
+#ifndef STSE_SIMULATOR_MAX_SYMMETRIC_KEY_SLOTS
+#define STSE_SIMULATOR_MAX_SYMMETRIC_KEY_SLOTS 2U /*!< Number of symmetric key slots per simulated device */
+#endif
+
+#ifndef STSE_SIMULATOR_HASH_BUFFER_SIZE
+#define STSE_SIMULATOR_HASH_BUFFER_SIZE 4096U /*!< Maximum message size of a Start/Process/Finish hash sequence */
+#endif
+
+#define STSE_SIMULATOR_FRAME_BUFFER_SIZE                                              \
+    (STSAFEA_MAX_FRAME_LENGTH_A120 + STSE_FRAME_LENGTH_SIZE + STSE_FRAME_CRC_SIZE + \
+     STSAFEA_MAC_SIZE + 16U) /*!< Simulated device frame buffer size (including response encryption padding) */
+
+/*!
+ * \struct stse_simulator_zone_t
+ * \brief STSAFE-A simulator data partition zone
+ */
+typedef struct stse_simulator_zone_t {
+    PLAT_UI8 *pData;          /*!< Zone content (caller allocated , NULL if zone not present) */
+    PLAT_UI16 size;           /*!< Zone size in bytes */
+    PLAT_UI8 zone_type;       /*!< 0x00 = data zone , 0x01 = counter zone */
+    stse_zone_ac_t read_ac;   /*!< Read access condition */
+    stse_zone_ac_t update_ac; /*!< Update / decrement access condition */
+    PLAT_UI32 counter;        /*!< Counter value (counter zone only) */
+} stse_simulator_zone_t;
+
+/*!
+ * \struct stse_simulator_private_key_t
+ * \brief STSAFE-A simulator private key slot
+ */
+typedef struct stse_simulator_private_key_t {
+    stse_ecc_key_type_t key_type; /*!< Private key type */
+    PLAT_UI8 *pPrivate_key;       /*!< Private key value (caller allocated , NULL if slot empty) */
+} stse_simulator_private_key_t;
+
+/*!
+ * \struct stse_simulator_symmetric_key_t
+ * \brief STSAFE-A simulator symmetric key slot
+ * \details Symmetric key slots are AES-GCM encryption keys (the Encrypt command mode is set by the key slot)
+ */
+typedef struct stse_simulator_symmetric_key_t {
+    stse_aes_key_type_t key_type; /*!< Symmetric key type */
+    PLAT_UI8 *pKey;               /*!< Symmetric key value (caller allocated , NULL if slot empty) */
+    PLAT_UI8 tag_length;          /*!< AES-GCM authentication tag length in bytes */
+} stse_simulator_symmetric_key_t;
+
+/*!
+ * \struct stse_simulator_statistics_t
+ * \brief STSAFE-A simulator statistics
+ */
+typedef struct stse_simulator_statistics_t {
+    PLAT_UI32 cmd_count;       /*!< Number of processed commands */
+    PLAT_UI32 error_count;     /*!< Number of commands answered with an error status */
+    PLAT_UI32 send_count;      /*!< Number of command bus transactions */
+    PLAT_UI32 receive_count;   /*!< Number of acknowledged response bus transactions */
+    PLAT_UI32 nack_count;      /*!< Number of bus transactions not acknowledged (device busy) */
+    PLAT_UI32 cmd_bytes;       /*!< Cumulated command frame bytes */
+    PLAT_UI32 rsp_bytes;       /*!< Cumulated response frame bytes */
+} stse_simulator_statistics_t;
+
+/*!
+ * \struct stse_simulator_t
+ * \brief STSAFE-A simulated device context
+ */
+typedef struct stse_simulator_t {
+    stse_device_t device_type;                                     /*!< Simulated device type */
+    PLAT_UI8 mask_id[STSAFEA_MASK_ID_SIZE];                        /*!< Product data mask identifier */
+    stse_perso_info_t perso_info;                                  /*!< Command access conditions and encryption flags */
+    PLAT_UI16 cmd_latency[STSAFEA_MAX_CMD_COUNT];                  /*!< Command processing latency in ms */
+    PLAT_UI16 ext_cmd_latency[STSAFEA_MAX_EXT_CMD_COUNT];          /*!< Extended command processing latency in ms */
+    PLAT_UI32 (*pGet_time_ms)(void);                               /*!< Millisecond time source (NULL : no processing latency) */
+    PLAT_UI8 host_key_presence;                                    /*!< Host key slot provisioned flag */
+    stse_aes_key_type_t host_key_type;                             /*!< Host keys type */
+    PLAT_UI8 host_MAC_key[STSE_AES_256_KEY_SIZE];                  /*!< Host MAC key */
+    PLAT_UI8 host_cipher_key[STSE_AES_256_KEY_SIZE];               /*!< Host cipher key */
+    PLAT_UI32 host_MAC_counter;                                    /*!< Host C-MAC sequence counter */
+    stse_simulator_zone_t zone[STSE_SIMULATOR_MAX_ZONES];          /*!< Data partition zones */
+    stse_simulator_private_key_t private_key[STSE_SIMULATOR_MAX_PRIVATE_KEY_SLOTS]; /*!< Private key slots */
+    stse_simulator_symmetric_key_t symmetric_key[STSE_SIMULATOR_MAX_SYMMETRIC_KEY_SLOTS]; /*!< Symmetric key slots */
+    stse_ReturnCode_t (*pEcc_sign)(stse_ecc_key_type_t key_type,
+                                   PLAT_UI8 *pPrivKey,
+                                   PLAT_UI8 *pDigest,
+                                   PLAT_UI16 digestLen,
+                                   PLAT_UI8 *pSignature); /*!< Signature generation function (NULL : Generate signature not supported) */
+    stse_simulator_statistics_t statistics;                        /*!< Simulated device statistics */
+    /* - Internal state */
+    PLAT_UI8 busID;                                                /*!< Attached bus identifier */
+    PLAT_UI8 devAddr;                                              /*!< Attached device address */
+    PLAT_UI8 hash_active;                                          /*!< Hash sequence started flag */
+    PLAT_UI8 hash_algorithm;                                       /*!< Hash sequence algorithm */
+    PLAT_UI16 hash_length;                                         /*!< Hash sequence message length */
+    PLAT_UI8 hash_buffer[STSE_SIMULATOR_HASH_BUFFER_SIZE];         /*!< Hash sequence message */
+    PLAT_UI16 cmd_length;                                          /*!< Received command frame length */
+    PLAT_UI16 cmd_expected_length;                                 /*!< Announced command frame length */
+    PLAT_UI8 cmd_buffer[STSE_SIMULATOR_FRAME_BUFFER_SIZE];         /*!< Received command frame */
+    PLAT_UI8 payload_buffer[STSE_SIMULATOR_FRAME_BUFFER_SIZE];     /*!< Decrypted command payload */
+    PLAT_UI8 work_buffer[2U * STSE_SIMULATOR_FRAME_BUFFER_SIZE];   /*!< Cryptographic computation buffer */
+    PLAT_UI16 rsp_length;                                          /*!< Response frame length */
+    PLAT_UI16 rsp_offset;                                          /*!< Response frame read offset */
+    PLAT_UI8 rsp_buffer[STSE_SIMULATOR_FRAME_BUFFER_SIZE];         /*!< Response frame */
+    PLAT_UI32 rsp_ready_time;                                      /*!< Response availability time */
+} stse_simulator_t;
+
+/**
+ * \brief       Initialize a simulated device
+ * \details     The device is initialized with the product mask identifier of the requested device type , all
+ *              commands in free access without encryption , no host key , no zone , no private key and command
+ *              latencies copied from the \ref stsafea_cmd_timings and \ref stsafea_extended_cmd_timings tables
+ * \param[out]  pSim        Pointer to simulated device context
+ * \param[in]   device_type Simulated device type (STSAFE-A100 , STSAFE-A110 or STSAFE-A120)
+ * \return      \ref STSE_OK on success ; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_simulator_init(stse_simulator_t *pSim, stse_device_t device_type);
+
+/**
+ * \brief       Attach a simulated device to an STSE handler
+ * \details     The simulated device is registered at the handler bus identifier and device address and the handler
+ *              bus callbacks are replaced by the simulator ones. Shall be called after
+ *              \ref stse_set_default_handler_value and before \ref stse_init.
+ * \param[in]   pSim        Pointer to simulated device context
+ * \param[in,out] pSTSE     Pointer to STSE handler
+ * \return      \ref STSE_OK on success ; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_simulator_attach(stse_simulator_t *pSim, stse_Handler_t *pSTSE);
+
+/**
+ * \brief       Detach a simulated device
+ * \param[in]   pSim        Pointer to simulated device context
+ */
+void stse_simulator_detach(stse_simulator_t *pSim);
+
+/**
+ * \brief       Provision the simulated device host keys
+ * \param[in,out] pSim          Pointer to simulated device context
+ * \param[in]   key_type        Host keys type
+ * \param[in]   pHost_MAC_key   Host MAC key
+ * \param[in]   pHost_cipher_key Host cipher key
+ * \param[in]   MAC_counter     Initial host C-MAC sequence counter
+ * \return      \ref STSE_OK on success ; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_simulator_set_host_keys(stse_simulator_t *pSim,
+                                               stse_aes_key_type_t key_type,
+                                               const PLAT_UI8 *pHost_MAC_key,
+                                               const PLAT_UI8 *pHost_cipher_key,
+                                               PLAT_UI32 MAC_counter);
+
+/**
+ * \brief       Configure a simulated device data partition zone
+ * \param[in,out] pSim          Pointer to simulated device context
+ * \param[in]   zone_index      Zone index (lower than \ref STSE_SIMULATOR_MAX_ZONES)
+ * \param[in]   zone_type       0x00 for data zone ; 0x01 for counter zone
+ * \param[in]   read_ac         Read access condition
+ * \param[in]   update_ac       Update / decrement access condition
+ * \param[in]   pData           Zone content buffer (caller allocated , kept by the simulator)
+ * \param[in]   size            Zone size in bytes
+ * \param[in]   counter         Initial counter value (counter zone only)
+ * \return      \ref STSE_OK on success ; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_simulator_set_zone(stse_simulator_t *pSim,
+                                          PLAT_UI8 zone_index,
+                                          PLAT_UI8 zone_type,
+                                          stse_zone_ac_t read_ac,
+                                          stse_zone_ac_t update_ac,
+                                          PLAT_UI8 *pData,
+                                          PLAT_UI16 size,
+                                          PLAT_UI32 counter);
+
+/**
+ * \brief       Provision a simulated device private key slot
+ * \details     Generate signature command relies on the \ref stse_simulator_t::pEcc_sign function
+ *              (\ref stse_platform_ecc_sign when declared by the library configuration)
+ * \param[in,out] pSim          Pointer to simulated device context
+ * \param[in]   slot_number     Private key slot number (lower than \ref STSE_SIMULATOR_MAX_PRIVATE_KEY_SLOTS)
+ * \param[in]   key_type        Private key type
+ * \param[in]   pPrivate_key    Private key buffer (caller allocated , kept by the simulator)
+ * \return      \ref STSE_OK on success ; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_simulator_set_private_key(stse_simulator_t *pSim,
+                                                 PLAT_UI8 slot_number,
+                                                 stse_ecc_key_type_t key_type,
+                                                 PLAT_UI8 *pPrivate_key);
+
+/**
+ * \brief       Provision a simulated device symmetric key slot
+ * \param[in,out] pSim          Pointer to simulated device context
+ * \param[in]   slot_number     Symmetric key slot number (lower than \ref STSE_SIMULATOR_MAX_SYMMETRIC_KEY_SLOTS)
+ * \param[in]   key_type        Symmetric key type
+ * \param[in]   pKey            Symmetric key buffer (caller allocated , kept by the simulator)
+ * \param[in]   tag_length      AES-GCM authentication tag length in bytes (4 to 16)
+ * \return      \ref STSE_OK on success ; \ref stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_simulator_set_symmetric_key(stse_simulator_t *pSim,
+                                                   PLAT_UI8 slot_number,
+                                                   stse_aes_key_type_t key_type,
+                                                   PLAT_UI8 *pKey,
+                                                   PLAT_UI8 tag_length);
+
+/**
+ * \brief       Set the access condition and encryption flags of a simulated device command
+ * \param[in,out] pSim          Pointer to simulated device context
+ * \param[in]   cmd_header      Command code (or extended command code when extended is set)
+ * \param[in]   extended        1 for extended command code ; 0 otherwise
+ * \param[in]   cmd_AC          Command access condition (\ref STSE_CMD_AC_FREE or \ref STSE_CMD_AC_HOST ; other access conditions are never satisfied)
+ * \param[in]   cmd_encryption  Command payload encryption flag
+ * \param[in]   rsp_encryption  Response payload encryption flag
+ */
+void stse_simulator_set_cmd_protection(stse_simulator_t *pSim,
+                                       PLAT_UI8 cmd_header,
+                                       PLAT_UI8 extended,
+                                       stse_cmd_access_conditions_t cmd_AC,
+                                       PLAT_UI8 cmd_encryption,
+                                       PLAT_UI8 rsp_encryption);
+
+/**
+ * \brief       Set the processing latency of a simulated device command
+ * \param[in,out] pSim          Pointer to simulated device context
+ * \param[in]   cmd_header      Command code (or extended command code when extended is set)
+ * \param[in]   extended        1 for extended command code ; 0 otherwise
+ * \param[in]   latency         Processing latency in ms
+ */
+void stse_simulator_set_cmd_latency(stse_simulator_t *pSim,
+                                    PLAT_UI8 cmd_header,
+                                    PLAT_UI8 extended,
+                                    PLAT_UI16 latency);
+
+/**
+ * \brief       Clear the simulated device statistics
+ * \param[in,out] pSim          Pointer to simulated device context
+ */
+void stse_simulator_reset_statistics(stse_simulator_t *pSim);
+
+#endif /* STSE_CONF_STSAFE_A_SUPPORT */
+
+/** @}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STSE_SIMULATOR_H */
@@ -0,0 +1,267 @@
+/*!
+ * ******************************************************************************
+ * \file	stse_transfer_benchmark.c
+ * \brief   STSELib frame transfer host overhead microbenchmark
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ * \details Host CPU time spent by the library on each frame transfer , measured against a loopback bus that
+ *          answers every command with a canned response (no device processing , no bus delay). Each transfer
+ *          reads the command authorization of the handler perso bitmaps , sends a command frame and receives
+ *          the response frame through the element-wise bus callbacks , as done by the STSAFE-A services.
+ *          Build the benchmark twice , with and without STSE_CONF_USE_ALIGNED_HANDLER , to compare the packed
+ *          and naturally aligned handler layouts.
+ *          Build   : stse_transfer_benchmark (packed layout) and stse_transfer_benchmark_aligned
+ *                    (STSE_CONF_USE_ALIGNED_HANDLER) targets of the repository root CMake project (tools/CMakeLists.txt)
+ *                    (STSE_CONF_STSAFE_A_SUPPORT and STSE_CONF_USE_BUILTIN_CRC16 required)
+ *          Usage   : stse_transfer_benchmark [-n transfers] [-r rounds] [-p payload_bytes]
+ *                    -n  number of transfers per round (default 100000)
+ *                    -r  number of measurement rounds , the fastest round is reported (default 10)
+ *                    -p  command and response payload size (default 32)
+ *          Output  : one JSON object , e.g.
+ *                    {"benchmark":"frame_transfer","layout":"aligned","handler_bytes":184,"io_offset":0,
+ *                     "payload_bytes":32,"transfers":100000,"ns_per_transfer":412.7,"ns_per_transfer_mean":431.0}
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <time.h>
+
+#include "stselib.h"
+#include "core/stse_crc16.h"
+
+#if !defined(STSE_CONF_STSAFE_A_SUPPORT) || !defined(STSE_CONF_USE_BUILTIN_CRC16)
+#error "stse_transfer_benchmark requires STSE_CONF_STSAFE_A_SUPPORT and STSE_CONF_USE_BUILTIN_CRC16"
+#endif
+
+#define STSE_TRANSFER_BENCHMARK_DEFAULT_TRANSFERS 100000U
+#define STSE_TRANSFER_BENCHMARK_DEFAULT_ROUNDS 10U
+#define STSE_TRANSFER_BENCHMARK_DEFAULT_PAYLOAD 32U
+#define STSE_TRANSFER_BENCHMARK_MAX_PAYLOAD 256U
+#define STSE_TRANSFER_BENCHMARK_RSP_PAYLOAD_OFFSET (STSE_RSP_FRAME_HEADER_SIZE + STSE_FRAME_LENGTH_SIZE)
+
+static stse_Handler_t benchmark_handler;
+static PLAT_UI8 benchmark_payload[STSE_TRANSFER_BENCHMARK_MAX_PAYLOAD];
+static PLAT_UI8 benchmark_rsp_frame[STSE_TRANSFER_BENCHMARK_RSP_PAYLOAD_OFFSET + STSE_TRANSFER_BENCHMARK_MAX_PAYLOAD + STSE_FRAME_CRC_SIZE];
+static PLAT_UI16 benchmark_rsp_length;
+static PLAT_UI16 benchmark_rsp_offset;
+
+static double stse_transfer_benchmark_time_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+
+    return ((double)ts.tv_sec * 1000000000.0) + (double)ts.tv_nsec;
+}
+
+/* Loopback bus --------------------------------------------------------------*/
+
+static stse_ReturnCode_t stse_transfer_benchmark_send_start(PLAT_UI8 busID,
+                                                            PLAT_UI8 devAddr,
+                                                            PLAT_UI16 speed,
+                                                            PLAT_UI16 frame_length) {
+    (void)busID;
+    (void)devAddr;
+    (void)speed;
+    (void)frame_length;
+
+    return STSE_OK;
+}
+
+static stse_ReturnCode_t stse_transfer_benchmark_send_continue(PLAT_UI8 busID,
+                                                               PLAT_UI8 devAddr,
+                                                               PLAT_UI16 speed,
+                                                               PLAT_UI8 *pData,
+                                                               PLAT_UI16 data_size) {
+    (void)busID;
+    (void)devAddr;
+    (void)speed;
+    (void)pData;
+    (void)data_size;
+
+    return STSE_OK;
+}
+
+static stse_ReturnCode_t stse_transfer_benchmark_receive_start(PLAT_UI8 busID,
+                                                               PLAT_UI8 devAddr,
+                                                               PLAT_UI16 speed,
+                                                               PLAT_UI16 frame_length) {
+    (void)busID;
+    (void)devAddr;
+    (void)speed;
+    (void)frame_length;
+
+    benchmark_rsp_offset = 0;
+
+    return STSE_OK;
+}
+
+static stse_ReturnCode_t stse_transfer_benchmark_receive_continue(PLAT_UI8 busID,
+                                                                  PLAT_UI8 devAddr,
+                                                                  PLAT_UI16 speed,
+                                                                  PLAT_UI8 *pData,
+                                                                  PLAT_UI16 data_size) {
+    PLAT_UI16 length = data_size;
+
+    (void)busID;
+    (void)devAddr;
+    (void)speed;
+
+    if (length > (benchmark_rsp_length - benchmark_rsp_offset)) {
+        length = benchmark_rsp_length - benchmark_rsp_offset;
+    }
+    if (pData != NULL) {
+        memcpy(pData, &benchmark_rsp_frame[benchmark_rsp_offset], length);
+        memset(pData + length, 0xFF, data_size - length);
+    }
+    benchmark_rsp_offset += length;
+
+    return STSE_OK;
+}
+
+static void stse_transfer_benchmark_rsp_set(PLAT_UI16 payload_length) {
+    PLAT_UI16 crc;
+
+    /* - [status OK][length = payload + CRC][payload][CRC over status and payload] */
+    benchmark_rsp_frame[0] = STSE_OK;
+    benchmark_rsp_frame[1] = UI16_B1(payload_length + STSE_FRAME_CRC_SIZE);
+    benchmark_rsp_frame[2] = UI16_B0(payload_length + STSE_FRAME_CRC_SIZE);
+    memcpy(&benchmark_rsp_frame[STSE_TRANSFER_BENCHMARK_RSP_PAYLOAD_OFFSET], benchmark_payload, payload_length);
+    crc = stse_crc16_finalize(stse_crc16_update(STSE_CRC16_INIT_VALUE, benchmark_rsp_frame, STSE_RSP_FRAME_HEADER_SIZE));
+    if (payload_length != 0) {
+        crc = stse_crc16_accumulate(crc, &benchmark_rsp_frame[STSE_TRANSFER_BENCHMARK_RSP_PAYLOAD_OFFSET], payload_length);
+    }
+    benchmark_rsp_frame[STSE_TRANSFER_BENCHMARK_RSP_PAYLOAD_OFFSET + payload_length] = UI16_B1(crc);
+    benchmark_rsp_frame[STSE_TRANSFER_BENCHMARK_RSP_PAYLOAD_OFFSET + payload_length + 1] = UI16_B0(crc);
+    benchmark_rsp_length = STSE_TRANSFER_BENCHMARK_RSP_PAYLOAD_OFFSET + payload_length + STSE_FRAME_CRC_SIZE;
+}
+
+/* Measured transfer ---------------------------------------------------------*/
+
+static stse_ReturnCode_t stse_transfer_benchmark_transfer(stse_Handler_t *pSTSE, PLAT_UI16 payload_length) {
+    stse_ReturnCode_t ret;
+    PLAT_UI8 cmd_header = STSAFEA_CMD_ECHO;
+    PLAT_UI8 rsp_header;
+    PLAT_UI8 rsp_payload[STSE_TRANSFER_BENCHMARK_MAX_PAYLOAD];
+    stse_cmd_access_conditions_t cmd_AC;
+    PLAT_UI8 cmd_encryption_flag;
+    PLAT_UI8 rsp_encryption_flag;
+
+    /* - Command authorization lookup performed by stsafea_frame_transfer */
+    stsafea_perso_info_get_cmd_AC(&pSTSE->perso_info, cmd_header, &cmd_AC);
+    stsafea_perso_info_get_cmd_encrypt_flag(&pSTSE->perso_info, cmd_header, &cmd_encryption_flag);
+    stsafea_perso_info_get_rsp_encrypt_flag(&pSTSE->perso_info, cmd_header, &rsp_encryption_flag);
+    if ((cmd_AC != STSE_CMD_AC_FREE) || (cmd_encryption_flag != 0) || (rsp_encryption_flag != 0)) {
+        return STSE_SERVICE_SESSION_ERROR;
+    }
+
+    stse_frame_allocate(CmdFrame);
+    stse_frame_element_allocate_push(&CmdFrame, eCmd_header, STSAFEA_HEADER_SIZE, &cmd_header);
+    stse_frame_element_allocate_push(&CmdFrame, eCmd_payload, payload_length, benchmark_payload);
+
+    stse_frame_allocate(RspFrame);
+    stse_frame_element_allocate_push(&RspFrame, eRsp_header, STSAFEA_HEADER_SIZE, &rsp_header);
+    stse_frame_element_allocate_push(&RspFrame, eRsp_payload, payload_length, rsp_payload);
+
+    ret = stsafea_frame_transmit(pSTSE, &CmdFrame);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+
+    return stsafea_frame_receive(pSTSE, &RspFrame);
+}
+
+int main(int argc, char **argv) {
+    stse_ReturnCode_t ret = STSE_OK;
+    PLAT_UI32 transfers = STSE_TRANSFER_BENCHMARK_DEFAULT_TRANSFERS;
+    PLAT_UI32 rounds = STSE_TRANSFER_BENCHMARK_DEFAULT_ROUNDS;
+    PLAT_UI16 payload_length = STSE_TRANSFER_BENCHMARK_DEFAULT_PAYLOAD;
+    double round_start;
+    double round_ns;
+    double best_ns = 0;
+    double total_ns = 0;
+    PLAT_UI32 round;
+    PLAT_UI32 i;
+    int arg;
+
+    for (arg = 1; arg < argc; arg++) {
+        if ((strcmp(argv[arg], "-n") == 0) && (arg + 1 < argc)) {
+            transfers = (PLAT_UI32)strtoul(argv[++arg], NULL, 0);
+        } else if ((strcmp(argv[arg], "-r") == 0) && (arg + 1 < argc)) {
+            rounds = (PLAT_UI32)strtoul(argv[++arg], NULL, 0);
+        } else if ((strcmp(argv[arg], "-p") == 0) && (arg + 1 < argc)) {
+            payload_length = (PLAT_UI16)strtoul(argv[++arg], NULL, 0);
+        } else {
+            fprintf(stderr, "usage: %s [-n transfers] [-r rounds] [-p payload_bytes]\n", argv[0]);
+            return 1;
+        }
+    }
+    if ((transfers == 0) || (rounds == 0) || (payload_length > STSE_TRANSFER_BENCHMARK_MAX_PAYLOAD)) {
+        fprintf(stderr, "transfers and rounds must be non zero , payload_bytes in 0..%u\n", STSE_TRANSFER_BENCHMARK_MAX_PAYLOAD);
+        return 1;
+    }
+
+    for (i = 0; i < sizeof(benchmark_payload); i++) {
+        benchmark_payload[i] = (PLAT_UI8)i;
+    }
+    stse_platform_crc16_init();
+    stse_transfer_benchmark_rsp_set(payload_length);
+
+    /* - Handler on loopback bus , all commands in free access without encryption */
+    stse_set_default_handler_value(&benchmark_handler);
+    benchmark_handler.device_type = STSAFE_A120;
+    benchmark_handler.perso_info.cmd_AC_status = 0x5555555555555555;
+    benchmark_handler.perso_info.ext_cmd_AC_status = 0x5555555555555555;
+    benchmark_handler.io.BusSendStart = stse_transfer_benchmark_send_start;
+    benchmark_handler.io.BusSendContinue = stse_transfer_benchmark_send_continue;
+    benchmark_handler.io.BusSendStop = stse_transfer_benchmark_send_continue;
+    benchmark_handler.io.BusRecvStart = stse_transfer_benchmark_receive_start;
+    benchmark_handler.io.BusRecvContinue = stse_transfer_benchmark_receive_continue;
+    benchmark_handler.io.BusRecvStop = stse_transfer_benchmark_receive_continue;
+
+    for (round = 0; (round < rounds) && (ret == STSE_OK); round++) {
+        round_start = stse_transfer_benchmark_time_ns();
+        for (i = 0; (i < transfers) && (ret == STSE_OK); i++) {
+            ret = stse_transfer_benchmark_transfer(&benchmark_handler, payload_length);
+        }
+        round_ns = stse_transfer_benchmark_time_ns() - round_start;
+        total_ns += round_ns;
+        if ((round == 0) || (round_ns < best_ns)) {
+            best_ns = round_ns;
+        }
+    }
+    if (ret != STSE_OK) {
+        fprintf(stderr, "transfer error 0x%04X\n", ret);
+        return 1;
+    }
+
+    printf("{\"benchmark\":\"frame_transfer\",\"layout\":\"%s\",\"handler_bytes\":%u,\"io_offset\":%u,\"perso_info_offset\":%u,"
+           "\"payload_bytes\":%u,\"transfers\":%u,\"ns_per_transfer\":%.1f,\"ns_per_transfer_mean\":%.1f}\n",
+#ifdef STSE_CONF_USE_ALIGNED_HANDLER
+           "aligned",
+#else
+           "packed",
+#endif /* STSE_CONF_USE_ALIGNED_HANDLER */
+           (unsigned int)sizeof(stse_Handler_t),
+           (unsigned int)offsetof(stse_Handler_t, io),
+           (unsigned int)offsetof(stse_Handler_t, perso_info),
+           payload_length,
+           (unsigned int)transfers,
+           best_ns / transfers,
+           total_ns / ((double)transfers * rounds));
+
+    return 0;
+}